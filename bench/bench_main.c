@@ -0,0 +1,661 @@
+/*******************************************************************************
+* File Name:   bench_main.c
+*
+* Description: This file contains the scenarios of the host benchmark. Each
+* scenario runs network_idle_task() from tcp_keepalive_offload.c against the
+* stand-ins in stand_in.c and writes its metrics as JSON, which
+* compare_baselines.py checks against baselines.json.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+#include "stand_in.h"
+#include "tcp_keepalive_offload.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TASK_STACK_SIZE                          (256U * 1024U)
+#define DEFAULT_ITERATIONS                       (20U)
+#define MAX_METRICS                              (12U)
+
+/* Scenario timeline, in virtual milliseconds. */
+#define SETTLE_MS                                (10000U)
+#define SERVER_RESTART_MS                        (5000U)
+#define AP_DROP_AT_MS                            (20000U)
+#define AP_OUTAGE_MS                             (30000U)
+#define BURST_COMMANDS                           (200U)
+#define BURST_SPACING_MS                         (20U)
+#define IDLE_PERIOD_MS                           (3600U * 1000U)
+#define SILENT_PERIOD_MS                         (30000U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    double value;
+} metric_t;
+
+typedef struct
+{
+    metric_t metrics[MAX_METRICS];
+    uint32_t count;
+} metric_set_t;
+
+typedef struct
+{
+    const char *name;
+    const char *description;
+    void (*schedule)(void);
+    void (*collect)(const stand_in_stats_t *stats, const stand_in_run_result_t *run,
+                    metric_set_t *out);
+} scenario_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const stand_in_world_t default_world =
+{
+    .ap_join_ms         = 1800U,
+    .ap_join_timeout_ms = 10000U,
+    .ap_rejoin_ms       = 2500U,
+    .rtt_ms             = 30U,
+    .syn_rto_ms         = 3000U,
+    .rto_ms             = 1000U,
+    .connect_timeout_ms = 10000U,
+    .uart_input         = "192.168.1.10\r"
+};
+
+/* Fault profiles for the fault_* scenarios. */
+static const stand_in_faults_t lossy_link =
+{
+    .seed        = 1U,
+    .loss_pct    = 10U,
+    .latency_ms  = 40U,
+    .jitter_ms   = 40U,
+    .reorder_pct = 5U,
+    .reorder_ms  = 200U
+};
+
+static const stand_in_faults_t bad_link =
+{
+    .seed        = 2U,
+    .loss_pct    = 30U,
+    .latency_ms  = 80U,
+    .jitter_ms   = 120U
+};
+
+static const stand_in_faults_t slow_server =
+{
+    .seed            = 3U,
+    .synack_delay_ms = 4000U
+};
+
+static uint8_t task_stack[TASK_STACK_SIZE];
+
+/*******************************************************************************
+* Function Name: add_metric
+*******************************************************************************/
+static void add_metric(metric_set_t *out, const char *name, double value)
+{
+    if (out->count < MAX_METRICS)
+    {
+        out->metrics[out->count].name = name;
+        out->metrics[out->count].value = value;
+        out->count++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: recovery_ms
+********************************************************************************
+* Summary:
+*  Time from a fault to the next successful connection. A client that never
+*  reconnects is charged the rest of the scenario.
+*
+*******************************************************************************/
+static double recovery_ms(const stand_in_stats_t *stats, const stand_in_run_result_t *run,
+                          uint64_t fault_ms)
+{
+    if (stats->last_connect_ms > fault_ms)
+    {
+        return (double)(stats->last_connect_ms - fault_ms);
+    }
+
+    return (double)(run->end_ms - fault_ms);
+}
+
+/*******************************************************************************
+* Function Name: add_fault_metrics
+********************************************************************************
+* Summary:
+*  Adds the metrics common to the fault scenarios: how long the client took to
+*  notice the fault, how long until it was connected again, and how many AP
+*  joins and server connects it spent in vain on the way. The scenarios keep
+*  the connection up until the fault, so the first disconnect is its
+*  detection. A client that never notices or never reconnects is charged the
+*  rest of the scenario.
+*
+*******************************************************************************/
+static void add_fault_metrics(metric_set_t *out, const stand_in_stats_t *stats,
+                              const stand_in_run_result_t *run, uint64_t fault_ms)
+{
+    double detect = (0U != stats->first_disconnect_ms) ?
+                    (double)(stats->first_disconnect_ms - fault_ms) :
+                    (double)(run->end_ms - fault_ms);
+    double recover = (0U != stats->reconnect_ms) ?
+                     (double)(stats->reconnect_ms - fault_ms) :
+                     (double)(run->end_ms - fault_ms);
+
+    add_metric(out, "detect_ms", detect);
+    add_metric(out, "recover_ms", recover);
+    add_metric(out, "wasted_retries", stats->connect_failures + stats->wifi_join_failures);
+}
+
+/*******************************************************************************
+* Scenario: cold_connect
+* Power-up to connected: radio bring-up, AP join, address prompt and connect.
+*******************************************************************************/
+static void cold_connect_schedule(void)
+{
+    stand_in_schedule(SETTLE_MS, STAND_IN_EV_END, 0U);
+}
+
+static void cold_connect_collect(const stand_in_stats_t *stats,
+                                 const stand_in_run_result_t *run, metric_set_t *out)
+{
+    (void)run;
+    add_metric(out, "online_ms", (double)stats->online_ms);
+    add_metric(out, "wifi_join_calls", stats->wifi_join_calls);
+    add_metric(out, "connect_calls", stats->connect_calls);
+    add_metric(out, "host_wakes", stats->host_wakes);
+    add_metric(out, "api_calls", stats->api_calls);
+}
+
+/*******************************************************************************
+* Scenario: server_drop_reconnect
+* The server closes the connection and listens again straight away.
+*******************************************************************************/
+static void server_drop_schedule(void)
+{
+    stand_in_schedule(SETTLE_MS, STAND_IN_EV_SERVER_DROP, 0U);
+    stand_in_schedule(2U * SETTLE_MS, STAND_IN_EV_END, 0U);
+}
+
+static void server_drop_collect(const stand_in_stats_t *stats,
+                                const stand_in_run_result_t *run, metric_set_t *out)
+{
+    add_metric(out, "recover_ms", recovery_ms(stats, run, SETTLE_MS));
+    add_metric(out, "connect_calls", stats->connect_calls);
+    add_metric(out, "sockets_open", stats->sockets_open);
+    add_metric(out, "sockets_peak", stats->sockets_peak);
+    add_metric(out, "api_calls", stats->api_calls);
+}
+
+/*******************************************************************************
+* Scenario: server_restart_slow
+* The server closes the connection and is down for SERVER_RESTART_MS.
+*******************************************************************************/
+static void server_restart_schedule(void)
+{
+    stand_in_schedule(SETTLE_MS, STAND_IN_EV_SERVER_DROP, SERVER_RESTART_MS);
+    stand_in_schedule(6U * SETTLE_MS, STAND_IN_EV_END, 0U);
+}
+
+static void server_restart_collect(const stand_in_stats_t *stats,
+                                   const stand_in_run_result_t *run, metric_set_t *out)
+{
+    add_metric(out, "recovered", (stats->last_connect_ms > SETTLE_MS) ? 1.0 : 0.0);
+    add_metric(out, "recover_ms", recovery_ms(stats, run, SETTLE_MS));
+    add_metric(out, "wasted_connects", stats->connect_failures);
+    add_metric(out, "sockets_open", stats->sockets_open);
+    add_metric(out, "api_calls", stats->api_calls);
+}
+
+/*******************************************************************************
+* Scenario: ap_drop_rejoin
+* The access point goes away for AP_OUTAGE_MS; WCM rejoins when it is back.
+*******************************************************************************/
+static void ap_drop_schedule(void)
+{
+    stand_in_schedule(AP_DROP_AT_MS, STAND_IN_EV_AP_DROP, AP_OUTAGE_MS);
+    stand_in_schedule(AP_DROP_AT_MS + AP_OUTAGE_MS + (4U * SETTLE_MS), STAND_IN_EV_END, 0U);
+}
+
+static void ap_drop_collect(const stand_in_stats_t *stats,
+                            const stand_in_run_result_t *run, metric_set_t *out)
+{
+    double detect = (stats->last_disconnect_ms > AP_DROP_AT_MS) ?
+                    (double)(stats->last_disconnect_ms - AP_DROP_AT_MS) :
+                    (double)(run->end_ms - AP_DROP_AT_MS);
+
+    add_metric(out, "detect_ms", detect);
+    add_metric(out, "recover_ms", recovery_ms(stats, run, AP_DROP_AT_MS));
+    add_metric(out, "wasted_connects", stats->connect_failures);
+    add_metric(out, "keepalive_probes", stats->keepalive_probes);
+    add_metric(out, "host_wakes", stats->host_wakes);
+    add_metric(out, "sockets_open", stats->sockets_open);
+}
+
+/*******************************************************************************
+* Scenario: command_burst
+* BURST_COMMANDS LED commands BURST_SPACING_MS apart; every tenth is invalid.
+*******************************************************************************/
+static void command_burst_schedule(void)
+{
+    for (uint32_t i = 0U; i < BURST_COMMANDS; i++)
+    {
+        uint32_t command = (9U == (i % 10U)) ? 'x' : ((0U == (i % 2U)) ? '1' : '0');
+
+        stand_in_schedule(SETTLE_MS + (i * BURST_SPACING_MS), STAND_IN_EV_COMMAND, command);
+    }
+    stand_in_schedule(2U * SETTLE_MS + (BURST_COMMANDS * BURST_SPACING_MS), STAND_IN_EV_END, 0U);
+}
+
+static void command_burst_collect(const stand_in_stats_t *stats,
+                                  const stand_in_run_result_t *run, metric_set_t *out)
+{
+    (void)run;
+    add_metric(out, "acks_ok", stats->acks_ok);
+    add_metric(out, "acks_bad", stats->acks_bad);
+    add_metric(out, "commands_lost", stats->commands_lost);
+    add_metric(out, "ack_latency_max_ms", (double)stats->ack_latency_max_ms);
+    add_metric(out, "host_wakes", stats->host_wakes);
+    add_metric(out, "api_calls_per_command", (double)stats->api_calls / BURST_COMMANDS);
+}
+
+/*******************************************************************************
+* Scenario: idle_keepalive
+* An hour without traffic on an established connection.
+*******************************************************************************/
+static void idle_keepalive_schedule(void)
+{
+    stand_in_schedule(IDLE_PERIOD_MS, STAND_IN_EV_END, 0U);
+}
+
+static void idle_keepalive_collect(const stand_in_stats_t *stats,
+                                   const stand_in_run_result_t *run, metric_set_t *out)
+{
+    (void)run;
+    add_metric(out, "keepalive_probes", stats->keepalive_probes);
+    add_metric(out, "host_wakes", stats->host_wakes);
+    add_metric(out, "api_calls", stats->api_calls);
+}
+
+/*******************************************************************************
+* Scenario: fault_lossy_commands
+* The command burst over a link with loss, jitter and reordering.
+*******************************************************************************/
+static void fault_lossy_commands_schedule(void)
+{
+    stand_in_schedule_faults(SETTLE_MS, &lossy_link);
+    command_burst_schedule();
+}
+
+static void fault_lossy_commands_collect(const stand_in_stats_t *stats,
+                                         const stand_in_run_result_t *run, metric_set_t *out)
+{
+    (void)run;
+    add_metric(out, "acks_ok", stats->acks_ok);
+    add_metric(out, "commands_lost", stats->commands_lost);
+    add_metric(out, "ack_latency_max_ms", (double)stats->ack_latency_max_ms);
+    add_metric(out, "retransmits", stats->retransmits);
+    add_metric(out, "keepalive_drops", stats->keepalive_drops);
+    add_metric(out, "wasted_retries", stats->connect_failures + stats->wifi_join_failures);
+    add_metric(out, "host_wakes", stats->host_wakes);
+}
+
+/*******************************************************************************
+* Scenario: fault_lossy_idle
+* An idle hour over the lossy link; lost keepalive probes close the connection.
+*******************************************************************************/
+static void fault_lossy_idle_schedule(void)
+{
+    stand_in_schedule_faults(SETTLE_MS, &lossy_link);
+    stand_in_schedule(IDLE_PERIOD_MS, STAND_IN_EV_END, 0U);
+}
+
+static void fault_lossy_idle_collect(const stand_in_stats_t *stats,
+                                     const stand_in_run_result_t *run, metric_set_t *out)
+{
+    (void)run;
+    add_metric(out, "keepalive_drops", stats->keepalive_drops);
+    add_metric(out, "keepalive_probes", stats->keepalive_probes);
+    add_metric(out, "wasted_retries", stats->connect_failures + stats->wifi_join_failures);
+    add_metric(out, "sockets_open", stats->sockets_open);
+    add_metric(out, "host_wakes", stats->host_wakes);
+}
+
+/*******************************************************************************
+* Scenario: fault_lossy_reconnect
+* The server closes the connection and the reconnect runs over a bad link.
+*******************************************************************************/
+static void fault_lossy_reconnect_schedule(void)
+{
+    stand_in_schedule_faults(SETTLE_MS, &bad_link);
+    stand_in_schedule(SETTLE_MS, STAND_IN_EV_SERVER_DROP, 0U);
+    stand_in_schedule(6U * SETTLE_MS, STAND_IN_EV_END, 0U);
+}
+
+static void fault_lossy_reconnect_collect(const stand_in_stats_t *stats,
+                                          const stand_in_run_result_t *run, metric_set_t *out)
+{
+    add_fault_metrics(out, stats, run, SETTLE_MS);
+    add_metric(out, "retransmits", stats->retransmits);
+    add_metric(out, "sockets_open", stats->sockets_open);
+}
+
+/*******************************************************************************
+* Scenario: fault_synack_delayed
+* The server closes the connection and then answers each SYN 4 s late, past
+* the first SYN retransmission timeout.
+*******************************************************************************/
+static void fault_synack_delayed_schedule(void)
+{
+    stand_in_schedule_faults(SETTLE_MS, &slow_server);
+    stand_in_schedule(SETTLE_MS, STAND_IN_EV_SERVER_DROP, 0U);
+    stand_in_schedule(6U * SETTLE_MS, STAND_IN_EV_END, 0U);
+}
+
+static void fault_synack_delayed_collect(const stand_in_stats_t *stats,
+                                         const stand_in_run_result_t *run, metric_set_t *out)
+{
+    add_fault_metrics(out, stats, run, SETTLE_MS);
+    add_metric(out, "retransmits", stats->retransmits);
+    add_metric(out, "connect_calls", stats->connect_calls);
+}
+
+/*******************************************************************************
+* Scenario: fault_server_silent
+* The server stops answering for SILENT_PERIOD_MS without closing the
+* connection; only the keepalive can notice.
+*******************************************************************************/
+static void fault_server_silent_schedule(void)
+{
+    stand_in_schedule(SETTLE_MS, STAND_IN_EV_SERVER_SILENT, SILENT_PERIOD_MS);
+    stand_in_schedule(SETTLE_MS + SILENT_PERIOD_MS + (4U * SETTLE_MS), STAND_IN_EV_END, 0U);
+}
+
+static void fault_server_silent_collect(const stand_in_stats_t *stats,
+                                        const stand_in_run_result_t *run, metric_set_t *out)
+{
+    add_fault_metrics(out, stats, run, SETTLE_MS);
+    add_metric(out, "recovered", (0U != stats->reconnect_ms) ? 1.0 : 0.0);
+    add_metric(out, "keepalive_probes", stats->keepalive_probes);
+    add_metric(out, "sockets_open", stats->sockets_open);
+}
+
+/*******************************************************************************
+* Scenario: fault_ap_drop_lossy
+* The access point goes away for AP_OUTAGE_MS and the link is lossy throughout.
+*******************************************************************************/
+static void fault_ap_drop_lossy_schedule(void)
+{
+    stand_in_schedule_faults(SETTLE_MS, &lossy_link);
+    ap_drop_schedule();
+}
+
+static void fault_ap_drop_lossy_collect(const stand_in_stats_t *stats,
+                                        const stand_in_run_result_t *run, metric_set_t *out)
+{
+    add_fault_metrics(out, stats, run, AP_DROP_AT_MS);
+    add_metric(out, "retransmits", stats->retransmits);
+    add_metric(out, "keepalive_probes", stats->keepalive_probes);
+    add_metric(out, "host_wakes", stats->host_wakes);
+}
+
+static const scenario_t scenarios[] =
+{
+    { "cold_connect", "power-up to connected",
+      cold_connect_schedule, cold_connect_collect },
+    { "server_drop_reconnect", "server closes and listens again at once",
+      server_drop_schedule, server_drop_collect },
+    { "server_restart_slow", "server closes and is down for 5 s",
+      server_restart_schedule, server_restart_collect },
+    { "ap_drop_rejoin", "access point gone for 30 s",
+      ap_drop_schedule, ap_drop_collect },
+    { "command_burst", "200 LED commands 20 ms apart",
+      command_burst_schedule, command_burst_collect },
+    { "idle_keepalive", "one idle hour",
+      idle_keepalive_schedule, idle_keepalive_collect },
+    { "fault_lossy_commands", "command burst at 10% loss with jitter and reordering",
+      fault_lossy_commands_schedule, fault_lossy_commands_collect },
+    { "fault_lossy_idle", "idle hour at 10% loss",
+      fault_lossy_idle_schedule, fault_lossy_idle_collect },
+    { "fault_lossy_reconnect", "server closes, reconnect at 30% loss",
+      fault_lossy_reconnect_schedule, fault_lossy_reconnect_collect },
+    { "fault_synack_delayed", "server closes, answers SYNs 4 s late",
+      fault_synack_delayed_schedule, fault_synack_delayed_collect },
+    { "fault_server_silent", "server silent for 30 s, connection left open",
+      fault_server_silent_schedule, fault_server_silent_collect },
+    { "fault_ap_drop_lossy", "access point gone for 30 s at 10% loss",
+      fault_ap_drop_lossy_schedule, fault_ap_drop_lossy_collect },
+};
+
+/*******************************************************************************
+* Function Name: elapsed_us
+*******************************************************************************/
+static double elapsed_us(const struct timespec *start, const struct timespec *end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e6) +
+           ((double)(end->tv_nsec - start->tv_nsec) / 1e3);
+}
+
+/*******************************************************************************
+* Function Name: run_scenario
+********************************************************************************
+* Summary:
+*  Runs a scenario the given number of times. The virtual-time metrics come
+*  from the first run, which every other run must repeat exactly; the host
+*  time is the fastest of all runs.
+*
+* Return:
+*  bool: true if all runs reached the end of the scenario
+*
+*******************************************************************************/
+static bool run_scenario(const scenario_t *scenario, uint32_t iterations,
+                         metric_set_t *out)
+{
+    stand_in_run_result_t run = { 0 };
+    stand_in_stats_t first_stats = { 0 };
+    double best_us = 0.0;
+
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        struct timespec start;
+        struct timespec end;
+
+        stand_in_reset(&default_world);
+        scenario->schedule();
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        run = stand_in_run(network_idle_task, task_stack, sizeof(task_stack));
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        if (!run.completed)
+        {
+            fprintf(stderr, "%s: stopped at %llu ms: %s\n", scenario->name,
+                    (unsigned long long)run.end_ms, run.failure);
+            return false;
+        }
+
+        if (0U == i)
+        {
+            first_stats = *stand_in_get_stats();
+            best_us = elapsed_us(&start, &end);
+        }
+        else
+        {
+            if (0 != memcmp(&first_stats, stand_in_get_stats(), sizeof(first_stats)))
+            {
+                fprintf(stderr, "%s: run %u differs from the first run\n",
+                        scenario->name, (unsigned)i);
+                return false;
+            }
+            if (elapsed_us(&start, &end) < best_us)
+            {
+                best_us = elapsed_us(&start, &end);
+            }
+        }
+    }
+
+    out->count = 0U;
+    scenario->collect(&first_stats, &run, out);
+    add_metric(out, "stack_bytes", (double)run.stack_used);
+    add_metric(out, "host_us", best_us);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: print_usage
+*******************************************************************************/
+static void print_usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [-o results.json] [-n iterations] [-s scenario] [-v] [-l]\n"
+            "  -o  write the results to this file (default: stdout)\n"
+            "  -n  runs per scenario; the fastest host time is kept (default: %u)\n"
+            "  -s  run only this scenario\n"
+            "  -v  print the console output of the client\n"
+            "  -l  list the scenarios\n",
+            program, (unsigned)DEFAULT_ITERATIONS);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    const char *output_path = NULL;
+    const char *only = NULL;
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    FILE *output = stdout;
+    bool all_completed = true;
+    bool first = true;
+    int option;
+
+    while (-1 != (option = getopt(argc, argv, "o:n:s:vlh")))
+    {
+        switch (option)
+        {
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'n':
+                iterations = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                only = optarg;
+                break;
+            case 'v':
+                stand_in_set_verbose(true);
+                break;
+            case 'l':
+                for (size_t i = 0U; i < (sizeof(scenarios) / sizeof(scenarios[0])); i++)
+                {
+                    printf("%-24s %s\n", scenarios[i].name, scenarios[i].description);
+                }
+                return EXIT_SUCCESS;
+            default:
+                print_usage(argv[0]);
+                return (('h' == option) ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+    }
+
+    if (0U == iterations)
+    {
+        iterations = 1U;
+    }
+
+    if (NULL != output_path)
+    {
+        output = fopen(output_path, "w");
+        if (NULL == output)
+        {
+            perror(output_path);
+            return EXIT_FAILURE;
+        }
+    }
+
+    fprintf(output, "{\n  \"schema-version\": 1.0,\n  \"iterations\": %u,\n  \"scenarios\": {",
+            (unsigned)iterations);
+
+    for (size_t i = 0U; i < (sizeof(scenarios) / sizeof(scenarios[0])); i++)
+    {
+        metric_set_t metrics = { 0 };
+        bool completed;
+
+        if ((NULL != only) && (0 != strcmp(only, scenarios[i].name)))
+        {
+            continue;
+        }
+
+        completed = run_scenario(&scenarios[i], iterations, &metrics);
+        all_completed = all_completed && completed;
+
+        fprintf(output, "%s\n    \"%s\": {\n      \"completed\": %s,\n      \"metrics\": {",
+                first ? "" : ",", scenarios[i].name, completed ? "true" : "false");
+        for (uint32_t m = 0U; m < metrics.count; m++)
+        {
+            fprintf(output, "%s\n        \"%s\": %.3f", (0U == m) ? "" : ",",
+                    metrics.metrics[m].name, metrics.metrics[m].value);
+        }
+        fprintf(output, "\n      }\n    }");
+        first = false;
+    }
+
+    fprintf(output, "\n  }\n}\n");
+
+    if (stdout != output)
+    {
+        fclose(output);
+    }
+
+    return all_completed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
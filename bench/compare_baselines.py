@@ -0,0 +1,173 @@
+#******************************************************************************
+# File Name:   compare_baselines.py
+#
+# Description: Compares the results of the host benchmark (bench_main.c)
+# against the tracked baselines in baselines.json. A metric regresses when it
+# moves past its baseline by more than its tolerance in the bad direction;
+# the script then exits with status 1. Improvements beyond the tolerance are
+# reported so that the baselines can be tightened with --update.
+#
+# Usage:
+#   python compare_baselines.py build/results.json baselines.json
+#   python compare_baselines.py build/results.json baselines.json --update
+#
+# Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+#******************************************************************************
+
+#!/usr/bin/python
+
+import argparse
+import json
+import sys
+
+# Metrics where a larger value is better; all others should stay low.
+HIGHER_IS_BETTER = ("acks_ok", "recovered")
+
+# Tolerances, as a fraction of the baseline, for metrics added by --update.
+# Virtual-time and count metrics are deterministic; host time and stack
+# depth depend on the machine and compiler.
+DEFAULT_TOLERANCE = 0.05
+METRIC_TOLERANCE = {
+    "host_us": 1.0,
+    "stack_bytes": 0.25,
+}
+
+# Absolute allowance on top of the tolerance, in the unit of the metric, so
+# that small host timings do not trip on scheduler noise.
+METRIC_SLACK = {
+    "host_us": 250.0,
+}
+
+
+def load(path):
+    with open(path) as json_file:
+        return json.load(json_file)
+
+
+def compare(results, baselines):
+    """Returns (rows, regressions) for every metric that has a baseline."""
+    rows = []
+    regressions = 0
+    for scenario, tracked in sorted(baselines["scenarios"].items()):
+        result = results["scenarios"].get(scenario)
+        if result is None:
+            continue
+        if not result.get("completed", False):
+            rows.append((scenario, "-", None, None, "DID NOT COMPLETE"))
+            regressions += 1
+            continue
+
+        for metric, limit in sorted(tracked.items()):
+            value = result["metrics"].get(metric)
+            if value is None:
+                rows.append((scenario, metric, limit["baseline"], None, "MISSING"))
+                regressions += 1
+                continue
+
+            baseline = limit["baseline"]
+            margin = abs(baseline) * limit["tolerance"] + limit.get("slack", 0.0)
+            if limit.get("higher-is-better", False):
+                worse, better = value < baseline - margin, value > baseline + margin
+            else:
+                worse, better = value > baseline + margin, value < baseline - margin
+
+            if worse:
+                status = "REGRESSION"
+                regressions += 1
+            elif better:
+                status = "improved"
+            else:
+                status = "ok"
+            rows.append((scenario, metric, baseline, value, status))
+    return rows, regressions
+
+
+def update(results, baselines):
+    """Takes the results as the new baselines, keeping existing tolerances."""
+    scenarios = baselines.setdefault("scenarios", {})
+    for scenario, result in results["scenarios"].items():
+        if not result.get("completed", False):
+            print("ERROR: %s did not complete; baselines not updated" % scenario)
+            sys.exit(1)
+        tracked = scenarios.setdefault(scenario, {})
+        for metric, value in result["metrics"].items():
+            limit = tracked.setdefault(metric, {
+                "tolerance": METRIC_TOLERANCE.get(metric, DEFAULT_TOLERANCE)})
+            if metric in METRIC_SLACK:
+                limit.setdefault("slack", METRIC_SLACK[metric])
+            limit["baseline"] = value
+            if metric in HIGHER_IS_BETTER:
+                limit["higher-is-better"] = True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check host benchmark results against baselines")
+    parser.add_argument("results", help="results.json written by the benchmark")
+    parser.add_argument("baselines", help="tracked baselines.json")
+    parser.add_argument("--update", action="store_true",
+                        help="take the results as the new baselines")
+    args = parser.parse_args()
+
+    results = load(args.results)
+
+    if args.update:
+        try:
+            baselines = load(args.baselines)
+        except FileNotFoundError:
+            baselines = {"schema-version": 1.0,
+                         "description": "Tracked baselines of the host benchmark."}
+        update(results, baselines)
+        with open(args.baselines, "w") as json_file:
+            json.dump(baselines, json_file, indent=4, sort_keys=True)
+            json_file.write("\n")
+        print("Updated %s" % args.baselines)
+        return
+
+    rows, regressions = compare(results, load(args.baselines))
+
+    print("%-24s %-24s %14s %14s  %s" % ("Scenario", "Metric", "Baseline", "Result", "Status"))
+    for scenario, metric, baseline, value, status in rows:
+        print("%-24s %-24s %14s %14s  %s" % (
+            scenario, metric,
+            "-" if baseline is None else "%.3f" % baseline,
+            "-" if value is None else "%.3f" % value, status))
+
+    if regressions:
+        print("\n%d metric(s) regressed" % regressions)
+        sys.exit(1)
+    print("\nNo regressions")
+
+
+if __name__ == "__main__":
+    main()
+
+# [] END OF FILE
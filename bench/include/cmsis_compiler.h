@@ -0,0 +1,13 @@
+/* Host stand-in for cmsis_compiler.h, for the host benchmark. */
+#ifndef CMSIS_COMPILER_H
+#define CMSIS_COMPILER_H
+
+#define __STATIC_INLINE                          static inline
+#define __PACKED_STRUCT                          struct __attribute__((packed))
+#define __WEAK                                   __attribute__((weak))
+
+static inline void __disable_irq(void) {}
+static inline void __enable_irq(void) {}
+static inline void __DMB(void) { __sync_synchronize(); }
+
+#endif /* CMSIS_COMPILER_H */
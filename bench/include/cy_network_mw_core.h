@@ -0,0 +1,12 @@
+/* Host stand-in for the network middleware core, for the host benchmark. */
+#ifndef CY_NETWORK_MW_CORE_H
+#define CY_NETWORK_MW_CORE_H
+
+#include <stdint.h>
+
+typedef enum { CY_NETWORK_WIFI_STA_INTERFACE } cy_network_hw_interface_type_t;
+
+void *cy_network_get_nw_interface(cy_network_hw_interface_type_t iface_type,
+                                  uint8_t iface_idx);
+
+#endif /* CY_NETWORK_MW_CORE_H */
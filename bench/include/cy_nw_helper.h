@@ -0,0 +1,22 @@
+/* Host stand-in for the network helper library, for the host benchmark. */
+#ifndef CY_NW_HELPER_H
+#define CY_NW_HELPER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum { NW_IP_IPV4 = 4, NW_IP_IPV6 = 6 } cy_nw_ip_version_t;
+typedef struct
+{
+    cy_nw_ip_version_t version;
+    union
+    {
+        uint32_t v4;
+        uint32_t v6[4];
+    } ip;
+} cy_nw_ip_address_t;
+
+bool cy_nw_ntoa(cy_nw_ip_address_t *addr, char *ip_str);
+int cy_nw_str_to_ipv4(const char *ip_str, cy_nw_ip_address_t *addr);
+
+#endif /* CY_NW_HELPER_H */
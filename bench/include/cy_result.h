@@ -0,0 +1,17 @@
+/* Host stand-in for the ModusToolbox result type, for the host benchmark. */
+#ifndef CY_RESULT_H
+#define CY_RESULT_H
+
+#include <stdint.h>
+
+typedef uint32_t cy_rslt_t;
+
+#define CY_RSLT_SUCCESS                          ((cy_rslt_t)0x00000000U)
+#define CY_RSLT_TYPE_ERROR                       (2U)
+#define CY_RSLT_MODULE_MIDDLEWARE_BASE           (0x0A00U)
+#define CY_RSLT_CREATE(type, module, code)       ((((module) & 0x3FFFU) << 2U) | \
+                                                 (((code) & 0xFFFFU) << 16U) | \
+                                                 ((type) & 0x3U))
+#define CY_RSLT_GET_CODE(result)                 (((result) >> 16U) & 0xFFFFU)
+
+#endif /* CY_RESULT_H */
@@ -0,0 +1,70 @@
+/* Host stand-in for the secure sockets library, for the host benchmark. The
+ * behaviour behind these calls is scripted by the scenario; see stand_in.c.
+ */
+#ifndef CY_SECURE_SOCKETS_H
+#define CY_SECURE_SOCKETS_H
+
+#include <stdint.h>
+#include "cy_result.h"
+
+#define CY_RSLT_MODULE_SECURE_SOCKETS_BASE       (0x0200U)
+#define CY_SOCKET_RSLT(code)                     CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, \
+                                                 CY_RSLT_MODULE_SECURE_SOCKETS_BASE, (code))
+#define CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT    CY_SOCKET_RSLT(5U)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_NOT_CONNECTED CY_SOCKET_RSLT(9U)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED     CY_SOCKET_RSLT(15U)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_TCPIP_ERROR CY_SOCKET_RSLT(7U)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM      CY_SOCKET_RSLT(4U)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_BADARG     CY_SOCKET_RSLT(2U)
+
+#define CY_SOCKET_DOMAIN_AF_INET                 (0)
+#define CY_SOCKET_TYPE_STREAM                    (1)
+#define CY_SOCKET_IPPROTO_TCP                    (1)
+#define CY_SOCKET_FLAGS_NONE                     (0)
+
+#define CY_SOCKET_SOL_SOCKET                     (1)
+#define CY_SOCKET_SOL_TCP                        (2)
+#define CY_SOCKET_SO_RECEIVE_CALLBACK            (1)
+#define CY_SOCKET_SO_DISCONNECT_CALLBACK         (2)
+#define CY_SOCKET_SO_TCP_KEEPALIVE_ENABLE        (3)
+#define CY_SOCKET_SO_TCP_KEEPALIVE_INTERVAL      (4)
+#define CY_SOCKET_SO_TCP_KEEPALIVE_COUNT         (5)
+#define CY_SOCKET_SO_TCP_KEEPALIVE_IDLE_TIME     (6)
+
+typedef void *cy_socket_t;
+typedef enum { CY_SOCKET_IP_VER_V4 = 4, CY_SOCKET_IP_VER_V6 = 6 } cy_socket_ip_version_t;
+typedef struct
+{
+    cy_socket_ip_version_t version;
+    union
+    {
+        uint32_t v4;
+        uint32_t v6[4];
+    } ip;
+} cy_socket_ip_address_t;
+typedef struct
+{
+    cy_socket_ip_address_t ip_address;
+    uint16_t port;
+} cy_socket_sockaddr_t;
+typedef cy_rslt_t (*cy_socket_callback_t)(cy_socket_t socket_handle, void *arg);
+typedef struct
+{
+    cy_socket_callback_t callback;
+    void *arg;
+} cy_socket_opt_callback_t;
+
+cy_rslt_t cy_socket_init(void);
+cy_rslt_t cy_socket_create(int domain, int type, int protocol, cy_socket_t *handle);
+cy_rslt_t cy_socket_setsockopt(cy_socket_t handle, int level, int optname,
+                               const void *optval, uint32_t optlen);
+cy_rslt_t cy_socket_connect(cy_socket_t handle, cy_socket_sockaddr_t *address,
+                            uint32_t address_length);
+cy_rslt_t cy_socket_recv(cy_socket_t handle, void *buffer, uint32_t length,
+                         int flags, uint32_t *bytes_received);
+cy_rslt_t cy_socket_send(cy_socket_t handle, const void *buffer, uint32_t length,
+                         int flags, uint32_t *bytes_sent);
+cy_rslt_t cy_socket_disconnect(cy_socket_t handle, uint32_t timeout);
+cy_rslt_t cy_socket_delete(cy_socket_t handle);
+
+#endif /* CY_SECURE_SOCKETS_H */
@@ -0,0 +1,16 @@
+/* Host stand-in for cy_utils.h, for the host benchmark. */
+#ifndef CY_UTILS_H
+#define CY_UTILS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Stops the scenario that hit the assertion; see stand_in.c. */
+void stand_in_fatal(const char *file, int line) __attribute__((noreturn));
+
+#define CY_ASSERT(x)                             do { if (!(x)) { stand_in_fatal(__FILE__, __LINE__); } } while (0)
+#define CY_UNUSED_PARAMETER(x)                   (void)(x)
+#define CY_SECTION(name)                         __attribute__((section(name)))
+#define CY_SECTION_SHAREDMEM
+
+#endif /* CY_UTILS_H */
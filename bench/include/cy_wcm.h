@@ -0,0 +1,54 @@
+/* Host stand-in for the Wi-Fi connection manager, for the host benchmark. */
+#ifndef CY_WCM_H
+#define CY_WCM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_result.h"
+#include "mtb_hal.h"
+
+#define CY_WCM_MAX_SSID_LEN                      (32U)
+#define CY_WCM_MAX_PASSPHRASE_LEN                (63U)
+#define CY_WCM_MAC_ADDR_LEN                      (6U)
+
+typedef enum { CY_WCM_INTERFACE_TYPE_STA } cy_wcm_interface_t;
+typedef enum
+{
+    CY_WCM_SECURITY_OPEN,
+    CY_WCM_SECURITY_WPA2_AES_PSK,
+    CY_WCM_SECURITY_WPA3_SAE
+} cy_wcm_security_t;
+typedef uint8_t cy_wcm_mac_t[CY_WCM_MAC_ADDR_LEN];
+typedef struct
+{
+    cy_wcm_interface_t interface;
+    mtb_hal_sdio_t *wifi_interface_instance;
+    mtb_hal_gpio_t wifi_wl_pin;
+    mtb_hal_gpio_t wifi_host_wake_pin;
+} cy_wcm_config_t;
+typedef struct
+{
+    uint8_t SSID[CY_WCM_MAX_SSID_LEN + 1];
+    uint8_t password[CY_WCM_MAX_PASSPHRASE_LEN + 1];
+    cy_wcm_security_t security;
+} cy_wcm_ap_credentials_t;
+typedef struct
+{
+    cy_wcm_ap_credentials_t ap_credentials;
+} cy_wcm_connect_params_t;
+typedef struct
+{
+    int version;
+    union
+    {
+        uint32_t v4;
+        uint32_t v6[4];
+    } ip;
+} cy_wcm_ip_address_t;
+
+cy_rslt_t cy_wcm_init(cy_wcm_config_t *config);
+cy_rslt_t cy_wcm_connect_ap(cy_wcm_connect_params_t *connect_params,
+                            cy_wcm_ip_address_t *ip_addr);
+bool cy_wcm_is_connected_to_ap(void);
+
+#endif /* CY_WCM_H */
@@ -0,0 +1,9 @@
+/* Host stand-in for the Wi-Fi connection manager errors, for the host benchmark. */
+#ifndef CY_WCM_ERROR_H
+#define CY_WCM_ERROR_H
+
+#include "cy_result.h"
+
+#define CY_RSLT_WCM_CONNECT_FAILED               CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, 0x0300U, 7U)
+
+#endif /* CY_WCM_ERROR_H */
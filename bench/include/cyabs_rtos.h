@@ -0,0 +1,26 @@
+/* Host stand-in for the RTOS abstraction, for the host benchmark. The network
+ * client runs as the only task, so a semaphore that would block forever ends
+ * the scenario instead.
+ */
+#ifndef CYABS_RTOS_H
+#define CYABS_RTOS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_result.h"
+
+#define CY_RTOS_NEVER_TIMEOUT                    (0xFFFFFFFFUL)
+#define CY_RTOS_TIMEOUT                          CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, 0x100U, 1U)
+#define portMAX_DELAY                            (0xFFFFFFFFUL)
+#define pdTRUE                                   (1)
+
+typedef struct { uint32_t count; uint32_t max_count; } cy_semaphore_t;
+typedef uint32_t cy_time_t;
+
+cy_rslt_t cy_rtos_semaphore_init(cy_semaphore_t *semaphore, uint32_t maxcount,
+                                 uint32_t initcount);
+cy_rslt_t cy_rtos_semaphore_get(cy_semaphore_t *semaphore, cy_time_t timeout_ms);
+cy_rslt_t cy_rtos_semaphore_set(cy_semaphore_t *semaphore);
+cy_rslt_t cy_rtos_delay_milliseconds(cy_time_t num_ms);
+
+#endif /* CYABS_RTOS_H */
@@ -0,0 +1,97 @@
+/* Host stand-in for the board support package: just enough of the PDL for
+ * the network client to compile on the host. See stand_in.c.
+ */
+#ifndef CYBSP_H
+#define CYBSP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "cy_result.h"
+#include "cy_utils.h"
+#include "cmsis_compiler.h"
+
+/* Power modes */
+#define CY_CFG_PWR_MODE_SLEEP                    (1)
+#define CY_CFG_PWR_MODE_DEEPSLEEP                (2)
+#define CY_CFG_PWR_SYS_IDLE_MODE                 CY_CFG_PWR_MODE_DEEPSLEEP
+
+typedef enum { CY_SYSPM_SUCCESS, CY_SYSPM_FAIL } cy_en_syspm_status_t;
+typedef enum
+{
+    CY_SYSPM_CHECK_READY,
+    CY_SYSPM_CHECK_FAIL,
+    CY_SYSPM_BEFORE_TRANSITION,
+    CY_SYSPM_AFTER_TRANSITION
+} cy_en_syspm_callback_mode_t;
+typedef enum { CY_SYSPM_SLEEP, CY_SYSPM_DEEPSLEEP } cy_en_syspm_callback_type_t;
+typedef struct { void *base; void *context; } cy_stc_syspm_callback_params_t;
+typedef cy_en_syspm_status_t (*Cy_SysPmCallback)(cy_stc_syspm_callback_params_t *,
+                                                 cy_en_syspm_callback_mode_t);
+typedef struct cy_stc_syspm_callback
+{
+    Cy_SysPmCallback callback;
+    cy_en_syspm_callback_type_t type;
+    uint32_t skipMode;
+    cy_stc_syspm_callback_params_t *callbackParams;
+    struct cy_stc_syspm_callback *prevItm;
+    struct cy_stc_syspm_callback *nextItm;
+    uint8_t order;
+} cy_stc_syspm_callback_t;
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t *handler);
+
+/* Interrupts */
+typedef int IRQn_Type;
+typedef enum { CY_SYSINT_SUCCESS, CY_SYSINT_BAD_PARAM } cy_en_sysint_status_t;
+typedef struct { IRQn_Type intrSrc; uint32_t intrPriority; } cy_stc_sysint_t;
+typedef void (*cy_israddress)(void);
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress handler);
+void NVIC_EnableIRQ(IRQn_Type irq);
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t saved);
+
+/* SD host */
+typedef struct { int unused; } SDHC_Type;
+typedef struct { int unused; } cy_stc_sd_host_context_t;
+typedef struct { int unused; } cy_stc_sd_host_init_config_t;
+typedef enum { CY_SD_HOST_BUS_WIDTH_1_BIT, CY_SD_HOST_BUS_WIDTH_4_BIT } cy_en_sd_host_bus_width_t;
+void Cy_SD_Host_Enable(SDHC_Type *base);
+int Cy_SD_Host_Init(SDHC_Type *base, const cy_stc_sd_host_init_config_t *config,
+                    cy_stc_sd_host_context_t *context);
+int Cy_SD_Host_SetHostBusWidth(SDHC_Type *base, cy_en_sd_host_bus_width_t width);
+cy_en_syspm_status_t Cy_SD_Host_DeepSleepCallback(cy_stc_syspm_callback_params_t *params,
+                                                  cy_en_syspm_callback_mode_t mode);
+
+/* GPIO */
+typedef struct { int unused; } GPIO_PRT_Type;
+void Cy_GPIO_Write(GPIO_PRT_Type *base, uint32_t pin, uint32_t value);
+
+/* Debug UART */
+typedef struct { int unused; } CySCB_Type;
+typedef struct { void *rxRingBuf; } cy_stc_scb_uart_context_t;
+#define CY_SCB_UART_RX_NO_DATA                   (0xFFFFFFFFUL)
+extern CySCB_Type stand_in_scb2;
+#define SCB2                                     (&stand_in_scb2)
+uint32_t Cy_SCB_UART_GetNumInRxFifo(CySCB_Type const *base);
+uint32_t Cy_SCB_UART_GetNumInRingBuffer(CySCB_Type const *base,
+                                        cy_stc_scb_uart_context_t const *context);
+uint32_t Cy_SCB_UART_Get(CySCB_Type const *base);
+uint32_t Cy_SCB_UART_Put(CySCB_Type *base, uint32_t data);
+
+/* Board resources */
+extern SDHC_Type stand_in_sdhc;
+extern GPIO_PRT_Type stand_in_led_port;
+#define CYBSP_WIFI_SDIO_HW                       (&stand_in_sdhc)
+#define CYBSP_USER_LED_PORT                      (&stand_in_led_port)
+#define CYBSP_USER_LED_PIN                       (0U)
+#define CYBSP_LED_STATE_ON                       (1U)
+#define CYBSP_LED_STATE_OFF                      (0U)
+#define CYBSP_WIFI_SDIO_IRQ                      (1)
+#define CYBSP_WIFI_HOST_WAKE_IRQ                 (2)
+#define CYBSP_WIFI_WL_REG_ON_PORT_NUM            (0U)
+#define CYBSP_WIFI_WL_REG_ON_PIN                 (0U)
+#define CYBSP_WIFI_HOST_WAKE_PORT_NUM            (0U)
+#define CYBSP_WIFI_HOST_WAKE_PIN                 (1U)
+
+#endif /* CYBSP_H */
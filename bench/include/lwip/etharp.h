@@ -0,0 +1,10 @@
+/* Host stand-in for lwIP ARP, for the host benchmark. */
+#ifndef LWIP_HDR_NETIF_ETHARP_H
+#define LWIP_HDR_NETIF_ETHARP_H
+
+#include <stdint.h>
+
+typedef struct { uint32_t addr; } ip4_addr_t;
+struct eth_addr { uint8_t addr[6]; };
+
+#endif /* LWIP_HDR_NETIF_ETHARP_H */
@@ -0,0 +1,15 @@
+/* Host stand-in for the lwIP network interface, for the host benchmark. */
+#ifndef LWIP_HDR_NETIF_H
+#define LWIP_HDR_NETIF_H
+
+#include <stdint.h>
+
+struct pbuf;
+
+struct netif
+{
+    uint8_t hwaddr[6];
+    uint32_t ip_addr;
+};
+
+#endif /* LWIP_HDR_NETIF_H */
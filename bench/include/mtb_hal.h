@@ -0,0 +1,25 @@
+/* Host stand-in for the HAL, for the host benchmark. */
+#ifndef MTB_HAL_H
+#define MTB_HAL_H
+
+#include <stdint.h>
+#include "cy_result.h"
+#include "cybsp.h"
+
+typedef struct { int unused; } mtb_hal_lptimer_t;
+uint32_t mtb_hal_lptimer_read(const mtb_hal_lptimer_t *obj);
+
+typedef struct { int unused; } mtb_hal_gpio_t;
+cy_rslt_t mtb_hal_gpio_setup(mtb_hal_gpio_t *obj, uint32_t port, uint32_t pin);
+void mtb_hal_gpio_process_interrupt(mtb_hal_gpio_t *obj);
+
+typedef struct { int unused; } mtb_hal_sdio_t;
+typedef struct { uint32_t frequencyhal_hz; uint16_t block_size; } mtb_hal_sdio_cfg_t;
+typedef struct { const cy_stc_sd_host_init_config_t *host_config; } mtb_hal_sdio_configurator_t;
+extern const mtb_hal_sdio_configurator_t CYBSP_WIFI_SDIO_sdio_hal_config;
+cy_rslt_t mtb_hal_sdio_setup(mtb_hal_sdio_t *obj, const mtb_hal_sdio_configurator_t *config,
+                             void *clock, cy_stc_sd_host_context_t *context);
+cy_rslt_t mtb_hal_sdio_configure(mtb_hal_sdio_t *obj, const mtb_hal_sdio_cfg_t *config);
+void mtb_hal_sdio_process_interrupt(mtb_hal_sdio_t *obj);
+
+#endif /* MTB_HAL_H */
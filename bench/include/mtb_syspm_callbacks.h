@@ -0,0 +1 @@
+/* Host stand-in, intentionally empty. */
@@ -0,0 +1,15 @@
+/* Host stand-in for the low power assistant network activity handler, for
+ * the host benchmark. A call returns when the scenario next produces network
+ * activity that wakes the host; see stand_in.c.
+ */
+#ifndef NETWORK_ACTIVITY_HANDLER_H
+#define NETWORK_ACTIVITY_HANDLER_H
+
+#include <stdint.h>
+
+struct netif;
+
+int32_t wait_net_suspend(void *net_intf, uint32_t wait_ms, uint32_t network_inactive_interval_ms,
+                         uint32_t network_inactive_window_ms);
+
+#endif /* NETWORK_ACTIVITY_HANDLER_H */
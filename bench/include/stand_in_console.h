@@ -0,0 +1,13 @@
+/* Force-included into the network client on the host so that its console
+ * output goes through the stand-ins, which drop it unless -v is given.
+ */
+#ifndef STAND_IN_CONSOLE_H
+#define STAND_IN_CONSOLE_H
+
+#include <stdio.h>
+
+int stand_in_printf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+#define printf                                   stand_in_printf
+
+#endif /* STAND_IN_CONSOLE_H */
@@ -0,0 +1,1561 @@
+/*******************************************************************************
+* File Name:   stand_in.c
+*
+* Description: This file contains the host stand-ins for the Wi-Fi connection
+* manager, secure sockets, RTOS, low power assistant and board support calls
+* made by the network client (tcp_keepalive_offload.c) in the host benchmark.
+* Time only moves when the client waits, so every run of a scenario takes the
+* same path and the results can be compared against the baselines. Injected
+* faults draw from a seeded generator and are just as repeatable.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <ucontext.h>
+
+#include "stand_in.h"
+
+#include "cybsp.h"
+#include "mtb_hal.h"
+#include "cyabs_rtos.h"
+#include "cy_secure_sockets.h"
+#include "cy_wcm.h"
+#include "cy_wcm_error.h"
+#include "cy_nw_helper.h"
+#include "cy_network_mw_core.h"
+#include "network_activity_handler.h"
+#include "lwip/netif.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define STACK_PAINT                              (0xA5U)
+#define CONSOLE_LINE_LEN                         (256U)
+
+/* Device address handed out by the modelled access point: 192.168.1.20 */
+#define DEVICE_IPV4                              (0x1401A8C0UL)
+
+/* lwIP stops doubling the retransmission timeout after this many tries. */
+#define RTO_BACKOFF_MAX                          (6U)
+
+/* Socket references in event arguments: index, generation and flags. */
+#define SOCKET_REF_INDEX_SHIFT                   (16U)
+#define SOCKET_REF_GENERATION_MASK               (0xFFFFUL)
+#define SOCKET_REF_INDEX_MASK                    (0xFFUL)
+#define KA_EXPIRE_LOST                           (1UL << 24U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint64_t at_ms;
+    uint32_t seq;                /* Keeps events at the same time in order */
+    stand_in_event_type_t type;
+    uint32_t arg;
+    const stand_in_faults_t *faults; /* STAND_IN_EV_FAULTS only */
+} event_t;
+
+typedef struct
+{
+    bool used;
+    bool connected;
+    uint32_t generation;         /* Tells a reused slot from the old socket */
+    cy_socket_opt_callback_t recv_cb;
+    cy_socket_opt_callback_t disconnect_cb;
+    bool keepalive;
+    uint32_t ka_idle_ms;
+    uint32_t ka_interval_ms;
+    uint32_t ka_count;
+    uint64_t last_activity_ms;
+    bool ka_lost;                /* Probes lost; a STAND_IN_EV_KA_EXPIRE is due */
+    bool disconnect_pending;
+    uint8_t rx[STAND_IN_RX_QUEUE_LEN];
+    uint64_t rx_at_ms[STAND_IN_RX_QUEUE_LEN];    /* Sent by the server */
+    uint64_t rx_ready_ms[STAND_IN_RX_QUEUE_LEN]; /* Reaches the client */
+    uint32_t rx_head;
+    uint32_t rx_count;
+} socket_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Board objects referenced by the client. */
+SDHC_Type stand_in_sdhc;
+GPIO_PRT_Type stand_in_led_port;
+CySCB_Type stand_in_scb2;
+cy_stc_scb_uart_context_t DEBUG_UART_context;
+const mtb_hal_sdio_configurator_t CYBSP_WIFI_SDIO_sdio_hal_config;
+
+static stand_in_world_t world;
+static stand_in_stats_t stats;
+static uint64_t now_ms;
+static bool ap_up;
+static bool server_up;
+static bool server_silent;
+static bool verbose;
+
+static stand_in_faults_t faults;
+static uint32_t random_state;
+
+static event_t events[STAND_IN_MAX_EVENTS];
+static uint32_t event_count;
+static uint32_t event_seq;
+
+static socket_t sockets[STAND_IN_MAX_SOCKETS];
+static struct netif wifi_netif;
+static const char *uart_next;
+
+/* Acknowledgement expected for the command the client is handling. */
+static const char *expected_ack;
+static uint64_t expected_ack_at_ms;
+
+static ucontext_t runner_context;
+static ucontext_t task_context;
+static uint8_t *task_stack;
+static size_t task_stack_size;
+static bool run_completed;
+static const char *run_failure;
+static char failure_text[CONSOLE_LINE_LEN];
+
+/*******************************************************************************
+* Function Name: finish_run
+********************************************************************************
+* Summary:
+*  Leaves the client task for good and returns to stand_in_run().
+*
+* Parameters:
+*  const char *failure: Why the run stopped, or NULL if the scenario ended
+*
+*******************************************************************************/
+static void __attribute__((noreturn)) finish_run(const char *failure)
+{
+    run_completed = (NULL == failure);
+    run_failure = failure;
+    setcontext(&runner_context);
+    __builtin_unreachable();
+}
+
+/*******************************************************************************
+* Function Name: stand_in_fatal
+********************************************************************************
+* Summary:
+*  Called by CY_ASSERT, which handle_app_error() uses to stop the device.
+*
+*******************************************************************************/
+void stand_in_fatal(const char *file, int line)
+{
+    const char *name = strrchr(file, '/');
+
+    snprintf(failure_text, sizeof(failure_text), "CY_ASSERT at %s:%d",
+             (NULL != name) ? (name + 1) : file, line);
+    finish_run(failure_text);
+}
+
+/*******************************************************************************
+* Function Name: pop_event
+********************************************************************************
+* Summary:
+*  Removes the earliest event from the queue.
+*
+* Parameters:
+*  event_t *event: Filled with the event
+*
+* Return:
+*  bool: false if the queue is empty
+*
+*******************************************************************************/
+static bool pop_event(event_t *event)
+{
+    uint32_t first = 0U;
+
+    if (0U == event_count)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 1U; i < event_count; i++)
+    {
+        if ((events[i].at_ms < events[first].at_ms) ||
+            ((events[i].at_ms == events[first].at_ms) && (events[i].seq < events[first].seq)))
+        {
+            first = i;
+        }
+    }
+
+    *event = events[first];
+    events[first] = events[--event_count];
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: peek_event_time
+********************************************************************************
+* Summary:
+*  Returns the time of the earliest event, or UINT64_MAX if there is none.
+*
+*******************************************************************************/
+static uint64_t peek_event_time(void)
+{
+    uint64_t first = UINT64_MAX;
+
+    for (uint32_t i = 0U; i < event_count; i++)
+    {
+        if (events[i].at_ms < first)
+        {
+            first = events[i].at_ms;
+        }
+    }
+
+    return first;
+}
+
+/*******************************************************************************
+* Function Name: stand_in_schedule
+********************************************************************************
+* Summary:
+*  Queues a scenario event.
+*
+* Parameters:
+*  uint64_t at_ms: Virtual time of the event
+*  stand_in_event_type_t type: Event
+*  uint32_t arg: Event argument; see stand_in_event_type_t
+*
+*******************************************************************************/
+void stand_in_schedule(uint64_t at_ms, stand_in_event_type_t type, uint32_t arg)
+{
+    if (STAND_IN_MAX_EVENTS == event_count)
+    {
+        finish_run("event queue full");
+    }
+
+    events[event_count].at_ms = at_ms;
+    events[event_count].seq = event_seq++;
+    events[event_count].type = type;
+    events[event_count].arg = arg;
+    events[event_count].faults = NULL;
+    event_count++;
+}
+
+/*******************************************************************************
+* Function Name: stand_in_schedule_faults
+********************************************************************************
+* Summary:
+*  Queues a change of the injected faults. The profile is copied when it takes
+*  effect, so it must stay valid until then.
+*
+* Parameters:
+*  uint64_t at_ms: Virtual time from which the faults apply
+*  const stand_in_faults_t *faults: Faults to inject, or NULL for a clean network
+*
+*******************************************************************************/
+void stand_in_schedule_faults(uint64_t at_ms, const stand_in_faults_t *faults)
+{
+    stand_in_schedule(at_ms, STAND_IN_EV_FAULTS, 0U);
+    events[event_count - 1U].faults = faults;
+}
+
+/*******************************************************************************
+* Function Name: random_below
+********************************************************************************
+* Summary:
+*  Returns a value from the seeded xorshift generator below the given limit.
+*  A limit of 0 returns 0 without drawing, so that a fault that is switched
+*  off does not change the draws of the others.
+*
+*******************************************************************************/
+static uint32_t random_below(uint32_t limit)
+{
+    if (0U == limit)
+    {
+        return 0U;
+    }
+
+    random_state ^= random_state << 13U;
+    random_state ^= random_state >> 17U;
+    random_state ^= random_state << 5U;
+    return random_state % limit;
+}
+
+/*******************************************************************************
+* Function Name: chance
+*******************************************************************************/
+static bool chance(uint32_t percent)
+{
+    return (0U != percent) && (random_below(100U) < percent);
+}
+
+/*******************************************************************************
+* Function Name: round_trip_lost
+********************************************************************************
+* Summary:
+*  Decides whether a segment or its answer is lost. A silent server answers
+*  nothing.
+*
+*******************************************************************************/
+static bool round_trip_lost(void)
+{
+    return server_silent || chance(faults.loss_pct) || chance(faults.loss_pct);
+}
+
+/*******************************************************************************
+* Function Name: backoff_ms
+********************************************************************************
+* Summary:
+*  Retransmission timeout for the given retry, doubling the first timeout as
+*  lwIP does.
+*
+*******************************************************************************/
+static uint64_t backoff_ms(uint32_t first_ms, uint32_t retry)
+{
+    return (uint64_t)first_ms << ((retry < RTO_BACKOFF_MAX) ? retry : RTO_BACKOFF_MAX);
+}
+
+/*******************************************************************************
+* Function Name: segment_delay
+********************************************************************************
+* Summary:
+*  Works out how long a data segment takes to get across with the injected
+*  faults: retransmission timeouts for each loss, then the extra latency and
+*  jitter, and the reordering delay if later segments overtake it. A lost
+*  acknowledgement is covered by the next one, so only the segment counts.
+*
+* Parameters:
+*  uint64_t *delay_ms: Set to the delay, or to the time until the sender
+*                      gives up if the segment never gets across
+*
+* Return:
+*  bool: false if the segment ran out of retransmissions
+*
+*******************************************************************************/
+static bool segment_delay(uint64_t *delay_ms)
+{
+    uint64_t delay = 0U;
+
+    for (uint32_t retry = 0U; server_silent || chance(faults.loss_pct); retry++)
+    {
+        stats.segments_lost++;
+        delay += backoff_ms(world.rto_ms, retry);
+        if (STAND_IN_MAX_RETRANSMITS == retry)
+        {
+            *delay_ms = delay;
+            return false;
+        }
+        stats.retransmits++;
+    }
+
+    delay += faults.latency_ms;
+    if (0U != faults.jitter_ms)
+    {
+        delay += random_below(faults.jitter_ms + 1U);
+    }
+    if (chance(faults.reorder_pct))
+    {
+        stats.segments_reordered++;
+        delay += faults.reorder_ms;
+    }
+
+    *delay_ms = delay;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: socket_ref
+********************************************************************************
+* Summary:
+*  Packs a socket into an event argument that goes stale when the slot is
+*  reused.
+*
+*******************************************************************************/
+static uint32_t socket_ref(const socket_t *sock)
+{
+    return ((uint32_t)(sock - sockets) << SOCKET_REF_INDEX_SHIFT) |
+           (sock->generation & SOCKET_REF_GENERATION_MASK);
+}
+
+/*******************************************************************************
+* Function Name: socket_from_ref
+********************************************************************************
+* Summary:
+*  Returns the connected socket an event argument refers to, or NULL if it has
+*  been closed since.
+*
+*******************************************************************************/
+static socket_t *socket_from_ref(uint32_t ref)
+{
+    socket_t *sock = &sockets[((ref >> SOCKET_REF_INDEX_SHIFT) & SOCKET_REF_INDEX_MASK) %
+                              STAND_IN_MAX_SOCKETS];
+
+    if (!sock->used || !sock->connected ||
+        ((sock->generation & SOCKET_REF_GENERATION_MASK) != (ref & SOCKET_REF_GENERATION_MASK)))
+    {
+        return NULL;
+    }
+
+    return sock;
+}
+
+/*******************************************************************************
+* Function Name: expire_keepalives
+********************************************************************************
+* Summary:
+*  Queues the end of the keepalive probes on every idle connection once the
+*  server can no longer answer them.
+*
+*******************************************************************************/
+static void expire_keepalives(void)
+{
+    for (uint32_t i = 0U; i < STAND_IN_MAX_SOCKETS; i++)
+    {
+        socket_t *sock = &sockets[i];
+
+        if (sock->used && sock->connected && sock->keepalive && !sock->ka_lost)
+        {
+            stand_in_schedule(sock->last_activity_ms + sock->ka_idle_ms +
+                              ((uint64_t)sock->ka_interval_ms * sock->ka_count),
+                              STAND_IN_EV_KA_EXPIRE, socket_ref(sock));
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: count_keepalives
+********************************************************************************
+* Summary:
+*  Counts the keepalive probes the TCP stack sends on idle connections up to
+*  the given time while the server answers them. With injected loss, a probe
+*  whose retries all go unanswered queues a STAND_IN_EV_KA_EXPIRE that may
+*  fall before the given time; callers pop events after counting.
+*
+* Parameters:
+*  uint64_t until_ms: Virtual time to count up to
+*
+*******************************************************************************/
+static void count_keepalives(uint64_t until_ms)
+{
+    for (uint32_t i = 0U; i < STAND_IN_MAX_SOCKETS; i++)
+    {
+        socket_t *sock = &sockets[i];
+
+        if (!sock->used || !sock->connected || !sock->keepalive ||
+            (0U == sock->ka_idle_ms) || !ap_up || server_silent || sock->ka_lost)
+        {
+            continue;
+        }
+
+        while ((sock->last_activity_ms + sock->ka_idle_ms) <= until_ms)
+        {
+            uint32_t probe = 0U;
+
+            sock->last_activity_ms += sock->ka_idle_ms;
+            stats.keepalive_probes++;
+
+            while ((probe < sock->ka_count) && (0U != faults.loss_pct) && round_trip_lost())
+            {
+                stats.segments_lost++;
+                if (++probe < sock->ka_count)
+                {
+                    stats.keepalive_probes++;
+                }
+            }
+
+            if ((0U != sock->ka_count) && (probe == sock->ka_count))
+            {
+                sock->ka_lost = true;
+                stand_in_schedule(sock->last_activity_ms +
+                                  ((uint64_t)sock->ka_interval_ms * sock->ka_count),
+                                  STAND_IN_EV_KA_EXPIRE, socket_ref(sock) | KA_EXPIRE_LOST);
+                break;
+            }
+
+            /* A retry was answered; the idle time starts again from there. */
+            sock->last_activity_ms += (uint64_t)sock->ka_interval_ms * probe;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: drop_connection
+********************************************************************************
+* Summary:
+*  Marks a connected socket as closed by the network and queues its
+*  disconnect callback.
+*
+*******************************************************************************/
+static void drop_connection(socket_t *sock)
+{
+    sock->connected = false;
+    sock->disconnect_pending = true;
+}
+
+/*******************************************************************************
+* Function Name: process_event
+********************************************************************************
+* Summary:
+*  Applies an event to the modelled network.
+*
+* Parameters:
+*  const event_t *event: Event that is due
+*
+* Return:
+*  bool: true if the event is network activity that wakes the host
+*
+*******************************************************************************/
+static bool process_event(const event_t *event)
+{
+    bool wake = false;
+
+    switch (event->type)
+    {
+        case STAND_IN_EV_SERVER_DROP:
+            for (uint32_t i = 0U; i < STAND_IN_MAX_SOCKETS; i++)
+            {
+                if (sockets[i].used && sockets[i].connected)
+                {
+                    drop_connection(&sockets[i]);
+                    wake = true;
+                }
+            }
+            if (0U != event->arg)
+            {
+                server_up = false;
+                stand_in_schedule(now_ms + event->arg, STAND_IN_EV_SERVER_UP, 0U);
+            }
+            break;
+
+        case STAND_IN_EV_SERVER_UP:
+            server_up = true;
+            break;
+
+        case STAND_IN_EV_AP_DROP:
+            /* The link-down event from the WLAN device wakes the host. The
+             * TCP connection only notices when its keepalive goes unanswered.
+             */
+            ap_up = false;
+            wake = true;
+            expire_keepalives();
+            stand_in_schedule(now_ms + event->arg + world.ap_rejoin_ms, STAND_IN_EV_AP_UP, 0U);
+            break;
+
+        case STAND_IN_EV_AP_UP:
+            ap_up = true;
+            wake = true;
+            break;
+
+        case STAND_IN_EV_KA_EXPIRE:
+        {
+            socket_t *sock = socket_from_ref(event->arg);
+
+            if (NULL == sock)
+            {
+                break;
+            }
+
+            if (0U != (event->arg & KA_EXPIRE_LOST))
+            {
+                /* The probes were counted as they were lost. Traffic since
+                 * the first of them shows the connection is alive after all.
+                 */
+                sock->ka_lost = false;
+                if (sock->last_activity_ms > (now_ms - ((uint64_t)sock->ka_interval_ms *
+                                                        sock->ka_count)))
+                {
+                    break;
+                }
+            }
+            else
+            {
+                stats.keepalive_probes += sock->ka_count;
+                if (ap_up && !server_silent)
+                {
+                    /* The AP or the server came back in time; the probes
+                     * were answered.
+                     */
+                    sock->last_activity_ms = now_ms;
+                    break;
+                }
+            }
+
+            stats.keepalive_drops++;
+            drop_connection(sock);
+            wake = true;
+            break;
+        }
+
+        case STAND_IN_EV_SERVER_SILENT:
+            server_silent = true;
+            expire_keepalives();
+            if (0U != event->arg)
+            {
+                stand_in_schedule(now_ms + event->arg, STAND_IN_EV_SERVER_ANSWERS, 0U);
+            }
+            break;
+
+        case STAND_IN_EV_SERVER_ANSWERS:
+            server_silent = false;
+            break;
+
+        case STAND_IN_EV_DELIVER:
+            /* The data is already queued; its arrival wakes the host. */
+            wake = (NULL != socket_from_ref(event->arg));
+            break;
+
+        case STAND_IN_EV_RTX_TIMEOUT:
+        {
+            socket_t *sock = socket_from_ref(event->arg);
+
+            if (NULL != sock)
+            {
+                drop_connection(sock);
+                wake = true;
+            }
+            break;
+        }
+
+        case STAND_IN_EV_FAULTS:
+            memset(&faults, 0, sizeof(faults));
+            if (NULL != event->faults)
+            {
+                faults = *event->faults;
+            }
+            random_state = (0U != faults.seed) ? faults.seed : 1U;
+            break;
+
+        case STAND_IN_EV_COMMAND:
+        {
+            socket_t *target = NULL;
+
+            stats.commands_sent++;
+            for (uint32_t i = 0U; i < STAND_IN_MAX_SOCKETS; i++)
+            {
+                if (sockets[i].used && sockets[i].connected)
+                {
+                    target = &sockets[i];
+                }
+            }
+
+            if ((NULL == target) || !ap_up || server_silent ||
+                (STAND_IN_RX_QUEUE_LEN == target->rx_count))
+            {
+                stats.commands_lost++;
+                break;
+            }
+
+            uint64_t delay = 0U;
+            if (!segment_delay(&delay))
+            {
+                /* The server gives up and resets the connection. */
+                stats.commands_lost++;
+                stand_in_schedule(now_ms + delay, STAND_IN_EV_RTX_TIMEOUT, socket_ref(target));
+                break;
+            }
+
+            uint32_t slot = (target->rx_head + target->rx_count) % STAND_IN_RX_QUEUE_LEN;
+            uint32_t last = (slot + STAND_IN_RX_QUEUE_LEN - 1U) % STAND_IN_RX_QUEUE_LEN;
+            uint64_t ready_ms = now_ms + delay;
+
+            /* TCP hands the data over in order: nothing overtakes a
+             * segment the client is still waiting for.
+             */
+            if ((0U != target->rx_count) && (target->rx_ready_ms[last] > ready_ms))
+            {
+                ready_ms = target->rx_ready_ms[last];
+            }
+
+            target->rx[slot] = (uint8_t)event->arg;
+            target->rx_at_ms[slot] = now_ms;
+            target->rx_ready_ms[slot] = ready_ms;
+            target->rx_count++;
+            target->last_activity_ms = now_ms;
+            if (ready_ms > now_ms)
+            {
+                stand_in_schedule(ready_ms, STAND_IN_EV_DELIVER, socket_ref(target));
+            }
+            else
+            {
+                wake = true;
+            }
+            break;
+        }
+
+        case STAND_IN_EV_END:
+        default:
+            finish_run(NULL);
+    }
+
+    return wake;
+}
+
+/*******************************************************************************
+* Function Name: advance_to
+********************************************************************************
+* Summary:
+*  Moves the virtual clock forward, applying the events that fall due on the
+*  way. Callbacks they cause are delivered at the next wait_net_suspend().
+*
+* Parameters:
+*  uint64_t until_ms: New virtual time
+*
+*******************************************************************************/
+static void advance_to(uint64_t until_ms)
+{
+    event_t event;
+
+    while (peek_event_time() <= until_ms)
+    {
+        count_keepalives(peek_event_time());
+        (void)pop_event(&event);
+        if (event.at_ms > now_ms)
+        {
+            now_ms = event.at_ms;
+        }
+        (void)process_event(&event);
+    }
+
+    count_keepalives(until_ms);
+    if (until_ms > now_ms)
+    {
+        now_ms = until_ms;
+    }
+}
+
+/*******************************************************************************
+* Function Name: deliver_callbacks
+********************************************************************************
+* Summary:
+*  Runs the receive and disconnect callbacks for pending socket events, the
+*  way the secure sockets worker thread does on the device.
+*
+* Return:
+*  bool: true if any callback ran
+*
+*******************************************************************************/
+static bool deliver_callbacks(void)
+{
+    bool delivered = false;
+
+    for (uint32_t i = 0U; i < STAND_IN_MAX_SOCKETS; i++)
+    {
+        socket_t *sock = &sockets[i];
+
+        while (sock->used && (0U != sock->rx_count) &&
+               (sock->rx_ready_ms[sock->rx_head] <= now_ms) && (NULL != sock->recv_cb.callback))
+        {
+            uint32_t before = sock->rx_count;
+
+            stats.api_calls++;
+            (void)sock->recv_cb.callback((cy_socket_t)sock, sock->recv_cb.arg);
+            delivered = true;
+            if (before == sock->rx_count)
+            {
+                break;
+            }
+        }
+
+        if (sock->used && sock->disconnect_pending)
+        {
+            sock->disconnect_pending = false;
+            sock->rx_count = 0U;
+            stats.last_disconnect_ms = now_ms;
+            if (0U == stats.first_disconnect_ms)
+            {
+                stats.first_disconnect_ms = now_ms;
+            }
+            delivered = true;
+            if (NULL != sock->disconnect_cb.callback)
+            {
+                (void)sock->disconnect_cb.callback((cy_socket_t)sock, sock->disconnect_cb.arg);
+            }
+        }
+    }
+
+    return delivered;
+}
+
+/*******************************************************************************
+* Function Name: stand_in_reset
+********************************************************************************
+* Summary:
+*  Starts a new scenario: access point and server up, no sockets, clock at 0.
+*
+* Parameters:
+*  const stand_in_world_t *config: Timing of the modelled network
+*
+*******************************************************************************/
+void stand_in_reset(const stand_in_world_t *config)
+{
+    world = *config;
+    memset(&stats, 0, sizeof(stats));
+    memset(sockets, 0, sizeof(sockets));
+    now_ms = 0U;
+    ap_up = true;
+    server_up = true;
+    server_silent = false;
+    memset(&faults, 0, sizeof(faults));
+    random_state = 1U;
+    event_count = 0U;
+    event_seq = 0U;
+    uart_next = world.uart_input;
+    expected_ack = NULL;
+}
+
+/*******************************************************************************
+* Function Name: stand_in_run
+********************************************************************************
+* Summary:
+*  Runs the client task on the given stack until the scenario ends or the
+*  client stops, and reports how deep the stack went.
+*
+* Parameters:
+*  void (*task)(void *): Task entry
+*  void *stack: Stack memory
+*  size_t stack_size: Size of the stack in bytes
+*
+* Return:
+*  stand_in_run_result_t: Outcome of the run
+*
+*******************************************************************************/
+stand_in_run_result_t stand_in_run(void (*task)(void *), void *stack, size_t stack_size)
+{
+    stand_in_run_result_t result = { 0 };
+    size_t untouched = 0U;
+
+    /* Kept in statics; locals are not safe across swapcontext(). */
+    task_stack = stack;
+    task_stack_size = stack_size;
+    memset(task_stack, STACK_PAINT, task_stack_size);
+    run_completed = false;
+    run_failure = "task returned";
+
+    getcontext(&task_context);
+    task_context.uc_stack.ss_sp = task_stack;
+    task_context.uc_stack.ss_size = task_stack_size;
+    task_context.uc_link = &runner_context;
+    makecontext(&task_context, (void (*)(void))task, 1, NULL);
+
+    swapcontext(&runner_context, &task_context);
+
+    /* The stack grows down; the paint left at the bottom was never used. */
+    while ((untouched < task_stack_size) && (STACK_PAINT == task_stack[untouched]))
+    {
+        untouched++;
+    }
+
+    result.completed = run_completed;
+    result.failure = run_completed ? NULL : run_failure;
+    result.end_ms = now_ms;
+    result.stack_used = task_stack_size - untouched;
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: stand_in_now_ms
+*******************************************************************************/
+uint64_t stand_in_now_ms(void)
+{
+    return now_ms;
+}
+
+/*******************************************************************************
+* Function Name: stand_in_get_stats
+*******************************************************************************/
+const stand_in_stats_t *stand_in_get_stats(void)
+{
+    return &stats;
+}
+
+/*******************************************************************************
+* Function Name: stand_in_set_verbose
+********************************************************************************
+* Summary:
+*  Selects whether the client's console output is printed.
+*
+*******************************************************************************/
+void stand_in_set_verbose(bool enable)
+{
+    verbose = enable;
+}
+
+/*******************************************************************************
+* Function Name: stand_in_printf
+********************************************************************************
+* Summary:
+*  Console output of the client. It is always formatted, so that its cost
+*  shows up in the timing, but only printed in verbose mode.
+*
+*******************************************************************************/
+int stand_in_printf(const char *format, ...)
+{
+    char line[CONSOLE_LINE_LEN];
+    va_list args;
+    int length;
+
+    va_start(args, format);
+    length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (verbose)
+    {
+        fprintf(stderr, "[%8llu ms] %s", (unsigned long long)now_ms, line);
+    }
+
+    return length;
+}
+
+/*******************************************************************************
+* RTOS abstraction
+*******************************************************************************/
+cy_rslt_t cy_rtos_semaphore_init(cy_semaphore_t *semaphore, uint32_t maxcount,
+                                 uint32_t initcount)
+{
+    stats.api_calls++;
+    semaphore->count = initcount;
+    semaphore->max_count = maxcount;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_semaphore_get(cy_semaphore_t *semaphore, cy_time_t timeout_ms)
+{
+    stats.api_calls++;
+    if (0U != semaphore->count)
+    {
+        semaphore->count--;
+        return CY_RSLT_SUCCESS;
+    }
+
+    if (CY_RTOS_NEVER_TIMEOUT == timeout_ms)
+    {
+        /* The client is the only task; nobody else can give it. */
+        finish_run("semaphore wait would block forever");
+    }
+
+    advance_to(now_ms + timeout_ms);
+    return CY_RTOS_TIMEOUT;
+}
+
+cy_rslt_t cy_rtos_semaphore_set(cy_semaphore_t *semaphore)
+{
+    stats.api_calls++;
+    if (semaphore->count < semaphore->max_count)
+    {
+        semaphore->count++;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_delay_milliseconds(cy_time_t num_ms)
+{
+    stats.api_calls++;
+    advance_to(now_ms + num_ms);
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Low power assistant
+*******************************************************************************/
+int32_t wait_net_suspend(void *net_intf, uint32_t wait_ms, uint32_t network_inactive_interval_ms,
+                         uint32_t network_inactive_window_ms)
+{
+    event_t event;
+    uint64_t wake_ms = (portMAX_DELAY == wait_ms) ? UINT64_MAX : (now_ms + wait_ms);
+
+    CY_UNUSED_PARAMETER(net_intf);
+    CY_UNUSED_PARAMETER(network_inactive_interval_ms);
+    CY_UNUSED_PARAMETER(network_inactive_window_ms);
+
+    stats.api_calls++;
+
+    /* Sleep until the network wakes the host or wait_ms runs out. Socket
+     * callbacks queued while the client was busy count as activity that is
+     * already there.
+     */
+    while (!deliver_callbacks())
+    {
+        if (peek_event_time() > wake_ms)
+        {
+            advance_to(wake_ms);
+            break;
+        }
+
+        if (0U == event_count)
+        {
+            finish_run("no more events; the scenario has no end");
+        }
+
+        count_keepalives(peek_event_time());
+        (void)pop_event(&event);
+        if (event.at_ms > now_ms)
+        {
+            now_ms = event.at_ms;
+        }
+
+        if (process_event(&event) && (STAND_IN_EV_COMMAND != event.type) &&
+            (STAND_IN_EV_SERVER_DROP != event.type) && (STAND_IN_EV_KA_EXPIRE != event.type) &&
+            (STAND_IN_EV_DELIVER != event.type) && (STAND_IN_EV_RTX_TIMEOUT != event.type))
+        {
+            /* Link events wake the host without a socket callback. */
+            break;
+        }
+    }
+
+    stats.host_wakes++;
+    return 0;
+}
+
+/*******************************************************************************
+* Wi-Fi connection manager and network helpers
+*******************************************************************************/
+cy_rslt_t cy_wcm_init(cy_wcm_config_t *config)
+{
+    CY_UNUSED_PARAMETER(config);
+    stats.api_calls++;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_wcm_connect_ap(cy_wcm_connect_params_t *connect_params,
+                            cy_wcm_ip_address_t *ip_addr)
+{
+    CY_UNUSED_PARAMETER(connect_params);
+    stats.api_calls++;
+    stats.wifi_join_calls++;
+
+    if (!ap_up)
+    {
+        advance_to(now_ms + world.ap_join_timeout_ms);
+        stats.wifi_join_failures++;
+        return CY_RSLT_WCM_CONNECT_FAILED;
+    }
+
+    advance_to(now_ms + world.ap_join_ms);
+    ip_addr->version = 4;
+    ip_addr->ip.v4 = DEVICE_IPV4;
+    wifi_netif.ip_addr = DEVICE_IPV4;
+    return CY_RSLT_SUCCESS;
+}
+
+bool cy_wcm_is_connected_to_ap(void)
+{
+    stats.api_calls++;
+    return ap_up;
+}
+
+void *cy_network_get_nw_interface(cy_network_hw_interface_type_t iface_type,
+                                  uint8_t iface_idx)
+{
+    CY_UNUSED_PARAMETER(iface_type);
+    CY_UNUSED_PARAMETER(iface_idx);
+    stats.api_calls++;
+    return &wifi_netif;
+}
+
+bool cy_nw_ntoa(cy_nw_ip_address_t *addr, char *ip_str)
+{
+    uint32_t ip = addr->ip.v4;
+
+    sprintf(ip_str, "%u.%u.%u.%u", (unsigned)(ip & 0xFFU), (unsigned)((ip >> 8U) & 0xFFU),
+            (unsigned)((ip >> 16U) & 0xFFU), (unsigned)(ip >> 24U));
+    return true;
+}
+
+int cy_nw_str_to_ipv4(const char *ip_str, cy_nw_ip_address_t *addr)
+{
+    unsigned int a, b, c, d;
+
+    if (4 != sscanf(ip_str, "%u.%u.%u.%u", &a, &b, &c, &d))
+    {
+        return -1;
+    }
+
+    addr->version = NW_IP_IPV4;
+    addr->ip.v4 = a | (b << 8U) | (c << 16U) | (d << 24U);
+    return 0;
+}
+
+/*******************************************************************************
+* Secure sockets
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: handshake
+********************************************************************************
+* Summary:
+*  Runs the TCP handshake with the injected faults. Lost SYNs are sent again
+*  with lwIP's backoff; a SYN-ACK that comes later than the retransmission
+*  timeout costs a spurious retransmission. Advances the clock to the answer,
+*  or to the connect timeout if none comes in time.
+*
+* Return:
+*  bool: true if the server answered
+*
+*******************************************************************************/
+static bool handshake(void)
+{
+    uint64_t answer_ms = UINT64_MAX;
+    uint64_t sent_ms = 0U;
+
+    for (uint32_t syn = 0U;
+         (syn <= STAND_IN_MAX_SYN_RETRANSMITS) && (sent_ms < answer_ms) &&
+         (sent_ms < world.connect_timeout_ms);
+         syn++)
+    {
+        if (0U != syn)
+        {
+            stats.retransmits++;
+        }
+
+        if (round_trip_lost())
+        {
+            stats.segments_lost++;
+        }
+        else
+        {
+            /* A server that is down answers with a reset straight away. */
+            uint64_t at_ms = sent_ms + world.rtt_ms + (server_up ? faults.synack_delay_ms : 0U) +
+                             (2U * (uint64_t)faults.latency_ms);
+
+            if (0U != faults.jitter_ms)
+            {
+                at_ms += random_below(faults.jitter_ms + 1U);
+            }
+            if (at_ms < answer_ms)
+            {
+                answer_ms = at_ms;
+            }
+        }
+
+        sent_ms += backoff_ms(world.syn_rto_ms, syn);
+    }
+
+    if (answer_ms > world.connect_timeout_ms)
+    {
+        advance_to(now_ms + world.connect_timeout_ms);
+        return false;
+    }
+
+    advance_to(now_ms + answer_ms);
+    return true;
+}
+
+static socket_t *find_socket(cy_socket_t handle)
+{
+    socket_t *sock = (socket_t *)handle;
+
+    if ((sock < &sockets[0]) || (sock >= &sockets[STAND_IN_MAX_SOCKETS]) || !sock->used)
+    {
+        return NULL;
+    }
+
+    return sock;
+}
+
+cy_rslt_t cy_socket_init(void)
+{
+    stats.api_calls++;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_create(int domain, int type, int protocol, cy_socket_t *handle)
+{
+    CY_UNUSED_PARAMETER(domain);
+    CY_UNUSED_PARAMETER(type);
+    CY_UNUSED_PARAMETER(protocol);
+    stats.api_calls++;
+
+    for (uint32_t i = 0U; i < STAND_IN_MAX_SOCKETS; i++)
+    {
+        if (!sockets[i].used)
+        {
+            uint32_t generation = sockets[i].generation + 1U;
+
+            memset(&sockets[i], 0, sizeof(sockets[i]));
+            sockets[i].used = true;
+            sockets[i].generation = generation;
+            *handle = (cy_socket_t)&sockets[i];
+
+            stats.sockets_created++;
+            stats.sockets_open++;
+            if (stats.sockets_open > stats.sockets_peak)
+            {
+                stats.sockets_peak = stats.sockets_open;
+            }
+            return CY_RSLT_SUCCESS;
+        }
+    }
+
+    return CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+}
+
+cy_rslt_t cy_socket_setsockopt(cy_socket_t handle, int level, int optname,
+                               const void *optval, uint32_t optlen)
+{
+    socket_t *sock = find_socket(handle);
+
+    CY_UNUSED_PARAMETER(level);
+    CY_UNUSED_PARAMETER(optlen);
+    stats.api_calls++;
+
+    if (NULL == sock)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    switch (optname)
+    {
+        case CY_SOCKET_SO_RECEIVE_CALLBACK:
+            sock->recv_cb = *(const cy_socket_opt_callback_t *)optval;
+            break;
+        case CY_SOCKET_SO_DISCONNECT_CALLBACK:
+            sock->disconnect_cb = *(const cy_socket_opt_callback_t *)optval;
+            break;
+        case CY_SOCKET_SO_TCP_KEEPALIVE_ENABLE:
+            sock->keepalive = (0 != *(const int *)optval);
+            break;
+        case CY_SOCKET_SO_TCP_KEEPALIVE_INTERVAL:
+            sock->ka_interval_ms = *(const uint32_t *)optval;
+            break;
+        case CY_SOCKET_SO_TCP_KEEPALIVE_COUNT:
+            sock->ka_count = *(const uint32_t *)optval;
+            break;
+        case CY_SOCKET_SO_TCP_KEEPALIVE_IDLE_TIME:
+            sock->ka_idle_ms = *(const uint32_t *)optval;
+            break;
+        default:
+            return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_connect(cy_socket_t handle, cy_socket_sockaddr_t *address,
+                            uint32_t address_length)
+{
+    socket_t *sock = find_socket(handle);
+
+    CY_UNUSED_PARAMETER(address);
+    CY_UNUSED_PARAMETER(address_length);
+    stats.api_calls++;
+    stats.connect_calls++;
+
+    if (NULL == sock)
+    {
+        stats.connect_failures++;
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    if (!ap_up)
+    {
+        /* The interface is down; lwIP has no route. */
+        advance_to(now_ms + 1U);
+        stats.connect_failures++;
+        return CY_RSLT_MODULE_SECURE_SOCKETS_TCPIP_ERROR;
+    }
+
+    if (!handshake())
+    {
+        stats.connect_failures++;
+        return CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+    }
+
+    if (!server_up)
+    {
+        /* Answered with a reset. */
+        stats.connect_failures++;
+        return CY_RSLT_MODULE_SECURE_SOCKETS_TCPIP_ERROR;
+    }
+
+    sock->connected = true;
+    sock->last_activity_ms = now_ms;
+    stats.last_connect_ms = now_ms;
+    if ((0U != stats.first_disconnect_ms) && (0U == stats.reconnect_ms))
+    {
+        stats.reconnect_ms = now_ms;
+    }
+    if (0U == stats.online_ms)
+    {
+        stats.online_ms = now_ms;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_recv(cy_socket_t handle, void *buffer, uint32_t length,
+                         int flags, uint32_t *bytes_received)
+{
+    socket_t *sock = find_socket(handle);
+    uint8_t *out = buffer;
+
+    CY_UNUSED_PARAMETER(flags);
+    stats.api_calls++;
+    *bytes_received = 0U;
+
+    if (NULL == sock)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    while ((*bytes_received < length) && (0U != sock->rx_count) &&
+           (sock->rx_ready_ms[sock->rx_head] <= now_ms))
+    {
+        uint8_t command = sock->rx[sock->rx_head];
+
+        out[(*bytes_received)++] = command;
+        expected_ack_at_ms = sock->rx_at_ms[sock->rx_head];
+        expected_ack = ('1' == command) ? "LED ON ACK" :
+                       (('0' == command) ? "LED OFF ACK" : "Invalid command");
+        sock->rx_head = (sock->rx_head + 1U) % STAND_IN_RX_QUEUE_LEN;
+        sock->rx_count--;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_send(cy_socket_t handle, const void *buffer, uint32_t length,
+                         int flags, uint32_t *bytes_sent)
+{
+    socket_t *sock = find_socket(handle);
+    uint64_t delay = 0U;
+
+    CY_UNUSED_PARAMETER(flags);
+    stats.api_calls++;
+    *bytes_sent = 0U;
+
+    if ((NULL == sock) || !sock->connected)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOT_CONNECTED;
+    }
+
+    if (!segment_delay(&delay))
+    {
+        /* The client stack gives up and the connection is closed. */
+        stand_in_schedule(now_ms + delay, STAND_IN_EV_RTX_TIMEOUT, socket_ref(sock));
+    }
+    else if ((NULL != expected_ack) && (strlen(expected_ack) == length) &&
+             (0 == memcmp(expected_ack, buffer, length)))
+    {
+        /* Measured when the acknowledgement reaches the server. */
+        uint64_t latency = now_ms + delay - expected_ack_at_ms;
+
+        stats.acks_ok++;
+        stats.ack_latency_total_ms += latency;
+        if (latency > stats.ack_latency_max_ms)
+        {
+            stats.ack_latency_max_ms = latency;
+        }
+    }
+    else
+    {
+        stats.acks_bad++;
+    }
+
+    expected_ack = NULL;
+    sock->last_activity_ms = now_ms;
+    *bytes_sent = length;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_disconnect(cy_socket_t handle, uint32_t timeout)
+{
+    socket_t *sock = find_socket(handle);
+
+    CY_UNUSED_PARAMETER(timeout);
+    stats.api_calls++;
+
+    if (NULL == sock)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    sock->connected = false;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_delete(cy_socket_t handle)
+{
+    socket_t *sock = find_socket(handle);
+
+    stats.api_calls++;
+
+    if (NULL == sock)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    sock->used = false;
+    sock->connected = false;
+    stats.sockets_open--;
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Board support: SDIO, GPIO, interrupts, power management and the debug UART
+*******************************************************************************/
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress handler)
+{
+    CY_UNUSED_PARAMETER(config);
+    CY_UNUSED_PARAMETER(handler);
+    stats.api_calls++;
+    return CY_SYSINT_SUCCESS;
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+    CY_UNUSED_PARAMETER(irq);
+}
+
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t *handler)
+{
+    CY_UNUSED_PARAMETER(handler);
+    return true;
+}
+
+void Cy_SD_Host_Enable(SDHC_Type *base)
+{
+    CY_UNUSED_PARAMETER(base);
+}
+
+int Cy_SD_Host_Init(SDHC_Type *base, const cy_stc_sd_host_init_config_t *config,
+                    cy_stc_sd_host_context_t *context)
+{
+    CY_UNUSED_PARAMETER(base);
+    CY_UNUSED_PARAMETER(config);
+    CY_UNUSED_PARAMETER(context);
+    return 0;
+}
+
+int Cy_SD_Host_SetHostBusWidth(SDHC_Type *base, cy_en_sd_host_bus_width_t width)
+{
+    CY_UNUSED_PARAMETER(base);
+    CY_UNUSED_PARAMETER(width);
+    return 0;
+}
+
+cy_en_syspm_status_t Cy_SD_Host_DeepSleepCallback(cy_stc_syspm_callback_params_t *params,
+                                                  cy_en_syspm_callback_mode_t mode)
+{
+    CY_UNUSED_PARAMETER(params);
+    CY_UNUSED_PARAMETER(mode);
+    return CY_SYSPM_SUCCESS;
+}
+
+cy_rslt_t mtb_hal_sdio_setup(mtb_hal_sdio_t *obj, const mtb_hal_sdio_configurator_t *config,
+                             void *clock, cy_stc_sd_host_context_t *context)
+{
+    CY_UNUSED_PARAMETER(obj);
+    CY_UNUSED_PARAMETER(config);
+    CY_UNUSED_PARAMETER(clock);
+    CY_UNUSED_PARAMETER(context);
+    stats.api_calls++;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_hal_sdio_configure(mtb_hal_sdio_t *obj, const mtb_hal_sdio_cfg_t *config)
+{
+    CY_UNUSED_PARAMETER(obj);
+    CY_UNUSED_PARAMETER(config);
+    return CY_RSLT_SUCCESS;
+}
+
+void mtb_hal_sdio_process_interrupt(mtb_hal_sdio_t *obj)
+{
+    CY_UNUSED_PARAMETER(obj);
+}
+
+cy_rslt_t mtb_hal_gpio_setup(mtb_hal_gpio_t *obj, uint32_t port, uint32_t pin)
+{
+    CY_UNUSED_PARAMETER(obj);
+    CY_UNUSED_PARAMETER(port);
+    CY_UNUSED_PARAMETER(pin);
+    return CY_RSLT_SUCCESS;
+}
+
+void mtb_hal_gpio_process_interrupt(mtb_hal_gpio_t *obj)
+{
+    CY_UNUSED_PARAMETER(obj);
+}
+
+uint32_t mtb_hal_lptimer_read(const mtb_hal_lptimer_t *obj)
+{
+    CY_UNUSED_PARAMETER(obj);
+    return (uint32_t)(now_ms * 32768U / 1000U);
+}
+
+void Cy_GPIO_Write(GPIO_PRT_Type *base, uint32_t pin, uint32_t value)
+{
+    CY_UNUSED_PARAMETER(base);
+    CY_UNUSED_PARAMETER(pin);
+    CY_UNUSED_PARAMETER(value);
+    stats.api_calls++;
+    stats.led_writes++;
+}
+
+uint32_t Cy_SCB_UART_GetNumInRxFifo(CySCB_Type const *base)
+{
+    CY_UNUSED_PARAMETER(base);
+    return ((NULL != uart_next) && ('\0' != *uart_next)) ? 1U : 0U;
+}
+
+uint32_t Cy_SCB_UART_GetNumInRingBuffer(CySCB_Type const *base,
+                                        cy_stc_scb_uart_context_t const *context)
+{
+    CY_UNUSED_PARAMETER(base);
+    CY_UNUSED_PARAMETER(context);
+    return 0U;
+}
+
+uint32_t Cy_SCB_UART_Get(CySCB_Type const *base)
+{
+    CY_UNUSED_PARAMETER(base);
+    if ((NULL == uart_next) || ('\0' == *uart_next))
+    {
+        return CY_SCB_UART_RX_NO_DATA;
+    }
+    return (uint8_t)*uart_next++;
+}
+
+uint32_t Cy_SCB_UART_Put(CySCB_Type *base, uint32_t data)
+{
+    CY_UNUSED_PARAMETER(base);
+    CY_UNUSED_PARAMETER(data);
+    return 1U;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,170 @@
+/*******************************************************************************
+* File Name:   stand_in.h
+*
+* Description: This file contains the declarations of the host stand-ins that
+* replace the Wi-Fi, socket and RTOS layers under the network client in the
+* host benchmark. The stand-ins run on a virtual clock and model one access
+* point and one TCP server whose behaviour is scripted per scenario, with
+* optional loss, delay and reordering injected between them and the client.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef STAND_IN_H_
+#define STAND_IN_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define STAND_IN_MAX_EVENTS                      (1024U)
+#define STAND_IN_MAX_SOCKETS                     (8U)
+#define STAND_IN_RX_QUEUE_LEN                    (64U)
+
+/* lwIP defaults: TCP_MAXRTX and TCP_SYNMAXRTX. */
+#define STAND_IN_MAX_RETRANSMITS                 (12U)
+#define STAND_IN_MAX_SYN_RETRANSMITS             (6U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Scenario events. The ones marked internal are scheduled by the stand-ins. */
+typedef enum
+{
+    STAND_IN_EV_SERVER_DROP,     /* Server closes the connection; arg: ms until it listens again */
+    STAND_IN_EV_SERVER_UP,       /* Internal: server listens again */
+    STAND_IN_EV_AP_DROP,         /* Access point goes away; arg: ms until it is back */
+    STAND_IN_EV_AP_UP,           /* Internal: WCM has rejoined the access point */
+    STAND_IN_EV_KA_EXPIRE,       /* Internal: keepalive probes went unanswered */
+    STAND_IN_EV_COMMAND,         /* Server sends a one-byte command; arg: the byte */
+    STAND_IN_EV_SERVER_SILENT,   /* Server stops answering, connections stay open; arg: ms until it answers again, 0 for never */
+    STAND_IN_EV_SERVER_ANSWERS,  /* Internal: silent server answers again */
+    STAND_IN_EV_DELIVER,         /* Internal: delayed data reaches the client */
+    STAND_IN_EV_RTX_TIMEOUT,     /* Internal: a segment ran out of retransmissions */
+    STAND_IN_EV_FAULTS,          /* Internal: see stand_in_schedule_faults() */
+    STAND_IN_EV_END              /* Scenario ends */
+} stand_in_event_type_t;
+
+/* Timing of the modelled network. */
+typedef struct
+{
+    uint32_t ap_join_ms;         /* cy_wcm_connect_ap() with the AP in range */
+    uint32_t ap_join_timeout_ms; /* cy_wcm_connect_ap() with the AP out of range */
+    uint32_t ap_rejoin_ms;       /* WCM rejoin once the AP is back */
+    uint32_t rtt_ms;             /* Round trip to the server */
+    uint32_t syn_rto_ms;         /* First SYN retransmission timeout */
+    uint32_t rto_ms;             /* First data retransmission timeout */
+    uint32_t connect_timeout_ms; /* cy_socket_connect() gives up */
+    const char *uart_input;      /* Typed at the server address prompt */
+} stand_in_world_t;
+
+/* Faults injected into the modelled network. All zero is a clean network.
+ * Random choices come from a generator seeded with 'seed' when the faults
+ * take effect, so every run of a scenario sees the same faults.
+ */
+typedef struct
+{
+    uint32_t seed;
+    uint32_t loss_pct;           /* Segments lost in each direction, in percent */
+    uint32_t latency_ms;         /* Extra one-way delay */
+    uint32_t jitter_ms;          /* Random extra one-way delay up to this */
+    uint32_t reorder_pct;        /* Segments overtaken by the ones sent after them */
+    uint32_t reorder_ms;         /* How far an overtaken segment falls behind */
+    uint32_t synack_delay_ms;    /* Server answers a SYN this late */
+} stand_in_faults_t;
+
+/* What the network client did, as seen from the stand-ins. Times are on the
+ * virtual clock in milliseconds.
+ */
+typedef struct
+{
+    uint64_t online_ms;          /* First connection to the server; 0 if none */
+    uint64_t last_connect_ms;    /* Last connection to the server */
+    uint64_t last_disconnect_ms; /* Last disconnect callback delivered */
+    uint64_t first_disconnect_ms; /* First disconnect callback delivered */
+    uint64_t reconnect_ms;       /* First connection after that */
+    uint32_t wifi_join_calls;
+    uint32_t wifi_join_failures;
+    uint32_t connect_calls;
+    uint32_t connect_failures;
+    uint32_t sockets_created;
+    uint32_t sockets_open;
+    uint32_t sockets_peak;
+    uint32_t commands_sent;      /* Commands sent by the server */
+    uint32_t commands_lost;      /* Sent while there was no connection */
+    uint32_t acks_ok;            /* Expected acknowledgements received */
+    uint32_t acks_bad;           /* Unexpected data received by the server */
+    uint64_t ack_latency_total_ms;
+    uint64_t ack_latency_max_ms;
+    uint32_t keepalive_probes;   /* Probes sent by the TCP stack */
+    uint32_t keepalive_drops;    /* Connections closed by unanswered probes */
+    uint32_t segments_lost;      /* Dropped by the injected faults */
+    uint32_t segments_reordered;
+    uint32_t retransmits;        /* Data and SYN retransmissions */
+    uint32_t host_wakes;         /* Returns from wait_net_suspend() */
+    uint32_t api_calls;          /* Calls into the stand-ins */
+    uint32_t led_writes;
+} stand_in_stats_t;
+
+/* Outcome of one scenario run. */
+typedef struct
+{
+    bool completed;              /* Reached STAND_IN_EV_END */
+    const char *failure;         /* Why it stopped early, if it did */
+    uint64_t end_ms;
+    size_t stack_used;           /* Deepest use of the task stack in bytes */
+} stand_in_run_result_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void stand_in_reset(const stand_in_world_t *world);
+void stand_in_schedule(uint64_t at_ms, stand_in_event_type_t type, uint32_t arg);
+void stand_in_schedule_faults(uint64_t at_ms, const stand_in_faults_t *faults);
+stand_in_run_result_t stand_in_run(void (*task)(void *), void *stack, size_t stack_size);
+uint64_t stand_in_now_ms(void);
+const stand_in_stats_t *stand_in_get_stats(void);
+void stand_in_set_verbose(bool verbose);
+int stand_in_printf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+#endif /* STAND_IN_H_ */
+
+/* [] END OF FILE */
@@ -56,3 +56,26 @@ CONFIG=Debug
 COMBINE_SIGN_JSON?=configs/boot_with_extended_boot.json
 
 include ../common_app.mk
+
+# Set to 1 to record boot-phase timestamps on all cores. The CM33 non-secure
+# project prints the boot report once the device is online. Needs the
+# m33_m55_boot_profile memory region (see shared/include/boot_profile_shared.h).
+BOOT_PROFILE?=0
+ifeq ($(BOOT_PROFILE),1)
+DEFINES+=BOOT_PROFILE=1
+endif
+
+# Set to 1 to account the power-state residency of all cores, the radio
+# power-save time and the network traffic. The CM33 non-secure project prints
+# an ENERGY_STATS line for energy_model.py.
+ENERGY_STATS?=0
+ifeq ($(ENERGY_STATS),1)
+DEFINES+=ENERGY_STATS=1
+endif
+
+# Set to 1 to have GCC write the stack usage (.su) and call graph (.ci) of
+# every function next to the object files, for stack_usage.py. GCC_ARM only.
+STACK_USAGE?=0
+ifeq ($(STACK_USAGE),1)
+CFLAGS+=-fstack-usage -fcallgraph-info=su
+endif
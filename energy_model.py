@@ -0,0 +1,253 @@
+#******************************************************************************
+# File Name:   energy_model.py
+#
+# Description: Host-side energy model for the ENERGY_STATS build of
+# proj_cm33_ns (energy_stats.c). Reads the ENERGY_STATS lines from captured
+# terminal logs and converts the residency, radio and traffic counters into
+# an estimated average current (mAh per hour) and a charge per keepalive,
+# command and connect, using the calibration in configs/energy_model.json.
+# With several logs, for example one per configuration, each is compared
+# against the first.
+#
+# Usage:
+#   python energy_model.py terminal.log
+#   python energy_model.py before.log after.log --window --battery-mah 1000
+#   python energy_model.py terminal.log --calibration my_board.json --json out.json
+#
+# Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+#******************************************************************************
+
+#!/usr/bin/python
+
+import argparse
+import json
+import os
+import sys
+
+REPORT_TAG = "ENERGY_STATS "
+DEFAULT_CALIBRATION = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                   "configs", "energy_model.json")
+OPERATIONS = ("keepalive", "command", "connect")
+
+
+def parse_reports(lines):
+    """Returns the ENERGY_STATS records of a log in the order printed."""
+    reports = []
+    for line in lines:
+        start = line.find(REPORT_TAG)
+        if start < 0:
+            continue
+        try:
+            reports.append(json.loads(line[start + len(REPORT_TAG):]))
+        except ValueError:
+            # Truncated line, for example when the log starts mid-report.
+            continue
+    return reports
+
+
+def difference(last, first):
+    """Subtracts two records field by field; a missing value stays None."""
+    if isinstance(last, dict):
+        return {key: difference(value, (first or {}).get(key))
+                for key, value in last.items()}
+    if last is None or first is None:
+        return None if last is None else last
+    return last - first
+
+
+def core_charge(core, elapsed_ms, calibration):
+    """Charge of one core in uC over elapsed_ms. The CM55 record is only
+    brought up to date when the CM55 wakes, so its residency is applied as a
+    fraction of its own elapsed time."""
+    if not core or not core.get("elapsed_ms"):
+        return 0.0
+    scale = float(elapsed_ms) / core["elapsed_ms"]
+    return scale * (core["active_ms"] * calibration["active-ma"] +
+                    core["sleep_ms"] * calibration["sleep-ma"] +
+                    core["deepsleep_ms"] * calibration["deepsleep-ma"])
+
+
+def frame_size(byte_count, packet_count):
+    return float(byte_count) / packet_count if packet_count else 0.0
+
+
+def traffic_charge(tx_bytes, rx_bytes, tx_packets, rx_packets, radio):
+    return (tx_bytes * radio["tx-uc-per-byte"] +
+            rx_bytes * radio["rx-uc-per-byte"] +
+            tx_packets * radio["tx-uc-per-packet"] +
+            rx_packets * radio["rx-uc-per-packet"])
+
+
+def evaluate(stats, calibration):
+    """Applies the calibration to one record. Charges are in uC."""
+    notes = []
+    elapsed_ms = stats["cm33"]["elapsed_ms"]
+    radio_stats = stats["radio"]
+    radio = calibration["radio"]
+
+    if stats.get("cm55") is None:
+        notes.append("no CM55 record; CM55 charge not included")
+
+    ps_ms = radio_stats.get("ps_ms")
+    if ps_ms is None:
+        notes.append("radio power-save time not reported; radio assumed "
+                     "dozing outside the traffic")
+        ps_ms = elapsed_ms
+    awake_ms = max(elapsed_ms - ps_ms, 0)
+
+    keepalive = stats["ops"]["keepalive"]
+    keepalive_count = keepalive["count"]
+    if 0 == keepalive_count:
+        keepalive_count = elapsed_ms / 1000.0 / calibration["keepalive"]["interval-s"]
+        notes.append("keepalives not counted on the device; %.1f estimated "
+                     "from the calibrated interval" % keepalive_count)
+
+    breakdown = {
+        "cm33": core_charge(stats["cm33"], elapsed_ms, calibration["cm33"]),
+        "cm55": core_charge(stats.get("cm55"), elapsed_ms, calibration["cm55"]),
+        "radio idle": ps_ms * radio["ps-ma"] + awake_ms * radio["awake-ma"],
+        "radio traffic": traffic_charge(radio_stats["tx_bytes"],
+                                        radio_stats["rx_bytes"],
+                                        radio_stats["tx_packets"],
+                                        radio_stats["rx_packets"], radio),
+        "keepalives": keepalive_count * calibration["keepalive"]["charge-uc"],
+    }
+
+    # An operation keeps the CM33 active and the radio awake for its active
+    # time, and sends frames of the average size seen on the interface.
+    tx_frame = frame_size(radio_stats["tx_bytes"], radio_stats["tx_packets"])
+    rx_frame = frame_size(radio_stats["rx_bytes"], radio_stats["rx_packets"])
+    active_ma = (calibration["cm33"]["active-ma"] -
+                 calibration["cm33"]["deepsleep-ma"] +
+                 radio["awake-ma"] - radio["ps-ma"])
+    per_operation = {}
+    for name in OPERATIONS:
+        op = stats["ops"][name]
+        if name == "keepalive":
+            per_operation[name] = calibration["keepalive"]["charge-uc"]
+            continue
+        if not op["count"]:
+            per_operation[name] = None
+            continue
+        tx_packets = op["tx_bytes"] / tx_frame if tx_frame else 0.0
+        rx_packets = op["rx_bytes"] / rx_frame if rx_frame else 0.0
+        charge = (op["active_ms"] * active_ma +
+                  traffic_charge(op["tx_bytes"], op["rx_bytes"],
+                                 tx_packets, rx_packets, radio))
+        per_operation[name] = charge / op["count"]
+
+    total = sum(breakdown.values())
+    return {
+        "elapsed_ms": elapsed_ms,
+        "average_ma": total / elapsed_ms if elapsed_ms else 0.0,
+        "breakdown_ma": {name: (charge / elapsed_ms if elapsed_ms else 0.0)
+                         for name, charge in breakdown.items()},
+        "per_operation_uc": per_operation,
+        "counts": {name: stats["ops"][name]["count"] for name in OPERATIONS},
+        "host_wakes": radio_stats["host_wakes"],
+        "notes": notes,
+    }
+
+
+def print_result(name, result, battery_mah, reference):
+    print("%s: %.1f s" % (name, result["elapsed_ms"] / 1000.0))
+    print("  Average current : %.4f mA (mAh per hour)" % result["average_ma"])
+    for part, current in sorted(result["breakdown_ma"].items(),
+                                key=lambda item: -item[1]):
+        print("    %-14s %.4f mA" % (part, current))
+    if battery_mah:
+        hours = battery_mah / result["average_ma"] if result["average_ma"] else 0.0
+        print("  Battery life    : %.0f h (%.1f days) from %d mAh"
+              % (hours, hours / 24.0, battery_mah))
+    print("  Per operation (count, charge):")
+    for op in OPERATIONS:
+        charge = result["per_operation_uc"][op]
+        print("    %-10s %6d  %s" % (op, result["counts"][op],
+              "n/a" if charge is None else
+              "%.1f uC (%.3f uAh)" % (charge, charge / 3600.0)))
+    print("  Host wakes      : %d" % result["host_wakes"])
+    if reference is not None and reference["average_ma"]:
+        delta = result["average_ma"] - reference["average_ma"]
+        print("  Versus first log: %+.4f mA (%+.1f%%)"
+              % (delta, 100.0 * delta / reference["average_ma"]))
+    for note in result["notes"]:
+        print("  Note: %s" % note)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Estimate the charge drawn from ENERGY_STATS reports")
+    parser.add_argument("logs", nargs="+", help="Captured terminal output "
+                        "containing ENERGY_STATS lines, one per configuration")
+    parser.add_argument("--calibration", default=DEFAULT_CALIBRATION,
+                        help="JSON calibration coefficients (default: %(default)s)")
+    parser.add_argument("--window", action="store_true",
+                        help="Use the difference between the first and the "
+                        "last report of each log, which leaves out start-up")
+    parser.add_argument("--battery-mah", type=int, default=0,
+                        help="Battery capacity for a battery life estimate")
+    parser.add_argument("--json", help="Write the results to this JSON file")
+    args = parser.parse_args()
+
+    with open(args.calibration) as calibration_file:
+        calibration = json.load(calibration_file)
+
+    results = {}
+    reference = None
+    for log in args.logs:
+        with open(log, errors="replace") as log_file:
+            reports = parse_reports(log_file)
+        if not reports or (args.window and len(reports) < 2):
+            print("ERROR: %s has too few ENERGY_STATS reports" % log)
+            sys.exit(1)
+
+        stats = difference(reports[-1], reports[0]) if args.window else reports[-1]
+        if stats["cm33"]["elapsed_ms"] <= 0:
+            print("ERROR: %s covers no time" % log)
+            sys.exit(1)
+
+        result = evaluate(stats, calibration)
+        print_result(log, result, args.battery_mah, reference)
+        results[log] = result
+        if reference is None:
+            reference = result
+
+    if args.json:
+        with open(args.json, "w") as output_file:
+            json.dump(results, output_file, indent=4)
+        print("Generated %s" % args.json)
+
+
+if __name__ == "__main__":
+    main()
+
+# [] END OF FILE
@@ -0,0 +1,305 @@
+#******************************************************************************
+# File Name:   event_trace_to_json.py
+#
+# Description: Host-side converter for the event trace of proj_cm33_ns
+# (event_trace.c). Extracts the dump printed between EVENT_TRACE_BEGIN and
+# EVENT_TRACE_END from a captured terminal log and writes it in the Chrome
+# trace event JSON format, which ui.perfetto.dev and chrome://tracing open.
+# It also lists the longest periods the MCU stayed awake, with the time each
+# task and interrupt took in them.
+#
+# Usage:
+#   python event_trace_to_json.py terminal.log --output trace.json
+#   python event_trace_to_json.py terminal.log --output trace.json --awake 10
+#
+#******************************************************************************
+# Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+#******************************************************************************
+
+#!/usr/bin/python
+
+import argparse
+import json
+import sys
+
+# Event types, identifiers and names as defined in event_trace.h.
+TASK_SWITCH = 1
+ISR_ENTER = 2
+ISR_EXIT = 3
+SLEEP_BEGIN = 4
+SLEEP_END = 5
+NET_WAIT = 6
+NET_RESUME = 7
+SOCKET = 8
+USER = 9
+
+IRQ_NAMES = {1: "SDIO", 2: "Host wake", 3: "LPTimer"}
+SOCKET_NAMES = {1: "connect", 2: "disconnect", 3: "receive", 4: "send"}
+
+# Perfetto process IDs of the tracks.
+PID_TASKS = 1
+PID_INTERRUPTS = 2
+PID_POWER = 3
+PID_NETWORK = 4
+TID_SLEEP = 1
+TID_NET_SUSPEND = 2
+
+COUNTER_WRAP = 1 << 32
+US_PER_SECOND = 1000000.0
+
+
+def parse_dumps(lines):
+    """Returns a list of (frequency, task names, events) for every dump."""
+    dumps = []
+    current = None
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == "EVENT_TRACE_BEGIN":
+            current = (int(fields[1]), {}, [])
+        elif current is None:
+            continue
+        elif fields[0] == "EVENT_TRACE_END":
+            dumps.append(current)
+            current = None
+        elif fields[0] == "N" and len(fields) >= 3:
+            current[1][int(fields[1])] = " ".join(fields[2:])
+        elif fields[0] == "E" and len(fields) == 5:
+            current[2].append((int(fields[1], 16), int(fields[2]),
+                               int(fields[3]), int(fields[4])))
+    return dumps
+
+
+def unwrap_timestamps(events, frequency):
+    """Converts the 32-bit LPTimer counts into microseconds from the first
+    event, undoing counter wrap-around."""
+    result = []
+    offset = 0
+    previous = None
+    first = None
+    for count, kind, ident, arg in events:
+        if previous is not None and count < previous:
+            offset += COUNTER_WRAP
+        previous = count
+        absolute = count + offset
+        if first is None:
+            first = absolute
+        time_us = (absolute - first) * US_PER_SECOND / frequency
+        result.append((time_us, kind, ident, arg))
+    return result
+
+
+def task_name(names, number):
+    return names.get(number, "Task %d" % number)
+
+
+def build_trace(events, names):
+    """Returns the Chrome trace events for the unwrapped events."""
+    trace = []
+
+    def span(name, pid, tid, start, end, args=None):
+        item = {"name": name, "ph": "X", "pid": pid, "tid": tid,
+                "ts": start, "dur": max(end - start, 0.0)}
+        if args:
+            item["args"] = args
+        trace.append(item)
+
+    def meta(kind, pid, tid, name):
+        trace.append({"name": kind, "ph": "M", "pid": pid, "tid": tid,
+                      "args": {"name": name}})
+
+    meta("process_name", PID_TASKS, 0, "CM33 tasks")
+    meta("process_name", PID_INTERRUPTS, 0, "Interrupts")
+    meta("process_name", PID_POWER, 0, "Power")
+    meta("process_name", PID_NETWORK, 0, "Network")
+    meta("thread_name", PID_POWER, TID_SLEEP, "Low-power idle")
+    meta("thread_name", PID_POWER, TID_NET_SUSPEND, "wait_net_suspend")
+
+    running = None
+    isr_start = {}
+    sleep_start = None
+    wait_start = None
+    seen_tasks = set()
+    seen_irqs = set()
+    end_time = events[-1][0] if events else 0.0
+
+    for time_us, kind, ident, arg in events:
+        if kind == TASK_SWITCH:
+            if running is not None:
+                span(task_name(names, running[0]), PID_TASKS, running[0],
+                     running[1], time_us)
+            running = (ident, time_us)
+            seen_tasks.add(ident)
+        elif kind == ISR_ENTER:
+            isr_start[ident] = time_us
+            seen_irqs.add(ident)
+        elif kind == ISR_EXIT and ident in isr_start:
+            span(IRQ_NAMES.get(ident, "IRQ %d" % ident), PID_INTERRUPTS,
+                 ident, isr_start.pop(ident), time_us)
+        elif kind == SLEEP_BEGIN:
+            sleep_start = time_us
+        elif kind == SLEEP_END and sleep_start is not None:
+            span("Low-power idle", PID_POWER, TID_SLEEP, sleep_start, time_us)
+            sleep_start = None
+        elif kind == NET_WAIT:
+            wait_start = time_us
+        elif kind == NET_RESUME and wait_start is not None:
+            span("Suspended / waiting", PID_POWER, TID_NET_SUSPEND,
+                 wait_start, time_us)
+            wait_start = None
+        elif kind == SOCKET:
+            trace.append({"name": SOCKET_NAMES.get(ident, "socket %d" % ident),
+                          "ph": "i", "s": "t", "pid": PID_NETWORK, "tid": 1,
+                          "ts": time_us, "args": {"arg": arg}})
+        elif kind == USER:
+            trace.append({"name": "user %d" % ident, "ph": "i", "s": "g",
+                          "pid": PID_NETWORK, "tid": 1, "ts": time_us,
+                          "args": {"arg": arg}})
+
+    # Close what is still open at the end of the buffer.
+    if running is not None:
+        span(task_name(names, running[0]), PID_TASKS, running[0], running[1],
+             end_time)
+    if wait_start is not None:
+        span("Suspended / waiting", PID_POWER, TID_NET_SUSPEND, wait_start,
+             end_time)
+
+    for number in sorted(seen_tasks):
+        meta("thread_name", PID_TASKS, number, task_name(names, number))
+    for irq in sorted(seen_irqs):
+        meta("thread_name", PID_INTERRUPTS, irq,
+             IRQ_NAMES.get(irq, "IRQ %d" % irq))
+    meta("thread_name", PID_NETWORK, 1, "Socket events")
+
+    return trace
+
+
+def awake_periods(events, names):
+    """Returns (start, duration, breakdown) for every period between waking
+    from low-power idle and entering it again. A period starts at the
+    interrupt that woke the MCU, which runs before the idle task records the
+    end of the sleep. The breakdown maps task and interrupt names to the time
+    they took in the period."""
+    periods = []
+    wake_time = None
+    breakdown = {}
+    running = None
+    isr_start = {}
+    sleep_isrs = []
+
+    def account(name, duration):
+        breakdown[name] = breakdown.get(name, 0.0) + duration
+
+    for time_us, kind, ident, arg in events:
+        if kind == TASK_SWITCH:
+            if running is not None and wake_time is not None:
+                account(task_name(names, running[0]),
+                        time_us - max(running[1], wake_time))
+            running = (ident, time_us)
+        elif kind == ISR_ENTER:
+            isr_start[ident] = time_us
+        elif kind == ISR_EXIT and ident in isr_start:
+            start = isr_start.pop(ident)
+            if wake_time is not None:
+                account("ISR " + IRQ_NAMES.get(ident, str(ident)),
+                        time_us - start)
+            else:
+                sleep_isrs.append((ident, start, time_us))
+        elif kind == SLEEP_END:
+            breakdown = {}
+            wake_time = sleep_isrs[0][1] if sleep_isrs else time_us
+            for irq, start, end in sleep_isrs:
+                account("ISR " + IRQ_NAMES.get(irq, str(irq)), end - start)
+            sleep_isrs = []
+        elif kind == SLEEP_BEGIN:
+            sleep_isrs = []
+            if wake_time is None:
+                continue
+            if running is not None:
+                account(task_name(names, running[0]),
+                        time_us - max(running[1], wake_time))
+            periods.append((wake_time, time_us - wake_time, breakdown))
+            wake_time = None
+    return periods
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert an event trace dump into Chrome/Perfetto JSON")
+    parser.add_argument("log", help="Captured terminal output containing "
+                        "EVENT_TRACE_BEGIN ... EVENT_TRACE_END")
+    parser.add_argument("--output", help="JSON file to write. Without it "
+                        "only the summary is printed")
+    parser.add_argument("--dump", type=int, default=-1,
+                        help="Index of the dump to convert when the log "
+                        "holds several (default: the last one)")
+    parser.add_argument("--awake", type=int, default=5,
+                        help="Number of longest awake periods to list")
+    args = parser.parse_args()
+
+    with open(args.log, errors="replace") as log_file:
+        dumps = parse_dumps(log_file)
+
+    if not dumps:
+        print("ERROR: no complete EVENT_TRACE dump found in %s" % args.log)
+        sys.exit(1)
+
+    frequency, names, raw_events = dumps[args.dump]
+    events = unwrap_timestamps(raw_events, frequency)
+    print("Dump %d of %d: %d events, %.3f s, time stamp resolution %.1f us"
+          % (args.dump % len(dumps), len(dumps), len(events),
+             (events[-1][0] / US_PER_SECOND) if events else 0.0,
+             US_PER_SECOND / frequency))
+
+    periods = sorted(awake_periods(events, names), key=lambda p: -p[1])
+    if periods:
+        print("Longest awake periods:")
+        for start, duration, breakdown in periods[:args.awake]:
+            parts = sorted(breakdown.items(), key=lambda item: -item[1])
+            print("  at %10.3f ms: %8.3f ms  (%s)"
+                  % (start / 1000.0, duration / 1000.0,
+                     ", ".join("%s %.3f ms" % (name, time / 1000.0)
+                               for name, time in parts)))
+
+    if args.output:
+        with open(args.output, "w") as output_file:
+            json.dump({"traceEvents": build_trace(events, names),
+                       "displayTimeUnit": "ms"}, output_file)
+        print("Generated %s; open it in ui.perfetto.dev or chrome://tracing"
+              % args.output)
+
+
+if __name__ == "__main__":
+    main()
+
+# [] END OF FILE
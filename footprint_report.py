@@ -0,0 +1,425 @@
+#******************************************************************************
+# File Name:   footprint_report.py
+#
+# Description: Host-side flash and RAM footprint report for the three
+# projects of this application. Parses the GNU linker map files and breaks
+# the sizes down per component (lwIP, mbedTLS, WCM, LPA, FreeRTOS, and so on)
+# and per output section for each core. It can compare against a report
+# saved from a previous build, and fails when a budget in
+# configs/footprint_budget.json is exceeded. RAM retained in deep sleep has
+# its own budget.
+#
+# Usage:
+#   python footprint_report.py proj_cm33_s.map proj_cm33_ns.map proj_cm55.map
+#   python footprint_report.py *.map --budget configs/footprint_budget.json
+#   python footprint_report.py *.map --save new.json --diff old.json
+#   python footprint_report.py *.map --update-budget
+#
+# Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+#******************************************************************************
+
+#!/usr/bin/python
+
+import argparse
+import fnmatch
+import json
+import os
+import re
+import sys
+
+DEFAULT_BUDGET = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              "configs", "footprint_budget.json")
+
+# Components by path segment of the object or archive, first match wins. The
+# Wi-Fi core asset is named after its dependencies, so it comes first.
+COMPONENTS = (
+    ("Wi-Fi core", ("wifi-core-freertos-lwip-mbedtls",)),
+    ("lwIP", ("lwip", "lwip-freertos-integration",
+              "lwip-network-interface-integration")),
+    ("mbedTLS", ("mbedtls",)),
+    ("WCM", ("wifi-connection-manager",)),
+    ("WHD", ("wifi-host-driver", "whd-expansion", "whd-bsp-integration")),
+    ("LPA", ("lpa",)),
+    ("FreeRTOS", ("freertos",)),
+    ("Secure sockets", ("secure-sockets",)),
+    ("MQTT", ("mqtt", "coremqtt")),
+    ("RTOS abstraction", ("abstraction-rtos", "clib-support")),
+    ("Connectivity utilities", ("connectivity-utilities",)),
+    ("kv-store", ("kv-store",)),
+    ("retarget-io", ("retarget-io",)),
+    ("PDL/HAL/BSP", ("mtb-pdl-cat1", "mtb-hal-cat1", "mtb-hal-pse84", "mtb-srf",
+                     "core-lib", "cmsis", "bsps", "device-db")),
+)
+TOOLCHAIN_ARCHIVES = ("libc.a", "libc_nano.a", "libg.a", "libg_nano.a",
+                      "libgcc.a", "libm.a", "libnosys.a", "libstdc++.a")
+APPLICATION = "Application"
+OTHER_LIBRARIES = "Other libraries"
+TOOLCHAIN = "Toolchain libraries"
+FILL = "Alignment fill"
+RESERVED = "Reserved (heap, stack)"
+
+# Output sections that take no target memory.
+NON_ALLOCATED = (".debug*", ".comment", ".ARM.attributes", ".stab*",
+                 ".gnu.attributes", ".note.gnu.build-id", "/DISCARD/")
+
+OUTPUT_SECTION = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)"
+                            r"(?:\s+load address 0x([0-9a-fA-F]+))?")
+INPUT_SECTION = re.compile(r"^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(.*))?$")
+MEMORY_REGION = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(\S+))?")
+
+
+class Region(object):
+    def __init__(self, name, origin, length, attributes):
+        self.name = name
+        self.origin = origin
+        self.length = length
+        # Writable regions are RAM; the rest is flash (RRAM or external).
+        self.ram = "w" in attributes.lower() and "!w" not in attributes.lower()
+
+    def holds(self, address):
+        return self.origin <= address < self.origin + self.length
+
+
+def find_region(regions, address):
+    for region in regions:
+        if region.holds(address):
+            return region
+    return None
+
+
+def component_of(path):
+    """Maps an object or archive member path from the map to a component."""
+    if not path:
+        return RESERVED
+    path = path.replace("\\", "/")
+    archive = path.split("(")[0]
+    if os.path.basename(archive) in TOOLCHAIN_ARCHIVES:
+        return TOOLCHAIN
+    segments = set(re.split(r"[/()]", path))
+    for name, keys in COMPONENTS:
+        if segments.intersection(keys):
+            return name
+    return OTHER_LIBRARIES if archive.endswith(".a") else APPLICATION
+
+
+def join_wrapped(lines):
+    """Joins section names that the linker put on a line of their own."""
+    pending = None
+    for line in lines:
+        line = line.rstrip("\r\n")
+        if pending is not None:
+            if line.startswith(" ") and line.strip().startswith("0x"):
+                line = pending + " " + line.strip()
+                pending = None
+            else:
+                yield pending
+                pending = None
+        stripped = line.strip()
+        if (stripped and " " not in stripped and not stripped.startswith("*") and
+                not stripped.startswith("0x") and
+                (line.startswith(".") or line.startswith(" ."))):
+            pending = line
+            continue
+        yield line
+    if pending is not None:
+        yield pending
+
+
+def parse_map(lines):
+    """Returns (regions, sections) of a GNU ld map. Each section is a dict
+    with its name, region, load region and the input sections it holds as
+    (component, size) pairs."""
+    regions = []
+    sections = []
+    state = None
+    current = None
+
+    for line in join_wrapped(lines):
+        if line.startswith("Memory Configuration"):
+            state = "memory"
+            continue
+        if line.startswith("Linker script and memory map"):
+            state = "map"
+            continue
+        if line.startswith("OUTPUT(") or line.startswith("Cross Reference Table"):
+            break
+
+        if state == "memory":
+            match = MEMORY_REGION.match(line)
+            if match and match.group(1) not in ("Name", "*default*"):
+                regions.append(Region(match.group(1), int(match.group(2), 16),
+                                      int(match.group(3), 16), match.group(4) or ""))
+            continue
+        if state != "map":
+            continue
+
+        match = OUTPUT_SECTION.match(line)
+        if match:
+            name = match.group(1)
+            address = int(match.group(2), 16)
+            size = int(match.group(3), 16)
+            current = None
+            if size == 0 or any(fnmatch.fnmatch(name, pattern) for pattern in NON_ALLOCATED):
+                continue
+            region = find_region(regions, address)
+            if region is None:
+                continue
+            load = int(match.group(4), 16) if match.group(4) else address
+            current = {"name": name, "size": size, "region": region,
+                       "load": find_region(regions, load) if load != address else None,
+                       "inputs": []}
+            sections.append(current)
+            continue
+
+        if current is None:
+            continue
+        match = INPUT_SECTION.match(line)
+        if match:
+            size = int(match.group(3), 16)
+            if size == 0:
+                continue
+            if match.group(1) == "*fill*":
+                current["inputs"].append((FILL, size))
+            else:
+                current["inputs"].append((component_of(match.group(4)), size))
+
+    # Space an output section reserves without input sections, such as the
+    # heap and the stacks, is kept so that the totals match the sections.
+    for section in sections:
+        reserved = section["size"] - sum(size for _, size in section["inputs"])
+        if reserved > 0:
+            section["inputs"].append((RESERVED, reserved))
+
+    return regions, sections
+
+
+def summarize(sections, retained_regions):
+    """Adds up flash, RAM and retained RAM per component and per section."""
+    components = {}
+    by_section = {}
+    totals = {"flash": 0, "ram": 0, "retained": 0}
+
+    def add(table, key, kind, size):
+        entry = table.setdefault(key, {"flash": 0, "ram": 0, "retained": 0})
+        entry[kind] += size
+
+    for section in sections:
+        region = section["region"]
+        retained = region.ram and any(fnmatch.fnmatch(region.name, pattern)
+                                      for pattern in retained_regions)
+        key = "%s (%s)" % (section["name"], region.name)
+        for component, size in section["inputs"]:
+            kinds = []
+            if region.ram:
+                kinds.append("ram")
+                if retained:
+                    kinds.append("retained")
+                # Initialized data also takes its load image in flash.
+                if section["load"] is not None and not section["load"].ram:
+                    kinds.append("flash")
+            else:
+                kinds.append("flash")
+            for kind in kinds:
+                add(components, component, kind, size)
+                add(by_section, key, kind, size)
+                totals[kind] += size
+
+    return {"components": components, "sections": by_section, "totals": totals}
+
+
+def delta(value, previous):
+    if previous is None:
+        return "     new"
+    change = value - previous
+    return "%+8d" % change if change else "       ="
+
+
+def print_table(title, rows, previous, columns):
+    header = "  %-32s %10s %10s %10s" % (title, "Flash", "RAM", "Retained")
+    if previous is not None:
+        header += "  %8s %8s %8s" % ("+Flash", "+RAM", "+Retain")
+    print(header)
+    for name, entry in sorted(rows.items(), key=lambda item: (-item[1]["flash"] - item[1]["ram"],
+                                                              item[0])):
+        line = "  %-32s" % name[:32]
+        for column in columns:
+            line += " %10d" % entry[column]
+        if previous is not None:
+            old = previous.get(name)
+            line += "  " + " ".join(delta(entry[column], None if old is None else old[column])
+                                    for column in columns)
+        print(line)
+    if previous is not None:
+        for name in sorted(set(previous) - set(rows)):
+            print("  %-32s %10s %10s %10s  (removed)" % (name[:32], "-", "-", "-"))
+
+
+def print_report(project, report, previous):
+    print("%s" % project)
+    columns = ("flash", "ram", "retained")
+    print_table("Component", report["components"],
+                None if previous is None else previous["components"], columns)
+    totals = report["totals"]
+    line = "  %-32s %10d %10d %10d" % ("Total", totals["flash"], totals["ram"],
+                                        totals["retained"])
+    if previous is not None:
+        line += "  " + " ".join(delta(totals[c], previous["totals"][c]) for c in columns)
+    print(line)
+    print("")
+    print_table("Section (region)", report["sections"],
+                None if previous is None else previous["sections"], columns)
+    print("")
+
+
+BUDGET_LIMITS = (("flash", "flash"), ("ram", "ram"), ("retained-ram", "retained"))
+COMPONENT_LIMITS = (("flash", "flash"), ("ram", "ram"))
+
+
+def budgeted_totals(report):
+    """Totals without the reserved space: the heap takes whatever RAM the
+    linker script leaves, so it would make the RAM budgets meaningless."""
+    reserved = report["components"].get(RESERVED, {})
+    return dict((kind, report["totals"][kind] - reserved.get(kind, 0))
+                for _, kind in BUDGET_LIMITS)
+
+
+def check_budget(project, report, budget):
+    """Returns the list of budgets the report exceeds."""
+    exceeded = []
+    limits = BUDGET_LIMITS
+    totals = budgeted_totals(report)
+    for key, kind in limits:
+        limit = budget.get(key)
+        if limit is not None and totals[kind] > limit:
+            exceeded.append("%s: %s %d bytes exceeds the budget of %d"
+                            % (project, key, totals[kind], limit))
+    for component, component_budget in sorted(budget.get("components", {}).items()):
+        used = report["components"].get(component, {"flash": 0, "ram": 0, "retained": 0})
+        for key, kind in limits:
+            limit = component_budget.get(key)
+            if limit is not None and used[kind] > limit:
+                exceeded.append("%s: %s %s %d bytes exceeds the budget of %d"
+                                % (project, component, key, used[kind], limit))
+    return exceeded
+
+
+def update_budget(project, report, budget, margin_percent):
+    """Sets the budgets of a project to its footprint plus the margin,
+    rounded up to 1 KB: its flash, RAM and retained RAM, and the flash and
+    RAM of every component listed for it."""
+    def with_margin(used):
+        return (used * (100 + margin_percent) // 100 + 1023) // 1024 * 1024
+
+    totals = budgeted_totals(report)
+    for key, kind in BUDGET_LIMITS:
+        budget[key] = with_margin(totals[kind])
+    for component, component_budget in budget.get("components", {}).items():
+        used = report["components"].get(component, {"flash": 0, "ram": 0, "retained": 0})
+        for key, kind in COMPONENT_LIMITS:
+            component_budget[key] = with_margin(used[kind])
+    print("%s: budgets set to the footprint plus %d%%" % (project, margin_percent))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Report the flash and RAM footprint per component from linker map files")
+    parser.add_argument("maps", nargs="+", help="Linker map files, one per project; "
+                        "the project is named after the file")
+    parser.add_argument("--budget", default=DEFAULT_BUDGET,
+                        help="JSON budgets and retained regions (default: %(default)s)")
+    parser.add_argument("--no-budget", action="store_true",
+                        help="Report only; do not check the budgets")
+    parser.add_argument("--diff", help="Report saved by --save from a previous build "
+                        "to compare against")
+    parser.add_argument("--save", help="Write the report to this JSON file")
+    parser.add_argument("--update-budget", action="store_true",
+                        help="Set the budgets in the budget file to this footprint "
+                        "plus margin-percent instead of checking them")
+    args = parser.parse_args()
+
+    with open(args.budget) as budget_file:
+        budgets = json.load(budget_file)
+
+    previous = None
+    if args.diff:
+        with open(args.diff) as previous_file:
+            previous = json.load(previous_file)["projects"]
+
+    reports = {}
+    exceeded = []
+    for path in args.maps:
+        project = os.path.splitext(os.path.basename(path))[0]
+        budget = budgets.get("projects", {}).get(project, {})
+        with open(path, errors="replace") as map_file:
+            regions, sections = parse_map(map_file)
+        if not sections:
+            print("ERROR: %s has no allocated sections; is it a GNU ld map file?" % path)
+            sys.exit(1)
+
+        retained_regions = budget.get("retained-regions", ["*"])
+        if not any(region.ram and fnmatch.fnmatch(region.name, pattern)
+                   for region in regions for pattern in retained_regions):
+            print("ERROR: %s: no RAM region matches the retained regions %s"
+                  % (project, ", ".join(retained_regions)))
+            sys.exit(1)
+
+        reports[project] = summarize(sections, retained_regions)
+        print_report(project, reports[project],
+                     None if previous is None else previous.get(project))
+        if args.update_budget:
+            update_budget(project, reports[project], budget,
+                          budgets.get("margin-percent", 10))
+        elif not args.no_budget:
+            exceeded += check_budget(project, reports[project], budget)
+
+    if args.update_budget:
+        with open(args.budget, "w") as budget_file:
+            json.dump(budgets, budget_file, indent=4)
+            budget_file.write("\n")
+        print("Updated %s" % args.budget)
+
+    if args.save:
+        with open(args.save, "w") as output_file:
+            json.dump({"schema-version": 1.0, "projects": reports}, output_file,
+                      indent=4, sort_keys=True)
+        print("Generated %s" % args.save)
+
+    for line in exceeded:
+        print("BUDGET EXCEEDED: %s" % line)
+    if exceeded:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
+
+# [] END OF FILE
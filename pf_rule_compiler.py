@@ -0,0 +1,406 @@
+#******************************************************************************
+# File Name:   pf_rule_compiler.py
+#
+# Description: Host-side packet filter rule compiler. Reads a declarative
+# description of the traffic the application needs to receive and produces the
+# minimal, ordered set of WLAN firmware packet filter rules as a C source file
+# in the same format that the Device Configurator generates for the Low Power
+# Assistant (LPA) packet filter offload.
+#
+# Usage:
+#   python pf_rule_compiler.py configs/packet_filter_spec.json
+#   python pf_rule_compiler.py configs/packet_filter_spec.json \
+#          --hits pf_hits.json --output proj_cm33_ns/pf_compiled_rules
+#   python pf_rule_compiler.py configs/packet_filter_spec.json \
+#          --hits terminal.log --rules proj_cm33_ns/pf_compiled_rules.c
+#
+# With a terminal log of the PF_STATS build (pf_stats.c) as --hits, the
+# per-filter counters of the last PF_STATS line are mapped to traffic names
+# through the rule comments of the generated source.
+#
+#******************************************************************************
+# Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+#******************************************************************************
+
+#!/usr/bin/python
+
+import argparse
+import json
+import os
+import re
+import sys
+
+ETHERTYPE_IPV4 = 0x0800
+IP_PROTOCOL = {"icmp": 1, "tcp": 6, "udp": 17}
+MAX_PORT = 0xFFFF
+REPORT_TAG = "PF_STATS "
+MS_PER_MINUTE = 60000.0
+
+# LPA packet filter names used in the generated source.
+LPA_PROTOCOL = {"tcp": "CY_PF_PROTOCOL_TCP", "udp": "CY_PF_PROTOCOL_UDP"}
+LPA_DIRECTION = {"source": "PF_PN_PORT_SOURCE",
+                 "destination": "PF_PN_PORT_DEST"}
+LPA_ACTIVE_BITS = "CY_PF_ACTIVE_SLEEP | CY_PF_ACTIVE_WAKE"
+
+
+class Rule(object):
+    """One firmware packet filter rule. 'kind' is ethertype, iptype or port."""
+
+    def __init__(self, kind, value=0, proto=None, direction=None,
+                 low=0, high=0, rate=0.0, names=None):
+        self.kind = kind
+        self.value = value
+        self.proto = proto
+        self.direction = direction
+        self.low = low
+        self.high = high
+        self.rate = rate
+        self.names = list(names or [])
+
+    def key(self):
+        return (self.kind, self.value, self.proto, self.direction,
+                self.low, self.high)
+
+    def describe(self):
+        if self.kind == "ethertype":
+            return "ethertype 0x%04X" % self.value
+        if self.kind == "iptype":
+            return "ip protocol %d" % self.value
+        if self.low == self.high:
+            ports = "%d" % self.low
+        else:
+            ports = "%d-%d" % (self.low, self.high)
+        return "%s %s port %s" % (self.proto, self.direction, ports)
+
+
+def parse_int(value):
+    if isinstance(value, int):
+        return value
+    return int(str(value), 0)
+
+
+def parse_ports(value):
+    """Returns a list of (low, high) tuples for an int, "a-b" or a list."""
+    if isinstance(value, list):
+        ranges = []
+        for item in value:
+            ranges.extend(parse_ports(item))
+        return ranges
+    text = str(value)
+    if "-" in text:
+        low, high = text.split("-", 1)
+        low, high = parse_int(low), parse_int(high)
+    else:
+        low = high = parse_int(text)
+    if not (0 < low <= high <= MAX_PORT):
+        raise ValueError("invalid port range '%s'" % text)
+    return [(low, high)]
+
+
+def expand_entry(entry, hits):
+    """Expands one declarative traffic entry into unoptimized rules."""
+    name = entry.get("name", "unnamed")
+    rate = float(hits.get(name, entry.get("expected-rate", 0.0)))
+    rules = []
+
+    if "ethertype" in entry:
+        rules.append(Rule("ethertype", parse_int(entry["ethertype"]),
+                          rate=rate, names=[name]))
+    if "ip-protocol" in entry:
+        value = entry["ip-protocol"]
+        value = IP_PROTOCOL.get(str(value).lower(), value)
+        rules.append(Rule("iptype", parse_int(value), rate=rate, names=[name]))
+
+    # Frames from the remote peer carry the remote port as the source port and
+    # the local port as the destination port.
+    port_fields = (("remote-port", "source"), ("local-port", "destination"))
+    for field, direction in port_fields:
+        if field not in entry:
+            continue
+        proto = str(entry.get("protocol", "")).lower()
+        if proto not in LPA_PROTOCOL:
+            raise ValueError("'%s': port rules need protocol tcp or udp" % name)
+        for low, high in parse_ports(entry[field]):
+            rules.append(Rule("port", proto=proto, direction=direction,
+                              low=low, high=high, rate=rate, names=[name]))
+
+    if not rules:
+        raise ValueError("'%s': no ethertype, ip-protocol or port given" % name)
+    return rules
+
+
+def remove_duplicates(rules):
+    unique = {}
+    for rule in rules:
+        existing = unique.get(rule.key())
+        if existing is None:
+            unique[rule.key()] = rule
+        else:
+            existing.rate += rule.rate
+            existing.names.extend(rule.names)
+    return list(unique.values())
+
+
+def remove_subsumed(rules):
+    """Drops rules already covered by a broader ethertype or IP type rule."""
+    ipv4_kept = any(r.kind == "ethertype" and r.value == ETHERTYPE_IPV4
+                    for r in rules)
+    iptypes = set(r.value for r in rules if r.kind == "iptype")
+    kept, dropped = [], []
+    for rule in rules:
+        if rule.kind in ("iptype", "port") and ipv4_kept:
+            dropped.append(rule)
+        elif rule.kind == "port" and IP_PROTOCOL[rule.proto] in iptypes:
+            dropped.append(rule)
+        else:
+            kept.append(rule)
+    return kept, dropped
+
+
+def merge_port_ranges(rules):
+    """Merges overlapping or adjacent port ranges of the same protocol and
+    direction into a single rule."""
+    others = [r for r in rules if r.kind != "port"]
+    groups = {}
+    for rule in rules:
+        if rule.kind == "port":
+            groups.setdefault((rule.proto, rule.direction), []).append(rule)
+
+    merged = []
+    for group in groups.values():
+        group.sort(key=lambda r: (r.low, r.high))
+        current = group[0]
+        for rule in group[1:]:
+            if rule.low <= current.high + 1:
+                current = Rule("port", proto=current.proto,
+                               direction=current.direction, low=current.low,
+                               high=max(current.high, rule.high),
+                               rate=current.rate + rule.rate,
+                               names=current.names + rule.names)
+            else:
+                merged.append(current)
+                current = rule
+        merged.append(current)
+    return others + merged
+
+
+def order_rules(rules):
+    """Highest expected hit rate first. Ties keep the cheaper ethertype and
+    IP type rules ahead of port rules."""
+    kind_order = {"ethertype": 0, "iptype": 1, "port": 2}
+    return sorted(rules, key=lambda r: (-r.rate, kind_order[r.kind],
+                                        r.value, r.low))
+
+
+def compile_rules(spec, hits):
+    raw = []
+    for entry in spec.get("traffic", []):
+        raw.extend(expand_entry(entry, hits))
+    rules = remove_duplicates(raw)
+    rules, dropped = remove_subsumed(rules)
+    rules = merge_port_ranges(rules)
+    return raw, order_rules(rules), dropped
+
+
+def emit_c_rule(rule, filter_id):
+    lines = ["    {",
+             "        .feature = %s," % {
+                 "ethertype": "CY_PF_OL_FEAT_ETHTYPE",
+                 "iptype": "CY_PF_OL_FEAT_IPTYPE",
+                 "port": "CY_PF_OL_FEAT_PORTNUM"}[rule.kind],
+             "        .id = %d," % filter_id,
+             "        .bits = %s," % LPA_ACTIVE_BITS]
+    if rule.kind == "ethertype":
+        lines.append("        .u.eth = { .eth_type = 0x%04X }," % rule.value)
+    elif rule.kind == "iptype":
+        lines.append("        .u.ip = { .ip_type = %d }," % rule.value)
+    else:
+        lines += ["        .u.pf =",
+                  "        {",
+                  "            .proto = %s," % LPA_PROTOCOL[rule.proto],
+                  "            .direction = %s," % LPA_DIRECTION[rule.direction],
+                  "            .portnum.portnum = %d," % rule.low,
+                  "            .portnum.range = %d," % (rule.high - rule.low),
+                  "        },"]
+    lines.append("    },")
+    return lines
+
+
+def emit_source(rules, spec_path, basename):
+    symbol = "pf_compiled_rules"
+    guard = "%s_H_" % os.path.basename(basename).upper()
+    banner = ["/*" + "*" * 78,
+              "* File Name:   %s" % os.path.basename(basename),
+              "*",
+              "* Description: Packet filter offload rules generated by",
+              "* pf_rule_compiler.py from %s." % os.path.basename(spec_path),
+              "* Do not edit; regenerate from the traffic description instead.",
+              "*" * 79 + "/", ""]
+
+    header = banner[:]
+    header[1] += ".h"
+    header += ["#ifndef %s" % guard, "#define %s" % guard, "",
+               '#include "cy_pf_ol.h"', "",
+               "/* Number of rules, excluding the terminating entry. */",
+               "#define PF_COMPILED_RULE_COUNT                   (%dU)"
+               % len(rules), "",
+               "extern cy_pf_ol_cfg_t %s[];" % symbol, "",
+               "#endif /* %s */" % guard, ""]
+
+    source = banner[:]
+    source[1] += ".c"
+    source += ['#include "%s.h"' % os.path.basename(basename), "",
+               "/* Ordered by expected hit rate so the firmware matches the",
+               " * most frequent traffic with the fewest comparisons. */",
+               "cy_pf_ol_cfg_t %s[] =" % symbol, "{"]
+    for filter_id, rule in enumerate(rules):
+        source.append("    /* %s: %s */" % (", ".join(rule.names),
+                                            rule.describe()))
+        source += emit_c_rule(rule, filter_id)
+    source += ["    {", "        .feature = CY_PF_OL_FEAT_LAST,", "    },",
+               "};", "", "/* [] END OF FILE */", ""]
+    header.insert(-1, "/* [] END OF FILE */")
+    return "\n".join(header), "\n".join(source)
+
+
+def parse_rule_names(path):
+    """Returns filter ID to traffic names from a source generated by
+    emit_source()."""
+    with open(path) as source_file:
+        text = source_file.read()
+    pattern = re.compile(r"/\* ([^:*]+): [^*]*\*/\s*\{\s*\.feature = \w+,"
+                         r"\s*\.id = (\d+),")
+    return {int(match.group(2)): [name.strip() for name in
+                                  match.group(1).split(",")]
+            for match in pattern.finditer(text)}
+
+
+def hits_from_log(lines, rule_names):
+    """Converts the last PF_STATS line of a log into matched frames per
+    minute by traffic name. A merged rule shares its rate among its names."""
+    report = None
+    for line in lines:
+        start = line.find(REPORT_TAG)
+        if start < 0:
+            continue
+        try:
+            report = json.loads(line[start + len(REPORT_TAG):])
+        except ValueError:
+            continue
+    if report is None:
+        raise ValueError("no PF_STATS line found")
+
+    minutes = max(report["elapsed_ms"], 1) / MS_PER_MINUTE
+    hits = {}
+    print("Observed over %.1f min:" % minutes)
+    for entry in report["filters"]:
+        names = rule_names.get(entry["id"])
+        forwarded = (100.0 * entry["forwarded"] / entry["matched"]
+                     if entry["matched"] else 0.0)
+        print("  filter %-3d %-30s %8.2f matched/min, %5.1f%% forwarded"
+              % (entry["id"], ", ".join(names or ["(unknown)"]),
+                 entry["matched"] / minutes, forwarded))
+        for name in names or []:
+            hits[name] = hits.get(name, 0.0) + \
+                entry["matched"] / minutes / len(names)
+    return hits
+
+
+def load_hits(path, rules_path):
+    """Reads --hits: a JSON map, or a terminal log with PF_STATS lines."""
+    with open(path, errors="replace") as hits_file:
+        text = hits_file.read()
+    try:
+        return json.loads(text)
+    except ValueError:
+        pass
+    if not rules_path or not os.path.exists(rules_path):
+        raise ValueError("%s is a log; --rules must name the generated "
+                         "source its filter IDs come from" % path)
+    return hits_from_log(text.splitlines(), parse_rule_names(rules_path))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compile a traffic description into packet filter rules")
+    parser.add_argument("spec", help="JSON traffic description")
+    parser.add_argument("--hits", help="JSON map of traffic name to observed "
+                        "hit count, or a terminal log with PF_STATS lines; "
+                        "overrides 'expected-rate' for ordering")
+    parser.add_argument("--rules", help="Generated source the device runs, "
+                        "to name the filter IDs of a PF_STATS log (default: "
+                        "the --output source)")
+    parser.add_argument("--output", help="Base path for the generated .c/.h "
+                        "files. Without it only the report is printed")
+    parser.add_argument("--max-rules", type=int, default=0,
+                        help="Fail if more rules than the firmware supports")
+    args = parser.parse_args()
+
+    with open(args.spec) as spec_file:
+        spec = json.load(spec_file)
+    hits = {}
+    rules_path = args.rules or (args.output + ".c" if args.output else None)
+
+    try:
+        if args.hits:
+            hits = load_hits(args.hits, rules_path)
+        raw, rules, dropped = compile_rules(spec, hits)
+    except ValueError as error:
+        print("ERROR: %s" % error)
+        sys.exit(1)
+
+    print("Input rules : %d" % len(raw))
+    print("Output rules: %d" % len(rules))
+    for rule in dropped:
+        print("  removed (subsumed): %s" % rule.describe())
+    for filter_id, rule in enumerate(rules):
+        print("  [%d] %-40s rate %.2f" % (filter_id, rule.describe(),
+                                          rule.rate))
+
+    if args.max_rules and len(rules) > args.max_rules:
+        print("ERROR: %d rules exceed the limit of %d"
+              % (len(rules), args.max_rules))
+        sys.exit(1)
+
+    if args.output:
+        header, source = emit_source(rules, args.spec, args.output)
+        with open(args.output + ".h", "w") as header_file:
+            header_file.write(header)
+        with open(args.output + ".c", "w") as source_file:
+            source_file.write(source)
+        print("Generated %s.c and %s.h" % (args.output, args.output))
+
+
+if __name__ == "__main__":
+    main()
+
+# [] END OF FILE
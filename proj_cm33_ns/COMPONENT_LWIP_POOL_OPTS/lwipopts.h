@@ -0,0 +1,175 @@
+/*******************************************************************************
+* File Name:   lwipopts.h
+*
+* Description: This file contains the lwIP configuration of LWIP_POOL_PROFILE
+* and LWIP_POOL_STATS builds. It follows configs/lwipopts.h of the
+* wifi-core-freertos-lwip-mbedtls library, which the Makefile leaves out of
+* those builds only, so that this copy applies. The buffer and statistics
+* options are only defaults here, so that the settings in the Makefile take
+* effect. Other builds use the library copy unchanged. Compare this file with
+* the library copy when updating the library.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef LWIPOPTS_H_
+#define LWIPOPTS_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdlib.h>
+#include "whd_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Protocols
+*******************************************************************************/
+#define MEM_ALIGNMENT                            (4)
+
+#define LWIP_RAW                                 (1)
+#define LWIP_IPV4                                (1)
+#define LWIP_IPV6                                (1)
+#define LWIP_ICMP                                (1)
+#define LWIP_TCP                                 (1)
+#define LWIP_UDP                                 (1)
+#define LWIP_IGMP                                (1)
+
+#define LWIP_DHCP                                (1)
+#define LWIP_AUTOIP                              (1)
+#define LWIP_DHCP_AUTOIP_COOP                    (1)
+#define LWIP_DNS                                 (1)
+
+/* Pinned next hops; see arp_offload.c. */
+#define ETHARP_SUPPORT_STATIC_ENTRIES            (1)
+
+/*******************************************************************************
+* Socket and netif options
+*******************************************************************************/
+/* The C library does not provide errno; use the one from lwIP. */
+#define LWIP_PROVIDE_ERRNO                       (1)
+
+/* Use the timeval of the C library, not the one of lwIP. */
+#define LWIP_TIMEVAL_PRIVATE                     (0)
+
+#define LWIP_SO_SNDTIMEO                         (1)
+#define LWIP_SO_RCVTIMEO                         (1)
+#define SO_REUSE                                 (1)
+#define LWIP_TCP_KEEPALIVE                       (1)
+
+#define LWIP_NETIF_STATUS_CALLBACK               (1)
+#define LWIP_NETIF_LINK_CALLBACK                 (1)
+#define LWIP_NETIF_REMOVE_CALLBACK               (1)
+#define LWIP_NETIF_API                           (1)
+#define LWIP_NETIF_HOSTNAME                      (1)
+#define LWIP_NETIF_TX_SINGLE_PBUF                (1)
+
+#define LWIP_CHKSUM_ALGORITHM                    (3)
+#define LWIP_RAND()                              ((u32_t)rand())
+
+/*******************************************************************************
+* Threading
+*******************************************************************************/
+#define TCPIP_THREAD_STACKSIZE                   (4 * 1024)
+#define TCPIP_THREAD_PRIO                        (4)
+#define TCPIP_MBOX_SIZE                          (16)
+#define DEFAULT_UDP_RECVMBOX_SIZE                (16)
+#define DEFAULT_TCP_RECVMBOX_SIZE                (16)
+#define DEFAULT_RAW_RECVMBOX_SIZE                (16)
+#define DEFAULT_ACCEPTMBOX_SIZE                  (16)
+
+/* Other tasks call into the stack under LOCK_TCPIP_CORE(); see
+ * wake_dispatch.c and arp_offload.c.
+ */
+#define LWIP_TCPIP_CORE_LOCKING                  (1)
+#define LWIP_FREERTOS_CHECK_CORE_LOCKING         (1)
+
+/*******************************************************************************
+* Memory
+*******************************************************************************/
+/* Allocate from the C library heap instead of the lwIP heap. */
+#define MEM_LIBC_MALLOC                          (1)
+
+/* Leave room in front of every frame for the Ethernet and WHD headers. */
+#define PBUF_LINK_HLEN                           (WHD_PHYSICAL_HEADER)
+
+#define TCP_MSS                                  (WHD_PAYLOAD_MTU - 20 - 20)
+
+/* Buffer sizes; LWIP_POOL_PROFILE in the Makefile replaces them. */
+#ifndef PBUF_POOL_SIZE
+#define PBUF_POOL_SIZE                           (24)
+#endif
+
+#ifndef TCP_WND
+#define TCP_WND                                  (6 * TCP_MSS)
+#endif
+
+#ifndef TCP_SND_BUF
+#define TCP_SND_BUF                              (6 * TCP_MSS)
+#endif
+
+#ifndef TCP_SND_QUEUELEN
+#define TCP_SND_QUEUELEN                         ((4 * TCP_SND_BUF) / TCP_MSS)
+#endif
+
+#ifndef MEMP_NUM_TCP_SEG
+#define MEMP_NUM_TCP_SEG                         (TCP_SND_QUEUELEN)
+#endif
+
+/*******************************************************************************
+* Statistics
+*******************************************************************************/
+/* Off unless LWIP_POOL_STATS=1 turns them on in the Makefile. */
+#ifndef LWIP_STATS
+#define LWIP_STATS                               (0)
+#endif
+
+#ifndef MEMP_STATS
+#define MEMP_STATS                               (0)
+#endif
+
+/* With MEM_LIBC_MALLOC the lwIP heap is not used; its counters stay off. */
+#define MEM_STATS                                (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWIPOPTS_H_ */
+
+/* [] END OF FILE */
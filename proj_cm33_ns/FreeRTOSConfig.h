@@ -109,11 +109,55 @@ when application makefile has VFP_SELECT configured as softfloat */
 #define configUSE_MALLOC_FAILED_HOOK            1
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
-/* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+/* Run time and task stats gathering related definitions. Build with
+ * TASK_STATS=1 to count the run time with the LPTimer, which keeps running in
+ * tickless deep sleep. See task_stats.c.
+ */
+#ifndef TASK_STATS
+#define TASK_STATS                              0
+#endif
+#define configGENERATE_RUN_TIME_STATS           TASK_STATS
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
+#if (TASK_STATS) && (defined (__ICCARM__) || (__GNUC__))
+extern uint32_t task_stats_get_counter(void);
+extern void task_stats_sleep_begin(void);
+extern void task_stats_sleep_end(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        task_stats_get_counter()
+#define traceLOW_POWER_IDLE_BEGIN()             task_stats_sleep_begin()
+#define traceLOW_POWER_IDLE_END()               task_stats_sleep_end()
+#endif
+
+/* Event tracer hooks. Build with EVENT_TRACE=1 to record task switches and
+ * low-power idle into the trace buffer. See event_trace.c.
+ */
+#ifndef EVENT_TRACE
+#define EVENT_TRACE                             0
+#endif
+
+#if (EVENT_TRACE) && (defined (__ICCARM__) || (__GNUC__))
+extern void event_trace_task_create(uint32_t number, const char *name);
+extern void event_trace_task_switched_in(uint32_t number);
+extern void event_trace_sleep_begin(void);
+extern void event_trace_sleep_end(void);
+#define traceTASK_CREATE(pxNewTCB)              event_trace_task_create((pxNewTCB)->uxTCBNumber, \
+                                                                        (pxNewTCB)->pcTaskName)
+#define traceTASK_SWITCHED_IN()                 event_trace_task_switched_in(pxCurrentTCB->uxTCBNumber)
+#if (TASK_STATS)
+#undef traceLOW_POWER_IDLE_BEGIN
+#undef traceLOW_POWER_IDLE_END
+#define traceLOW_POWER_IDLE_BEGIN()             do { task_stats_sleep_begin(); \
+                                                     event_trace_sleep_begin(); } while (0)
+#define traceLOW_POWER_IDLE_END()               do { event_trace_sleep_end(); \
+                                                     task_stats_sleep_end(); } while (0)
+#else
+#define traceLOW_POWER_IDLE_BEGIN()             event_trace_sleep_begin()
+#define traceLOW_POWER_IDLE_END()               event_trace_sleep_end()
+#endif
+#endif
+
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES                   0
 #define configMAX_CO_ROUTINE_PRIORITIES         1
@@ -122,6 +166,7 @@ when application makefile has VFP_SELECT configured as softfloat */
 #define configUSE_TIMERS                        1
 #define configTIMER_TASK_PRIORITY               3
 #define configTIMER_QUEUE_LENGTH                10
+
 #define configTIMER_TASK_STACK_DEPTH            ( configMINIMAL_STACK_SIZE * 2 )
 
 
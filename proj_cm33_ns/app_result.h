@@ -0,0 +1,84 @@
+/*******************************************************************************
+* File Name:   app_result.h
+*
+* Description: This file contains the result module and code groups of the
+* cy_rslt_t values returned by the application modules, so that a failure
+* can be told apart from the middleware results it is reported next to.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef APP_RESULT_H_
+#define APP_RESULT_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Module identifier of the application results, above the identifiers used
+ * by the middleware libraries.
+ */
+#define APP_RSLT_MODULE                          (CY_RSLT_MODULE_MIDDLEWARE_BASE + 0xF0U)
+
+/* Code groups; the upper byte of the code identifies the source module. */
+#define APP_RSLT_GROUP_ARP_OFFLOAD               (0x01U)
+#define APP_RSLT_GROUP_MQTT_KA_OFFLOAD           (0x02U)
+#define APP_RSLT_GROUP_MQTT_CLIENT               (0x03U)
+#define APP_RSLT_GROUP_WOWL_PATTERN              (0x04U)
+#define APP_RSLT_GROUP_TLS_CLIENT                (0x05U)
+#define APP_RSLT_GROUP_TLS_MEM_POOL              (0x06U)
+#define APP_RSLT_GROUP_TASK_STATS                (0x07U)
+#define APP_RSLT_GROUP_CONFIG_STORE              (0x08U)
+#define APP_RSLT_GROUP_POWER_PROFILE             (0x09U)
+#define APP_RSLT_GROUP_WLAN_PS                   (0x0AU)
+#define APP_RSLT_GROUP_EVENT_TRACE               (0x0BU)
+#define APP_RSLT_GROUP_ENERGY_STATS              (0x0CU)
+#define APP_RSLT_GROUP_SERVER_FAILOVER           (0x0DU)
+#define APP_RSLT_GROUP_ASYNC_CONNECT             (0x0EU)
+#define APP_RSLT_GROUP_WAKE_DISPATCH             (0x0FU)
+#define APP_RSLT_GROUP_PF_STATS                  (0x10U)
+
+/* Error result with the given group and reason (1 to 255). */
+#define APP_RSLT_ERROR(group, reason)            CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, \
+                                                 APP_RSLT_MODULE, \
+                                                 (((group) << 8U) | (reason)))
+
+#endif /* APP_RESULT_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,457 @@
+/*******************************************************************************
+* File Name:   arp_offload.c
+*
+* Description: This file contains functions that program the WLAN firmware ARP
+* offload from the current lwIP network interface state and prewarm the lwIP
+* ARP cache for the gateway and the TCP server.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include "cyabs_rtos.h"
+#include <string.h>
+#include <inttypes.h>
+
+/* Wi-Fi connection manager and Wi-Fi host driver header files. */
+#include "cy_wcm.h"
+#include "whd_wifi_api.h"
+
+/* lwIP header files */
+#include "lwip/etharp.h"
+#include "lwip/tcpip.h"
+
+#include "arp_offload.h"
+
+#if (ARP_OFFLOAD_RUNTIME_CONFIG)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Firmware answers ARP requests for the host IP and for snooped peers, so that
+ * neither the host nor the peers need to wake the host MCU for ARP.
+ */
+#define ARP_OFFLOAD_FEATURES                     (ARP_OL_AGENT | ARP_OL_SNOOP | \
+                                                 ARP_OL_HOST_AUTO_REPLY | \
+                                                 ARP_OL_PEER_AUTO_REPLY)
+#define ARP_OFFLOAD_HOST_IP_COUNT                (1U)
+#define ARP_ENTRY_NOT_FOUND                      (-1)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static struct netif *arp_netif = NULL;
+static bool event_callback_registered = false;
+
+/* Set by the WCM event callback; the network task refreshes after resume. */
+static volatile bool refresh_pending = false;
+
+/* Destinations passed to arp_offload_prewarm(), prewarmed again on refresh. */
+static uint32_t prewarm_targets[ARP_OFFLOAD_MAX_TARGETS];
+static uint32_t prewarm_target_count = 0U;
+
+#if ETHARP_SUPPORT_STATIC_ENTRIES
+/* Next hops pinned in the lwIP ARP cache; the gateway plus on-link peers. */
+static ip4_addr_t pinned[ARP_OFFLOAD_MAX_TARGETS + 1U];
+static uint32_t pinned_count = 0U;
+#endif
+
+/*******************************************************************************
+* Function Name: unpin_all
+********************************************************************************
+* Summary:
+*  Removes the static ARP entries added by the prewarm, so that lwIP resolves
+*  the next hops again instead of sending to a MAC address that may no longer
+*  be on the network.
+*
+*******************************************************************************/
+static void unpin_all(void)
+{
+#if ETHARP_SUPPORT_STATIC_ENTRIES
+    LOCK_TCPIP_CORE();
+    for (uint32_t index = 0U; index < pinned_count; index++)
+    {
+        (void)etharp_remove_static_entry(&pinned[index]);
+    }
+    pinned_count = 0U;
+    UNLOCK_TCPIP_CORE();
+#endif
+}
+
+/*******************************************************************************
+* Function Name: pin
+********************************************************************************
+* Summary:
+*  Pins a resolved next hop so that it does not age out while the network
+*  stack is suspended. An entry pinned before is replaced.
+*
+*******************************************************************************/
+static void pin(const ip4_addr_t *next_hop, const struct eth_addr *eth)
+{
+#if ETHARP_SUPPORT_STATIC_ENTRIES
+    uint32_t index;
+
+    LOCK_TCPIP_CORE();
+    for (index = 0U; index < pinned_count; index++)
+    {
+        if (ip4_addr_cmp(&pinned[index], next_hop))
+        {
+            break;
+        }
+    }
+
+    if ((index < pinned_count) ||
+        (pinned_count < (sizeof(pinned) / sizeof(pinned[0]))))
+    {
+        if (ERR_OK == etharp_add_static_entry(next_hop, (struct eth_addr *)eth))
+        {
+            ip4_addr_copy(pinned[index], *next_hop);
+            pinned_count = (index < pinned_count) ? pinned_count : (pinned_count + 1U);
+        }
+    }
+    UNLOCK_TCPIP_CORE();
+#else
+    CY_UNUSED_PARAMETER(next_hop);
+    CY_UNUSED_PARAMETER(eth);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: wcm_event_callback
+********************************************************************************
+* Summary:
+*  Drops the pinned entries when the connection to the AP is lost or the IP
+*  address changes, and requests a refresh once the connection is back. The
+*  gateway and its MAC address may differ after a reconnect or a DHCP lease
+*  that moves the device to another subnet.
+*
+* Parameters:
+*  cy_wcm_event_t event: WCM event
+*  cy_wcm_event_data_t *event_data: Event data (unused)
+*
+*******************************************************************************/
+static void wcm_event_callback(cy_wcm_event_t event, cy_wcm_event_data_t *event_data)
+{
+    CY_UNUSED_PARAMETER(event_data);
+
+    switch (event)
+    {
+        case CY_WCM_EVENT_DISCONNECTED:
+            unpin_all();
+            break;
+
+        case CY_WCM_EVENT_RECONNECTED:
+            refresh_pending = true;
+            break;
+
+        case CY_WCM_EVENT_IP_CHANGED:
+            unpin_all();
+            refresh_pending = true;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: arp_cache_lookup
+********************************************************************************
+* Summary:
+*  Looks up an IPv4 address in the lwIP ARP cache and optionally issues an ARP
+*  request when the address is not cached.
+*
+* Parameters:
+*  struct netif *wifi: lwIP network interface
+*  const ip4_addr_t *addr: Address to look up
+*  struct eth_addr *eth_out: MAC address copied out on a cache hit
+*  bool send_request: Send an ARP request on a cache miss
+*
+* Return:
+*  bool: true if the address is in the ARP cache
+*
+*******************************************************************************/
+static bool arp_cache_lookup(struct netif *wifi, const ip4_addr_t *addr,
+                             struct eth_addr *eth_out, bool send_request)
+{
+    struct eth_addr *eth_ret = NULL;
+    const ip4_addr_t *ip_ret = NULL;
+    ssize_t index;
+
+    LOCK_TCPIP_CORE();
+    index = etharp_find_addr(wifi, addr, &eth_ret, &ip_ret);
+    if (ARP_ENTRY_NOT_FOUND != index)
+    {
+        memcpy(eth_out, eth_ret, sizeof(struct eth_addr));
+    }
+    else if (send_request)
+    {
+        etharp_request(wifi, addr);
+    }
+    UNLOCK_TCPIP_CORE();
+
+    return (ARP_ENTRY_NOT_FOUND != index);
+}
+
+/*******************************************************************************
+* Function Name: arp_offload_resolve
+********************************************************************************
+* Summary:
+*  Resolves the MAC address of the next hop towards the given IPv4 address,
+*  sending an ARP request and waiting up to ARP_PREWARM_TIMEOUT_MS if the entry
+*  is not already in the lwIP ARP cache.
+*
+* Parameters:
+*  struct netif *wifi: lwIP network interface
+*  uint32_t ipv4_addr: Destination IPv4 address in network byte order
+*  ip4_addr_t *next_hop: Next hop address (destination or gateway)
+*  struct eth_addr *eth: MAC address of the next hop
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the next hop was resolved
+*
+*******************************************************************************/
+cy_rslt_t arp_offload_resolve(struct netif *wifi, uint32_t ipv4_addr,
+                              ip4_addr_t *next_hop, struct eth_addr *eth)
+{
+    bool resolved;
+
+    ip4_addr_set_u32(next_hop, ipv4_addr);
+
+    /* Off-subnet traffic is sent to the gateway. */
+    if (!ip4_addr_netcmp(next_hop, netif_ip4_addr(wifi), netif_ip4_netmask(wifi)))
+    {
+        ip4_addr_copy(*next_hop, *netif_ip4_gw(wifi));
+    }
+
+    resolved = arp_cache_lookup(wifi, next_hop, eth, true);
+
+    for (uint32_t waited_ms = 0; (!resolved) && (waited_ms < ARP_PREWARM_TIMEOUT_MS);
+         waited_ms += ARP_PREWARM_POLL_INTERVAL_MS)
+    {
+        cy_rtos_delay_milliseconds(ARP_PREWARM_POLL_INTERVAL_MS);
+        resolved = arp_cache_lookup(wifi, next_hop, eth, false);
+    }
+
+    return resolved ? CY_RSLT_SUCCESS : ARP_OFFLOAD_RSLT_NOT_RESOLVED;
+}
+
+/*******************************************************************************
+* Function Name: prewarm_next_hop
+*******************************************************************************/
+static cy_rslt_t prewarm_next_hop(struct netif *wifi, uint32_t ipv4_addr)
+{
+    ip4_addr_t next_hop;
+    struct eth_addr eth;
+
+    if (CY_RSLT_SUCCESS != arp_offload_resolve(wifi, ipv4_addr, &next_hop, &eth))
+    {
+        printf("ARP prewarm: %s did not answer\n", ip4addr_ntoa(&next_hop));
+        return ARP_OFFLOAD_RSLT_NOT_RESOLVED;
+    }
+
+    pin(&next_hop, &eth);
+
+    printf("ARP prewarm: %s is at %02X:%02X:%02X:%02X:%02X:%02X\n",
+           ip4addr_ntoa(&next_hop), eth.addr[0], eth.addr[1], eth.addr[2],
+           eth.addr[3], eth.addr[4], eth.addr[5]);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: arp_offload_prewarm
+********************************************************************************
+* Summary:
+*  Resolves the next hop towards the given IPv4 address so that the first
+*  transmit after a network stack resume does not stall on ARP resolution. The
+*  ARP reply is also snooped by the WLAN firmware, which fills the peer
+*  auto-reply table. When lwIP supports static ARP entries the resolved entry
+*  is pinned so that it never ages out while the stack is suspended. The
+*  destination is remembered and prewarmed again after a reconnect, when the
+*  pinned entries have been dropped.
+*
+* Parameters:
+*  struct netif *wifi: lwIP network interface
+*  uint32_t ipv4_addr: Destination IPv4 address in network byte order
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the next hop was resolved
+*
+*******************************************************************************/
+cy_rslt_t arp_offload_prewarm(struct netif *wifi, uint32_t ipv4_addr)
+{
+    uint32_t index;
+
+    for (index = 0U; index < prewarm_target_count; index++)
+    {
+        if (ipv4_addr == prewarm_targets[index])
+        {
+            break;
+        }
+    }
+
+    if ((index == prewarm_target_count) && (prewarm_target_count < ARP_OFFLOAD_MAX_TARGETS))
+    {
+        prewarm_targets[prewarm_target_count++] = ipv4_addr;
+    }
+
+    return prewarm_next_hop(wifi, ipv4_addr);
+}
+
+/*******************************************************************************
+* Function Name: arp_offload_configure
+********************************************************************************
+* Summary:
+*  Programs the WLAN firmware ARP offload with the host IP address assigned to
+*  the lwIP network interface, enables host and peer auto-reply with snooping,
+*  and prewarms the ARP cache for the gateway. Call after connect_to_wifi_ap()
+*  succeeds; it is called again by arp_offload_poll() after a reconnect.
+*
+* Parameters:
+*  struct netif *wifi: lwIP network interface
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the ARP offload was programmed
+*
+*******************************************************************************/
+cy_rslt_t arp_offload_configure(struct netif *wifi)
+{
+    cy_rslt_t result;
+    whd_interface_t whd_ifp;
+    uint32_t host_ip = ip4_addr_get_u32(netif_ip4_addr(wifi));
+
+    arp_netif = wifi;
+    if (!event_callback_registered)
+    {
+        result = cy_wcm_register_event_callback(wcm_event_callback);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            printf("ARP offload: WCM event callback registration failed\n");
+            return result;
+        }
+        event_callback_registered = true;
+    }
+
+    result = cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &whd_ifp);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to get the WHD interface! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        return result;
+    }
+
+    /* Disable the agent while the host IP table and features are replaced. */
+    result = whd_arp_arpoe_set(whd_ifp, WHD_FALSE);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_arp_features_set(whd_ifp, ARP_OFFLOAD_FEATURES);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_arp_peerage_set(whd_ifp, ARP_OFFLOAD_PEER_AGE_SEC);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_arp_hostip_list_clear(whd_ifp);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_arp_hostip_list_add(whd_ifp, &host_ip, ARP_OFFLOAD_HOST_IP_COUNT);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        /* Drop entries snooped under a previous IP address. */
+        result = whd_arp_cache_clear(whd_ifp);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_arp_arpoe_set(whd_ifp, WHD_TRUE);
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("ARP offload configuration failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        return result;
+    }
+
+    printf("ARP offload configured for host IP %s\n", ip4addr_ntoa(netif_ip4_addr(wifi)));
+
+    /* A failed prewarm is not fatal; the entry is resolved on first use. */
+    (void)prewarm_next_hop(wifi, ip4_addr_get_u32(netif_ip4_gw(wifi)));
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: arp_offload_poll
+********************************************************************************
+* Summary:
+*  Called by the network task after each resume. After a reconnect or an IP
+*  address change, programs the ARP offload for the current host IP and
+*  prewarms the gateway and the destinations passed to arp_offload_prewarm()
+*  again. Waits for DHCP when the interface has no address yet.
+*
+*******************************************************************************/
+void arp_offload_poll(void)
+{
+    if ((!refresh_pending) || (NULL == arp_netif) ||
+        ip4_addr_isany_val(*netif_ip4_addr(arp_netif)))
+    {
+        return;
+    }
+
+    refresh_pending = false;
+
+    if (CY_RSLT_SUCCESS == arp_offload_configure(arp_netif))
+    {
+        for (uint32_t index = 0U; index < prewarm_target_count; index++)
+        {
+            (void)prewarm_next_hop(arp_netif, prewarm_targets[index]);
+        }
+    }
+}
+
+#endif /* (ARP_OFFLOAD_RUNTIME_CONFIG) */
+
+/* [] END OF FILE */
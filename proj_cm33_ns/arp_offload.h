@@ -0,0 +1,88 @@
+/*******************************************************************************
+* File Name:   arp_offload.h
+*
+* Description: This file contains declarations of functions that program the
+* WLAN firmware ARP offload and prewarm the lwIP ARP cache at runtime.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ARP_OFFLOAD_H_
+#define ARP_OFFLOAD_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include "lwip/netif.h"
+#include "lwip/etharp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to program the ARP offload from the lwIP network
+ * interface after the Wi-Fi connection instead of relying only on the static
+ * Device Configurator settings.
+ */
+#ifndef ARP_OFFLOAD_RUNTIME_CONFIG
+#define ARP_OFFLOAD_RUNTIME_CONFIG               (0U)
+#endif
+
+/* Age in seconds after which the firmware drops a snooped peer entry. */
+#define ARP_OFFLOAD_PEER_AGE_SEC                 (1200U)
+
+/* Time allowed for a prewarm ARP request to be answered. */
+#define ARP_PREWARM_TIMEOUT_MS                   (1000U)
+#define ARP_PREWARM_POLL_INTERVAL_MS             (20U)
+
+/* Destinations remembered by arp_offload_prewarm() for a refresh. */
+#define ARP_OFFLOAD_MAX_TARGETS                  (4U)
+
+/* Results returned by this module. */
+#define ARP_OFFLOAD_RSLT_NOT_RESOLVED            APP_RSLT_ERROR(APP_RSLT_GROUP_ARP_OFFLOAD, 1U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t arp_offload_configure(struct netif *wifi);
+cy_rslt_t arp_offload_prewarm(struct netif *wifi, uint32_t ipv4_addr);
+cy_rslt_t arp_offload_resolve(struct netif *wifi, uint32_t ipv4_addr,
+                              ip4_addr_t *next_hop, struct eth_addr *eth);
+void arp_offload_poll(void);
+
+#endif /* ARP_OFFLOAD_H_ */
+
+/* [] END OF FILE */
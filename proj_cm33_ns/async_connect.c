@@ -0,0 +1,393 @@
+/*******************************************************************************
+* File Name:   async_connect.c
+*
+* Description: This file contains the asynchronous connect. cy_socket_connect()
+* blocks until the TCP handshake ends, so the connect runs in a worker task
+* and its outcome is handed to the owner from async_connect_poll(). An
+* attempt that passes its deadline or is cancelled is abandoned: its owner
+* moves on at once, and the worker closes the connection if it still comes
+* up. The next attempt starts as soon as the worker is free.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <stdio.h>
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "async_connect.h"
+#include "static_rtos.h"
+
+#if (ASYNC_CONNECT)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    OP_IDLE,                     /* Nothing in flight */
+    OP_QUEUED,                   /* Waiting for the worker */
+    OP_RUNNING,                  /* Worker is connecting; deadline running */
+    OP_DONE                      /* Outcome waiting for async_connect_poll() */
+} op_state_t;
+
+/* The attempt owned by the caller. Shared with the worker; accessed in
+ * critical sections.
+ */
+typedef struct
+{
+    volatile op_state_t state;
+    uint32_t id;
+    async_connect_fn_t connect;
+    void *connect_arg;
+    async_connect_callback_t callback;
+    void *callback_arg;
+    uint32_t deadline_ms;
+    TickType_t started;
+    cy_rslt_t result;
+    cy_socket_t socket_handle;
+} connect_op_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static connect_op_t op;
+static uint32_t next_id;
+static TaskHandle_t worker_task;
+static volatile bool worker_running;
+
+#if (STATIC_ALLOCATION_PROFILE)
+STATIC_RTOS_SECTION static StackType_t worker_stack[ASYNC_CONNECT_WORKER_STACK_SIZE];
+STATIC_RTOS_SECTION static StaticTask_t worker_tcb;
+#endif
+
+/*******************************************************************************
+* Function Name: claim_queued_op
+********************************************************************************
+* Summary:
+*  Takes the queued attempt, if any, and starts its deadline. Clears
+*  worker_running when there is none so that the next start notifies.
+*
+*******************************************************************************/
+static bool claim_queued_op(uint32_t *id, async_connect_fn_t *connect, void **connect_arg)
+{
+    bool claimed;
+
+    taskENTER_CRITICAL();
+    claimed = (OP_QUEUED == op.state);
+    if (claimed)
+    {
+        op.state = OP_RUNNING;
+        op.started = xTaskGetTickCount();
+        *id = op.id;
+        *connect = op.connect;
+        *connect_arg = op.connect_arg;
+    }
+    worker_running = claimed;
+    taskEXIT_CRITICAL();
+
+    return claimed;
+}
+
+/*******************************************************************************
+* Function Name: async_connect_worker_task
+********************************************************************************
+* Summary:
+*  Runs the queued attempts one after the other.
+*
+* Parameters:
+*  void *arg: Unused
+*
+*******************************************************************************/
+static void async_connect_worker_task(void *arg)
+{
+    uint32_t id;
+    async_connect_fn_t connect;
+    void *connect_arg;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    while (true)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (claim_queued_op(&id, &connect, &connect_arg))
+        {
+            cy_socket_t socket_handle = NULL;
+            cy_rslt_t result = connect(&socket_handle, connect_arg);
+            bool wanted;
+
+            taskENTER_CRITICAL();
+            wanted = (OP_RUNNING == op.state) && (id == op.id);
+            if (wanted)
+            {
+                op.result = result;
+                op.socket_handle = socket_handle;
+                op.state = OP_DONE;
+            }
+            taskEXIT_CRITICAL();
+
+            if (!wanted && (CY_RSLT_SUCCESS == result))
+            {
+                /* Timed out or cancelled meanwhile; nobody takes it. */
+                cy_socket_delete(socket_handle);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: async_connect_init
+********************************************************************************
+* Summary:
+*  Starts the connect worker.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the worker is running
+*
+*******************************************************************************/
+cy_rslt_t async_connect_init(void)
+{
+    if (NULL != worker_task)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+#if (STATIC_ALLOCATION_PROFILE)
+    worker_task = xTaskCreateStatic(async_connect_worker_task, "Connect",
+                                    ASYNC_CONNECT_WORKER_STACK_SIZE, NULL,
+                                    ASYNC_CONNECT_WORKER_PRIORITY, worker_stack, &worker_tcb);
+    static_rtos_account("Connect", sizeof(worker_stack) + sizeof(worker_tcb), true);
+#else
+    if (pdPASS != xTaskCreate(async_connect_worker_task, "Connect",
+                              ASYNC_CONNECT_WORKER_STACK_SIZE, NULL,
+                              ASYNC_CONNECT_WORKER_PRIORITY, &worker_task))
+    {
+        worker_task = NULL;
+    }
+#endif
+
+    if (NULL == worker_task)
+    {
+        printf("Failed to create the connect task\n");
+        return ASYNC_CONNECT_RSLT_TASK_FAILED;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: async_connect_start
+********************************************************************************
+* Summary:
+*  Queues a connect attempt and returns at once. The deadline counts from
+*  when the worker starts the attempt; an abandoned attempt that is still
+*  blocking the worker delays the start.
+*
+* Parameters:
+*  async_connect_fn_t connect: Blocking connect to run
+*  void *connect_arg: Argument of connect; must stay valid until it returns
+*  uint32_t deadline_ms: Time the attempt is given
+*  async_connect_callback_t callback: Called with the outcome
+*  void *callback_arg: Argument of callback
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the attempt is queued; an error if another
+*  attempt is in flight
+*
+*******************************************************************************/
+cy_rslt_t async_connect_start(async_connect_fn_t connect, void *connect_arg,
+                              uint32_t deadline_ms, async_connect_callback_t callback,
+                              void *callback_arg)
+{
+    bool notify;
+
+    if (NULL == worker_task)
+    {
+        return ASYNC_CONNECT_RSLT_NOT_STARTED;
+    }
+
+    taskENTER_CRITICAL();
+    if (OP_IDLE != op.state)
+    {
+        taskEXIT_CRITICAL();
+        return ASYNC_CONNECT_RSLT_BUSY;
+    }
+
+    op.id = ++next_id;
+    op.connect = connect;
+    op.connect_arg = connect_arg;
+    op.callback = callback;
+    op.callback_arg = callback_arg;
+    op.deadline_ms = deadline_ms;
+    op.socket_handle = NULL;
+    op.state = OP_QUEUED;
+    notify = !worker_running;
+    taskEXIT_CRITICAL();
+
+    if (notify)
+    {
+        xTaskNotifyGive(worker_task);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: async_connect_cancel
+********************************************************************************
+* Summary:
+*  Abandons the attempt in flight without calling its callback. A connection
+*  that was already made is closed. A socket the worker is still connecting
+*  on is left to the worker, which closes it once the connect returns; it is
+*  never closed under the blocked call.
+*
+*******************************************************************************/
+void async_connect_cancel(void)
+{
+    cy_socket_t orphan = NULL;
+
+    taskENTER_CRITICAL();
+    if ((OP_DONE == op.state) && (CY_RSLT_SUCCESS == op.result))
+    {
+        orphan = op.socket_handle;
+    }
+    op.state = OP_IDLE;
+    taskEXIT_CRITICAL();
+
+    if (NULL != orphan)
+    {
+        cy_socket_delete(orphan);
+    }
+}
+
+/*******************************************************************************
+* Function Name: async_connect_in_flight
+*******************************************************************************/
+bool async_connect_in_flight(void)
+{
+    return (OP_IDLE != op.state);
+}
+
+/*******************************************************************************
+* Function Name: async_connect_time_left_ms
+********************************************************************************
+* Summary:
+*  Time until async_connect_poll() has something to report at the latest:
+*  zero if the outcome is in, the rest of the deadline while connecting, and
+*  ASYNC_CONNECT_NO_DEADLINE when nothing is in flight.
+*
+*******************************************************************************/
+uint32_t async_connect_time_left_ms(void)
+{
+    uint32_t left = ASYNC_CONNECT_NO_DEADLINE;
+
+    taskENTER_CRITICAL();
+    switch (op.state)
+    {
+        case OP_DONE:
+            left = 0U;
+            break;
+
+        case OP_RUNNING:
+        {
+            uint32_t elapsed = (uint32_t)((xTaskGetTickCount() - op.started) * portTICK_PERIOD_MS);
+
+            left = (elapsed < op.deadline_ms) ? (op.deadline_ms - elapsed) : 0U;
+            break;
+        }
+
+        case OP_QUEUED:
+            left = op.deadline_ms;
+            break;
+
+        case OP_IDLE:
+        default:
+            break;
+    }
+    taskEXIT_CRITICAL();
+
+    return left;
+}
+
+/*******************************************************************************
+* Function Name: async_connect_poll
+********************************************************************************
+* Summary:
+*  Calls the callback of an attempt that has finished or passed its deadline.
+*  Must be called from the task that owns the attempts; the callback may
+*  start the next one.
+*
+*******************************************************************************/
+void async_connect_poll(void)
+{
+    async_connect_callback_t callback = NULL;
+    void *callback_arg = NULL;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_socket_t socket_handle = NULL;
+
+    if (0U != async_connect_time_left_ms())
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    if (OP_DONE == op.state)
+    {
+        result = op.result;
+        socket_handle = op.socket_handle;
+    }
+    else
+    {
+        /* Deadline passed; the worker closes the socket if it connects. */
+        result = CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+    }
+    callback = op.callback;
+    callback_arg = op.callback_arg;
+    op.state = OP_IDLE;
+    taskEXIT_CRITICAL();
+
+    callback(result, socket_handle, callback_arg);
+}
+
+#endif /* ASYNC_CONNECT */
+
+/* [] END OF FILE */
@@ -0,0 +1,109 @@
+/*******************************************************************************
+* File Name:   async_connect.h
+*
+* Description: This file contains the configuration and declarations of the
+* asynchronous connect, which runs blocking secure sockets connects in a
+* worker task with a per-attempt deadline, a completion callback and
+* cancellation.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ASYNC_CONNECT_H_
+#define ASYNC_CONNECT_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include "cy_secure_sockets.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to connect to the TCP server in the background so
+ * that the network task keeps suspending the network stack meanwhile.
+ */
+#ifndef ASYNC_CONNECT
+#define ASYNC_CONNECT                            (0U)
+#endif
+
+/* Time an attempt is given before it is reported as timed out. */
+#define ASYNC_CONNECT_DEADLINE_MS                (10000U)
+
+/* The worker runs above the network task so that a finished connect is
+ * recorded before the network task resumes on the traffic that ended it.
+ */
+#define ASYNC_CONNECT_WORKER_STACK_SIZE          (1024U * 2U)
+#define ASYNC_CONNECT_WORKER_PRIORITY            (2U)
+
+/* Returned by async_connect_time_left_ms() when nothing is in flight. */
+#define ASYNC_CONNECT_NO_DEADLINE                (0xFFFFFFFFUL)
+
+/* Results returned by this module. */
+#define ASYNC_CONNECT_RSLT_TASK_FAILED           APP_RSLT_ERROR(APP_RSLT_GROUP_ASYNC_CONNECT, 1U)
+#define ASYNC_CONNECT_RSLT_NOT_STARTED           APP_RSLT_ERROR(APP_RSLT_GROUP_ASYNC_CONNECT, 2U)
+#define ASYNC_CONNECT_RSLT_BUSY                  APP_RSLT_ERROR(APP_RSLT_GROUP_ASYNC_CONNECT, 3U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Blocking connect run in the worker. It returns the connected socket, or
+ * closes what it opened and returns an error.
+ */
+typedef cy_rslt_t (*async_connect_fn_t)(cy_socket_t *socket_handle, void *arg);
+
+/* Outcome of an attempt, called from async_connect_poll(). The socket is
+ * only valid on success; it then belongs to the callback.
+ */
+typedef void (*async_connect_callback_t)(cy_rslt_t result, cy_socket_t socket_handle,
+                                         void *arg);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t async_connect_init(void);
+cy_rslt_t async_connect_start(async_connect_fn_t connect, void *connect_arg,
+                              uint32_t deadline_ms, async_connect_callback_t callback,
+                              void *callback_arg);
+void async_connect_cancel(void);
+bool async_connect_in_flight(void);
+uint32_t async_connect_time_left_ms(void);
+void async_connect_poll(void);
+
+#endif /* ASYNC_CONNECT_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,393 @@
+/*******************************************************************************
+* File Name:   boot_profile.c
+*
+* Description: This file contains the boot-phase timing profiler. Every
+* marker closes the phase that started at the previous marker.
+*
+* Timestamps are in microseconds from the start of the CM33 secure main().
+* The secure project starts the DWT cycle counter, which the non-secure
+* project keeps reading until the LPTimer is set up for tickless idle; from
+* then on the LPTimer is used, because the cycle counter stops in deep sleep.
+* The CM55 core writes its markers to shared memory relative to its own
+* main(), and they are placed on the same time line from the moment the CM55
+* core is enabled.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <string.h>
+#include <inttypes.h>
+
+#include "boot_profile.h"
+
+#if (BOOT_PROFILE)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define US_PER_SECOND                            (1000000UL)
+#define US_PER_MS                                (1000UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    uint64_t end_us;
+    bool wait;                 /* Phase waits for user input */
+} boot_profile_mark_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static boot_profile_mark_t marks[BOOT_PROFILE_MAX_MARKS];
+static uint32_t mark_count = 0U;
+static bool report_done = false;
+
+/* Time base state. */
+static uint32_t last_cycles = 0U;
+static uint64_t cycle_time_us = 0U;
+static mtb_hal_lptimer_t *profile_lptimer = NULL;
+static uint32_t lptimer_start;
+static uint64_t lptimer_base_us;
+
+/* Time at which the CM55 core was enabled. */
+static uint64_t cm55_origin_us = 0U;
+
+/* Filled by the CM33 secure project and the CM55 core, in the dedicated
+ * boot profile region.
+ */
+static volatile boot_profile_secure_record_t * const secure_record = &BOOT_PROFILE_SHARED->secure;
+static volatile boot_profile_cm55_record_t * const cm55_record = &BOOT_PROFILE_SHARED->cm55;
+
+/*******************************************************************************
+* Function Name: boot_profile_now_us
+********************************************************************************
+* Summary:
+*  Returns the time since the start of the CM33 secure main(). Each interval
+*  of the cycle counter is converted with the core clock at the time it is
+*  read, so a phase that changes the core clock is converted with the new
+*  clock.
+*
+* Return:
+*  uint64_t: Time in microseconds
+*
+*******************************************************************************/
+static uint64_t boot_profile_now_us(void)
+{
+    uint32_t cycles;
+    uint32_t frequency;
+
+    if (NULL != profile_lptimer)
+    {
+        frequency = Cy_SysClk_ClkLfGetFrequency();
+        return lptimer_base_us + (((uint64_t)(mtb_hal_lptimer_read(profile_lptimer) -
+                                   lptimer_start) * US_PER_SECOND) / frequency);
+    }
+
+    /* Start the counter if the secure project did not. */
+    if (0U == (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    cycles = DWT->CYCCNT;
+    cycle_time_us += ((uint64_t)(cycles - last_cycles) * US_PER_SECOND) / SystemCoreClock;
+    last_cycles = cycles;
+
+    return cycle_time_us;
+}
+
+/*******************************************************************************
+* Function Name: boot_profile_mark
+********************************************************************************
+* Summary:
+*  Closes the current boot phase. Does nothing after the report is printed,
+*  so the markers in the connection functions do not fire on reconnects.
+*
+* Parameters:
+*  const char *name: Name of the phase that ends now (string literal)
+*  bool wait: true if the phase waits for user input
+*
+*******************************************************************************/
+void boot_profile_mark(const char *name, bool wait)
+{
+    if ((!report_done) && (mark_count < BOOT_PROFILE_MAX_MARKS))
+    {
+        marks[mark_count].end_us = boot_profile_now_us();
+        marks[mark_count].name = name;
+        marks[mark_count].wait = wait;
+        mark_count++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: boot_profile_set_lptimer
+********************************************************************************
+* Summary:
+*  Switches the time base from the cycle counter to the LPTimer.
+*
+* Parameters:
+*  mtb_hal_lptimer_t *lptimer: Initialized LPTimer object
+*
+*******************************************************************************/
+void boot_profile_set_lptimer(mtb_hal_lptimer_t *lptimer)
+{
+    lptimer_base_us = boot_profile_now_us();
+    lptimer_start = mtb_hal_lptimer_read(lptimer);
+    profile_lptimer = lptimer;
+}
+
+/*******************************************************************************
+* Function Name: boot_profile_cm55_start
+********************************************************************************
+* Summary:
+*  Clears the shared CM55 record and records the time the CM55 core is
+*  enabled. Must be called right before Cy_SysEnableCM55().
+*
+*******************************************************************************/
+void boot_profile_cm55_start(void)
+{
+    cm55_record->magic = 0U;
+    cm55_record->count = 0U;
+    cm55_origin_us = boot_profile_now_us();
+}
+
+/*******************************************************************************
+* Function Name: print_phase
+********************************************************************************
+* Summary:
+*  Prints one row of the human-readable report.
+*
+*******************************************************************************/
+static void print_phase(const char *name, uint64_t start_us, uint64_t end_us, bool wait)
+{
+    printf("  %-28s %10"PRIu32" %10"PRIu32"%s\n", name,
+           (uint32_t)(end_us - start_us), (uint32_t)end_us,
+           wait ? "  (user input)" : "");
+}
+
+/*******************************************************************************
+* Function Name: secure_mark_end_us
+********************************************************************************
+* Summary:
+*  Converts the CM33 secure markers up to and including index to
+*  microseconds from the start of the CM33 secure main().
+*
+*******************************************************************************/
+static uint64_t secure_mark_end_us(uint32_t index)
+{
+    uint64_t end_us = 0U;
+    uint32_t previous = 0U;
+
+    for (uint32_t i = 0; i <= index; i++)
+    {
+        if (0U != secure_record->marks[i].clock_hz)
+        {
+            end_us += ((uint64_t)(secure_record->marks[i].cycles - previous) *
+                       US_PER_SECOND) / secure_record->marks[i].clock_hz;
+        }
+        previous = secure_record->marks[i].cycles;
+    }
+
+    return end_us;
+}
+
+/*******************************************************************************
+* Function Name: cm55_mark_end_us
+********************************************************************************
+* Summary:
+*  Converts the CM55 markers up to and including index to microseconds on the
+*  common time line.
+*
+*******************************************************************************/
+static uint64_t cm55_mark_end_us(uint32_t index)
+{
+    uint64_t end_us = cm55_origin_us;
+    uint32_t previous = 0U;
+
+    for (uint32_t i = 0; i <= index; i++)
+    {
+        if (0U != cm55_record->marks[i].clock_hz)
+        {
+            end_us += ((uint64_t)(cm55_record->marks[i].cycles - previous) *
+                       US_PER_SECOND) / cm55_record->marks[i].clock_hz;
+        }
+        previous = cm55_record->marks[i].cycles;
+    }
+
+    return end_us;
+}
+
+/*******************************************************************************
+* Function Name: boot_profile_report
+********************************************************************************
+* Summary:
+*  Closes the last phase and prints the duration and end time of every boot
+*  phase on the CM33 secure, CM33 non-secure and CM55 cores, and the time to
+*  online with and without the time spent waiting for user input. Only the
+*  first call prints the report.
+*
+*******************************************************************************/
+void boot_profile_report(void)
+{
+    uint64_t start_us = 0U;
+    uint64_t wait_us = 0U;
+    uint64_t online_us;
+    uint32_t secure_count;
+    uint32_t cm55_count;
+    bool cm55_valid;
+
+    if (report_done)
+    {
+        return;
+    }
+
+    report_done = true;
+    online_us = (0U != mark_count) ? marks[mark_count - 1U].end_us : 0U;
+
+    secure_count = (BOOT_PROFILE_SECURE_MAGIC == secure_record->magic) ?
+                   secure_record->count : 0U;
+    if (secure_count > BOOT_PROFILE_SECURE_MAX_MARKS)
+    {
+        secure_count = BOOT_PROFILE_SECURE_MAX_MARKS;
+    }
+
+    cm55_valid = (BOOT_PROFILE_CM55_MAGIC == cm55_record->magic);
+    cm55_count = cm55_valid ? cm55_record->count : 0U;
+    if (cm55_count > BOOT_PROFILE_CM55_MAX_MARKS)
+    {
+        cm55_count = BOOT_PROFILE_CM55_MAX_MARKS;
+    }
+
+    printf("\nBoot profile (us from CM33 secure main)\n");
+    printf("  %-28s %10s %10s\n", "Phase", "Duration", "End");
+    printf("CM33 secure:\n");
+    if (0U == secure_count)
+    {
+        printf("  No record from the secure project\n");
+    }
+
+    for (uint32_t i = 0; i < secure_count; i++)
+    {
+        uint64_t end_us = secure_mark_end_us(i);
+
+        print_phase((const char *)secure_record->marks[i].name, start_us, end_us, false);
+        start_us = end_us;
+    }
+
+    printf("CM33 non-secure:\n");
+
+    for (uint32_t i = 0; i < mark_count; i++)
+    {
+        print_phase(marks[i].name, start_us, marks[i].end_us, marks[i].wait);
+        if (marks[i].wait)
+        {
+            wait_us += marks[i].end_us - start_us;
+        }
+        start_us = marks[i].end_us;
+    }
+
+    printf("CM55 (in parallel):\n");
+    if (!cm55_valid)
+    {
+        printf("  No record from the CM55 core\n");
+    }
+
+    start_us = cm55_origin_us;
+    for (uint32_t i = 0; i < cm55_count; i++)
+    {
+        uint64_t end_us = cm55_mark_end_us(i);
+
+        print_phase((const char *)cm55_record->marks[i].name, start_us, end_us, false);
+        start_us = end_us;
+    }
+
+    printf("Time to online: %"PRIu32" ms, %"PRIu32" ms without user input\n\n",
+           (uint32_t)(online_us / US_PER_MS), (uint32_t)((online_us - wait_us) / US_PER_MS));
+
+#if (BOOT_PROFILE_MACHINE_READABLE)
+    start_us = 0U;
+    printf(BOOT_PROFILE_JSON_PREFIX "{\"version\":1,\"online_us\":%"PRIu32
+           ",\"online_without_wait_us\":%"PRIu32",\"cm33_s\":[",
+           (uint32_t)online_us, (uint32_t)(online_us - wait_us));
+
+    for (uint32_t i = 0; i < secure_count; i++)
+    {
+        uint64_t end_us = secure_mark_end_us(i);
+
+        printf("%s{\"phase\":\"%s\",\"start_us\":%"PRIu32",\"duration_us\":%"PRIu32"}",
+               (0U != i) ? "," : "", (const char *)secure_record->marks[i].name,
+               (uint32_t)start_us, (uint32_t)(end_us - start_us));
+        start_us = end_us;
+    }
+
+    printf("],\"cm33_ns\":[");
+
+    for (uint32_t i = 0; i < mark_count; i++)
+    {
+        printf("%s{\"phase\":\"%s\",\"start_us\":%"PRIu32",\"duration_us\":%"PRIu32
+               ",\"wait\":%s}", (0U != i) ? "," : "", marks[i].name,
+               (uint32_t)start_us, (uint32_t)(marks[i].end_us - start_us),
+               marks[i].wait ? "true" : "false");
+        start_us = marks[i].end_us;
+    }
+
+    printf("],\"cm55\":[");
+
+    start_us = cm55_origin_us;
+    for (uint32_t i = 0; i < cm55_count; i++)
+    {
+        uint64_t end_us = cm55_mark_end_us(i);
+
+        printf("%s{\"phase\":\"%s\",\"start_us\":%"PRIu32",\"duration_us\":%"PRIu32"}",
+               (0U != i) ? "," : "", (const char *)cm55_record->marks[i].name,
+               (uint32_t)start_us, (uint32_t)(end_us - start_us));
+        start_us = end_us;
+    }
+
+    printf("]}\n\n");
+#endif
+}
+
+#endif /* BOOT_PROFILE */
+
+/* [] END OF FILE */
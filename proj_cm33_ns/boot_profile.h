@@ -0,0 +1,86 @@
+/*******************************************************************************
+* File Name:   boot_profile.h
+*
+* Description: This file contains the configuration and declarations of the
+* boot-phase timing profiler, which breaks down the time from reset to the
+* first network connection.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BOOT_PROFILE_H_
+#define BOOT_PROFILE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "mtb_hal.h"
+
+/* Shared with the CM55 project; defines BOOT_PROFILE. */
+#include "boot_profile_shared.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to also print the report as a single JSON line that
+ * starts with BOOT_PROFILE_JSON_PREFIX, for parsing on a test bench.
+ */
+#ifndef BOOT_PROFILE_MACHINE_READABLE
+#define BOOT_PROFILE_MACHINE_READABLE            (0U)
+#endif
+
+#define BOOT_PROFILE_JSON_PREFIX                 "BOOT_PROFILE_JSON "
+#define BOOT_PROFILE_MAX_MARKS                   (24U)
+
+/* Boot markers; they compile to nothing unless BOOT_PROFILE is set. */
+#if (BOOT_PROFILE)
+#define BOOT_PROFILE_MARK(name)                  boot_profile_mark((name), false)
+#define BOOT_PROFILE_MARK_WAIT(name)             boot_profile_mark((name), true)
+#else
+#define BOOT_PROFILE_MARK(name)
+#define BOOT_PROFILE_MARK_WAIT(name)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void boot_profile_mark(const char *name, bool wait);
+void boot_profile_set_lptimer(mtb_hal_lptimer_t *lptimer);
+void boot_profile_cm55_start(void);
+void boot_profile_report(void);
+
+#endif /* BOOT_PROFILE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,561 @@
+/*******************************************************************************
+* File Name:   config_store.c
+*
+* Description: This file contains the persistent configuration store. The
+* settings are kept as key-value records in the kv-store library, which
+* appends every update and compacts into the other half of the region when
+* one half fills up, so writes are spread over the whole region. A small
+* block device maps the library onto RRAM.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <string.h>
+#include <inttypes.h>
+
+#include "config_store.h"
+#include "tls_client.h"
+
+#if (CONFIG_STORE)
+#include "mtb_kvstore.h"
+
+#if !defined(CYMEM_CM33_0_m33_kvstore_START) || !defined(CYMEM_CM33_0_m33_kvstore_SIZE)
+#error "CONFIG_STORE needs the m33_kvstore RRAM region in the Device Configurator memory configuration"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the buffer used to program erased RRAM. */
+#define RRAM_ERASE_CHUNK_SIZE                    (64U)
+#define RRAM_ERASED_VALUE                        (0xFFU)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Stored form of the network settings. */
+typedef struct
+{
+    uint32_t version;
+    config_store_net_t net;
+} net_record_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static cy_rslt_t rram_bd_read(void *context, uint32_t addr, uint32_t length,
+                              uint8_t *buf);
+static cy_rslt_t rram_bd_program(void *context, uint32_t addr, uint32_t length,
+                                 const uint8_t *buf);
+static cy_rslt_t rram_bd_erase(void *context, uint32_t addr, uint32_t length);
+static uint32_t rram_bd_read_size(void *context, uint32_t addr);
+static uint32_t rram_bd_program_size(void *context, uint32_t addr);
+static uint32_t rram_bd_erase_size(void *context, uint32_t addr);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static mtb_kvstore_bd_t rram_block_device =
+{
+    .read         = rram_bd_read,
+    .program      = rram_bd_program,
+    .erase        = rram_bd_erase,
+    .read_size    = rram_bd_read_size,
+    .program_size = rram_bd_program_size,
+    .erase_size   = rram_bd_erase_size,
+    .context      = NULL
+};
+
+static mtb_kvstore_t kvstore;
+static bool store_ready = false;
+
+/* Network settings in use: the defaults overlaid with the stored values. */
+static config_store_net_t net_config;
+
+/*******************************************************************************
+* Function Name: rram_bd_read
+********************************************************************************
+* Summary:
+*  Reads from the store region. RRAM is memory mapped, so this is a copy.
+*
+* Parameters:
+*  void *context: Unused
+*  uint32_t addr: Address to read from
+*  uint32_t length: Number of bytes to read
+*  uint8_t *buf: Destination buffer
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+static cy_rslt_t rram_bd_read(void *context, uint32_t addr, uint32_t length,
+                              uint8_t *buf)
+{
+    (void)context;
+
+    memcpy(buf, (const void *)addr, length);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: rram_bd_program
+********************************************************************************
+* Summary:
+*  Writes to the store region through the RRAM controller.
+*
+* Parameters:
+*  void *context: Unused
+*  uint32_t addr: Address to write to
+*  uint32_t length: Number of bytes to write
+*  const uint8_t *buf: Data to write
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the data is written
+*
+*******************************************************************************/
+static cy_rslt_t rram_bd_program(void *context, uint32_t addr, uint32_t length,
+                                 const uint8_t *buf)
+{
+    (void)context;
+
+    if (CY_RRAM_SUCCESS != Cy_RRAM_NvmWriteByteArray(RRAMC0, addr, buf, length))
+    {
+        return CONFIG_STORE_RSLT_WRITE_FAILED;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: rram_bd_erase
+********************************************************************************
+* Summary:
+*  RRAM is overwritten in place and has no erase operation; the range is
+*  programmed to the erased value the store expects instead.
+*
+* Parameters:
+*  void *context: Unused
+*  uint32_t addr: Start of the range
+*  uint32_t length: Length of the range
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the range is erased
+*
+*******************************************************************************/
+static cy_rslt_t rram_bd_erase(void *context, uint32_t addr, uint32_t length)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint8_t erased[RRAM_ERASE_CHUNK_SIZE];
+    uint32_t chunk;
+
+    memset(erased, RRAM_ERASED_VALUE, sizeof(erased));
+
+    while ((0U != length) && (CY_RSLT_SUCCESS == result))
+    {
+        chunk = (length < sizeof(erased)) ? length : sizeof(erased);
+        result = rram_bd_program(context, addr, chunk, erased);
+        addr += chunk;
+        length -= chunk;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: rram_bd_read_size
+********************************************************************************
+* Summary:
+*  Returns the read granularity of the store region.
+*
+*******************************************************************************/
+static uint32_t rram_bd_read_size(void *context, uint32_t addr)
+{
+    (void)context;
+    (void)addr;
+
+    return 1U;
+}
+
+/*******************************************************************************
+* Function Name: rram_bd_program_size
+********************************************************************************
+* Summary:
+*  Returns the program granularity of the store region.
+*
+*******************************************************************************/
+static uint32_t rram_bd_program_size(void *context, uint32_t addr)
+{
+    (void)context;
+    (void)addr;
+
+    return CONFIG_STORE_PROGRAM_SIZE;
+}
+
+/*******************************************************************************
+* Function Name: rram_bd_erase_size
+********************************************************************************
+* Summary:
+*  Returns the erase granularity of the store region.
+*
+*******************************************************************************/
+static uint32_t rram_bd_erase_size(void *context, uint32_t addr)
+{
+    (void)context;
+    (void)addr;
+
+    return CONFIG_STORE_ERASE_SIZE;
+}
+
+/*******************************************************************************
+* Function Name: make_net_record
+********************************************************************************
+* Summary:
+*  Builds the stored form of the network settings. Padding and unused string
+*  bytes are zeroed so that equal settings give equal records.
+*
+*******************************************************************************/
+static void make_net_record(net_record_t *record, const config_store_net_t *config)
+{
+    memset(record, 0, sizeof(*record));
+    record->version = CONFIG_STORE_NET_VERSION;
+    strncpy(record->net.ssid, config->ssid, sizeof(record->net.ssid) - 1U);
+    strncpy(record->net.password, config->password, sizeof(record->net.password) - 1U);
+    record->net.security = config->security;
+    record->net.server_ip = config->server_ip;
+    record->net.server_port = config->server_port;
+    record->net.keepalive_idle_ms = config->keepalive_idle_ms;
+    record->net.keepalive_interval_ms = config->keepalive_interval_ms;
+    record->net.keepalive_count = config->keepalive_count;
+    record->net.inactive_interval_ms = config->inactive_interval_ms;
+    record->net.inactive_window_ms = config->inactive_window_ms;
+}
+
+/*******************************************************************************
+* Function Name: read_net_record
+********************************************************************************
+* Summary:
+*  Reads the stored network settings.
+*
+* Return:
+*  bool: true if a record of the current version is stored
+*
+*******************************************************************************/
+static bool read_net_record(net_record_t *record)
+{
+    uint32_t size = sizeof(*record);
+
+    return (CY_RSLT_SUCCESS == mtb_kvstore_read(&kvstore, CONFIG_KEY_NET, (uint8_t *)record, &size)) &&
+           (sizeof(*record) == size) && (CONFIG_STORE_NET_VERSION == record->version);
+}
+
+/*******************************************************************************
+* Function Name: config_store_init
+********************************************************************************
+* Summary:
+*  Opens the store and loads the stored network settings. The defaults are
+*  used if no settings are stored, or if the store cannot be opened, in which
+*  case nothing is persisted.
+*
+* Parameters:
+*  const config_store_net_t *defaults: Settings used for missing keys
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the store is opened
+*
+*******************************************************************************/
+cy_rslt_t config_store_init(const config_store_net_t *defaults)
+{
+    cy_rslt_t result;
+    net_record_t record;
+
+    net_config = *defaults;
+
+    result = mtb_kvstore_init(&kvstore, CONFIG_STORE_RRAM_ADDR,
+                              CONFIG_STORE_RRAM_SIZE, &rram_block_device);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Configuration store init failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        return result;
+    }
+
+    store_ready = true;
+
+    if (read_net_record(&record))
+    {
+        net_config = record.net;
+        net_config.ssid[sizeof(net_config.ssid) - 1U] = '\0';
+        net_config.password[sizeof(net_config.password) - 1U] = '\0';
+    }
+
+    printf("Configuration store: %"PRIu32" bytes used of %"PRIu32"\n",
+           mtb_kvstore_size(&kvstore), (uint32_t)CONFIG_STORE_RRAM_SIZE);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: config_store_get_net
+********************************************************************************
+* Summary:
+*  Returns the network settings in use. The pointer stays valid and reflects
+*  later updates made through config_store_set_net().
+*
+* Return:
+*  const config_store_net_t*: Network settings
+*
+*******************************************************************************/
+const config_store_net_t *config_store_get_net(void)
+{
+    return &net_config;
+}
+
+/*******************************************************************************
+* Function Name: config_store_set_net
+********************************************************************************
+* Summary:
+*  Updates the network settings in use and persists them as one record, so
+*  that an interrupted update leaves the previous settings in place. Nothing
+*  is written if the settings are unchanged. Credentials and the server
+*  endpoint take effect on the next connection; the suspend window takes
+*  effect on the next suspend cycle.
+*
+* Parameters:
+*  const config_store_net_t *config: New network settings
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the settings are persisted
+*
+*******************************************************************************/
+cy_rslt_t config_store_set_net(const config_store_net_t *config)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    net_record_t record;
+    net_record_t stored;
+
+    net_config = *config;
+
+    if (!store_ready)
+    {
+        return CONFIG_STORE_RSLT_NOT_READY;
+    }
+
+    make_net_record(&record, config);
+
+    if (!read_net_record(&stored) || (0 != memcmp(&stored, &record, sizeof(record))))
+    {
+        result = mtb_kvstore_write(&kvstore, CONFIG_KEY_NET, (const uint8_t *)&record,
+                                   sizeof(record));
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Configuration store update failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: config_store_read
+********************************************************************************
+* Summary:
+*  Reads a value from the store.
+*
+* Parameters:
+*  const char *key: Key of the value
+*  void *data: Destination buffer
+*  uint32_t *size: In: size of the buffer. Out: length of the value
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the value is read
+*
+*******************************************************************************/
+cy_rslt_t config_store_read(const char *key, void *data, uint32_t *size)
+{
+    if (!store_ready)
+    {
+        return CONFIG_STORE_RSLT_NOT_READY;
+    }
+
+    return mtb_kvstore_read(&kvstore, key, (uint8_t *)data, size);
+}
+
+/*******************************************************************************
+* Function Name: config_store_write
+********************************************************************************
+* Summary:
+*  Writes a value to the store. Short values are compared with the stored
+*  copy first and left alone if unchanged, so repeated updates with the same
+*  value do not wear the RRAM.
+*
+* Parameters:
+*  const char *key: Key of the value
+*  const void *data: Value to write
+*  uint32_t size: Length of the value
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the value is stored
+*
+*******************************************************************************/
+cy_rslt_t config_store_write(const char *key, const void *data, uint32_t size)
+{
+    uint8_t stored[CONFIG_STORE_COMPARE_LEN];
+    uint32_t stored_size = 0U;
+
+    if (!store_ready)
+    {
+        return CONFIG_STORE_RSLT_NOT_READY;
+    }
+
+    if ((size <= sizeof(stored)) &&
+        (CY_RSLT_SUCCESS == mtb_kvstore_read(&kvstore, key, NULL, &stored_size)) &&
+        (stored_size == size) &&
+        (CY_RSLT_SUCCESS == mtb_kvstore_read(&kvstore, key, stored, &stored_size)) &&
+        (0 == memcmp(stored, data, size)))
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    return mtb_kvstore_write(&kvstore, key, (const uint8_t *)data, size);
+}
+
+/*******************************************************************************
+* Function Name: config_store_delete
+********************************************************************************
+* Summary:
+*  Removes a value from the store.
+*
+* Parameters:
+*  const char *key: Key of the value
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the value is removed
+*
+*******************************************************************************/
+cy_rslt_t config_store_delete(const char *key)
+{
+    if (!store_ready)
+    {
+        return CONFIG_STORE_RSLT_NOT_READY;
+    }
+
+    return mtb_kvstore_delete(&kvstore, key);
+}
+
+/*******************************************************************************
+* Function Name: config_store_reset
+********************************************************************************
+* Summary:
+*  Erases every stored value. The settings in use are left unchanged until
+*  the next boot, which falls back to the defaults.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the store is erased
+*
+*******************************************************************************/
+cy_rslt_t config_store_reset(void)
+{
+    if (!store_ready)
+    {
+        return CONFIG_STORE_RSLT_NOT_READY;
+    }
+
+    return mtb_kvstore_reset(&kvstore);
+}
+
+#if (TLS_CLIENT_MODE) && (TLS_SESSION_PERSIST)
+/*******************************************************************************
+* Function Name: tls_session_persist_save
+********************************************************************************
+* Summary:
+*  Stores the serialized TLS session in the configuration store. A zero
+*  length erases the stored session.
+*
+* Parameters:
+*  const uint8_t *data: Serialized session
+*  uint32_t length: Length of the serialized session
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the session is stored
+*
+*******************************************************************************/
+cy_rslt_t tls_session_persist_save(const uint8_t *data, uint32_t length)
+{
+    if (0U == length)
+    {
+        return config_store_delete(CONFIG_KEY_TLS_SESSION);
+    }
+
+    return config_store_write(CONFIG_KEY_TLS_SESSION, data, length);
+}
+
+/*******************************************************************************
+* Function Name: tls_session_persist_load
+********************************************************************************
+* Summary:
+*  Loads the serialized TLS session from the configuration store.
+*
+* Parameters:
+*  uint8_t *data: Buffer for the serialized session
+*  uint32_t size: Size of the buffer
+*  uint32_t *length: Length of the loaded session
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if a session is loaded
+*
+*******************************************************************************/
+cy_rslt_t tls_session_persist_load(uint8_t *data, uint32_t size, uint32_t *length)
+{
+    cy_rslt_t result;
+
+    *length = size;
+    result = config_store_read(CONFIG_KEY_TLS_SESSION, data, length);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        *length = 0U;
+    }
+
+    return result;
+}
+#endif /* TLS_CLIENT_MODE && TLS_SESSION_PERSIST */
+
+#endif /* CONFIG_STORE */
+
+/* [] END OF FILE */
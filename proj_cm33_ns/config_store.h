@@ -0,0 +1,125 @@
+/*******************************************************************************
+* File Name:   config_store.h
+*
+* Description: This file contains the configuration and declarations of the
+* persistent configuration store, which keeps the network credentials, the
+* server endpoint, and the keepalive and suspend-window settings in a
+* wear-leveled key-value store in RRAM.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CONFIG_STORE_H_
+#define CONFIG_STORE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include "cy_wcm.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to load the network settings from the configuration
+ * store instead of the compile-time defaults and the UART prompt.
+ */
+#ifndef CONFIG_STORE
+#define CONFIG_STORE                             (0U)
+#endif
+
+/* RRAM region holding the store: the "m33_kvstore" region of the memory
+ * configuration in the Device Configurator, carved out of the RRAM so that
+ * no image is linked into it. Its size must be a multiple of two erase units;
+ * the store alternates between the two halves as records are appended and
+ * compacted.
+ */
+#define CONFIG_STORE_RRAM_ADDR                   (CYMEM_CM33_0_m33_kvstore_START)
+#define CONFIG_STORE_RRAM_SIZE                   (CYMEM_CM33_0_m33_kvstore_SIZE)
+#define CONFIG_STORE_ERASE_SIZE                  (0x800UL)
+#define CONFIG_STORE_PROGRAM_SIZE                (16UL)
+
+/* Values up to this length are compared with the stored copy and only
+ * written when they differ.
+ */
+#define CONFIG_STORE_COMPARE_LEN                 (64U)
+
+/* The network settings are stored as one record under one key, so that an
+ * update is either stored completely or not at all. Bump the version when
+ * config_store_net_t changes; a record of another version is ignored.
+ */
+#define CONFIG_KEY_NET                           "net_cfg"
+#define CONFIG_STORE_NET_VERSION                 (1U)
+
+#define CONFIG_KEY_TLS_SESSION                   "tls_sess"
+#define CONFIG_KEY_POWER_PROFILE                 "pwr_prof"
+
+/* Results returned by this module. */
+#define CONFIG_STORE_RSLT_WRITE_FAILED           APP_RSLT_ERROR(APP_RSLT_GROUP_CONFIG_STORE, 1U)
+#define CONFIG_STORE_RSLT_NOT_READY              APP_RSLT_ERROR(APP_RSLT_GROUP_CONFIG_STORE, 2U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Network settings. A server_ip of zero means the address is not set. */
+typedef struct
+{
+    char ssid[CY_WCM_MAX_SSID_LEN + 1];
+    char password[CY_WCM_MAX_PASSPHRASE_LEN + 1];
+    cy_wcm_security_t security;
+    uint32_t server_ip;               /* IPv4 address, network byte order */
+    uint16_t server_port;
+    uint32_t keepalive_idle_ms;
+    uint32_t keepalive_interval_ms;
+    uint32_t keepalive_count;
+    uint32_t inactive_interval_ms;
+    uint32_t inactive_window_ms;
+} config_store_net_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t config_store_init(const config_store_net_t *defaults);
+const config_store_net_t *config_store_get_net(void);
+cy_rslt_t config_store_set_net(const config_store_net_t *config);
+cy_rslt_t config_store_read(const char *key, void *data, uint32_t *size);
+cy_rslt_t config_store_write(const char *key, const void *data, uint32_t size);
+cy_rslt_t config_store_delete(const char *key);
+cy_rslt_t config_store_reset(void);
+
+#endif /* CONFIG_STORE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,62 @@
+/*******************************************************************************
+* File Name:   core_mqtt_config.h
+*
+* Description: This file contains the coreMQTT configuration required by the
+* MQTT library used in the MQTT client mode.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CORE_MQTT_CONFIG_H_
+#define CORE_MQTT_CONFIG_H_
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* coreMQTT logging is disabled to keep the console free for the application. */
+#define LogError( message )
+#define LogWarn( message )
+#define LogInfo( message )
+#define LogDebug( message )
+
+/* Maximum number of outstanding QoS1/QoS2 publishes tracked by the library. */
+#define MQTT_STATE_ARRAY_MAX_COUNT               (10U)
+
+/* Time to wait for a PINGRESP sent in answer to a host generated PINGREQ. */
+#define MQTT_PINGRESP_TIMEOUT_MS                 (5000U)
+
+#endif /* CORE_MQTT_CONFIG_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,620 @@
+/*******************************************************************************
+* File Name:   energy_stats.c
+*
+* Description: This file contains the on-device energy accounting. The time
+* each core spends in Active, Sleep and Deep Sleep is counted by SysPm
+* callbacks on the LPTimer, the radio power-save time is read from the WLAN
+* firmware, and the traffic is counted on the lwIP network interface. The
+* ENERGY_STATS line printed by energy_stats_report() is converted into an
+* estimated charge by energy_model.py.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <inttypes.h>
+
+/* Wi-Fi connection manager and Wi-Fi host driver header files. */
+#include "cy_wcm.h"
+#include "whd_wifi_api.h"
+
+/* lwIP header files */
+#include "lwip/tcpip.h"
+
+#include "energy_stats.h"
+
+#if (ENERGY_STATS)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define MS_PER_SECOND                            (1000U)
+
+/* Run the residency callbacks last before and first after the transition. */
+#define ENERGY_STATS_CALLBACK_ORDER              (255U)
+
+#define ENERGY_STATS_CM55_READ_RETRIES           (4U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Time spent in one low-power mode. */
+typedef struct
+{
+    uint64_t entered_ticks;
+    uint64_t total_ticks;
+    uint32_t entries;
+} energy_residency_t;
+
+/* Cost of one kind of operation. The CM33 active time and the traffic are
+ * counted from energy_stats_op_begin() to energy_stats_op_end().
+ */
+typedef struct
+{
+    uint32_t count;
+    uint64_t active_ticks;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    bool open;
+    uint64_t begin_active_ticks;
+    uint32_t begin_tx_bytes;
+    uint32_t begin_rx_bytes;
+} energy_op_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static cy_en_syspm_status_t residency_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static mtb_hal_lptimer_t *stats_lptimer = NULL;
+static uint32_t last_lptimer_count;
+static uint64_t lptimer_ticks = 0U;
+static uint64_t start_ticks;
+static uint64_t last_report_ticks;
+
+static energy_residency_t sleep_residency;
+static energy_residency_t deepsleep_residency;
+
+static volatile uint32_t host_wakes = 0U;
+
+/* Traffic on the Wi-Fi interface, Ethernet frames as seen by lwIP. */
+static volatile uint32_t tx_bytes = 0U;
+static volatile uint32_t rx_bytes = 0U;
+static volatile uint32_t tx_packets = 0U;
+static volatile uint32_t rx_packets = 0U;
+static netif_input_fn wifi_input = NULL;
+static netif_linkoutput_fn wifi_linkoutput = NULL;
+
+/* Radio power-save time accumulated from the firmware counter. */
+static bool pm_dur_valid = false;
+static uint32_t last_pm_dur_ms;
+static uint64_t radio_ps_ms = 0U;
+
+static energy_op_stats_t op_stats[ENERGY_OP_COUNT];
+static const char *const op_names[ENERGY_OP_COUNT] =
+{
+    "keepalive",
+    "command",
+    "connect"
+};
+
+/* Written by the CM55 core; see energy_stats_shared.h. */
+CY_SECTION_SHAREDMEM static volatile energy_stats_cm55_record_t cm55_record;
+
+static cy_stc_syspm_callback_params_t sleep_params =
+{
+    .base    = NULL,
+    .context = &sleep_residency
+};
+
+static cy_stc_syspm_callback_params_t deepsleep_params =
+{
+    .base    = NULL,
+    .context = &deepsleep_residency
+};
+
+static cy_stc_syspm_callback_t sleep_callback =
+{
+    .callback       = residency_callback,
+    .type           = CY_SYSPM_SLEEP,
+    .skipMode       = 0U,
+    .callbackParams = &sleep_params,
+    .prevItm        = NULL,
+    .nextItm        = NULL,
+    .order          = ENERGY_STATS_CALLBACK_ORDER
+};
+
+static cy_stc_syspm_callback_t deepsleep_callback =
+{
+    .callback       = residency_callback,
+    .type           = CY_SYSPM_DEEPSLEEP,
+    .skipMode       = 0U,
+    .callbackParams = &deepsleep_params,
+    .prevItm        = NULL,
+    .nextItm        = NULL,
+    .order          = ENERGY_STATS_CALLBACK_ORDER
+};
+
+/*******************************************************************************
+* Function Name: now_ticks
+********************************************************************************
+* Summary:
+*  Returns the LPTimer count extended to 64 bits. The LPTimer keeps counting
+*  in deep sleep; the count is extended on every call, which happens at least
+*  on every wakeup.
+*
+* Return:
+*  uint64_t: LPTimer ticks, or 0 before the LPTimer is set up
+*
+*******************************************************************************/
+static uint64_t now_ticks(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint32_t count;
+    uint64_t ticks;
+
+    if (NULL != stats_lptimer)
+    {
+        count = mtb_hal_lptimer_read(stats_lptimer);
+        lptimer_ticks += (uint32_t)(count - last_lptimer_count);
+        last_lptimer_count = count;
+    }
+    ticks = lptimer_ticks;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    return ticks;
+}
+
+/*******************************************************************************
+* Function Name: ticks_to_ms
+********************************************************************************
+* Summary:
+*  Converts LPTimer ticks to milliseconds.
+*
+*******************************************************************************/
+static uint32_t ticks_to_ms(uint64_t ticks)
+{
+    return (uint32_t)((ticks * MS_PER_SECOND) / Cy_SysClk_ClkLfGetFrequency());
+}
+
+/*******************************************************************************
+* Function Name: cm33_active_ticks
+********************************************************************************
+* Summary:
+*  Returns the time the CM33 spent in Active mode since energy_stats_init().
+*
+*******************************************************************************/
+static uint64_t cm33_active_ticks(void)
+{
+    uint64_t now = now_ticks();
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint64_t low_power = sleep_residency.total_ticks + deepsleep_residency.total_ticks;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    return (now - start_ticks) - low_power;
+}
+
+/*******************************************************************************
+* Function Name: residency_callback
+********************************************************************************
+* Summary:
+*  SysPm callback for both Sleep and Deep Sleep. Notes the time the CM33
+*  enters the mode and adds the time spent in it on the way out.
+*
+* Parameters:
+*  cy_stc_syspm_callback_params_t *callback_params: context is the residency
+*  cy_en_syspm_callback_mode_t mode: Callback mode
+*
+* Return:
+*  cy_en_syspm_status_t: Always CY_SYSPM_SUCCESS
+*
+*******************************************************************************/
+static cy_en_syspm_status_t residency_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode)
+{
+    energy_residency_t *residency = (energy_residency_t *)callback_params->context;
+
+    if (CY_SYSPM_BEFORE_TRANSITION == mode)
+    {
+        residency->entered_ticks = now_ticks();
+    }
+    else if (CY_SYSPM_AFTER_TRANSITION == mode)
+    {
+        residency->total_ticks += now_ticks() - residency->entered_ticks;
+        residency->entries++;
+    }
+    else
+    {
+        /* Nothing to do for the readiness check and its rollback. */
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: counting_input
+********************************************************************************
+* Summary:
+*  Counts a frame received on the Wi-Fi interface and passes it to lwIP.
+*
+*******************************************************************************/
+static err_t counting_input(struct pbuf *p, struct netif *inp)
+{
+    rx_bytes += p->tot_len;
+    rx_packets++;
+
+    return wifi_input(p, inp);
+}
+
+/*******************************************************************************
+* Function Name: counting_linkoutput
+********************************************************************************
+* Summary:
+*  Counts a frame sent on the Wi-Fi interface and passes it to the driver.
+*
+*******************************************************************************/
+static err_t counting_linkoutput(struct netif *netif, struct pbuf *p)
+{
+    tx_bytes += p->tot_len;
+    tx_packets++;
+
+    return wifi_linkoutput(netif, p);
+}
+
+/*******************************************************************************
+* Function Name: update_radio_ps
+********************************************************************************
+* Summary:
+*  Adds the radio power-save time since the last call from the firmware
+*  counter. The counter restarts when the firmware re-associates, in which
+*  case its whole value is new time.
+*
+* Return:
+*  bool: true if the firmware reports the counter
+*
+*******************************************************************************/
+static bool update_radio_ps(void)
+{
+    whd_interface_t whd_ifp;
+    uint32_t pm_dur_ms;
+
+    if ((CY_RSLT_SUCCESS != cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &whd_ifp)) ||
+        (WHD_SUCCESS != whd_wifi_get_iovar_value(whd_ifp, ENERGY_STATS_PM_DUR_IOVAR, &pm_dur_ms)))
+    {
+        return false;
+    }
+
+    if (pm_dur_valid)
+    {
+        radio_ps_ms += (pm_dur_ms >= last_pm_dur_ms) ? (pm_dur_ms - last_pm_dur_ms) : pm_dur_ms;
+    }
+
+    last_pm_dur_ms = pm_dur_ms;
+    pm_dur_valid = true;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: read_cm55_record
+********************************************************************************
+* Summary:
+*  Takes a consistent copy of the CM55 record.
+*
+* Parameters:
+*  energy_stats_cm55_record_t *copy: Receives the record
+*
+* Return:
+*  bool: true if the CM55 has published a record
+*
+*******************************************************************************/
+static bool read_cm55_record(energy_stats_cm55_record_t *copy)
+{
+    uint32_t seq;
+
+    for (uint32_t retries = 0U; retries < ENERGY_STATS_CM55_READ_RETRIES; retries++)
+    {
+        seq = cm55_record.seq;
+        __DMB();
+
+        if ((ENERGY_STATS_CM55_MAGIC != cm55_record.magic) || (0U != (seq & 1U)))
+        {
+            continue;
+        }
+
+        copy->elapsed_ticks = cm55_record.elapsed_ticks;
+        copy->sleep_ticks = cm55_record.sleep_ticks;
+        copy->deepsleep_ticks = cm55_record.deepsleep_ticks;
+        copy->wakeups = cm55_record.wakeups;
+        __DMB();
+
+        if (seq == cm55_record.seq)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: energy_stats_set_lptimer
+********************************************************************************
+* Summary:
+*  Sets the LPTimer used to time the residency. This is the same timer that
+*  the RTOS abstraction library uses for tickless idle.
+*
+* Parameters:
+*  mtb_hal_lptimer_t *lptimer: Initialized LPTimer object
+*
+*******************************************************************************/
+void energy_stats_set_lptimer(mtb_hal_lptimer_t *lptimer)
+{
+    last_lptimer_count = mtb_hal_lptimer_read(lptimer);
+    stats_lptimer = lptimer;
+}
+
+/*******************************************************************************
+* Function Name: energy_stats_init
+********************************************************************************
+* Summary:
+*  Starts the accounting: registers the residency callbacks, hooks the traffic
+*  counters into the Wi-Fi interface and takes the radio power-save baseline.
+*  Call once the Wi-Fi device has joined the AP.
+*
+* Parameters:
+*  struct netif *wifi: lwIP network interface
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the accounting is running
+*
+*******************************************************************************/
+cy_rslt_t energy_stats_init(struct netif *wifi)
+{
+    if ((NULL == wifi) || (NULL == stats_lptimer))
+    {
+        printf("Energy stats: no network interface or LPTimer\n");
+        return ENERGY_STATS_RSLT_INIT_FAILED;
+    }
+
+    start_ticks = now_ticks();
+    last_report_ticks = start_ticks;
+
+    if (!Cy_SysPm_RegisterCallback(&sleep_callback) ||
+        !Cy_SysPm_RegisterCallback(&deepsleep_callback))
+    {
+        printf("Energy stats: SysPm callback registration failed\n");
+        return ENERGY_STATS_RSLT_INIT_FAILED;
+    }
+
+    LOCK_TCPIP_CORE();
+    wifi_input = wifi->input;
+    wifi_linkoutput = wifi->linkoutput;
+    wifi->input = counting_input;
+    wifi->linkoutput = counting_linkoutput;
+    UNLOCK_TCPIP_CORE();
+
+    if (!update_radio_ps())
+    {
+        printf("Energy stats: firmware does not report '%s', radio time not counted\n",
+               ENERGY_STATS_PM_DUR_IOVAR);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: energy_stats_note_host_wake
+********************************************************************************
+* Summary:
+*  Counts a host wake from the WLAN device. Called from the host wake
+*  interrupt.
+*
+*******************************************************************************/
+void energy_stats_note_host_wake(void)
+{
+    host_wakes++;
+}
+
+/*******************************************************************************
+* Function Name: energy_stats_op_begin
+********************************************************************************
+* Summary:
+*  Counts an operation and starts timing it. An operation that begins while
+*  one of the same kind is open is counted but timed with the open one.
+*
+* Parameters:
+*  energy_op_t op: Operation
+*
+*******************************************************************************/
+void energy_stats_op_begin(energy_op_t op)
+{
+    energy_op_stats_t *stats = &op_stats[op];
+
+    stats->count++;
+
+    if (!stats->open)
+    {
+        stats->begin_active_ticks = cm33_active_ticks();
+        stats->begin_tx_bytes = tx_bytes;
+        stats->begin_rx_bytes = rx_bytes;
+        stats->open = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: energy_stats_op_end
+********************************************************************************
+* Summary:
+*  Adds the CM33 active time and the traffic since energy_stats_op_begin()
+*  to the operation.
+*
+* Parameters:
+*  energy_op_t op: Operation
+*
+*******************************************************************************/
+void energy_stats_op_end(energy_op_t op)
+{
+    energy_op_stats_t *stats = &op_stats[op];
+
+    if (stats->open)
+    {
+        stats->active_ticks += cm33_active_ticks() - stats->begin_active_ticks;
+        stats->tx_bytes += tx_bytes - stats->begin_tx_bytes;
+        stats->rx_bytes += rx_bytes - stats->begin_rx_bytes;
+        stats->open = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: energy_stats_add_keepalives
+********************************************************************************
+* Summary:
+*  Counts keepalives the WLAN firmware sent on the host's behalf. They cost no
+*  host time; the energy model prices them from the calibration file.
+*
+* Parameters:
+*  uint32_t count: Number of keepalives
+*
+*******************************************************************************/
+void energy_stats_add_keepalives(uint32_t count)
+{
+    op_stats[ENERGY_OP_KEEPALIVE].count += count;
+}
+
+/*******************************************************************************
+* Function Name: energy_stats_poll
+********************************************************************************
+* Summary:
+*  Called by the network task after each resume. Prints the report every
+*  ENERGY_STATS_REPORT_INTERVAL_S seconds.
+*
+*******************************************************************************/
+void energy_stats_poll(void)
+{
+    uint64_t now = now_ticks();
+
+    if (ticks_to_ms(now - last_report_ticks) >=
+        (ENERGY_STATS_REPORT_INTERVAL_S * MS_PER_SECOND))
+    {
+        last_report_ticks = now;
+        energy_stats_report();
+    }
+}
+
+/*******************************************************************************
+* Function Name: energy_stats_report
+********************************************************************************
+* Summary:
+*  Prints the totals since energy_stats_init() as a single ENERGY_STATS line
+*  of JSON, the input of energy_model.py. Values that are not available are
+*  printed as null.
+*
+*******************************************************************************/
+void energy_stats_report(void)
+{
+    energy_stats_cm55_record_t cm55;
+    energy_residency_t sleep;
+    energy_residency_t deepsleep;
+    uint64_t elapsed_ticks;
+    uint32_t interrupt_state;
+
+    elapsed_ticks = now_ticks() - start_ticks;
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    sleep = sleep_residency;
+    deepsleep = deepsleep_residency;
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    printf("ENERGY_STATS {\"cm33\":{\"elapsed_ms\":%"PRIu32",\"active_ms\":%"PRIu32
+           ",\"sleep_ms\":%"PRIu32",\"deepsleep_ms\":%"PRIu32
+           ",\"sleeps\":%"PRIu32",\"deepsleeps\":%"PRIu32"},",
+           ticks_to_ms(elapsed_ticks),
+           ticks_to_ms(elapsed_ticks - sleep.total_ticks - deepsleep.total_ticks),
+           ticks_to_ms(sleep.total_ticks), ticks_to_ms(deepsleep.total_ticks),
+           sleep.entries, deepsleep.entries);
+
+    if (read_cm55_record(&cm55))
+    {
+        printf("\"cm55\":{\"elapsed_ms\":%"PRIu32",\"active_ms\":%"PRIu32
+               ",\"sleep_ms\":%"PRIu32",\"deepsleep_ms\":%"PRIu32",\"wakeups\":%"PRIu32"},",
+               ticks_to_ms(cm55.elapsed_ticks),
+               ticks_to_ms(cm55.elapsed_ticks - cm55.sleep_ticks - cm55.deepsleep_ticks),
+               ticks_to_ms(cm55.sleep_ticks), ticks_to_ms(cm55.deepsleep_ticks),
+               cm55.wakeups);
+    }
+    else
+    {
+        printf("\"cm55\":null,");
+    }
+
+    if (update_radio_ps())
+    {
+        printf("\"radio\":{\"ps_ms\":%"PRIu32",", (uint32_t)radio_ps_ms);
+    }
+    else
+    {
+        printf("\"radio\":{\"ps_ms\":null,");
+    }
+
+    printf("\"tx_bytes\":%"PRIu32",\"rx_bytes\":%"PRIu32",\"tx_packets\":%"PRIu32
+           ",\"rx_packets\":%"PRIu32",\"host_wakes\":%"PRIu32"},\"ops\":{",
+           tx_bytes, rx_bytes, tx_packets, rx_packets, host_wakes);
+
+    for (uint32_t i = 0U; i < (uint32_t)ENERGY_OP_COUNT; i++)
+    {
+        printf("%s\"%s\":{\"count\":%"PRIu32",\"active_ms\":%"PRIu32
+               ",\"tx_bytes\":%"PRIu32",\"rx_bytes\":%"PRIu32"}",
+               (0U == i) ? "" : ",", op_names[i], op_stats[i].count,
+               ticks_to_ms(op_stats[i].active_ticks),
+               op_stats[i].tx_bytes, op_stats[i].rx_bytes);
+    }
+
+    printf("}}\n");
+}
+
+#endif /* (ENERGY_STATS) */
+
+/* [] END OF FILE */
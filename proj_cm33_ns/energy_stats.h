@@ -0,0 +1,93 @@
+/*******************************************************************************
+* File Name:   energy_stats.h
+*
+* Description: This file contains declarations of the on-device energy
+* accounting: power-state residency per core, radio awake time, network
+* traffic, wakeups, and the cost of keepalives, commands and connects.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ENERGY_STATS_H_
+#define ENERGY_STATS_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include "mtb_hal.h"
+#include "lwip/netif.h"
+#include "energy_stats_shared.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Interval at which the network task prints the ENERGY_STATS line. */
+#define ENERGY_STATS_REPORT_INTERVAL_S           (300U)
+
+/* Firmware iovar that returns the time the radio spent in power save, in ms. */
+#define ENERGY_STATS_PM_DUR_IOVAR                "pm_dur"
+
+/* Results returned by this module. */
+#define ENERGY_STATS_RSLT_INIT_FAILED            APP_RSLT_ERROR(APP_RSLT_GROUP_ENERGY_STATS, 1U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Operations whose cost is accounted separately. */
+typedef enum
+{
+    ENERGY_OP_KEEPALIVE,
+    ENERGY_OP_COMMAND,
+    ENERGY_OP_CONNECT,
+    ENERGY_OP_COUNT
+} energy_op_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void energy_stats_set_lptimer(mtb_hal_lptimer_t *lptimer);
+cy_rslt_t energy_stats_init(struct netif *wifi);
+void energy_stats_note_host_wake(void);
+void energy_stats_op_begin(energy_op_t op);
+void energy_stats_op_end(energy_op_t op);
+void energy_stats_add_keepalives(uint32_t count);
+void energy_stats_poll(void);
+void energy_stats_report(void);
+
+#endif /* ENERGY_STATS_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,384 @@
+/*******************************************************************************
+* File Name:   event_trace.c
+*
+* Description: This file contains the event tracer. Events are 8-byte records
+* written into a RAM ring buffer from tasks, the kernel and interrupts, with
+* the LPTimer count as time stamp so that time spent in deep sleep is kept.
+* The buffer is dumped as text over the debug UART and converted into a
+* Chrome/Perfetto trace by event_trace_to_json.py.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <string.h>
+#include <inttypes.h>
+
+/* RTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "event_trace.h"
+#include "static_rtos.h"
+#include "task_stats.h"
+
+#if (EVENT_TRACE)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define EVENT_TRACE_INDEX_MASK                   (EVENT_TRACE_BUFFER_EVENTS - 1U)
+
+#if (0U != (EVENT_TRACE_BUFFER_EVENTS & EVENT_TRACE_INDEX_MASK))
+#error "EVENT_TRACE_BUFFER_EVENTS must be a power of two"
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t timestamp;                   /* LPTimer count */
+    uint8_t type;
+    uint8_t id;
+    uint16_t arg;
+} event_trace_event_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static mtb_hal_lptimer_t *trace_lptimer = NULL;
+
+static event_trace_event_t events[EVENT_TRACE_BUFFER_EVENTS];
+static uint32_t event_count = 0U;
+static volatile bool recording = true;
+
+/* Task names by FreeRTOS task number, kept for tasks that have been deleted
+ * by the time the trace is dumped.
+ */
+static char task_names[EVENT_TRACE_MAX_TASKS][EVENT_TRACE_TASK_NAME_LEN];
+
+/* Console task, woken by the debug UART receive interrupt. */
+static TaskHandle_t console_task_handle = NULL;
+
+#if (STATIC_ALLOCATION_PROFILE)
+STATIC_RTOS_SECTION static StackType_t console_task_stack[EVENT_TRACE_CONSOLE_STACK_SIZE];
+STATIC_RTOS_SECTION static StaticTask_t console_task_tcb;
+#endif
+
+/*******************************************************************************
+* Function Name: event_trace_set_lptimer
+********************************************************************************
+* Summary:
+*  Sets the LPTimer used for the time stamps. This is the same timer that the
+*  RTOS abstraction library uses for tickless idle. Events recorded before
+*  this is called have a time stamp of zero.
+*
+* Parameters:
+*  mtb_hal_lptimer_t *lptimer: Initialized LPTimer object
+*
+*******************************************************************************/
+void event_trace_set_lptimer(mtb_hal_lptimer_t *lptimer)
+{
+    trace_lptimer = lptimer;
+}
+
+/*******************************************************************************
+* Function Name: event_trace_record
+********************************************************************************
+* Summary:
+*  Appends an event, overwriting the oldest one when the buffer is full. Can
+*  be called from tasks, the kernel and interrupts.
+*
+* Parameters:
+*  uint8_t type: Event type (EVENT_TRACE_*)
+*  uint8_t id: Event identifier, depending on the type
+*  uint16_t arg: Event argument, depending on the type
+*
+*******************************************************************************/
+void event_trace_record(uint8_t type, uint8_t id, uint16_t arg)
+{
+    event_trace_event_t *event;
+    uint32_t interrupt_state;
+
+    if (!recording)
+    {
+        return;
+    }
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    event = &events[event_count & EVENT_TRACE_INDEX_MASK];
+    event->timestamp = (NULL != trace_lptimer) ? mtb_hal_lptimer_read(trace_lptimer) : 0U;
+    event->type = type;
+    event->id = id;
+    event->arg = arg;
+    event_count++;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: event_trace_task_create
+********************************************************************************
+* Summary:
+*  Called by the kernel when a task is created (traceTASK_CREATE).
+*
+* Parameters:
+*  uint32_t number: FreeRTOS task number
+*  const char *name: Task name
+*
+*******************************************************************************/
+void event_trace_task_create(uint32_t number, const char *name)
+{
+    if (number < EVENT_TRACE_MAX_TASKS)
+    {
+        strncpy(task_names[number], name, EVENT_TRACE_TASK_NAME_LEN - 1U);
+    }
+}
+
+/*******************************************************************************
+* Function Name: event_trace_task_switched_in
+********************************************************************************
+* Summary:
+*  Called by the kernel when a task starts running (traceTASK_SWITCHED_IN).
+*
+* Parameters:
+*  uint32_t number: FreeRTOS task number
+*
+*******************************************************************************/
+void event_trace_task_switched_in(uint32_t number)
+{
+    event_trace_record(EVENT_TRACE_TASK_SWITCH, (uint8_t)number, 0U);
+}
+
+/*******************************************************************************
+* Function Name: event_trace_sleep_begin
+********************************************************************************
+* Summary:
+*  Called by the idle task before it suppresses the tick and sleeps
+*  (traceLOW_POWER_IDLE_BEGIN).
+*
+*******************************************************************************/
+void event_trace_sleep_begin(void)
+{
+    event_trace_record(EVENT_TRACE_SLEEP_BEGIN, 0U, 0U);
+}
+
+/*******************************************************************************
+* Function Name: event_trace_sleep_end
+********************************************************************************
+* Summary:
+*  Called by the idle task after it wakes up (traceLOW_POWER_IDLE_END).
+*
+*******************************************************************************/
+void event_trace_sleep_end(void)
+{
+    event_trace_record(EVENT_TRACE_SLEEP_END, 0U, 0U);
+}
+
+/*******************************************************************************
+* Function Name: event_trace_dump
+********************************************************************************
+* Summary:
+*  Prints the task names and the buffered events, oldest first, between
+*  EVENT_TRACE_BEGIN and EVENT_TRACE_END lines. Recording stops while the
+*  dump is printed so that the UART traffic does not overwrite the events,
+*  and the buffer is emptied afterwards.
+*
+*******************************************************************************/
+void event_trace_dump(void)
+{
+    uint32_t first;
+    uint32_t index;
+    event_trace_event_t *event;
+
+    recording = false;
+
+    first = (event_count > EVENT_TRACE_BUFFER_EVENTS) ?
+            (event_count - EVENT_TRACE_BUFFER_EVENTS) : 0U;
+
+    printf("EVENT_TRACE_BEGIN %"PRIu32" %"PRIu32" %"PRIu32"\n",
+           Cy_SysClk_ClkLfGetFrequency(), event_count - first, first);
+
+    for (index = 0U; index < EVENT_TRACE_MAX_TASKS; index++)
+    {
+        if ('\0' != task_names[index][0])
+        {
+            printf("N %"PRIu32" %s\n", index, task_names[index]);
+        }
+    }
+
+    for (index = first; index < event_count; index++)
+    {
+        event = &events[index & EVENT_TRACE_INDEX_MASK];
+        printf("E %08"PRIx32" %u %u %u\n", event->timestamp, event->type,
+               event->id, event->arg);
+    }
+
+    printf("EVENT_TRACE_END\n");
+
+    event_count = 0U;
+    recording = true;
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_rx_interrupt_handler
+********************************************************************************
+* Summary:
+*  Wakes the console task when the debug UART has received data. The receive
+*  interrupt stays masked until the task has read the FIFO.
+*
+*******************************************************************************/
+static void debug_uart_rx_interrupt_handler(void)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    Cy_SCB_SetRxInterruptMask(CYBSP_DEBUG_UART_HW, 0U);
+    Cy_SCB_ClearRxInterrupt(CYBSP_DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+
+    vTaskNotifyGiveFromISR(console_task_handle, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*******************************************************************************
+* Function Name: event_trace_console_task
+********************************************************************************
+* Summary:
+*  Dumps the trace when EVENT_TRACE_KEY is received on the debug UART. With
+*  TASK_STATS, this task also serves TASK_STATS_KEY since only one task can
+*  read the UART. The task blocks until the receive interrupt wakes it, so
+*  idle periods in the trace are not broken up by console wakeups. The UART
+*  does not receive while the device is in deep sleep, so a key sent at that
+*  time may have to be repeated.
+*
+* Parameters:
+*  void *arg: Unused
+*
+*******************************************************************************/
+static void event_trace_console_task(void *arg)
+{
+    uint32_t value;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    console_task_handle = xTaskGetCurrentTaskHandle();
+
+    while (true)
+    {
+        while (0U != Cy_SCB_UART_GetNumInRxFifo(CYBSP_DEBUG_UART_HW))
+        {
+            value = Cy_SCB_UART_Get(CYBSP_DEBUG_UART_HW);
+            if (EVENT_TRACE_KEY == value)
+            {
+                event_trace_dump();
+            }
+#if (TASK_STATS)
+            else if (TASK_STATS_KEY == value)
+            {
+                task_stats_print();
+            }
+#endif
+        }
+
+        /* The interrupt is raised again at once if data arrived since the
+         * FIFO was read.
+         */
+        Cy_SCB_ClearRxInterrupt(CYBSP_DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+        Cy_SCB_SetRxInterruptMask(CYBSP_DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+/*******************************************************************************
+* Function Name: event_trace_start_console
+********************************************************************************
+* Summary:
+*  Starts the task that dumps the trace on demand and the debug UART receive
+*  interrupt that wakes it. Must be called after the application has
+*  finished reading its own input from the debug UART.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the task is created
+*
+*******************************************************************************/
+cy_rslt_t event_trace_start_console(void)
+{
+    BaseType_t created;
+    cy_stc_sysint_t uart_intr_cfg =
+    {
+        .intrSrc = CYBSP_DEBUG_UART_IRQ,
+        .intrPriority = EVENT_TRACE_UART_INTERRUPT_PRIORITY
+    };
+
+    /* The console task unmasks the receive interrupt once it runs. */
+    Cy_SCB_SetRxInterruptMask(CYBSP_DEBUG_UART_HW, 0U);
+    if (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&uart_intr_cfg, debug_uart_rx_interrupt_handler))
+    {
+        printf("Failed to set up the debug UART interrupt\n");
+        return EVENT_TRACE_RSLT_UART_FAILED;
+    }
+    NVIC_EnableIRQ(CYBSP_DEBUG_UART_IRQ);
+
+#if (STATIC_ALLOCATION_PROFILE)
+    created = (NULL != xTaskCreateStatic(event_trace_console_task, "Trace console",
+                                         EVENT_TRACE_CONSOLE_STACK_SIZE, NULL,
+                                         EVENT_TRACE_CONSOLE_PRIORITY,
+                                         console_task_stack, &console_task_tcb)) ? pdPASS : pdFAIL;
+    static_rtos_account("Trace console", sizeof(console_task_stack) +
+                        sizeof(console_task_tcb), true);
+#else
+    created = xTaskCreate(event_trace_console_task, "Trace console",
+                          EVENT_TRACE_CONSOLE_STACK_SIZE, NULL,
+                          EVENT_TRACE_CONSOLE_PRIORITY, NULL);
+#endif
+
+    if (pdPASS != created)
+    {
+        printf("Failed to create the trace console task\n");
+        return EVENT_TRACE_RSLT_TASK_FAILED;
+    }
+
+    printf("Press '%c' to dump the event trace\n", EVENT_TRACE_KEY);
+
+    return CY_RSLT_SUCCESS;
+}
+
+#endif /* EVENT_TRACE */
+
+/* [] END OF FILE */
@@ -0,0 +1,133 @@
+/*******************************************************************************
+* File Name:   event_trace.h
+*
+* Description: This file contains the configuration and declarations of the
+* event tracer, which records task switches, interrupts, low-power idle,
+* network suspend transitions and socket events into a RAM ring buffer that
+* is dumped over the debug UART.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef EVENT_TRACE_H_
+#define EVENT_TRACE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include "mtb_hal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Build with EVENT_TRACE=1 to record events. The same switch is read by
+ * FreeRTOSConfig.h.
+ */
+#ifndef EVENT_TRACE
+#define EVENT_TRACE                              (0U)
+#endif
+
+/* Number of events kept; must be a power of two. Each event takes 8 bytes. */
+#define EVENT_TRACE_BUFFER_EVENTS                (1024U)
+
+/* Key on the debug UART that dumps the trace. */
+#define EVENT_TRACE_KEY                          ('t')
+
+/* Priority of the debug UART receive interrupt that wakes the console task.
+ * It calls FreeRTOS, so it must not be above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+#define EVENT_TRACE_UART_INTERRUPT_PRIORITY      (7U)
+
+#define EVENT_TRACE_MAX_TASKS                    (16U)
+#define EVENT_TRACE_TASK_NAME_LEN                (16U)
+#define EVENT_TRACE_CONSOLE_STACK_SIZE           (configMINIMAL_STACK_SIZE * 2U)
+#define EVENT_TRACE_CONSOLE_PRIORITY             (tskIDLE_PRIORITY + 1U)
+
+/* Event types. The host converter (event_trace_to_json.py) uses the same
+ * numbers.
+ */
+#define EVENT_TRACE_TASK_SWITCH                  (1U)    /* id: task number */
+#define EVENT_TRACE_ISR_ENTER                    (2U)    /* id: EVENT_TRACE_IRQ_* */
+#define EVENT_TRACE_ISR_EXIT                     (3U)
+#define EVENT_TRACE_SLEEP_BEGIN                  (4U)
+#define EVENT_TRACE_SLEEP_END                    (5U)
+#define EVENT_TRACE_NET_WAIT                     (6U)    /* wait_net_suspend() called */
+#define EVENT_TRACE_NET_RESUME                   (7U)    /* wait_net_suspend() returned */
+#define EVENT_TRACE_SOCKET                       (8U)    /* id: EVENT_TRACE_SOCK_* */
+#define EVENT_TRACE_USER                         (9U)    /* id and arg: caller defined */
+
+#define EVENT_TRACE_IRQ_SDIO                     (1U)
+#define EVENT_TRACE_IRQ_HOST_WAKE                (2U)
+#define EVENT_TRACE_IRQ_LPTIMER                  (3U)
+
+#define EVENT_TRACE_SOCK_CONNECT                 (1U)    /* arg: 0 on success */
+#define EVENT_TRACE_SOCK_DISCONNECT              (2U)
+#define EVENT_TRACE_SOCK_RECEIVE                 (3U)    /* arg: length */
+#define EVENT_TRACE_SOCK_SEND                    (4U)    /* arg: length */
+
+/* Recording points that compile away when the tracer is disabled. */
+#if (EVENT_TRACE)
+#define EVENT_TRACE_RECORD(type, id, arg)        event_trace_record((type), (id), (arg))
+#else
+#define EVENT_TRACE_RECORD(type, id, arg)
+#endif
+
+#define EVENT_TRACE_ISR_BEGIN(irq)               EVENT_TRACE_RECORD(EVENT_TRACE_ISR_ENTER, (irq), 0U)
+#define EVENT_TRACE_ISR_END(irq)                 EVENT_TRACE_RECORD(EVENT_TRACE_ISR_EXIT, (irq), 0U)
+
+/* Results returned by this module. */
+#define EVENT_TRACE_RSLT_TASK_FAILED             APP_RSLT_ERROR(APP_RSLT_GROUP_EVENT_TRACE, 1U)
+#define EVENT_TRACE_RSLT_UART_FAILED             APP_RSLT_ERROR(APP_RSLT_GROUP_EVENT_TRACE, 2U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void event_trace_set_lptimer(mtb_hal_lptimer_t *lptimer);
+void event_trace_record(uint8_t type, uint8_t id, uint16_t arg);
+void event_trace_dump(void);
+cy_rslt_t event_trace_start_console(void);
+
+/* Hooks called by the FreeRTOS kernel, see FreeRTOSConfig.h. */
+void event_trace_task_create(uint32_t number, const char *name);
+void event_trace_task_switched_in(uint32_t number);
+void event_trace_sleep_begin(void);
+void event_trace_sleep_end(void);
+
+#endif /* EVENT_TRACE_H_ */
+
+/* [] END OF FILE */
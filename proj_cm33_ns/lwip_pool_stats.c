@@ -0,0 +1,351 @@
+/*******************************************************************************
+* File Name:   lwip_pool_stats.c
+*
+* Description: This file contains the lwIP memory pool statistics. The lwIP
+* statistics counters are sampled before each network suspend, when the
+* network stack resumes and after socket activity. Each sample updates the
+* high-water mark of every pool at that point and reports any new allocation
+* failure at once: an exhausted PBUF_POOL drops received frames, and an
+* exhausted TCP_SEG pool holds back sends, both of which are recovered by
+* retransmissions that wake the host again. The report prints the pool sizes
+* built in with the selected LWIP_POOL_PROFILE next to what was used, and an
+* LWIP_POOL_STATS line with the same figures.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include "cyabs_rtos.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* lwIP header files */
+#include "lwip/opt.h"
+#include "lwip/sys.h"
+#include "lwip/memp.h"
+#include "lwip/stats.h"
+
+#include "lwip_pool_stats.h"
+
+#if (LWIP_POOL_STATS)
+
+/* The Makefile turns the counters on; lwipopts.h must not turn them off. */
+#if !(LWIP_STATS && MEMP_STATS)
+#error "LWIP_POOL_STATS=1 needs LWIP_STATS and MEMP_STATS enabled in lwIP"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The lwIP heap has its own counters unless the C library heap is used. */
+#define HEAP_STATS                               (MEM_STATS && !MEM_LIBC_MALLOC)
+#define POOL_COUNT                               ((uint32_t)MEMP_MAX + HEAP_STATS)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t max_at[LWIP_POOL_STATS_POINTS];  /* High-water mark per sample point */
+    STAT_COUNTER sampled_err;    /* lwIP failure count at the previous sample */
+    STAT_COUNTER reported_err;   /* lwIP failure count at the previous report */
+} pool_record_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Pool names in memp_t order, generated from the same list as the enum. */
+static const char *const pool_names[POOL_COUNT] =
+{
+#define LWIP_MEMPOOL(name, num, size, desc)      #name,
+#include "lwip/priv/memp_std.h"
+#if (HEAP_STATS)
+    "HEAP",
+#endif
+};
+
+static const char *const point_names[LWIP_POOL_STATS_POINTS] =
+{
+    "suspend", "resume", "socket"
+};
+
+static pool_record_t records[POOL_COUNT];
+static uint32_t cycles;
+static uint32_t failed_cycles;
+static bool cycle_failed;
+static bool started = false;
+static cy_time_t start_ms;
+static cy_time_t last_report_ms;
+
+/*******************************************************************************
+* Function Name: pool_counters
+********************************************************************************
+* Summary:
+*  Returns the lwIP counters of a pool; index MEMP_MAX is the lwIP heap.
+*
+*******************************************************************************/
+static const struct stats_mem *pool_counters(uint32_t index)
+{
+#if (HEAP_STATS)
+    if ((uint32_t)MEMP_MAX == index)
+    {
+        return &lwip_stats.mem;
+    }
+#endif
+
+    return lwip_stats.memp[index];
+}
+
+/*******************************************************************************
+* Function Name: lwip_pool_stats_init
+********************************************************************************
+* Summary:
+*  Starts the statistics and prints the buffer sizes built in, so that the
+*  LWIP_POOL_PROFILE in effect can be checked. The lwIP
+*  counters run from boot; failures up to here, while joining the AP, are
+*  only shown in the totals of the report.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t lwip_pool_stats_init(void)
+{
+    SYS_ARCH_DECL_PROTECT(level);
+
+    SYS_ARCH_PROTECT(level);
+    for (uint32_t index = 0U; index < POOL_COUNT; index++)
+    {
+        const struct stats_mem *counters = pool_counters(index);
+
+        records[index].sampled_err = (NULL != counters) ? counters->err : 0U;
+        records[index].reported_err = records[index].sampled_err;
+    }
+    SYS_ARCH_UNPROTECT(level);
+
+    (void)cy_rtos_get_time(&start_ms);
+    last_report_ms = start_ms;
+    started = true;
+
+    printf("lwIP pools: %s profile, PBUF_POOL_SIZE %u, MEMP_NUM_TCP_SEG %u, "
+           "TCP_WND %u, TCP_SND_BUF %u\n", LWIP_POOL_PROFILE,
+           (unsigned int)PBUF_POOL_SIZE, (unsigned int)MEMP_NUM_TCP_SEG,
+           (unsigned int)TCP_WND, (unsigned int)TCP_SND_BUF);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: lwip_pool_stats_sample
+********************************************************************************
+* Summary:
+*  Takes the pool use at one of the sample points and prints the pools that
+*  failed an allocation since the previous sample. Called by the network task
+*  around wait_net_suspend() and by the socket handlers, so the records are
+*  only updated with the lwIP counters protected.
+*
+* Parameters:
+*  uint32_t point: LWIP_POOL_STATS_SUSPEND, _RESUME or _SOCKET
+*
+*******************************************************************************/
+void lwip_pool_stats_sample(uint32_t point)
+{
+    uint32_t new_failures[POOL_COUNT];
+    bool failed = false;
+    SYS_ARCH_DECL_PROTECT(level);
+
+    if ((!started) || (point >= LWIP_POOL_STATS_POINTS))
+    {
+        return;
+    }
+
+    SYS_ARCH_PROTECT(level);
+    for (uint32_t index = 0U; index < POOL_COUNT; index++)
+    {
+        const struct stats_mem *counters = pool_counters(index);
+        pool_record_t *record = &records[index];
+
+        new_failures[index] = 0U;
+        if (NULL == counters)
+        {
+            continue;
+        }
+
+        if ((uint32_t)counters->used > record->max_at[point])
+        {
+            record->max_at[point] = (uint32_t)counters->used;
+        }
+
+        new_failures[index] = (STAT_COUNTER)(counters->err - record->sampled_err);
+        record->sampled_err = counters->err;
+        failed = failed || (0U != new_failures[index]);
+    }
+
+    /* A cycle runs from one resume to the next. */
+    cycle_failed = cycle_failed || failed;
+    if (LWIP_POOL_STATS_RESUME == point)
+    {
+        cycles++;
+        if (cycle_failed)
+        {
+            failed_cycles++;
+        }
+        cycle_failed = false;
+    }
+    SYS_ARCH_UNPROTECT(level);
+
+    for (uint32_t index = 0U; failed && (index < POOL_COUNT); index++)
+    {
+        if (0U != new_failures[index])
+        {
+            printf("lwIP pools: %s out of memory %"PRIu32" times (%s)\n",
+                   pool_names[index], new_failures[index], point_names[point]);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: lwip_pool_stats_poll
+********************************************************************************
+* Summary:
+*  Called by the network task after each resume. Prints the report every
+*  LWIP_POOL_STATS_REPORT_INTERVAL_S seconds.
+*
+*******************************************************************************/
+void lwip_pool_stats_poll(void)
+{
+    cy_time_t now;
+
+    (void)cy_rtos_get_time(&now);
+    if (started &&
+        ((now - last_report_ms) >= (LWIP_POOL_STATS_REPORT_INTERVAL_S * 1000U)))
+    {
+        lwip_pool_stats_report();
+    }
+}
+
+/*******************************************************************************
+* Function Name: lwip_pool_stats_report
+********************************************************************************
+* Summary:
+*  Prints, for every pool that has been used, its size, current use, high-water
+*  mark since boot and per sample point, and the allocation failures in total
+*  and since the previous report. A size of 0 means the pool is taken from
+*  the heap (MEMP_MEM_MALLOC). Use still held at "suspend" is memory the
+*  device keeps while idle; the largest figure sizes the pool. The
+*  LWIP_POOL_STATS line carries the same figures.
+*
+*******************************************************************************/
+void lwip_pool_stats_report(void)
+{
+    cy_time_t now;
+    uint32_t count = 0U;
+    struct stats_mem counters[POOL_COUNT];
+    pool_record_t snapshot[POOL_COUNT];
+    SYS_ARCH_DECL_PROTECT(level);
+
+    (void)cy_rtos_get_time(&now);
+    last_report_ms = now;
+
+    SYS_ARCH_PROTECT(level);
+    for (uint32_t index = 0U; index < POOL_COUNT; index++)
+    {
+        const struct stats_mem *pool = pool_counters(index);
+
+        memset(&counters[index], 0, sizeof(counters[index]));
+        if (NULL != pool)
+        {
+            counters[index] = *pool;
+        }
+        snapshot[index] = records[index];
+        records[index].reported_err = counters[index].err;
+    }
+    SYS_ARCH_UNPROTECT(level);
+
+    printf("lwIP pools, %s profile\n", LWIP_POOL_PROFILE);
+    printf("%-17s %6s %6s %6s  %7s %7s %7s  %8s %6s\n", "Pool", "size", "used",
+           "max", "suspend", "resume", "socket", "failures", "new");
+    for (uint32_t index = 0U; index < POOL_COUNT; index++)
+    {
+        if ((0U == counters[index].max) && (0U == counters[index].err))
+        {
+            continue;
+        }
+
+        printf("%-17s %6"PRIu32" %6"PRIu32" %6"PRIu32"  %7"PRIu32" %7"PRIu32
+               " %7"PRIu32"  %8"PRIu32" %6"PRIu32"\n", pool_names[index],
+               (uint32_t)counters[index].avail, (uint32_t)counters[index].used,
+               (uint32_t)counters[index].max,
+               snapshot[index].max_at[LWIP_POOL_STATS_SUSPEND],
+               snapshot[index].max_at[LWIP_POOL_STATS_RESUME],
+               snapshot[index].max_at[LWIP_POOL_STATS_SOCKET],
+               (uint32_t)counters[index].err,
+               (uint32_t)(STAT_COUNTER)(counters[index].err - snapshot[index].reported_err));
+    }
+    printf("Suspend cycles: %"PRIu32", with allocation failures: %"PRIu32"\n",
+           cycles, failed_cycles);
+
+    printf("LWIP_POOL_STATS {\"elapsed_ms\":%"PRIu32",\"profile\":\"%s\","
+           "\"cycles\":%"PRIu32",\"failed_cycles\":%"PRIu32",\"pools\":[",
+           (uint32_t)(now - start_ms), LWIP_POOL_PROFILE, cycles, failed_cycles);
+    for (uint32_t index = 0U; index < POOL_COUNT; index++)
+    {
+        if ((0U == counters[index].max) && (0U == counters[index].err))
+        {
+            continue;
+        }
+
+        printf("%s{\"name\":\"%s\",\"size\":%"PRIu32",\"used\":%"PRIu32
+               ",\"max\":%"PRIu32",\"suspend\":%"PRIu32",\"resume\":%"PRIu32
+               ",\"socket\":%"PRIu32",\"err\":%"PRIu32"}", (0U == count) ? "" : ",",
+               pool_names[index], (uint32_t)counters[index].avail,
+               (uint32_t)counters[index].used, (uint32_t)counters[index].max,
+               snapshot[index].max_at[LWIP_POOL_STATS_SUSPEND],
+               snapshot[index].max_at[LWIP_POOL_STATS_RESUME],
+               snapshot[index].max_at[LWIP_POOL_STATS_SOCKET],
+               (uint32_t)counters[index].err);
+        count++;
+    }
+    printf("]}\n");
+}
+
+#endif /* LWIP_POOL_STATS */
+
+/* [] END OF FILE */
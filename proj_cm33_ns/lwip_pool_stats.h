@@ -0,0 +1,86 @@
+/*******************************************************************************
+* File Name:   lwip_pool_stats.h
+*
+* Description: This file contains the configuration and declarations of the
+* lwIP memory pool statistics, which sample the pbuf and memp pool use around
+* the network suspend cycle and socket activity.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef LWIP_POOL_STATS_H_
+#define LWIP_POOL_STATS_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Build with LWIP_POOL_STATS=1 to enable the pool statistics. The same switch
+ * turns on the lwIP statistics counters, see the project Makefile.
+ */
+#ifndef LWIP_POOL_STATS
+#define LWIP_POOL_STATS                          (0U)
+#endif
+
+/* Pool sizing profile selected with LWIP_POOL_PROFILE in the Makefile. */
+#ifndef LWIP_POOL_PROFILE
+#define LWIP_POOL_PROFILE                        "DEFAULT"
+#endif
+
+/* Points at which the pools are sampled. */
+#define LWIP_POOL_STATS_SUSPEND                  (0U)    /* Before wait_net_suspend() */
+#define LWIP_POOL_STATS_RESUME                   (1U)    /* wait_net_suspend() returned */
+#define LWIP_POOL_STATS_SOCKET                   (2U)    /* After a socket receive/send */
+#define LWIP_POOL_STATS_POINTS                   (3U)
+
+/* Interval at which the network task prints the report. */
+#define LWIP_POOL_STATS_REPORT_INTERVAL_S        (300U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t lwip_pool_stats_init(void);
+void lwip_pool_stats_sample(uint32_t point);
+void lwip_pool_stats_poll(void);
+void lwip_pool_stats_report(void);
+
+#endif /* LWIP_POOL_STATS_H_ */
+
+/* [] END OF FILE */
@@ -54,6 +54,24 @@
 /* TCP server task header file. */
 #include "tcp_keepalive_offload.h"
 
+/* Static-allocation build profile header file. */
+#include "static_rtos.h"
+
+/* Task run-time statistics header file. */
+#include "task_stats.h"
+
+/* Boot-phase timing profiler header file. */
+#include "boot_profile.h"
+
+/* WLAN power-save control header file. */
+#include "wlan_power_save.h"
+
+/* Event tracer header file. */
+#include "event_trace.h"
+
+/* Energy accounting header file. */
+#include "energy_stats.h"
+
 /*******************************************************************************
 * Macros
 *******************************************************************************/
@@ -81,6 +99,18 @@
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
+#if (STATIC_ALLOCATION_PROFILE)
+/* Stack and control block of the network task. */
+STATIC_RTOS_SECTION static StackType_t network_task_stack[NETWORK_ACTIVITY_TASK_STACK_SIZE];
+STATIC_RTOS_SECTION static StaticTask_t network_task_tcb;
+
+#if (PARALLEL_STARTUP)
+/* Stack and control block of the radio init task. */
+STATIC_RTOS_SECTION static StackType_t radio_task_stack[RADIO_INIT_TASK_STACK_SIZE];
+STATIC_RTOS_SECTION static StaticTask_t radio_task_tcb;
+#endif
+#endif
+
 /* LPTimer HAL object */
 static mtb_hal_lptimer_t lptimer_obj;
 
@@ -127,7 +157,9 @@ static void setup_clib_support(void)
 *******************************************************************************/
 static void lptimer_interrupt_handler(void)
 {
+    EVENT_TRACE_ISR_BEGIN(EVENT_TRACE_IRQ_LPTIMER);
     mtb_hal_lptimer_process_interrupt(&lptimer_obj);
+    EVENT_TRACE_ISR_END(EVENT_TRACE_IRQ_LPTIMER);
 }
 
 /*******************************************************************************
@@ -202,8 +234,87 @@ static void setup_tickless_idle_timer(void)
      * tickless idle mode
      */
     cyabs_rtos_set_lptimer(&lptimer_obj);
+
+#if (TASK_STATS)
+    /* The same LPTimer counts the task run time. */
+    task_stats_set_lptimer(&lptimer_obj);
+#endif
+
+#if (BOOT_PROFILE)
+    /* Keep timing boot phases through tickless deep sleep. */
+    boot_profile_set_lptimer(&lptimer_obj);
+#endif
+
+#if (WLAN_PS_MEASURE)
+    /* Time host wakeups and commands on the same LPTimer. */
+    wlan_ps_measure_set_lptimer(&lptimer_obj);
+#endif
+
+#if (EVENT_TRACE)
+    /* Time stamp trace events across tickless deep sleep. */
+    event_trace_set_lptimer(&lptimer_obj);
+#endif
+
+#if (ENERGY_STATS)
+    /* Time the power-mode residency on the same LPTimer. */
+    energy_stats_set_lptimer(&lptimer_obj);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: print_banner
+********************************************************************************
+* Summary:
+*  Clears the terminal and prints the application banner.
+*
+*******************************************************************************/
+static void print_banner(void)
+{
+    /* \x1b[2J\x1b[;H - ANSI ESC sequence to clear screen */
+    printf("\x1b[2J\x1b[;H");
+    printf("****************** "
+           "PSOC Edge MCU: Wlan Offloads "
+           "****************** \r\n\n");
+}
+
+/*******************************************************************************
+* Function Name: enable_cm55
+********************************************************************************
+* Summary:
+*  Releases the CM55 core from reset.
+*
+*******************************************************************************/
+static void enable_cm55(void)
+{
+    /* CM55_APP_BOOT_ADDR must be updated if CM55 memory layout is changed.*/
+#if (BOOT_PROFILE)
+    boot_profile_cm55_start();
+#endif
+    Cy_SysEnableCM55(MXCM55, CM55_APP_BOOT_ADDR, CM55_BOOT_WAIT_TIME_USEC);
+    BOOT_PROFILE_MARK("Cy_SysEnableCM55");
 }
 
+#if (PARALLEL_STARTUP)
+/*******************************************************************************
+* Function Name: startup_task
+********************************************************************************
+* Summary:
+*  Enables the CM55 core while the radio init task brings up the Wi-Fi
+*  device, and then continues as the network task.
+*
+* Parameters:
+*  void *arg: Unused
+*
+*******************************************************************************/
+static void startup_task(void *arg)
+{
+    /* Enable CM55. */
+    enable_cm55();
+
+    network_idle_task(arg);
+}
+#endif
+
 /*******************************************************************************
 * Function Name: main
 ********************************************************************************
@@ -221,6 +332,17 @@ static void setup_tickless_idle_timer(void)
 int main(void)
 {
     cy_rslt_t result;
+    TaskHandle_t network_task_handle = NULL;
+#if (PARALLEL_STARTUP)
+    TaskFunction_t network_task_entry = startup_task;
+#else
+    TaskFunction_t network_task_entry = network_idle_task;
+#endif
+
+    /* The secure project records its own phases; this one is the non-secure
+     * start-up code that ran after it.
+     */
+    BOOT_PROFILE_MARK("Non-secure start-up");
 
     /* Initialize the board support package. */
     result = cybsp_init() ;
@@ -233,25 +355,33 @@ int main(void)
 
     /* To avoid compiler warnings. */
     CY_UNUSED_PARAMETER(result);
+    BOOT_PROFILE_MARK("cybsp_init");
 
-    /* Setup CLIB support library. */
+#if (PARALLEL_STARTUP)
+    /* Power up the Wi-Fi device first; it settles during the set-up below. */
+    radio_power_up();
+#endif
+
+    /* Setup CLIB support library before any task, including the radio init
+     * task, can use it.
+     */
     setup_clib_support();
+    BOOT_PROFILE_MARK("setup_clib_support");
 
     /* Initialize retarget-io middleware */
     init_retarget_io();
+    BOOT_PROFILE_MARK("init_retarget_io");
 
     /* Setup the LPTimer instance for CM33 CPU. */
     setup_tickless_idle_timer();
+    BOOT_PROFILE_MARK("setup_tickless_idle_timer");
 
-    /* \x1b[2J\x1b[;H - ANSI ESC sequence to clear screen */
-    printf("\x1b[2J\x1b[;H");
-    printf("****************** "
-           "PSOC Edge MCU: Wlan Offloads "
-           "****************** \r\n\n");
-           
+    print_banner();
+
+#if !(PARALLEL_STARTUP)
     /* Enable CM55. */
-    /* CM55_APP_BOOT_ADDR must be updated if CM55 memory layout is changed.*/
-    Cy_SysEnableCM55(MXCM55, CM55_APP_BOOT_ADDR, CM55_BOOT_WAIT_TIME_USEC);
+    enable_cm55();
+#endif
     
     /* Enable global interrupts. */
     __enable_irq();
@@ -260,8 +390,39 @@ int main(void)
     Cy_SysPm_SetSOCMEMDeepSleepMode(CY_SYSPM_MODE_DEEPSLEEP_OFF);
 
     /* Create the tasks. */
-    result = xTaskCreate(network_idle_task, "Network task", NETWORK_ACTIVITY_TASK_STACK_SIZE, NULL,
-                NETWORK_ACTIVITY_TASK_PRIORITY, NULL);
+#if (STATIC_ALLOCATION_PROFILE)
+    network_task_handle = xTaskCreateStatic(network_task_entry, "Network task",
+                NETWORK_ACTIVITY_TASK_STACK_SIZE, NULL, NETWORK_ACTIVITY_TASK_PRIORITY,
+                network_task_stack, &network_task_tcb);
+    result = (NULL != network_task_handle) ? pdPASS : pdFAIL;
+    static_rtos_account("Network task", sizeof(network_task_stack) +
+                        sizeof(network_task_tcb), true);
+#else
+    result = xTaskCreate(network_task_entry, "Network task", NETWORK_ACTIVITY_TASK_STACK_SIZE, NULL,
+                NETWORK_ACTIVITY_TASK_PRIORITY, &network_task_handle);
+#endif
+
+#if (PARALLEL_STARTUP)
+    /* The radio init task runs at a higher priority, so the radio reset and
+     * firmware download start first; the board start-up continues whenever
+     * the radio init task waits for the Wi-Fi device.
+     */
+    if (pdPASS == result)
+    {
+#if (STATIC_ALLOCATION_PROFILE)
+        result = (NULL != xTaskCreateStatic(radio_init_task, "Radio init",
+                    RADIO_INIT_TASK_STACK_SIZE, network_task_handle, RADIO_INIT_TASK_PRIORITY,
+                    radio_task_stack, &radio_task_tcb)) ? pdPASS : pdFAIL;
+        static_rtos_account("Radio init task", sizeof(radio_task_stack) +
+                            sizeof(radio_task_tcb), true);
+#else
+        result = xTaskCreate(radio_init_task, "Radio init", RADIO_INIT_TASK_STACK_SIZE,
+                    network_task_handle, RADIO_INIT_TASK_PRIORITY, NULL);
+#endif
+    }
+#endif
+
+    BOOT_PROFILE_MARK("Task creation");
 
     if( pdPASS == result )
     {
@@ -0,0 +1,532 @@
+/*******************************************************************************
+* File Name:   mqtt_client.c
+*
+* Description: This file contains the MQTT client mode. The client connects to
+* the broker, subscribes to the command topic and shares the network task's
+* wait_net_suspend() loop; the broker connection is kept alive by the WLAN
+* firmware TCP keepalive offload while the network stack is suspended. A lost
+* session is re-established by a separate task so that the network task never
+* blocks on the broker.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include "cyabs_rtos.h"
+#include <string.h>
+#include <inttypes.h>
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/* MQTT header file. */
+#include "cy_mqtt_api.h"
+
+#include "mqtt_client.h"
+#include "mqtt_keepalive_offload.h"
+#include "static_rtos.h"
+#include "wlan_power_save.h"
+#include "event_trace.h"
+#include "energy_stats.h"
+
+#if (MQTT_CLIENT_MODE)
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define MQTT_LED_ON_CMD                          '1'
+#define MQTT_LED_OFF_CMD                         '0'
+#define MQTT_ACK_LED_ON                          "LED ON ACK"
+#define MQTT_ACK_LED_OFF                         "LED OFF ACK"
+#define MQTT_MSG_INVALID_CMD                     "Invalid command"
+#define MQTT_SUBSCRIPTION_COUNT                  (1U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static cy_mqtt_t mqtt_handle;
+static uint8_t mqtt_network_buffer[MQTT_NETWORK_BUFFER_SIZE];
+static volatile bool mqtt_connected = false;
+static TaskHandle_t reconnect_task;
+
+/* Last command received from the broker, handled by the network task. */
+static volatile bool command_pending = false;
+static volatile char pending_command;
+
+#if (ENERGY_STATS)
+/* Start of the current suspend, for counting offloaded keepalives. */
+static cy_time_t suspend_start_ms;
+#endif
+
+#if (STATIC_ALLOCATION_PROFILE)
+STATIC_RTOS_SECTION static StackType_t reconnect_stack[MQTT_RECONNECT_TASK_STACK_SIZE];
+STATIC_RTOS_SECTION static StaticTask_t reconnect_tcb;
+#endif
+
+/*******************************************************************************
+* Function Name: request_reconnect
+********************************************************************************
+* Summary:
+*  Marks the session down and wakes the reconnect task.
+*
+*******************************************************************************/
+static void request_reconnect(void)
+{
+    mqtt_connected = false;
+
+    if (NULL != reconnect_task)
+    {
+        xTaskNotifyGive(reconnect_task);
+    }
+}
+
+/*******************************************************************************
+* Function Name: mqtt_event_callback
+********************************************************************************
+* Summary:
+*  MQTT library event callback. Runs in the MQTT library context, so received
+*  commands are only recorded here and handled by the network task.
+*
+* Parameters:
+*  cy_mqtt_t handle: MQTT handle (unused)
+*  cy_mqtt_event_t event: MQTT event
+*  void *user_data: User data (unused)
+*
+*******************************************************************************/
+static void mqtt_event_callback(cy_mqtt_t handle, cy_mqtt_event_t event, void *user_data)
+{
+    cy_mqtt_received_msg_info_t *received_msg;
+
+    CY_UNUSED_PARAMETER(handle);
+    CY_UNUSED_PARAMETER(user_data);
+
+    switch (event.type)
+    {
+        case CY_MQTT_EVENT_TYPE_SUBSCRIPTION_MESSAGE_RECEIVE:
+        {
+            received_msg = &(event.data.pub_msg.received_message);
+
+            /* The broker's sequence number moved on. */
+            mqtt_ka_offload_rearm();
+            EVENT_TRACE_RECORD(EVENT_TRACE_SOCKET, EVENT_TRACE_SOCK_RECEIVE,
+                               (uint16_t)received_msg->payload_len);
+            printf("MQTT message on '%.*s': %.*s\n",
+                   (int)received_msg->topic_len, received_msg->topic,
+                   (int)received_msg->payload_len, (const char *)received_msg->payload);
+
+            if (0U != received_msg->payload_len)
+            {
+                pending_command = ((const char *)received_msg->payload)[0];
+                command_pending = true;
+#if (WLAN_PS_MEASURE)
+                wlan_ps_measure_note_command();
+#endif
+#if (ENERGY_STATS)
+                energy_stats_op_begin(ENERGY_OP_COMMAND);
+#endif
+            }
+            break;
+        }
+
+        case CY_MQTT_EVENT_TYPE_DISCONNECT:
+        {
+            EVENT_TRACE_RECORD(EVENT_TRACE_SOCKET, EVENT_TRACE_SOCK_DISCONNECT, 0U);
+            printf("Disconnected from the MQTT broker!\n");
+            request_reconnect();
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: mqtt_connect_and_subscribe
+********************************************************************************
+* Summary:
+*  Connects to the broker, retrying up to MQTT_MAX_CONN_RETRIES times, and
+*  subscribes to the command topic. Blocks for the retries, so it only runs in
+*  the reconnect task.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if connected and subscribed
+*
+*******************************************************************************/
+static cy_rslt_t mqtt_connect_and_subscribe(void)
+{
+    cy_rslt_t result = MQTT_CLIENT_RSLT_CONNECT_FAILED;
+
+    /* The WLAN firmware keeps the connection alive with TCP keepalives, which
+     * the broker does not count as MQTT traffic. The MQTT keepalive is
+     * disabled so that the broker does not drop the session while the host
+     * sleeps.
+     */
+    cy_mqtt_connect_info_t connect_info =
+    {
+        .client_id = MQTT_CLIENT_IDENTIFIER,
+        .client_id_len = (uint16_t)(sizeof(MQTT_CLIENT_IDENTIFIER) - 1U),
+        .clean_session = true,
+        .keep_alive_sec = 0U,
+        .will_info = NULL
+    };
+
+    cy_mqtt_subscribe_info_t subscribe_info =
+    {
+        .qos = CY_MQTT_QOS0,
+        .topic = MQTT_SUB_TOPIC,
+        .topic_len = (uint16_t)(sizeof(MQTT_SUB_TOPIC) - 1U)
+    };
+
+    for (uint32_t conn_retries = 0; conn_retries < MQTT_MAX_CONN_RETRIES; conn_retries++)
+    {
+        result = cy_mqtt_connect(mqtt_handle, &connect_info);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            break;
+        }
+
+        printf("MQTT connect failed with error 0x%08"PRIx32". Retrying in %d ms...\n",
+               (uint32_t)result, MQTT_CONN_RETRY_INTERVAL_MS);
+        cy_rtos_delay_milliseconds(MQTT_CONN_RETRY_INTERVAL_MS);
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Exceeded maximum MQTT connection attempts\n");
+        return result;
+    }
+
+    result = cy_mqtt_subscribe(mqtt_handle, &subscribe_info, MQTT_SUBSCRIPTION_COUNT);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("MQTT subscribe failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        (void)cy_mqtt_disconnect(mqtt_handle);
+        return result;
+    }
+
+    mqtt_connected = true;
+
+    printf("============================================================\n");
+    printf("Connected to MQTT broker, subscribed to '%s'\n", MQTT_SUB_TOPIC);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: mqtt_reconnect_task
+********************************************************************************
+* Summary:
+*  Establishes the broker session whenever it is requested: at start-up, on a
+*  broker disconnect and when the keepalive offload reports the connection
+*  lost. Failed rounds are retried after MQTT_RECONNECT_BACKOFF_MS.
+*
+* Parameters:
+*  void *arg: Unused
+*
+*******************************************************************************/
+static void mqtt_reconnect_task(void *arg)
+{
+    cy_rslt_t result;
+    TickType_t wait = portMAX_DELAY;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    while (true)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, wait);
+
+        if (mqtt_connected)
+        {
+            wait = portMAX_DELAY;
+            continue;
+        }
+
+        /* The old session, if any, is gone; the network task programs the
+         * offload for the new connection at its next suspend edge.
+         */
+        mqtt_ka_offload_rearm();
+        (void)cy_mqtt_disconnect(mqtt_handle);
+
+        printf("Connecting to MQTT broker '%s' port %d\n", MQTT_BROKER_ADDRESS, MQTT_PORT);
+
+#if (ENERGY_STATS)
+        energy_stats_op_begin(ENERGY_OP_CONNECT);
+#endif
+        result = mqtt_connect_and_subscribe();
+#if (ENERGY_STATS)
+        energy_stats_op_end(ENERGY_OP_CONNECT);
+#endif
+
+        wait = (CY_RSLT_SUCCESS == result) ? portMAX_DELAY :
+               pdMS_TO_TICKS(MQTT_RECONNECT_BACKOFF_MS);
+    }
+}
+
+/*******************************************************************************
+* Function Name: mqtt_client_start
+********************************************************************************
+* Summary:
+*  Initializes the MQTT library, creates the client and starts the reconnect
+*  task, which connects to the broker and subscribes to the command topic.
+*  Call after connect_to_wifi_ap().
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the client is started
+*
+*******************************************************************************/
+cy_rslt_t mqtt_client_start(void)
+{
+    cy_rslt_t result;
+
+    cy_mqtt_broker_info_t broker_info =
+    {
+        .hostname = MQTT_BROKER_ADDRESS,
+        .hostname_len = (uint16_t)(sizeof(MQTT_BROKER_ADDRESS) - 1U),
+        .port = MQTT_PORT
+    };
+
+    result = cy_mqtt_init();
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("MQTT library initialization failed!\n");
+        return result;
+    }
+
+    result = cy_mqtt_create(mqtt_network_buffer, MQTT_NETWORK_BUFFER_SIZE, NULL,
+                            &broker_info, MQTT_CLIENT_IDENTIFIER, &mqtt_handle);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("MQTT instance creation failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        return result;
+    }
+
+    result = cy_mqtt_register_event_callback(mqtt_handle, mqtt_event_callback, NULL);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("MQTT event callback registration failed!\n");
+        return result;
+    }
+
+#if (STATIC_ALLOCATION_PROFILE)
+    reconnect_task = xTaskCreateStatic(mqtt_reconnect_task, "MQTT reconnect",
+                                       MQTT_RECONNECT_TASK_STACK_SIZE, NULL,
+                                       MQTT_RECONNECT_TASK_PRIORITY, reconnect_stack,
+                                       &reconnect_tcb);
+    static_rtos_account("MQTT reconnect", sizeof(reconnect_stack) + sizeof(reconnect_tcb), true);
+#else
+    if (pdPASS != xTaskCreate(mqtt_reconnect_task, "MQTT reconnect",
+                              MQTT_RECONNECT_TASK_STACK_SIZE, NULL,
+                              MQTT_RECONNECT_TASK_PRIORITY, &reconnect_task))
+    {
+        reconnect_task = NULL;
+    }
+#endif
+
+    if (NULL == reconnect_task)
+    {
+        printf("Failed to create the MQTT reconnect task\n");
+        return MQTT_CLIENT_RSLT_TASK_FAILED;
+    }
+
+    request_reconnect();
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: mqtt_client_publish
+********************************************************************************
+* Summary:
+*  Publishes a message on MQTT_PUB_TOPIC and re-arms the keepalive offload,
+*  whose programmed sequence number the message moved on.
+*
+* Parameters:
+*  const char *message: NULL terminated message
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the message was published
+*
+*******************************************************************************/
+cy_rslt_t mqtt_client_publish(const char *message)
+{
+    cy_rslt_t result;
+
+    cy_mqtt_publish_info_t publish_info =
+    {
+        .qos = CY_MQTT_QOS0,
+        .topic = MQTT_PUB_TOPIC,
+        .topic_len = (uint16_t)(sizeof(MQTT_PUB_TOPIC) - 1U),
+        .retain = false,
+        .dup = false,
+        .payload = message,
+        .payload_len = strlen(message)
+    };
+
+    if (!mqtt_connected)
+    {
+        return MQTT_CLIENT_RSLT_NOT_CONNECTED;
+    }
+
+    result = cy_mqtt_publish(mqtt_handle, &publish_info);
+    EVENT_TRACE_RECORD(EVENT_TRACE_SOCKET, EVENT_TRACE_SOCK_SEND,
+                       (uint16_t)publish_info.payload_len);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("MQTT publish failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+    }
+    else
+    {
+        mqtt_ka_offload_rearm();
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: mqtt_client_prepare_suspend
+********************************************************************************
+* Summary:
+*  Called by the network task before wait_net_suspend(). Handles a command
+*  received while the stack was active, then arms the keepalive offload and
+*  wake pattern from the live broker connection, or removes them when there
+*  is no session. Never blocks on the broker; reconnecting is left to the
+*  reconnect task.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS, or the publish or offload error
+*
+*******************************************************************************/
+cy_rslt_t mqtt_client_prepare_suspend(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (command_pending)
+    {
+        command_pending = false;
+
+        switch (pending_command)
+        {
+            case MQTT_LED_ON_CMD:
+                Cy_GPIO_Write(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN, CYBSP_LED_STATE_ON);
+                result = mqtt_client_publish(MQTT_ACK_LED_ON);
+                break;
+
+            case MQTT_LED_OFF_CMD:
+                Cy_GPIO_Write(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN, CYBSP_LED_STATE_OFF);
+                result = mqtt_client_publish(MQTT_ACK_LED_OFF);
+                break;
+
+            default:
+                result = mqtt_client_publish(MQTT_MSG_INVALID_CMD);
+                break;
+        }
+
+#if (ENERGY_STATS)
+        /* The command is done once its acknowledgement is sent. */
+        energy_stats_op_end(ENERGY_OP_COMMAND);
+#endif
+
+        if (CY_RSLT_SUCCESS != result)
+        {
+            return result;
+        }
+    }
+
+    if (mqtt_connected)
+    {
+        result = mqtt_ka_offload_arm(MQTT_SUB_TOPIC, MQTT_PORT, MQTT_KEEP_ALIVE_SEC);
+
+        /* Data still queued in lwIP; the next suspend edge hands it over. */
+        if (MQTT_KA_OFFLOAD_RSLT_NOT_READY == result)
+        {
+            result = CY_RSLT_SUCCESS;
+        }
+    }
+    else
+    {
+        mqtt_ka_offload_disarm();
+    }
+
+#if (ENERGY_STATS)
+    (void)cy_rtos_get_time(&suspend_start_ms);
+#endif
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: mqtt_client_resume
+********************************************************************************
+* Summary:
+*  Called by the network task when wait_net_suspend() returns after the network
+*  stack resumed. Hands a session the firmware lost while the host slept to
+*  the reconnect task.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS, or the offload error
+*
+*******************************************************************************/
+cy_rslt_t mqtt_client_resume(void)
+{
+    cy_rslt_t result;
+
+#if (ENERGY_STATS)
+    cy_time_t now_ms;
+
+    /* The firmware sent one keepalive per interval while the host slept. */
+    if (mqtt_ka_offload_is_armed())
+    {
+        (void)cy_rtos_get_time(&now_ms);
+        energy_stats_add_keepalives((uint32_t)(now_ms - suspend_start_ms) /
+                                    (MQTT_KEEP_ALIVE_SEC * 1000U));
+    }
+#endif
+
+    result = mqtt_ka_offload_check();
+
+    if (MQTT_KA_OFFLOAD_RSLT_LOST == result)
+    {
+        request_reconnect();
+    }
+
+    return result;
+}
+#endif /* (MQTT_CLIENT_MODE) */
+
+/* [] END OF FILE */
@@ -0,0 +1,99 @@
+/*******************************************************************************
+* File Name:   mqtt_client.h
+*
+* Description: This file contains the configuration and declarations of the
+* MQTT client mode, which keeps its MQTT keepalive offloaded to the WLAN
+* firmware while the host is in deep sleep.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef MQTT_CLIENT_H_
+#define MQTT_CLIENT_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to run the MQTT client instead of the TCP client. */
+#ifndef MQTT_CLIENT_MODE
+#define MQTT_CLIENT_MODE                         (0U)
+#endif
+
+/* MQTT broker details. Modify to match your broker. */
+#define MQTT_BROKER_ADDRESS                      "MY_MQTT_BROKER"
+#define MQTT_PORT                                (1883U)
+#define MQTT_CLIENT_IDENTIFIER                   "psoc-edge-wlan-offloads"
+
+/* Topic on which the client receives commands, and the acknowledgement topic. */
+#define MQTT_SUB_TOPIC                           "MQTT_Broker"
+#define MQTT_PUB_TOPIC                           "MQTT_Broker_ack"
+
+/* Keepalive interval of the broker connection; the WLAN firmware sends a TCP
+ * keepalive at this interval while the network stack is suspended.
+ */
+#define MQTT_KEEP_ALIVE_SEC                      (60U)
+
+#define MQTT_NETWORK_BUFFER_SIZE                 (CY_MQTT_MIN_NETWORK_BUFFER_SIZE)
+#define MQTT_MAX_CONN_RETRIES                    (5U)
+#define MQTT_CONN_RETRY_INTERVAL_MS              (2000U)
+#define MQTT_MAX_MESSAGE_LEN                     (32U)
+
+/* Task that (re)connects to the broker, and the delay between its rounds. */
+#define MQTT_RECONNECT_TASK_STACK_SIZE           (1024U * 2U)
+#define MQTT_RECONNECT_TASK_PRIORITY             (1U)
+#define MQTT_RECONNECT_BACKOFF_MS                (30000U)
+
+/* Results returned by this module. */
+#define MQTT_CLIENT_RSLT_CONNECT_FAILED          APP_RSLT_ERROR(APP_RSLT_GROUP_MQTT_CLIENT, 1U)
+#define MQTT_CLIENT_RSLT_TASK_FAILED             APP_RSLT_ERROR(APP_RSLT_GROUP_MQTT_CLIENT, 2U)
+#define MQTT_CLIENT_RSLT_NOT_CONNECTED           APP_RSLT_ERROR(APP_RSLT_GROUP_MQTT_CLIENT, 3U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t mqtt_client_start(void);
+cy_rslt_t mqtt_client_publish(const char *message);
+cy_rslt_t mqtt_client_prepare_suspend(void);
+cy_rslt_t mqtt_client_resume(void);
+
+#endif /* MQTT_CLIENT_H_ */
+
+/* [] END OF FILE */
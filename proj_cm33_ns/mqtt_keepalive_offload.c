@@ -0,0 +1,667 @@
+/*******************************************************************************
+* File Name:   mqtt_keepalive_offload.c
+*
+* Description: This file contains functions that hand the MQTT broker
+* connection to the WLAN firmware while the host sleeps. On each suspend edge
+* the connection's addresses, ports and sequence numbers are read from lwIP
+* and programmed into a TCP keepalive offload (TKO) slot, so that the firmware
+* sends the keepalives at the MQTT keepalive interval, and a WOWL pattern is
+* programmed so that only a PUBLISH on the subscribed topic wakes the host.
+* No Device Configurator TKO entry is needed for the broker connection. The
+* firmware status is read after each resume to find out whether the broker
+* stopped answering while the host slept.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <string.h>
+#include <inttypes.h>
+
+/* Wi-Fi connection manager and Wi-Fi host driver header files. */
+#include "cy_wcm.h"
+#include "whd_wifi_api.h"
+
+/* lwIP header files. The broker connection is only read, never modified. */
+#include "lwip/tcpip.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/tcp.h"
+#include "lwip/priv/tcp_priv.h"
+
+#include "mqtt_keepalive_offload.h"
+#include "mqtt_client.h"
+#include "wowl_pattern.h"
+
+#if (MQTT_CLIENT_MODE)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TKO_PARAM_SET                            (1U)
+
+/* Firmware iovar and subcommand that program one TKO connection. */
+#define TKO_IOVAR                                "tko"
+#define TKO_SUBCMD_CONNECT                       (2U)
+#define TKO_IP_ADDR_TYPE_IPV4                    (0U)
+#define TKO_CMD_HEADER_LEN                       (4U)
+#define TKO_CONNECT_HEADER_LEN                   (18U)
+
+/* IPv4 and TCP headers without options, as the keepalive and its answer. */
+#define TKO_IP_HDR_LEN                           (20U)
+#define TKO_TCP_HDR_LEN                          (20U)
+#define TKO_PACKET_LEN                           (TKO_IP_HDR_LEN + TKO_TCP_HDR_LEN)
+#define TKO_PSEUDO_HDR_LEN                       (12U)
+#define TKO_IP_TOS                               (0U)
+#define TKO_IP_ID                                (0U)
+#define TKO_TCP_HDR_WORDS                        (5U)
+
+#define TKO_IOVAR_LEN                            (TKO_CMD_HEADER_LEN + TKO_CONNECT_HEADER_LEN + \
+                                                 (2U * sizeof(uint32_t)) + (2U * TKO_PACKET_LEN))
+
+/* Offsets in the Ethernet frame of a PUBLISH from the broker. The broker
+ * sends no IP or TCP options on a connection lwIP opened without them.
+ */
+#define WAKE_PATTERN_OFFSET                      (12U)   /* EtherType */
+#define WAKE_ETHERTYPE_IPV4_HI                   (0x08U)
+#define WAKE_ETHERTYPE_IPV4_LO                   (0x00U)
+#define WAKE_IP_VHL                              (0x45U)
+#define WAKE_IP_VHL_POS                          (14U)
+#define WAKE_IP_PROTO_POS                        (23U)
+#define WAKE_IP_SRC_POS                          (26U)
+#define WAKE_IP_DST_POS                          (30U)
+#define WAKE_TCP_SRC_PORT_POS                    (34U)
+#define WAKE_TCP_DST_PORT_POS                    (36U)
+#define WAKE_TCP_HDRLEN_POS                      (46U)
+#define WAKE_TCP_HDRLEN                          (TKO_TCP_HDR_WORDS << 4)
+#define WAKE_MQTT_TYPE_POS                       (54U)
+#define WAKE_MQTT_PUBLISH_QOS0                   (0x30U)
+#define WAKE_MQTT_TOPIC_LEN_POS                  (56U)
+#define WAKE_MQTT_TOPIC_POS                      (58U)
+#define WAKE_BYTE_MATCH                          (0xFFU)
+#define WAKE_PATTERN_MAX_TOPIC_LEN               (WOWL_MAX_PATTERN_LEN + WAKE_PATTERN_OFFSET - \
+                                                 WAKE_MQTT_TOPIC_POS)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Broker connection as read from lwIP. Addresses are in network order. */
+typedef struct
+{
+    uint32_t local_ip;
+    uint32_t remote_ip;
+    uint16_t local_port;
+    uint16_t remote_port;
+    uint32_t snd_nxt;
+    uint32_t rcv_nxt;
+    uint16_t rcv_wnd;
+    uint16_t snd_wnd;
+    uint8_t ttl;
+} mqtt_ka_session_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Set from other tasks when the connection was used since it was programmed. */
+static volatile bool session_stale = true;
+static bool session_programmed = false;
+static mqtt_ka_session_t programmed_session;
+
+static bool wake_pattern_added = false;
+static uint32_t wake_pattern_id;
+
+static bool offload_armed = false;
+
+static uint8_t tko_iovar_buffer[TKO_IOVAR_LEN];
+
+/*******************************************************************************
+* Function Name: read_session
+********************************************************************************
+* Summary:
+*  Finds the established IPv4 connection to the broker port among the active
+*  lwIP connections and copies what the offload needs. A connection with data
+*  queued but not sent yet is not handed over.
+*
+* Parameters:
+*  uint16_t broker_port: Broker TCP port
+*  mqtt_ka_session_t *session: Connection read
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS, or MQTT_KA_OFFLOAD_RSLT_NOT_READY
+*
+*******************************************************************************/
+static cy_rslt_t read_session(uint16_t broker_port, mqtt_ka_session_t *session)
+{
+    cy_rslt_t result = MQTT_KA_OFFLOAD_RSLT_NOT_READY;
+    struct tcp_pcb *pcb;
+
+    LOCK_TCPIP_CORE();
+    for (pcb = tcp_active_pcbs; NULL != pcb; pcb = pcb->next)
+    {
+        if ((ESTABLISHED != pcb->state) || (broker_port != pcb->remote_port) ||
+            !IP_IS_V4_VAL(pcb->remote_ip))
+        {
+            continue;
+        }
+
+        if (NULL == pcb->unsent)
+        {
+            /* Cleared as a whole; sessions are compared with memcmp(). */
+            memset(session, 0, sizeof(*session));
+            session->local_ip = ip4_addr_get_u32(ip_2_ip4(&pcb->local_ip));
+            session->remote_ip = ip4_addr_get_u32(ip_2_ip4(&pcb->remote_ip));
+            session->local_port = pcb->local_port;
+            session->remote_port = pcb->remote_port;
+            session->snd_nxt = pcb->snd_nxt;
+            session->rcv_nxt = pcb->rcv_nxt;
+            session->rcv_wnd = (uint16_t)pcb->rcv_ann_wnd;
+            session->snd_wnd = (uint16_t)pcb->snd_wnd;
+            session->ttl = pcb->ttl;
+            result = CY_RSLT_SUCCESS;
+        }
+        break;
+    }
+    UNLOCK_TCPIP_CORE();
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: build_packet
+********************************************************************************
+* Summary:
+*  Builds an IPv4 TCP ACK without payload, with both checksums, as the
+*  firmware sends it as a keepalive or expects it as the answer.
+*
+* Parameters:
+*  uint8_t *packet: TKO_PACKET_LEN bytes for the packet
+*  uint32_t src_ip: Source address, network order
+*  uint32_t dst_ip: Destination address, network order
+*  uint16_t src_port: Source port
+*  uint16_t dst_port: Destination port
+*  uint32_t seq: Sequence number
+*  uint32_t ack: Acknowledgement number
+*  uint16_t wnd: Advertised window
+*  uint8_t ttl: Time to live
+*
+*******************************************************************************/
+static void build_packet(uint8_t *packet, uint32_t src_ip, uint32_t dst_ip,
+                         uint16_t src_port, uint16_t dst_port, uint32_t seq,
+                         uint32_t ack, uint16_t wnd, uint8_t ttl)
+{
+    struct ip_hdr iphdr;
+    struct tcp_hdr tcphdr;
+    uint8_t pseudo[TKO_PSEUDO_HDR_LEN + TKO_TCP_HDR_LEN];
+
+    memset(&iphdr, 0, sizeof(iphdr));
+    IPH_VHL_SET(&iphdr, 4, TKO_IP_HDR_LEN / 4U);
+    IPH_TOS_SET(&iphdr, TKO_IP_TOS);
+    IPH_LEN_SET(&iphdr, lwip_htons(TKO_PACKET_LEN));
+    IPH_ID_SET(&iphdr, lwip_htons(TKO_IP_ID));
+    IPH_OFFSET_SET(&iphdr, lwip_htons(IP_DF));
+    IPH_TTL_SET(&iphdr, ttl);
+    IPH_PROTO_SET(&iphdr, IP_PROTO_TCP);
+    memcpy(&iphdr.src, &src_ip, sizeof(src_ip));
+    memcpy(&iphdr.dest, &dst_ip, sizeof(dst_ip));
+    IPH_CHKSUM_SET(&iphdr, inet_chksum(&iphdr, TKO_IP_HDR_LEN));
+
+    memset(&tcphdr, 0, sizeof(tcphdr));
+    tcphdr.src = lwip_htons(src_port);
+    tcphdr.dest = lwip_htons(dst_port);
+    tcphdr.seqno = lwip_htonl(seq);
+    tcphdr.ackno = lwip_htonl(ack);
+    TCPH_HDRLEN_FLAGS_SET(&tcphdr, TKO_TCP_HDR_WORDS, TCP_ACK);
+    tcphdr.wnd = lwip_htons(wnd);
+
+    /* The TCP checksum covers the pseudo header of the addresses as well. */
+    memset(pseudo, 0, TKO_PSEUDO_HDR_LEN);
+    memcpy(&pseudo[0], &src_ip, sizeof(src_ip));
+    memcpy(&pseudo[4], &dst_ip, sizeof(dst_ip));
+    pseudo[9] = IP_PROTO_TCP;
+    pseudo[11] = TKO_TCP_HDR_LEN;
+    memcpy(&pseudo[TKO_PSEUDO_HDR_LEN], &tcphdr, TKO_TCP_HDR_LEN);
+    tcphdr.chksum = inet_chksum(pseudo, sizeof(pseudo));
+
+    memcpy(packet, &iphdr, TKO_IP_HDR_LEN);
+    memcpy(&packet[TKO_IP_HDR_LEN], &tcphdr, TKO_TCP_HDR_LEN);
+}
+
+/*******************************************************************************
+* Function Name: put_le16
+********************************************************************************
+* Summary:
+*  Stores a 16-bit value in the little-endian order of the firmware.
+*
+* Parameters:
+*  uint8_t *buffer: Destination
+*  uint16_t value: Value
+*
+* Return:
+*  uint8_t *: Byte after the value
+*
+*******************************************************************************/
+static uint8_t *put_le16(uint8_t *buffer, uint16_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+
+    return &buffer[2];
+}
+
+/*******************************************************************************
+* Function Name: put_le32
+********************************************************************************
+* Summary:
+*  Stores a 32-bit value in the little-endian order of the firmware.
+*
+* Parameters:
+*  uint8_t *buffer: Destination
+*  uint32_t value: Value
+*
+* Return:
+*  uint8_t *: Byte after the value
+*
+*******************************************************************************/
+static uint8_t *put_le32(uint8_t *buffer, uint32_t value)
+{
+    return put_le16(put_le16(buffer, (uint16_t)value), (uint16_t)(value >> 16));
+}
+
+/*******************************************************************************
+* Function Name: program_connection
+********************************************************************************
+* Summary:
+*  Programs the broker connection into the MQTT_KA_OFFLOAD_TKO_INDEX slot with
+*  the "tko" connect subcommand, followed by the keepalive interval. The
+*  keepalive carries the last sequence number already acknowledged, so the
+*  broker answers it with an ACK of the current sequence numbers.
+*
+* Parameters:
+*  whd_interface_t whd_ifp: WHD interface
+*  const mqtt_ka_session_t *session: Broker connection
+*  uint16_t interval_sec: Keepalive interval
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the firmware accepted the connection
+*
+*******************************************************************************/
+static cy_rslt_t program_connection(whd_interface_t whd_ifp, const mqtt_ka_session_t *session,
+                                    uint16_t interval_sec)
+{
+    cy_rslt_t result;
+    uint8_t *cursor;
+    whd_tko_retry_t retry =
+    {
+        .tko_interval = interval_sec,
+        .tko_retry_count = MQTT_KA_OFFLOAD_RETRY_COUNT,
+        .tko_retry_interval = MQTT_KA_OFFLOAD_RETRY_INTERVAL_SEC
+    };
+
+    memset(tko_iovar_buffer, 0, sizeof(tko_iovar_buffer));
+
+    /* Subcommand header, then the connection as expected by the firmware. */
+    cursor = put_le16(tko_iovar_buffer, TKO_SUBCMD_CONNECT);
+    cursor = put_le16(cursor, (uint16_t)(TKO_IOVAR_LEN - TKO_CMD_HEADER_LEN));
+    *cursor++ = (uint8_t)MQTT_KA_OFFLOAD_TKO_INDEX;
+    *cursor++ = (uint8_t)TKO_IP_ADDR_TYPE_IPV4;
+    cursor = put_le16(cursor, session->local_port);
+    cursor = put_le16(cursor, session->remote_port);
+    cursor = put_le32(cursor, session->snd_nxt);
+    cursor = put_le32(cursor, session->rcv_nxt);
+    cursor = put_le16(cursor, TKO_PACKET_LEN);
+    cursor = put_le16(cursor, TKO_PACKET_LEN);
+
+    memcpy(cursor, &session->local_ip, sizeof(uint32_t));
+    cursor += sizeof(uint32_t);
+    memcpy(cursor, &session->remote_ip, sizeof(uint32_t));
+    cursor += sizeof(uint32_t);
+
+    build_packet(cursor, session->local_ip, session->remote_ip, session->local_port,
+                 session->remote_port, session->snd_nxt - 1U, session->rcv_nxt,
+                 session->rcv_wnd, session->ttl);
+    cursor += TKO_PACKET_LEN;
+    build_packet(cursor, session->remote_ip, session->local_ip, session->remote_port,
+                 session->local_port, session->rcv_nxt, session->snd_nxt,
+                 session->snd_wnd, session->ttl);
+
+    result = whd_wifi_set_iovar_buffer(whd_ifp, TKO_IOVAR, tko_iovar_buffer,
+                                       (uint16_t)sizeof(tko_iovar_buffer));
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_tko_param(whd_ifp, &retry, TKO_PARAM_SET);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: match_frame_byte
+********************************************************************************
+* Summary:
+*  Sets one byte of the wake pattern that must match, by its frame offset.
+*
+* Parameters:
+*  uint8_t *pattern: Pattern starting at WAKE_PATTERN_OFFSET
+*  uint8_t *mask: Per-byte match flags of the pattern
+*  uint32_t position: Offset of the byte in the frame
+*  uint8_t value: Value the byte must have
+*
+*******************************************************************************/
+static void match_frame_byte(uint8_t *pattern, uint8_t *mask, uint32_t position, uint8_t value)
+{
+    pattern[position - WAKE_PATTERN_OFFSET] = value;
+    mask[position - WAKE_PATTERN_OFFSET] = WAKE_BYTE_MATCH;
+}
+
+/*******************************************************************************
+* Function Name: program_wake_pattern
+********************************************************************************
+* Summary:
+*  Replaces the wake pattern with one matching a QoS 0 PUBLISH on 'topic' from
+*  the broker on this connection. The one-byte remaining length is not
+*  matched, so every message on the topic shorter than 128 bytes after the
+*  fixed header wakes the host.
+*
+* Parameters:
+*  const mqtt_ka_session_t *session: Broker connection
+*  const char *topic: Subscribed topic
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS, MQTT_KA_OFFLOAD_RSLT_BAD_TOPIC, or the WOWL
+*  error
+*
+*******************************************************************************/
+static cy_rslt_t program_wake_pattern(const mqtt_ka_session_t *session, const char *topic)
+{
+    cy_rslt_t result;
+    uint8_t pattern[WOWL_MAX_PATTERN_LEN];
+    uint8_t mask[WOWL_MAX_PATTERN_LEN];
+    uint32_t topic_len = strlen(topic);
+    uint32_t len = WAKE_MQTT_TOPIC_POS + topic_len - WAKE_PATTERN_OFFSET;
+
+    if ((0U == topic_len) || (WAKE_PATTERN_MAX_TOPIC_LEN < topic_len))
+    {
+        printf("MQTT topic '%s' does not fit a wake pattern\n", topic);
+        return MQTT_KA_OFFLOAD_RSLT_BAD_TOPIC;
+    }
+
+    if (wake_pattern_added)
+    {
+        result = wowl_pattern_remove(wake_pattern_id);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            return result;
+        }
+        wake_pattern_added = false;
+    }
+
+    /* Bytes not set below are left as "any". */
+    memset(pattern, 0, sizeof(pattern));
+    memset(mask, 0, sizeof(mask));
+    match_frame_byte(pattern, mask, WAKE_PATTERN_OFFSET, WAKE_ETHERTYPE_IPV4_HI);
+    match_frame_byte(pattern, mask, WAKE_PATTERN_OFFSET + 1U, WAKE_ETHERTYPE_IPV4_LO);
+    match_frame_byte(pattern, mask, WAKE_IP_VHL_POS, WAKE_IP_VHL);
+    match_frame_byte(pattern, mask, WAKE_IP_PROTO_POS, IP_PROTO_TCP);
+    for (uint32_t i = 0U; i < sizeof(uint32_t); i++)
+    {
+        match_frame_byte(pattern, mask, WAKE_IP_SRC_POS + i,
+                         ((const uint8_t *)&session->remote_ip)[i]);
+        match_frame_byte(pattern, mask, WAKE_IP_DST_POS + i,
+                         ((const uint8_t *)&session->local_ip)[i]);
+    }
+    match_frame_byte(pattern, mask, WAKE_TCP_SRC_PORT_POS, (uint8_t)(session->remote_port >> 8));
+    match_frame_byte(pattern, mask, WAKE_TCP_SRC_PORT_POS + 1U, (uint8_t)session->remote_port);
+    match_frame_byte(pattern, mask, WAKE_TCP_DST_PORT_POS, (uint8_t)(session->local_port >> 8));
+    match_frame_byte(pattern, mask, WAKE_TCP_DST_PORT_POS + 1U, (uint8_t)session->local_port);
+    match_frame_byte(pattern, mask, WAKE_TCP_HDRLEN_POS, WAKE_TCP_HDRLEN);
+    match_frame_byte(pattern, mask, WAKE_MQTT_TYPE_POS, WAKE_MQTT_PUBLISH_QOS0);
+    match_frame_byte(pattern, mask, WAKE_MQTT_TOPIC_LEN_POS, (uint8_t)(topic_len >> 8));
+    match_frame_byte(pattern, mask, WAKE_MQTT_TOPIC_LEN_POS + 1U, (uint8_t)topic_len);
+    for (uint32_t i = 0U; i < topic_len; i++)
+    {
+        match_frame_byte(pattern, mask, WAKE_MQTT_TOPIC_POS + i, (uint8_t)topic[i]);
+    }
+
+    result = wowl_pattern_add(WAKE_PATTERN_OFFSET, pattern, mask, len, &wake_pattern_id);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        wake_pattern_added = true;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: mqtt_ka_offload_arm
+********************************************************************************
+* Summary:
+*  Called by the network task on each suspend edge while the session is up.
+*  Reads the broker connection from lwIP and, when it changed or was used
+*  since it was last programmed, programs the TKO connection and the wake
+*  pattern again. Then enables the offload for this suspend.
+*
+* Parameters:
+*  const char *topic: Subscribed topic whose messages wake the host
+*  uint16_t broker_port: Broker TCP port
+*  uint16_t interval_sec: Keepalive interval
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the offload is armed,
+*  MQTT_KA_OFFLOAD_RSLT_NOT_READY if the connection cannot be handed over
+*  yet, or the error
+*
+*******************************************************************************/
+cy_rslt_t mqtt_ka_offload_arm(const char *topic, uint16_t broker_port, uint16_t interval_sec)
+{
+    cy_rslt_t result;
+    whd_interface_t whd_ifp;
+    mqtt_ka_session_t session;
+    bool stale = session_stale;
+
+    session_stale = false;
+
+    result = read_session(broker_port, &session);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        session_stale = true;
+        return result;
+    }
+
+    result = cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &whd_ifp);
+
+    if ((CY_RSLT_SUCCESS == result) &&
+        (stale || !session_programmed ||
+         (0 != memcmp(&session, &programmed_session, sizeof(session)))))
+    {
+        session_programmed = false;
+        result = program_connection(whd_ifp, &session, interval_sec);
+
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = program_wake_pattern(&session, topic);
+        }
+
+        if (CY_RSLT_SUCCESS == result)
+        {
+            programmed_session = session;
+            session_programmed = true;
+        }
+    }
+
+    if ((CY_RSLT_SUCCESS == result) && !offload_armed)
+    {
+        result = whd_tko_toggle(whd_ifp, WHD_TRUE);
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("MQTT keepalive offload arm failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        session_stale = true;
+        return result;
+    }
+
+    offload_armed = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: mqtt_ka_offload_check
+********************************************************************************
+* Summary:
+*  Called by the network task after a resume. Reads the status of the broker
+*  connection slot and gives the connection back to lwIP. A connection the
+*  firmware saw no answer on, or saw the broker reset, is reported as lost so
+*  that the client reconnects instead of publishing into a dead session.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the connection is alive or the offload is not
+*  armed, MQTT_KA_OFFLOAD_RSLT_LOST if it is lost, or the WHD error
+*
+*******************************************************************************/
+cy_rslt_t mqtt_ka_offload_check(void)
+{
+    cy_rslt_t result;
+    whd_interface_t whd_ifp;
+    whd_tko_status_t status;
+    uint8_t connection_status;
+
+    if (!offload_armed)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    result = cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &whd_ifp);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_tko_get_status(whd_ifp, &status);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_tko_toggle(whd_ifp, WHD_FALSE);
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("MQTT keepalive offload status failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        return result;
+    }
+
+    offload_armed = false;
+
+    if ((MQTT_KA_OFFLOAD_TKO_INDEX < status.count) &&
+        (MQTT_KA_OFFLOAD_TKO_INDEX < (sizeof(status.status) / sizeof(status.status[0]))))
+    {
+        connection_status = status.status[MQTT_KA_OFFLOAD_TKO_INDEX];
+
+        if ((TKO_STATUS_NO_RESPONSE == connection_status) ||
+            (TKO_STATUS_UNEXPECT_TCP_FLAG == connection_status))
+        {
+            printf("MQTT keepalive offload: broker connection lost (status %u)\n",
+                   (unsigned int)connection_status);
+            return MQTT_KA_OFFLOAD_RSLT_LOST;
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: mqtt_ka_offload_rearm
+********************************************************************************
+* Summary:
+*  Marks the programmed connection out of date after the session sent or
+*  received data, so that the next suspend edge programs the current sequence
+*  numbers. Safe to call from any task.
+*
+*******************************************************************************/
+void mqtt_ka_offload_rearm(void)
+{
+    session_stale = true;
+}
+
+/*******************************************************************************
+* Function Name: mqtt_ka_offload_disarm
+********************************************************************************
+* Summary:
+*  Called by the network task on a suspend edge without a session. Disables
+*  the offload and removes the wake pattern of the old connection, so that
+*  neither keeps working on a connection that no longer exists.
+*
+*******************************************************************************/
+void mqtt_ka_offload_disarm(void)
+{
+    whd_interface_t whd_ifp;
+
+    session_stale = true;
+    session_programmed = false;
+
+    if (offload_armed &&
+        (CY_RSLT_SUCCESS == cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &whd_ifp)) &&
+        (CY_RSLT_SUCCESS == whd_tko_toggle(whd_ifp, WHD_FALSE)))
+    {
+        offload_armed = false;
+    }
+
+    if (wake_pattern_added && (CY_RSLT_SUCCESS == wowl_pattern_remove(wake_pattern_id)))
+    {
+        wake_pattern_added = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: mqtt_ka_offload_is_armed
+********************************************************************************
+* Summary:
+*  Reports whether the offload is enabled for the current suspend.
+*
+* Return:
+*  bool: true if the offload is armed
+*
+*******************************************************************************/
+bool mqtt_ka_offload_is_armed(void)
+{
+    return offload_armed;
+}
+
+#endif /* (MQTT_CLIENT_MODE) */
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/*******************************************************************************
+* File Name:   mqtt_keepalive_offload.h
+*
+* Description: This file contains declarations of functions that keep the MQTT
+* broker connection alive through the WLAN firmware TCP keepalive offload and
+* wake the host only for messages on the subscribed topic.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef MQTT_KEEPALIVE_OFFLOAD_H_
+#define MQTT_KEEPALIVE_OFFLOAD_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* TKO connection slot of the broker connection. The lower slots are left to
+ * the TCP keepalive offload connections configured in the Device Configurator.
+ */
+#define MQTT_KA_OFFLOAD_TKO_INDEX                (3U)
+
+/* Unanswered keepalives the firmware retries, and the time between them,
+ * before it reports the connection as lost and wakes the host.
+ */
+#define MQTT_KA_OFFLOAD_RETRY_COUNT              (3U)
+#define MQTT_KA_OFFLOAD_RETRY_INTERVAL_SEC       (5U)
+
+/* Results returned by this module. */
+#define MQTT_KA_OFFLOAD_RSLT_LOST                APP_RSLT_ERROR(APP_RSLT_GROUP_MQTT_KA_OFFLOAD, 1U)
+#define MQTT_KA_OFFLOAD_RSLT_NOT_READY           APP_RSLT_ERROR(APP_RSLT_GROUP_MQTT_KA_OFFLOAD, 2U)
+#define MQTT_KA_OFFLOAD_RSLT_BAD_TOPIC           APP_RSLT_ERROR(APP_RSLT_GROUP_MQTT_KA_OFFLOAD, 3U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t mqtt_ka_offload_arm(const char *topic, uint16_t broker_port, uint16_t interval_sec);
+cy_rslt_t mqtt_ka_offload_check(void);
+void mqtt_ka_offload_rearm(void);
+void mqtt_ka_offload_disarm(void);
+bool mqtt_ka_offload_is_armed(void);
+
+#endif /* MQTT_KEEPALIVE_OFFLOAD_H_ */
+
+/* [] END OF FILE */
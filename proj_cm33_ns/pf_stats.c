@@ -0,0 +1,275 @@
+/*******************************************************************************
+* File Name:   pf_stats.c
+*
+* Description: This file contains the packet filter statistics. The WLAN
+* firmware counts, per packet filter, the frames it matched, forwarded to the
+* host and discarded. The counters are read only when the network task has
+* resumed anyway, so reading them never wakes the host or the bus. Each report
+* prints the pass and drop rate of every filter since the previous report and
+* a PF_STATS line with the totals for pf_rule_compiler.py --hits.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include "cyabs_rtos.h"
+#include <stdio.h>
+#include <inttypes.h>
+
+/* Wi-Fi connection manager and Wi-Fi host driver header files. */
+#include "cy_wcm.h"
+#include "whd_wifi_api.h"
+
+#include "pf_stats.h"
+
+#if (PF_STATS)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define MS_PER_MINUTE                            (60000U)
+#define PERCENT                                  (100U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    pf_stats_filter_t total;
+    pf_stats_filter_t base;      /* Firmware counters at pf_stats_init() */
+    pf_stats_filter_t reported;  /* Totals at the previous report */
+} filter_record_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static filter_record_t records[PF_STATS_MAX_FILTERS];
+static uint32_t record_count;
+static whd_interface_t whd_ifp;
+static cy_time_t start_ms;
+static cy_time_t last_report_ms;
+
+/*******************************************************************************
+* Function Name: read_filter
+*******************************************************************************/
+static cy_rslt_t read_filter(uint8_t id, pf_stats_filter_t *filter)
+{
+    whd_pkt_filter_stats_t stats;
+    cy_rslt_t result = whd_pf_get_packet_filter_stats(whd_ifp, id, &stats);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        filter->id = id;
+        filter->matched = stats.num_pkts_matched;
+        filter->forwarded = stats.num_pkts_forwarded;
+        filter->discarded = stats.num_pkts_discarded;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: refresh
+********************************************************************************
+* Summary:
+*  Reads the firmware counters of all filters. Must only be called while the
+*  host is awake for another reason.
+*
+*******************************************************************************/
+static void refresh(void)
+{
+    pf_stats_filter_t now;
+
+    for (uint32_t index = 0U; index < record_count; index++)
+    {
+        filter_record_t *record = &records[index];
+
+        if (CY_RSLT_SUCCESS == read_filter(record->total.id, &now))
+        {
+            record->total.matched = now.matched - record->base.matched;
+            record->total.forwarded = now.forwarded - record->base.forwarded;
+            record->total.discarded = now.discarded - record->base.discarded;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: pf_stats_init
+********************************************************************************
+* Summary:
+*  Finds the packet filters the firmware keeps counters for and takes their
+*  current values as the base. Call once the packet filter offload is
+*  configured, after the AP is joined.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if at least one filter is found
+*
+*******************************************************************************/
+cy_rslt_t pf_stats_init(void)
+{
+    pf_stats_filter_t filter;
+    cy_rslt_t result = cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &whd_ifp);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    record_count = 0U;
+    for (uint32_t id = 0U; id < PF_STATS_MAX_FILTERS; id++)
+    {
+        if (CY_RSLT_SUCCESS == read_filter((uint8_t)id, &filter))
+        {
+            records[record_count].base = filter;
+            records[record_count].total.id = (uint8_t)id;
+            record_count++;
+        }
+    }
+
+    (void)cy_rtos_get_time(&start_ms);
+    last_report_ms = start_ms;
+
+    if (0U == record_count)
+    {
+        printf("PF stats: the firmware reports no packet filters\n");
+        return PF_STATS_RSLT_NO_FILTERS;
+    }
+
+    printf("PF stats: %"PRIu32" packet filters\n", record_count);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: pf_stats_get
+********************************************************************************
+* Summary:
+*  Returns the totals since pf_stats_init() as of the last read.
+*
+* Parameters:
+*  pf_stats_filter_t *filters: Receives one entry per filter
+*  uint32_t max_filters: Entries available in filters
+*
+* Return:
+*  uint32_t: Number of entries written
+*
+*******************************************************************************/
+uint32_t pf_stats_get(pf_stats_filter_t *filters, uint32_t max_filters)
+{
+    uint32_t count = (record_count < max_filters) ? record_count : max_filters;
+
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        filters[index] = records[index].total;
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: pf_stats_poll
+********************************************************************************
+* Summary:
+*  Called by the network task after each resume. Reads the counters and
+*  prints the report every PF_STATS_REPORT_INTERVAL_S seconds.
+*
+*******************************************************************************/
+void pf_stats_poll(void)
+{
+    cy_time_t now;
+
+    (void)cy_rtos_get_time(&now);
+    if ((0U != record_count) &&
+        ((now - last_report_ms) >= (PF_STATS_REPORT_INTERVAL_S * 1000U)))
+    {
+        pf_stats_report();
+    }
+}
+
+/*******************************************************************************
+* Function Name: pf_stats_report
+********************************************************************************
+* Summary:
+*  Reads the counters and prints, per filter, the frames matched, forwarded
+*  and discarded per minute since the previous report and the share passed to
+*  the host. A filter with a high forward rate on a quiet link lets the noise
+*  through that wakes the host. The PF_STATS line carries the totals.
+*
+*******************************************************************************/
+void pf_stats_report(void)
+{
+    cy_time_t now;
+    uint32_t window_ms;
+
+    refresh();
+    (void)cy_rtos_get_time(&now);
+    window_ms = (now > last_report_ms) ? (now - last_report_ms) : 1U;
+    last_report_ms = now;
+
+    printf("PF filter  matched/min  forwarded/min  discarded/min  passed(%%)\n");
+    for (uint32_t index = 0U; index < record_count; index++)
+    {
+        filter_record_t *record = &records[index];
+        uint32_t matched = record->total.matched - record->reported.matched;
+        uint32_t forwarded = record->total.forwarded - record->reported.forwarded;
+        uint32_t discarded = record->total.discarded - record->reported.discarded;
+
+        printf("%9u  %11"PRIu32"  %13"PRIu32"  %13"PRIu32"  %9"PRIu32"\n",
+               (unsigned int)record->total.id,
+               (uint32_t)(((uint64_t)matched * MS_PER_MINUTE) / window_ms),
+               (uint32_t)(((uint64_t)forwarded * MS_PER_MINUTE) / window_ms),
+               (uint32_t)(((uint64_t)discarded * MS_PER_MINUTE) / window_ms),
+               (0U != matched) ? (uint32_t)(((uint64_t)forwarded * PERCENT) / matched) : 0U);
+
+        record->reported = record->total;
+    }
+
+    printf("PF_STATS {\"elapsed_ms\":%"PRIu32",\"filters\":[", (uint32_t)(now - start_ms));
+    for (uint32_t index = 0U; index < record_count; index++)
+    {
+        printf("%s{\"id\":%u,\"matched\":%"PRIu32",\"forwarded\":%"PRIu32
+               ",\"discarded\":%"PRIu32"}", (0U == index) ? "" : ",",
+               (unsigned int)records[index].total.id, records[index].total.matched,
+               records[index].total.forwarded, records[index].total.discarded);
+    }
+    printf("]}\n");
+}
+
+#endif /* PF_STATS */
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/*******************************************************************************
+* File Name:   pf_stats.h
+*
+* Description: This file contains the configuration and declarations of the
+* packet filter statistics, which read the per-filter hit counters of the
+* WLAN firmware packet filter offload.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PF_STATS_H_
+#define PF_STATS_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to report the packet filter hit counters. */
+#ifndef PF_STATS
+#define PF_STATS                                 (0U)
+#endif
+
+/* Filter IDs probed for counters; covers the LPA packet filter table. */
+#define PF_STATS_MAX_FILTERS                     (16U)
+
+/* Interval at which the network task reads and prints the counters. */
+#define PF_STATS_REPORT_INTERVAL_S               (300U)
+
+/* Results returned by this module. */
+#define PF_STATS_RSLT_NO_FILTERS                 APP_RSLT_ERROR(APP_RSLT_GROUP_PF_STATS, 1U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Totals of one filter since pf_stats_init(). */
+typedef struct
+{
+    uint8_t id;
+    uint32_t matched;
+    uint32_t forwarded;          /* Passed to the host; may wake it */
+    uint32_t discarded;
+} pf_stats_filter_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t pf_stats_init(void);
+uint32_t pf_stats_get(pf_stats_filter_t *filters, uint32_t max_filters);
+void pf_stats_poll(void);
+void pf_stats_report(void);
+
+#endif /* PF_STATS_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,580 @@
+/*******************************************************************************
+* File Name:   power_profile.c
+*
+* Description: This file contains the named power profiles. Selecting a
+* profile programs the WLAN power-save mode and listen interval, the keepalive
+* of the connected TCP socket, the suspend window used by the network task,
+* and whether the MCU may enter deep sleep, rolling back if any step fails.
+* The time spent in every profile is recorded.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include "cyabs_rtos.h"
+#include "mtb_hal.h"
+#include <string.h>
+#include <inttypes.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Wi-Fi connection manager and Wi-Fi host driver header files. */
+#include "cy_wcm.h"
+#include "whd_wifi_api.h"
+
+#include "power_profile.h"
+
+#if (POWER_PROFILES)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define POWER_PROFILE_COUNT                      (POWER_PROFILE_BUILTIN_COUNT + \
+                                                  POWER_PROFILE_MAX_USER)
+#define POWER_PROFILE_BALANCED_INDEX             (1U)
+#define MS_PER_SEC                               (1000U)
+#define PERCENT                                  (100U)
+#define TKO_PARAM_SET                            (1U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Built-in profiles followed by the user-defined ones. The suspend window and
+ * keepalive of "balanced" are taken from the network settings at init.
+ */
+static power_profile_t profiles[POWER_PROFILE_COUNT] =
+{
+    {
+        .name                  = "latency",
+        .inactive_interval_ms  = 1000U,
+        .inactive_window_ms    = 900U,
+        .keepalive_idle_ms     = 10000U,
+        .keepalive_interval_ms = 1000U,
+        .keepalive_count       = 2U,
+        .wlan_ps               = { WLAN_PS_PM2, 200U, 1U },
+        .allow_deepsleep       = false
+    },
+    {
+        .name                  = "balanced",
+        .wlan_ps               = { WLAN_PS_PM2, 50U, 1U },
+        .allow_deepsleep       = true
+    },
+    {
+        .name                  = "deep-saver",
+        .inactive_interval_ms  = 100U,
+        .inactive_window_ms    = 50U,
+        .keepalive_idle_ms     = 60000U,
+        .keepalive_interval_ms = 5000U,
+        .keepalive_count       = 3U,
+        .wlan_ps               = { WLAN_PS_PM1, 0U, 3U },
+        .allow_deepsleep       = true
+    }
+};
+
+static uint32_t profile_count = POWER_PROFILE_BUILTIN_COUNT;
+static uint32_t active_index = POWER_PROFILE_BALANCED_INDEX;
+static bool profile_applied = false;
+
+/* Time spent in every profile, and when the active one was entered. */
+static uint64_t residency_ms[POWER_PROFILE_COUNT];
+static TickType_t entered_tick;
+
+/* Suspend window read by the network task on every cycle. */
+static volatile uint32_t suspend_interval_ms;
+static volatile uint32_t suspend_window_ms;
+
+static cy_mutex_t profile_mutex;
+static cy_socket_t attached_socket;
+static bool socket_attached = false;
+
+/* Whether this module holds the HAL deep sleep lock for the active profile. */
+static bool deepsleep_locked = false;
+
+/*******************************************************************************
+* Function Name: find_profile
+********************************************************************************
+* Summary:
+*  Looks up a profile by name.
+*
+* Parameters:
+*  const char *name: Profile name
+*
+* Return:
+*  uint32_t: Index of the profile, or profile_count if not found
+*
+*******************************************************************************/
+static uint32_t find_profile(const char *name)
+{
+    uint32_t index;
+
+    for (index = 0U; index < profile_count; index++)
+    {
+        if (0 == strncmp(profiles[index].name, name, POWER_PROFILE_NAME_LEN))
+        {
+            break;
+        }
+    }
+
+    return index;
+}
+
+/*******************************************************************************
+* Function Name: apply_tko
+********************************************************************************
+* Summary:
+*  Programs the keepalive of a profile into the TCP keepalive offload, which
+*  sends the keepalives while the network stack is suspended. The offload
+*  counts in seconds; shorter times are rounded up to one second.
+*
+* Parameters:
+*  const power_profile_t *profile: Profile to apply
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the offload is reconfigured
+*
+*******************************************************************************/
+static cy_rslt_t apply_tko(const power_profile_t *profile)
+{
+    cy_rslt_t result;
+    whd_interface_t whd_ifp;
+    whd_tko_retry_t retry =
+    {
+        .tko_interval = (uint16_t)((profile->keepalive_idle_ms + MS_PER_SEC - 1U) / MS_PER_SEC),
+        .tko_retry_count = (uint16_t)profile->keepalive_count,
+        .tko_retry_interval = (uint16_t)((profile->keepalive_interval_ms + MS_PER_SEC - 1U) /
+                                         MS_PER_SEC)
+    };
+
+    result = cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &whd_ifp);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_tko_param(whd_ifp, &retry, TKO_PARAM_SET);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: apply_socket
+********************************************************************************
+* Summary:
+*  Programs the TCP keepalive of a profile on the attached socket, if any,
+*  and into the TCP keepalive offload that takes over the socket while the
+*  network stack is suspended.
+*
+* Parameters:
+*  const power_profile_t *profile: Profile to apply
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the keepalive is applied
+*
+*******************************************************************************/
+static cy_rslt_t apply_socket(const power_profile_t *profile)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t value;
+
+    if (!socket_attached)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    value = profile->keepalive_interval_ms;
+    result = cy_socket_setsockopt(attached_socket, CY_SOCKET_SOL_TCP,
+                                  CY_SOCKET_SO_TCP_KEEPALIVE_INTERVAL,
+                                  &value, sizeof(value));
+    if (CY_RSLT_SUCCESS == result)
+    {
+        value = profile->keepalive_count;
+        result = cy_socket_setsockopt(attached_socket, CY_SOCKET_SOL_TCP,
+                                      CY_SOCKET_SO_TCP_KEEPALIVE_COUNT,
+                                      &value, sizeof(value));
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        value = profile->keepalive_idle_ms;
+        result = cy_socket_setsockopt(attached_socket, CY_SOCKET_SOL_TCP,
+                                      CY_SOCKET_SO_TCP_KEEPALIVE_IDLE_TIME,
+                                      &value, sizeof(value));
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = apply_tko(profile);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: publish_profile
+********************************************************************************
+* Summary:
+*  Makes a profile the active one: closes the residency of the previous
+*  profile, publishes the suspend window and takes or releases the HAL deep
+*  sleep lock.
+*
+* Parameters:
+*  uint32_t index: Index of the profile
+*
+*******************************************************************************/
+static void publish_profile(uint32_t index)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    taskENTER_CRITICAL();
+    if (profile_applied)
+    {
+        residency_ms[active_index] += (uint64_t)(now - entered_tick) * portTICK_PERIOD_MS;
+    }
+    entered_tick = now;
+    active_index = index;
+    profile_applied = true;
+    suspend_interval_ms = profiles[index].inactive_interval_ms;
+    suspend_window_ms = profiles[index].inactive_window_ms;
+    taskEXIT_CRITICAL();
+
+    /* Idle time is spent in Sleep, with its faster wakeup, while locked. */
+    if (!profiles[index].allow_deepsleep && !deepsleep_locked)
+    {
+        mtb_hal_syspm_lock_deepsleep();
+        deepsleep_locked = true;
+    }
+    else if (profiles[index].allow_deepsleep && deepsleep_locked)
+    {
+        mtb_hal_syspm_unlock_deepsleep();
+        deepsleep_locked = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: power_profile_init
+********************************************************************************
+* Summary:
+*  Completes the "balanced" profile from the network settings and selects
+*  the stored profile, or POWER_PROFILE_DEFAULT. Must be called once the
+*  Wi-Fi device is connected to the AP.
+*
+* Parameters:
+*  const config_store_net_t *base: Network settings
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if a profile is applied
+*
+*******************************************************************************/
+cy_rslt_t power_profile_init(const config_store_net_t *base)
+{
+    cy_rslt_t result;
+    power_profile_t *balanced = &profiles[POWER_PROFILE_BALANCED_INDEX];
+    char name[POWER_PROFILE_NAME_LEN] = POWER_PROFILE_DEFAULT;
+
+    balanced->inactive_interval_ms = base->inactive_interval_ms;
+    balanced->inactive_window_ms = base->inactive_window_ms;
+    balanced->keepalive_idle_ms = base->keepalive_idle_ms;
+    balanced->keepalive_interval_ms = base->keepalive_interval_ms;
+    balanced->keepalive_count = base->keepalive_count;
+
+    /* The network task may suspend before a profile has been applied. */
+    suspend_interval_ms = base->inactive_interval_ms;
+    suspend_window_ms = base->inactive_window_ms;
+
+    result = cy_rtos_mutex_init(&profile_mutex, false);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+#if (CONFIG_STORE)
+    uint32_t length = sizeof(name) - 1U;
+
+    if (CY_RSLT_SUCCESS == config_store_read(CONFIG_KEY_POWER_PROFILE, name, &length))
+    {
+        name[length] = '\0';
+    }
+#endif
+
+    result = power_profile_select(name);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        result = power_profile_select(POWER_PROFILE_DEFAULT);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: power_profile_register
+********************************************************************************
+* Summary:
+*  Adds a user-defined profile, or replaces a user-defined profile of the
+*  same name. Built-in profiles cannot be replaced. Must be called after
+*  power_profile_init().
+*
+* Parameters:
+*  const power_profile_t *profile: Profile to add
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the profile is registered
+*
+*******************************************************************************/
+cy_rslt_t power_profile_register(const power_profile_t *profile)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t index;
+
+    if (profile->inactive_window_ms > profile->inactive_interval_ms)
+    {
+        printf("Power profile '%s': window exceeds interval\n", profile->name);
+        return POWER_PROFILE_RSLT_INVALID;
+    }
+
+    cy_rtos_mutex_get(&profile_mutex, CY_RTOS_NEVER_TIMEOUT);
+
+    index = find_profile(profile->name);
+    if (index < POWER_PROFILE_BUILTIN_COUNT)
+    {
+        result = POWER_PROFILE_RSLT_BUILTIN;
+    }
+    else if (index < profile_count)
+    {
+        /* Re-apply through power_profile_select() for a change to the
+         * active profile to take effect.
+         */
+        profiles[index] = *profile;
+    }
+    else if (profile_count < POWER_PROFILE_COUNT)
+    {
+        profiles[profile_count] = *profile;
+        profiles[profile_count].name[POWER_PROFILE_NAME_LEN - 1U] = '\0';
+        profile_count++;
+    }
+    else
+    {
+        result = POWER_PROFILE_RSLT_TABLE_FULL;
+    }
+
+    cy_rtos_mutex_set(&profile_mutex);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Power profile '%s' could not be registered\n", profile->name);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: power_profile_select
+********************************************************************************
+* Summary:
+*  Applies every setting of a profile. If the radio or socket rejects a
+*  setting, the previous profile is restored and stays active.
+*
+* Parameters:
+*  const char *name: Profile name
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the profile is active
+*
+*******************************************************************************/
+cy_rslt_t power_profile_select(const char *name)
+{
+    cy_rslt_t result;
+    uint32_t index;
+
+    cy_rtos_mutex_get(&profile_mutex, CY_RTOS_NEVER_TIMEOUT);
+
+    index = find_profile(name);
+    if (index >= profile_count)
+    {
+        cy_rtos_mutex_set(&profile_mutex);
+        printf("Power profile '%s' not found\n", name);
+        return POWER_PROFILE_RSLT_NOT_FOUND;
+    }
+
+    result = wlan_ps_apply(&profiles[index].wlan_ps);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = apply_socket(&profiles[index]);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        publish_profile(index);
+    }
+    else if (profile_applied)
+    {
+        (void)wlan_ps_apply(&profiles[active_index].wlan_ps);
+        (void)apply_socket(&profiles[active_index]);
+    }
+
+    cy_rtos_mutex_set(&profile_mutex);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Power profile '%s' failed! Error code: 0x%08"PRIx32"\n", name, (uint32_t)result);
+        return result;
+    }
+
+#if (CONFIG_STORE)
+    /* Start in the same profile after a reboot. */
+    (void)config_store_write(CONFIG_KEY_POWER_PROFILE, profiles[index].name,
+                             strnlen(profiles[index].name, POWER_PROFILE_NAME_LEN));
+#endif
+
+    printf("Power profile: %s\n", profiles[index].name);
+    power_profile_print_stats();
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: power_profile_get_active
+********************************************************************************
+* Summary:
+*  Returns the active profile.
+*
+* Return:
+*  const power_profile_t*: Active profile
+*
+*******************************************************************************/
+const power_profile_t *power_profile_get_active(void)
+{
+    return &profiles[active_index];
+}
+
+/*******************************************************************************
+* Function Name: power_profile_get_suspend_window
+********************************************************************************
+* Summary:
+*  Returns the suspend interval and window of the active profile as a
+*  consistent pair.
+*
+* Parameters:
+*  uint32_t *interval_ms: Inactive interval for wait_net_suspend()
+*  uint32_t *window_ms: Inactive window for wait_net_suspend()
+*
+*******************************************************************************/
+void power_profile_get_suspend_window(uint32_t *interval_ms, uint32_t *window_ms)
+{
+    taskENTER_CRITICAL();
+    *interval_ms = suspend_interval_ms;
+    *window_ms = suspend_window_ms;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: power_profile_attach_socket
+********************************************************************************
+* Summary:
+*  Applies the keepalive of the active profile to a connected TCP socket and
+*  keeps doing so on later profile changes.
+*
+* Parameters:
+*  cy_socket_t socket: Connected TCP socket
+*
+*******************************************************************************/
+void power_profile_attach_socket(cy_socket_t socket)
+{
+    cy_rtos_mutex_get(&profile_mutex, CY_RTOS_NEVER_TIMEOUT);
+
+    attached_socket = socket;
+    socket_attached = true;
+    if (CY_RSLT_SUCCESS != apply_socket(&profiles[active_index]))
+    {
+        printf("Power profile: keepalive not applied to the socket\n");
+    }
+
+    cy_rtos_mutex_set(&profile_mutex);
+}
+
+/*******************************************************************************
+* Function Name: power_profile_detach_socket
+********************************************************************************
+* Summary:
+*  Stops applying keepalive settings to the socket. Must be called before
+*  the socket is deleted.
+*
+*******************************************************************************/
+void power_profile_detach_socket(void)
+{
+    cy_rtos_mutex_get(&profile_mutex, CY_RTOS_NEVER_TIMEOUT);
+    socket_attached = false;
+    cy_rtos_mutex_set(&profile_mutex);
+}
+
+/*******************************************************************************
+* Function Name: power_profile_print_stats
+********************************************************************************
+* Summary:
+*  Prints the time spent in every profile.
+*
+*******************************************************************************/
+void power_profile_print_stats(void)
+{
+    uint64_t time_ms[POWER_PROFILE_COUNT];
+    uint64_t total_ms = 0U;
+    TickType_t now = xTaskGetTickCount();
+    uint32_t index;
+
+    taskENTER_CRITICAL();
+    memcpy(time_ms, residency_ms, sizeof(time_ms));
+    if (profile_applied)
+    {
+        time_ms[active_index] += (uint64_t)(now - entered_tick) * portTICK_PERIOD_MS;
+    }
+    taskEXIT_CRITICAL();
+
+    for (index = 0U; index < profile_count; index++)
+    {
+        total_ms += time_ms[index];
+    }
+
+    printf("Power profile residency:\n");
+    for (index = 0U; index < profile_count; index++)
+    {
+        printf("  %-16s %10"PRIu32" s  %3"PRIu32"%%%s\n", profiles[index].name,
+               (uint32_t)(time_ms[index] / MS_PER_SEC),
+               (0U != total_ms) ? (uint32_t)((time_ms[index] * PERCENT) / total_ms) : 0U,
+               (index == active_index) ? "  (active)" : "");
+    }
+}
+
+#endif /* POWER_PROFILES */
+
+/* [] END OF FILE */
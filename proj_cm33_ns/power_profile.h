@@ -0,0 +1,106 @@
+/*******************************************************************************
+* File Name:   power_profile.h
+*
+* Description: This file contains the configuration and declarations of the
+* named power profiles, which switch the suspend window, the TCP keepalive,
+* the WLAN power-save mode and listen interval, and the deep sleep permission
+* together at runtime.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef POWER_PROFILE_H_
+#define POWER_PROFILE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include "cy_secure_sockets.h"
+#include "config_store.h"
+#include "wlan_power_save.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to control the power settings through profiles. */
+#ifndef POWER_PROFILES
+#define POWER_PROFILES                           (0U)
+#endif
+
+/* Profile selected at start-up when none is stored. */
+#define POWER_PROFILE_DEFAULT                    "balanced"
+
+#define POWER_PROFILE_NAME_LEN                   (16U)
+#define POWER_PROFILE_BUILTIN_COUNT              (3U)
+#define POWER_PROFILE_MAX_USER                   (4U)
+
+/* Results returned by this module. */
+#define POWER_PROFILE_RSLT_INVALID               APP_RSLT_ERROR(APP_RSLT_GROUP_POWER_PROFILE, 1U)
+#define POWER_PROFILE_RSLT_BUILTIN               APP_RSLT_ERROR(APP_RSLT_GROUP_POWER_PROFILE, 2U)
+#define POWER_PROFILE_RSLT_TABLE_FULL            APP_RSLT_ERROR(APP_RSLT_GROUP_POWER_PROFILE, 3U)
+#define POWER_PROFILE_RSLT_NOT_FOUND             APP_RSLT_ERROR(APP_RSLT_GROUP_POWER_PROFILE, 4U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    char name[POWER_PROFILE_NAME_LEN];
+    uint32_t inactive_interval_ms;        /* wait_net_suspend() interval */
+    uint32_t inactive_window_ms;          /* wait_net_suspend() window */
+    uint32_t keepalive_idle_ms;
+    uint32_t keepalive_interval_ms;
+    uint32_t keepalive_count;
+    wlan_ps_config_t wlan_ps;             /* WLAN power-save setting */
+    bool allow_deepsleep;                 /* false holds the MCU in Sleep */
+} power_profile_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t power_profile_init(const config_store_net_t *base);
+cy_rslt_t power_profile_register(const power_profile_t *profile);
+cy_rslt_t power_profile_select(const char *name);
+const power_profile_t *power_profile_get_active(void);
+void power_profile_get_suspend_window(uint32_t *interval_ms, uint32_t *window_ms);
+void power_profile_attach_socket(cy_socket_t socket);
+void power_profile_detach_socket(void);
+void power_profile_print_stats(void);
+
+#endif /* POWER_PROFILE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,572 @@
+/*******************************************************************************
+* File Name:   server_failover.c
+*
+* Description: This file contains the TCP server failover. Connection
+* attempts to an ordered list of server endpoints are raced in the style of
+* Happy Eyeballs (RFC 8305): the next endpoint is tried when the previous
+* attempt fails or has not answered within the stagger delay, the first
+* connection wins and the others are closed. The connect latency and
+* failures of each endpoint decide the order of the next race.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+
+#include "cy_nw_helper.h"
+
+#include "server_failover.h"
+#include "static_rtos.h"
+
+#if (SERVER_FAILOVER)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BACKUP_LIST_LEN                          (96U)
+#define IP_STRING_LEN                            (16U)
+
+/* Weight of the newest sample in the connect latency average, as 1/N. */
+#define LATENCY_AVG_WEIGHT                       (4U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* A connection attempt handed to a worker task. */
+typedef struct
+{
+    TaskHandle_t task;
+    volatile bool busy;
+    uint32_t race;
+    uint32_t endpoint;
+} attempt_worker_t;
+
+/* Outcome of an attempt, posted by the worker. */
+typedef struct
+{
+    uint32_t race;
+    uint32_t endpoint;
+    cy_rslt_t result;
+    cy_socket_t socket_handle;    /* Connected socket of the winner */
+} attempt_result_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static server_failover_endpoint_t endpoints[SERVER_FAILOVER_MAX_ENDPOINTS];
+static uint32_t endpoint_count;
+static server_failover_create_t create_socket;
+
+static attempt_worker_t workers[SERVER_FAILOVER_MAX_PARALLEL];
+static QueueHandle_t results;
+
+/* Current race and whether it already has a connection. Attempts of an
+ * earlier race, or that finish after the winner, close their socket.
+ */
+static volatile uint32_t current_race;
+static volatile bool race_decided;
+
+#if (STATIC_ALLOCATION_PROFILE)
+STATIC_RTOS_SECTION static StackType_t worker_stack[SERVER_FAILOVER_MAX_PARALLEL][SERVER_FAILOVER_WORKER_STACK_SIZE];
+STATIC_RTOS_SECTION static StaticTask_t worker_tcb[SERVER_FAILOVER_MAX_PARALLEL];
+STATIC_RTOS_SECTION static StaticQueue_t results_queue;
+STATIC_RTOS_SECTION static uint8_t results_storage[SERVER_FAILOVER_MAX_PARALLEL * sizeof(attempt_result_t)];
+#endif
+
+/*******************************************************************************
+* Function Name: endpoint_cost
+********************************************************************************
+* Summary:
+*  Expected cost of trying an endpoint: its average connect latency plus a
+*  penalty per consecutive failure. Endpoints not connected yet cost one
+*  stagger delay per position in the list so that the configured order holds.
+*
+*******************************************************************************/
+static uint32_t endpoint_cost(uint32_t index)
+{
+    const server_failover_endpoint_t *ep = &endpoints[index];
+    uint32_t cost = (0U != ep->successes) ? ep->latency_avg_ms :
+                    (index * SERVER_FAILOVER_STAGGER_MS);
+
+    return cost + (ep->consecutive_failures * SERVER_FAILOVER_FAILURE_PENALTY_MS);
+}
+
+/*******************************************************************************
+* Function Name: record_attempt
+********************************************************************************
+* Summary:
+*  Updates the statistics of an endpoint after a connection attempt.
+*
+* Parameters:
+*  uint32_t index: Endpoint
+*  bool connected: Whether the attempt connected
+*  uint32_t latency_ms: Time the attempt took
+*
+*******************************************************************************/
+static void record_attempt(uint32_t index, bool connected, uint32_t latency_ms)
+{
+    server_failover_endpoint_t *ep = &endpoints[index];
+
+    taskENTER_CRITICAL();
+    ep->attempts++;
+    if (connected)
+    {
+        ep->latency_avg_ms = (0U == ep->successes) ? latency_ms :
+            (((ep->latency_avg_ms * (LATENCY_AVG_WEIGHT - 1U)) + latency_ms) / LATENCY_AVG_WEIGHT);
+        ep->latency_last_ms = latency_ms;
+        ep->successes++;
+        ep->consecutive_failures = 0U;
+    }
+    else
+    {
+        ep->consecutive_failures++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: attempt_worker_task
+********************************************************************************
+* Summary:
+*  Runs the connection attempts handed to it. A connection that is no longer
+*  wanted, because another endpoint won or the race ended, is closed here.
+*
+* Parameters:
+*  void *arg: The worker
+*
+*******************************************************************************/
+static void attempt_worker_task(void *arg)
+{
+    attempt_worker_t *worker = (attempt_worker_t *)arg;
+
+    while (true)
+    {
+        attempt_result_t outcome;
+        TickType_t start;
+        bool won;
+
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        outcome.race = worker->race;
+        outcome.endpoint = worker->endpoint;
+        outcome.socket_handle = NULL;
+
+        start = xTaskGetTickCount();
+        outcome.result = create_socket(&outcome.socket_handle);
+        if (CY_RSLT_SUCCESS == outcome.result)
+        {
+            outcome.result = cy_socket_connect(outcome.socket_handle,
+                                               &endpoints[outcome.endpoint].address,
+                                               sizeof(cy_socket_sockaddr_t));
+        }
+
+        if ((CY_RSLT_SUCCESS != outcome.result) && (NULL != outcome.socket_handle))
+        {
+            cy_socket_delete(outcome.socket_handle);
+            outcome.socket_handle = NULL;
+        }
+
+        record_attempt(outcome.endpoint, (CY_RSLT_SUCCESS == outcome.result),
+                       (uint32_t)((xTaskGetTickCount() - start) * portTICK_PERIOD_MS));
+
+        taskENTER_CRITICAL();
+        won = (CY_RSLT_SUCCESS == outcome.result) && (outcome.race == current_race) &&
+              !race_decided;
+        if (won)
+        {
+            race_decided = true;
+        }
+        taskEXIT_CRITICAL();
+
+        if ((CY_RSLT_SUCCESS == outcome.result) && !won)
+        {
+            /* Lost the race; the connection is not needed. */
+            cy_socket_delete(outcome.socket_handle);
+            outcome.socket_handle = NULL;
+        }
+
+        worker->busy = false;
+
+        if (outcome.race == current_race)
+        {
+            (void)xQueueSend(results, &outcome, 0U);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: add_endpoint
+*******************************************************************************/
+static void add_endpoint(uint32_t ipv4, uint16_t port)
+{
+    if (endpoint_count < SERVER_FAILOVER_MAX_ENDPOINTS)
+    {
+        memset(&endpoints[endpoint_count], 0, sizeof(endpoints[endpoint_count]));
+        endpoints[endpoint_count].address.ip_address.version = CY_SOCKET_IP_VER_V4;
+        endpoints[endpoint_count].address.ip_address.ip.v4 = ipv4;
+        endpoints[endpoint_count].address.port = port;
+        endpoint_count++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: server_failover_init
+********************************************************************************
+* Summary:
+*  Builds the endpoint list from the primary server and
+*  SERVER_FAILOVER_BACKUPS and starts the attempt workers.
+*
+* Parameters:
+*  const cy_socket_sockaddr_t *primary: Primary server
+*  server_failover_create_t create: Creates the socket for an attempt
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the workers are running
+*
+*******************************************************************************/
+cy_rslt_t server_failover_init(const cy_socket_sockaddr_t *primary,
+                               server_failover_create_t create)
+{
+    char backups[BACKUP_LIST_LEN];
+    char *entry;
+    char *save = NULL;
+
+    create_socket = create;
+    endpoint_count = 0U;
+    add_endpoint(primary->ip_address.ip.v4, primary->port);
+
+    strncpy(backups, SERVER_FAILOVER_BACKUPS, sizeof(backups) - 1U);
+    backups[sizeof(backups) - 1U] = '\0';
+
+    for (entry = strtok_r(backups, ",", &save); NULL != entry;
+         entry = strtok_r(NULL, ",", &save))
+    {
+        cy_nw_ip_address_t address = { .version = NW_IP_IPV4 };
+        char *port = strchr(entry, ':');
+
+        if (NULL != port)
+        {
+            *port++ = '\0';
+        }
+
+        if (0 != cy_nw_str_to_ipv4(entry, &address))
+        {
+            printf("Server failover: ignoring backup '%s'\n", entry);
+            continue;
+        }
+
+        add_endpoint(address.ip.v4, (NULL != port) ? (uint16_t)atoi(port) : primary->port);
+    }
+
+    if (NULL != results)
+    {
+        /* Already running; only the list is rebuilt. */
+        return CY_RSLT_SUCCESS;
+    }
+
+#if (STATIC_ALLOCATION_PROFILE)
+    results = xQueueCreateStatic(SERVER_FAILOVER_MAX_PARALLEL, sizeof(attempt_result_t),
+                                 results_storage, &results_queue);
+    static_rtos_account("Failover results", sizeof(results_storage) +
+                        sizeof(results_queue), true);
+#else
+    results = xQueueCreate(SERVER_FAILOVER_MAX_PARALLEL, sizeof(attempt_result_t));
+#endif
+
+    for (uint32_t i = 0U; (NULL != results) && (i < SERVER_FAILOVER_MAX_PARALLEL); i++)
+    {
+#if (STATIC_ALLOCATION_PROFILE)
+        workers[i].task = xTaskCreateStatic(attempt_worker_task, "Failover attempt",
+                                            SERVER_FAILOVER_WORKER_STACK_SIZE, &workers[i],
+                                            SERVER_FAILOVER_WORKER_PRIORITY,
+                                            worker_stack[i], &worker_tcb[i]);
+        static_rtos_account("Failover attempt", sizeof(worker_stack[i]) +
+                            sizeof(worker_tcb[i]), true);
+#else
+        if (pdPASS != xTaskCreate(attempt_worker_task, "Failover attempt",
+                                  SERVER_FAILOVER_WORKER_STACK_SIZE, &workers[i],
+                                  SERVER_FAILOVER_WORKER_PRIORITY, &workers[i].task))
+        {
+            workers[i].task = NULL;
+        }
+#endif
+        if (NULL == workers[i].task)
+        {
+            printf("Server failover: failed to create the attempt tasks\n");
+            return SERVER_FAILOVER_RSLT_INIT_FAILED;
+        }
+    }
+
+    if (NULL == results)
+    {
+        printf("Server failover: failed to create the result queue\n");
+        return SERVER_FAILOVER_RSLT_INIT_FAILED;
+    }
+
+    printf("Server failover: %"PRIu32" endpoints\n", endpoint_count);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: start_attempt
+********************************************************************************
+* Summary:
+*  Hands a connection attempt to an idle worker.
+*
+* Return:
+*  bool: false if all workers are busy
+*
+*******************************************************************************/
+static bool start_attempt(uint32_t race, uint32_t endpoint)
+{
+    for (uint32_t i = 0U; i < SERVER_FAILOVER_MAX_PARALLEL; i++)
+    {
+        if (!workers[i].busy)
+        {
+            workers[i].busy = true;
+            workers[i].race = race;
+            workers[i].endpoint = endpoint;
+            xTaskNotifyGive(workers[i].task);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: server_failover_connect
+********************************************************************************
+* Summary:
+*  Races the endpoints, cheapest first (see endpoint_cost()). The next
+*  endpoint is started when an attempt fails or after
+*  SERVER_FAILOVER_STAGGER_MS without an answer, with at most
+*  SERVER_FAILOVER_MAX_PARALLEL attempts in flight. Returns the first
+*  connection; the other attempts close theirs when they finish.
+*
+* Parameters:
+*  cy_socket_t *socket_handle: Receives the connected socket
+*  uint32_t *endpoint: Receives the index of the endpoint that won
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if an endpoint connected
+*
+*******************************************************************************/
+cy_rslt_t server_failover_connect(cy_socket_t *socket_handle, uint32_t *endpoint)
+{
+    uint32_t order[SERVER_FAILOVER_MAX_ENDPOINTS];
+    uint32_t race;
+    uint32_t next = 0U;
+    uint32_t in_flight = 0U;
+    bool start_next = true;
+    bool late_winner;
+    cy_rslt_t result = CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(SERVER_FAILOVER_RACE_TIMEOUT_MS);
+    attempt_result_t outcome;
+
+    /* Order by cost; ties keep the configured order. */
+    for (uint32_t i = 0U; i < endpoint_count; i++)
+    {
+        uint32_t j = i;
+
+        while ((j > 0U) && (endpoint_cost(order[j - 1U]) > endpoint_cost(i)))
+        {
+            order[j] = order[j - 1U];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    taskENTER_CRITICAL();
+    race = ++current_race;
+    race_decided = false;
+    taskEXIT_CRITICAL();
+
+    (void)xQueueReset(results);
+
+    while (true)
+    {
+        TickType_t now = xTaskGetTickCount();
+        TickType_t wait;
+
+        if (start_next && (next < endpoint_count) && start_attempt(race, order[next]))
+        {
+            next++;
+            in_flight++;
+            start_next = false;
+        }
+
+        if ((0U == in_flight) && (next == endpoint_count))
+        {
+            /* Every endpoint failed. */
+            break;
+        }
+
+        if ((int32_t)(deadline - now) <= 0)
+        {
+            break;
+        }
+
+        wait = deadline - now;
+        if ((next < endpoint_count) && (wait > pdMS_TO_TICKS(SERVER_FAILOVER_STAGGER_MS)))
+        {
+            wait = pdMS_TO_TICKS(SERVER_FAILOVER_STAGGER_MS);
+        }
+
+        if (pdTRUE != xQueueReceive(results, &outcome, wait))
+        {
+            /* No answer within the stagger delay; start the next endpoint. */
+            start_next = true;
+            continue;
+        }
+
+        if (outcome.race != race)
+        {
+            continue;
+        }
+
+        in_flight--;
+        result = outcome.result;
+
+        if (NULL != outcome.socket_handle)
+        {
+            *socket_handle = outcome.socket_handle;
+            *endpoint = outcome.endpoint;
+            return CY_RSLT_SUCCESS;
+        }
+
+        start_next = true;
+    }
+
+    /* Attempts still in flight close their socket when they finish. One
+     * that won just before the deadline posts its socket; take it out of
+     * the queue and close it here, or the next race's xQueueReset() would
+     * drop it unclosed.
+     */
+    taskENTER_CRITICAL();
+    late_winner = race_decided;
+    race_decided = true;
+    taskEXIT_CRITICAL();
+
+    while (pdTRUE == xQueueReceive(results, &outcome, late_winner ? portMAX_DELAY : 0U))
+    {
+        if ((outcome.race == race) && (NULL != outcome.socket_handle))
+        {
+            cy_socket_delete(outcome.socket_handle);
+            late_winner = false;
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: server_failover_get_count
+*******************************************************************************/
+uint32_t server_failover_get_count(void)
+{
+    return endpoint_count;
+}
+
+/*******************************************************************************
+* Function Name: server_failover_get_endpoint
+********************************************************************************
+* Summary:
+*  Copies the statistics of an endpoint.
+*
+* Parameters:
+*  uint32_t index: Endpoint, in the configured order
+*  server_failover_endpoint_t *endpoint: Receives the statistics
+*
+*******************************************************************************/
+void server_failover_get_endpoint(uint32_t index, server_failover_endpoint_t *endpoint)
+{
+    if (index < endpoint_count)
+    {
+        taskENTER_CRITICAL();
+        *endpoint = endpoints[index];
+        taskEXIT_CRITICAL();
+    }
+}
+
+/*******************************************************************************
+* Function Name: server_failover_print_stats
+********************************************************************************
+* Summary:
+*  Prints the connect statistics of every endpoint.
+*
+*******************************************************************************/
+void server_failover_print_stats(void)
+{
+    server_failover_endpoint_t ep;
+    char ip_str[IP_STRING_LEN];
+
+    printf("Server failover statistics:\n");
+    printf("  %-21s %8s %8s %6s %9s %9s\n", "Endpoint", "Attempts", "Success",
+           "Rate", "Avg (ms)", "Last (ms)");
+
+    for (uint32_t i = 0U; i < endpoint_count; i++)
+    {
+        cy_nw_ip_address_t address = { .version = NW_IP_IPV4 };
+        char name[IP_STRING_LEN + 7U];
+
+        server_failover_get_endpoint(i, &ep);
+        address.ip.v4 = ep.address.ip_address.ip.v4;
+        cy_nw_ntoa(&address, ip_str);
+        snprintf(name, sizeof(name), "%s:%u", ip_str, (unsigned)ep.address.port);
+
+        printf("  %-21s %8"PRIu32" %8"PRIu32" %5"PRIu32"%% %9"PRIu32" %9"PRIu32"\n",
+               name, ep.attempts, ep.successes,
+               (0U != ep.attempts) ? ((ep.successes * 100U) / ep.attempts) : 0U,
+               ep.latency_avg_ms, ep.latency_last_ms);
+    }
+}
+
+#endif /* SERVER_FAILOVER */
+
+/* [] END OF FILE */
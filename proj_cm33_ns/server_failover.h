@@ -0,0 +1,128 @@
+/*******************************************************************************
+* File Name:   server_failover.h
+*
+* Description: This file contains the configuration and declarations of the
+* TCP server failover, which races staggered connection attempts over an
+* ordered list of server endpoints and keeps per-endpoint statistics.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SERVER_FAILOVER_H_
+#define SERVER_FAILOVER_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include "cy_secure_sockets.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to connect to the first of several TCP servers that
+ * answers instead of retrying a single one.
+ */
+#ifndef SERVER_FAILOVER
+#define SERVER_FAILOVER                          (0U)
+#endif
+
+/* Backup servers tried after the primary one (the address entered on the
+ * UART or held in the configuration store), as a comma-separated list of
+ * "a.b.c.d" or "a.b.c.d:port". Without a port, the primary port is used.
+ */
+#ifndef SERVER_FAILOVER_BACKUPS
+#define SERVER_FAILOVER_BACKUPS                  "192.168.1.11,192.168.1.12"
+#endif
+
+#define SERVER_FAILOVER_MAX_ENDPOINTS            (4U)
+
+/* Connection attempts in flight at once. Each runs in its own task because
+ * cy_socket_connect() blocks.
+ */
+#define SERVER_FAILOVER_MAX_PARALLEL             (2U)
+
+/* Delay before the next endpoint is tried while earlier attempts are still
+ * pending; the "Connection Attempt Delay" of Happy Eyeballs (RFC 8305).
+ */
+#define SERVER_FAILOVER_STAGGER_MS               (250U)
+
+/* A race gives up after this long without a connection. */
+#define SERVER_FAILOVER_RACE_TIMEOUT_MS          (30000U)
+
+/* Cost added per consecutive failure when ordering the endpoints, so that
+ * an endpoint that keeps failing is tried after those that answer.
+ */
+#define SERVER_FAILOVER_FAILURE_PENALTY_MS       (5000U)
+
+#define SERVER_FAILOVER_WORKER_STACK_SIZE        (1024U * 2U)
+#define SERVER_FAILOVER_WORKER_PRIORITY          (1U)
+
+/* Results returned by this module. */
+#define SERVER_FAILOVER_RSLT_INIT_FAILED         APP_RSLT_ERROR(APP_RSLT_GROUP_SERVER_FAILOVER, 1U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Creates a TCP client socket with its options set; see
+ * create_tcp_client_socket().
+ */
+typedef cy_rslt_t (*server_failover_create_t)(cy_socket_t *socket_handle);
+
+/* Connect statistics of one endpoint. */
+typedef struct
+{
+    cy_socket_sockaddr_t address;
+    uint32_t attempts;
+    uint32_t successes;
+    uint32_t consecutive_failures;
+    uint32_t latency_avg_ms;      /* Moving average of successful connects */
+    uint32_t latency_last_ms;
+} server_failover_endpoint_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t server_failover_init(const cy_socket_sockaddr_t *primary,
+                               server_failover_create_t create);
+cy_rslt_t server_failover_connect(cy_socket_t *socket_handle, uint32_t *endpoint);
+uint32_t server_failover_get_count(void);
+void server_failover_get_endpoint(uint32_t index, server_failover_endpoint_t *endpoint);
+void server_failover_print_stats(void);
+
+#endif /* SERVER_FAILOVER_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,174 @@
+/*******************************************************************************
+* File Name:   static_rtos.c
+*
+* Description: This file contains the idle and timer task memory of the
+* static-allocation build profile and the report of the RAM moved out of the
+* heap.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <inttypes.h>
+
+#include "static_rtos.h"
+
+#if (STATIC_ALLOCATION_PROFILE)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    uint32_t bytes;
+    bool from_heap;            /* Previously allocated from the heap */
+} static_rtos_object_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+STATIC_RTOS_SECTION static StaticTask_t idle_task_tcb;
+STATIC_RTOS_SECTION static StackType_t idle_task_stack[configMINIMAL_STACK_SIZE];
+
+#if (configUSE_TIMERS == 1)
+STATIC_RTOS_SECTION static StaticTask_t timer_task_tcb;
+STATIC_RTOS_SECTION static StackType_t timer_task_stack[configTIMER_TASK_STACK_DEPTH];
+#endif
+
+static static_rtos_object_t objects[STATIC_RTOS_MAX_OBJECTS];
+static uint32_t object_count = 0U;
+
+/*******************************************************************************
+* Function Name: vApplicationGetIdleTaskMemory
+********************************************************************************
+* Summary:
+*  Provides the statically placed memory of the idle task. This overrides the
+*  weak default of the RTOS abstraction library so that the memory is placed
+*  together with the rest of the static RTOS objects.
+*
+*******************************************************************************/
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+                                   StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    *ppxIdleTaskTCBBuffer = &idle_task_tcb;
+    *ppxIdleTaskStackBuffer = idle_task_stack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+#if (configUSE_TIMERS == 1)
+/*******************************************************************************
+* Function Name: vApplicationGetTimerTaskMemory
+********************************************************************************
+* Summary:
+*  Provides the statically placed memory of the timer service task.
+*
+*******************************************************************************/
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+                                    StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+    *ppxTimerTaskTCBBuffer = &timer_task_tcb;
+    *ppxTimerTaskStackBuffer = timer_task_stack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+
+/*******************************************************************************
+* Function Name: static_rtos_account
+********************************************************************************
+* Summary:
+*  Records a statically allocated RTOS object for the report.
+*
+* Parameters:
+*  const char *name: Name of the object
+*  uint32_t bytes: Size of the stack and control block of the object
+*  bool from_heap: true if the object was allocated from the heap before
+*
+*******************************************************************************/
+void static_rtos_account(const char *name, uint32_t bytes, bool from_heap)
+{
+    if (object_count < STATIC_RTOS_MAX_OBJECTS)
+    {
+        objects[object_count].name = name;
+        objects[object_count].bytes = bytes;
+        objects[object_count].from_heap = from_heap;
+        object_count++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: static_rtos_report
+********************************************************************************
+* Summary:
+*  Prints the statically placed RTOS objects and the number of bytes that no
+*  longer come from the heap.
+*
+*******************************************************************************/
+void static_rtos_report(void)
+{
+    uint32_t total = 0U;
+    uint32_t heap_savings = 0U;
+
+    static_rtos_account("Idle task", sizeof(idle_task_tcb) + sizeof(idle_task_stack), false);
+#if (configUSE_TIMERS == 1)
+    static_rtos_account("Timer task", sizeof(timer_task_tcb) + sizeof(timer_task_stack), false);
+#endif
+
+    printf("Static RTOS allocation:\n");
+
+    for (uint32_t i = 0; i < object_count; i++)
+    {
+        printf("  %-24s %6"PRIu32" bytes%s\n", objects[i].name, objects[i].bytes,
+               objects[i].from_heap ? " (moved out of the heap)" : "");
+        total += objects[i].bytes;
+        if (objects[i].from_heap)
+        {
+            heap_savings += objects[i].bytes;
+        }
+    }
+
+    printf("  Total %"PRIu32" bytes, heap savings %"PRIu32" bytes\n\n", total, heap_savings);
+
+    object_count = 0U;
+}
+
+#endif /* STATIC_ALLOCATION_PROFILE */
+
+/* [] END OF FILE */
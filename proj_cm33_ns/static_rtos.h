@@ -0,0 +1,86 @@
+/*******************************************************************************
+* File Name:   static_rtos.h
+*
+* Description: This file contains the configuration and declarations of the
+* static-allocation build profile, in which the application FreeRTOS objects
+* are placed at link time instead of being allocated from the heap.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef STATIC_RTOS_H_
+#define STATIC_RTOS_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_utils.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Build with STATIC_ALLOCATION_PROFILE=1 to create the application tasks and
+ * semaphores from statically placed memory.
+ */
+#ifndef STATIC_ALLOCATION_PROFILE
+#define STATIC_ALLOCATION_PROFILE                (0U)
+#endif
+
+#if (STATIC_ALLOCATION_PROFILE)
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#endif
+
+/* All statically allocated RTOS memory is grouped in one input section so
+ * that it shows up as a single block in the map file and can be moved to a
+ * dedicated memory region from the linker script.
+ */
+#define STATIC_RTOS_SECTION                      CY_SECTION(".bss.static_rtos")
+
+/* Maximum number of objects listed in the report. */
+#define STATIC_RTOS_MAX_OBJECTS                  (12U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void static_rtos_account(const char *name, uint32_t bytes, bool from_heap);
+void static_rtos_report(void);
+
+#endif /* STATIC_RTOS_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,363 @@
+/*******************************************************************************
+* File Name:   task_stats.c
+*
+* Description: This file contains the per-task CPU run-time and stack
+* high-water mark statistics. Run time is counted with the LPTimer, which
+* keeps running while the device is in tickless deep sleep, so the time spent
+* asleep is attributed correctly instead of being lost as it is with the CPU
+* cycle counter.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <inttypes.h>
+
+/* RTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "task_stats.h"
+#include "static_rtos.h"
+
+#if (TASK_STATS)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PER_MILLE                                (1000U)
+#define MS_PER_SECOND                            (1000U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static mtb_hal_lptimer_t *stats_lptimer = NULL;
+
+/* Time spent in tickless low-power idle, in LPTimer ticks. */
+static uint32_t sleep_start;
+static uint32_t sleep_ticks = 0U;
+static uint32_t sleep_entries = 0U;
+
+/* Counters at the previous report, used to print the share since then. */
+static TaskStatus_t task_status[TASK_STATS_MAX_TASKS];
+static UBaseType_t previous_number[TASK_STATS_MAX_TASKS];
+static uint32_t previous_run_time[TASK_STATS_MAX_TASKS];
+static uint32_t previous_total = 0U;
+static uint32_t previous_sleep_ticks = 0U;
+
+/* Console task, woken by the debug UART receive interrupt. */
+static TaskHandle_t console_task_handle = NULL;
+
+#if (STATIC_ALLOCATION_PROFILE)
+STATIC_RTOS_SECTION static StackType_t console_task_stack[TASK_STATS_CONSOLE_STACK_SIZE];
+STATIC_RTOS_SECTION static StaticTask_t console_task_tcb;
+#endif
+
+/*******************************************************************************
+* Function Name: task_stats_set_lptimer
+********************************************************************************
+* Summary:
+*  Sets the LPTimer used as run-time counter. This is the same timer that the
+*  RTOS abstraction library uses for tickless idle.
+*
+* Parameters:
+*  mtb_hal_lptimer_t *lptimer: Initialized LPTimer object
+*
+*******************************************************************************/
+void task_stats_set_lptimer(mtb_hal_lptimer_t *lptimer)
+{
+    stats_lptimer = lptimer;
+}
+
+/*******************************************************************************
+* Function Name: task_stats_get_counter
+********************************************************************************
+* Summary:
+*  Returns the run-time counter (portGET_RUN_TIME_COUNTER_VALUE).
+*
+* Return:
+*  uint32_t: LPTimer count, or 0 before the LPTimer is set up
+*
+*******************************************************************************/
+uint32_t task_stats_get_counter(void)
+{
+    return (NULL != stats_lptimer) ? mtb_hal_lptimer_read(stats_lptimer) : 0U;
+}
+
+/*******************************************************************************
+* Function Name: task_stats_sleep_begin
+********************************************************************************
+* Summary:
+*  Called by the idle task before it suppresses the tick and sleeps
+*  (traceLOW_POWER_IDLE_BEGIN).
+*
+*******************************************************************************/
+void task_stats_sleep_begin(void)
+{
+    sleep_start = task_stats_get_counter();
+}
+
+/*******************************************************************************
+* Function Name: task_stats_sleep_end
+********************************************************************************
+* Summary:
+*  Called by the idle task after it wakes up (traceLOW_POWER_IDLE_END).
+*
+*******************************************************************************/
+void task_stats_sleep_end(void)
+{
+    sleep_ticks += task_stats_get_counter() - sleep_start;
+    sleep_entries++;
+}
+
+/*******************************************************************************
+* Function Name: ticks_to_ms
+********************************************************************************
+* Summary:
+*  Converts LPTimer ticks to milliseconds.
+*
+*******************************************************************************/
+static uint32_t ticks_to_ms(uint32_t ticks)
+{
+    uint32_t frequency = Cy_SysClk_ClkLfGetFrequency();
+
+    return (0U != frequency) ?
+           (uint32_t)(((uint64_t)ticks * MS_PER_SECOND) / frequency) : 0U;
+}
+
+/*******************************************************************************
+* Function Name: share_per_mille
+********************************************************************************
+* Summary:
+*  Returns part as a share of total in tenths of a percent.
+*
+*******************************************************************************/
+static uint32_t share_per_mille(uint32_t part, uint32_t total)
+{
+    return (0U != total) ? (uint32_t)(((uint64_t)part * PER_MILLE) / total) : 0U;
+}
+
+/*******************************************************************************
+* Function Name: task_stats_print
+********************************************************************************
+* Summary:
+*  Prints the CPU share of every task since the previous report and since
+*  boot, the smallest amount of free stack each task has had, and the time
+*  spent in tickless low-power idle. The idle task time includes the
+*  low-power idle time.
+*
+*******************************************************************************/
+void task_stats_print(void)
+{
+    UBaseType_t count;
+    uint32_t total;
+    uint32_t interval;
+    uint32_t slept;
+    uint32_t delta;
+    uint32_t previous;
+
+    count = uxTaskGetSystemState(task_status, TASK_STATS_MAX_TASKS, &total);
+    if (0U == count)
+    {
+        printf("Task statistics: more than %u tasks\n", (unsigned int)TASK_STATS_MAX_TASKS);
+        return;
+    }
+
+    interval = total - previous_total;
+    slept = sleep_ticks - previous_sleep_ticks;
+
+    printf("\nTask              CPU now  CPU boot  Stack free (bytes)\n");
+
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        TaskStatus_t *task = &task_status[i];
+
+        previous = 0U;
+        for (UBaseType_t j = 0; j < TASK_STATS_MAX_TASKS; j++)
+        {
+            if (previous_number[j] == task->xTaskNumber)
+            {
+                previous = previous_run_time[j];
+                break;
+            }
+        }
+        delta = task->ulRunTimeCounter - previous;
+
+        printf("%-16s %3"PRIu32".%"PRIu32"%%   %3"PRIu32".%"PRIu32"%%  %6"PRIu32"\n",
+               task->pcTaskName,
+               share_per_mille(delta, interval) / 10U,
+               share_per_mille(delta, interval) % 10U,
+               share_per_mille(task->ulRunTimeCounter, total) / 10U,
+               share_per_mille(task->ulRunTimeCounter, total) % 10U,
+               (uint32_t)task->usStackHighWaterMark * (uint32_t)sizeof(StackType_t));
+    }
+
+    printf("Low-power idle    %3"PRIu32".%"PRIu32"%%   %3"PRIu32".%"PRIu32"%%  "
+           "(%"PRIu32" entries)\n",
+           share_per_mille(slept, interval) / 10U, share_per_mille(slept, interval) % 10U,
+           share_per_mille(sleep_ticks, total) / 10U, share_per_mille(sleep_ticks, total) % 10U,
+           sleep_entries);
+    printf("Interval %"PRIu32" ms, uptime %"PRIu32" ms\n\n",
+           ticks_to_ms(interval), ticks_to_ms(total));
+
+    for (UBaseType_t i = 0; i < TASK_STATS_MAX_TASKS; i++)
+    {
+        previous_number[i] = (i < count) ? task_status[i].xTaskNumber : 0U;
+        previous_run_time[i] = (i < count) ? task_status[i].ulRunTimeCounter : 0U;
+    }
+    previous_total = total;
+    previous_sleep_ticks = sleep_ticks;
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_rx_interrupt_handler
+********************************************************************************
+* Summary:
+*  Wakes the console task when the debug UART has received data. The receive
+*  interrupt stays masked until the task has read the FIFO.
+*
+*******************************************************************************/
+static void debug_uart_rx_interrupt_handler(void)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    Cy_SCB_SetRxInterruptMask(CYBSP_DEBUG_UART_HW, 0U);
+    Cy_SCB_ClearRxInterrupt(CYBSP_DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+
+    vTaskNotifyGiveFromISR(console_task_handle, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*******************************************************************************
+* Function Name: task_stats_console_task
+********************************************************************************
+* Summary:
+*  Prints the statistics when TASK_STATS_KEY is received on the debug UART.
+*  The task blocks until the receive interrupt wakes it, so it does not keep
+*  the device out of deep sleep. The UART does not receive while the device
+*  is in deep sleep, so a key sent at that time may have to be repeated.
+*
+* Parameters:
+*  void *arg: Unused
+*
+*******************************************************************************/
+static void task_stats_console_task(void *arg)
+{
+    uint32_t value;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    console_task_handle = xTaskGetCurrentTaskHandle();
+
+    while (true)
+    {
+        while (0U != Cy_SCB_UART_GetNumInRxFifo(CYBSP_DEBUG_UART_HW))
+        {
+            value = Cy_SCB_UART_Get(CYBSP_DEBUG_UART_HW);
+            if (TASK_STATS_KEY == value)
+            {
+                task_stats_print();
+            }
+        }
+
+        /* The interrupt is raised again at once if data arrived since the
+         * FIFO was read.
+         */
+        Cy_SCB_ClearRxInterrupt(CYBSP_DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+        Cy_SCB_SetRxInterruptMask(CYBSP_DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+/*******************************************************************************
+* Function Name: task_stats_start_console
+********************************************************************************
+* Summary:
+*  Starts the task that prints the statistics on demand and the debug UART
+*  receive interrupt that wakes it. Must be called after the application has
+*  finished reading its own input from the debug UART.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the task is created
+*
+*******************************************************************************/
+cy_rslt_t task_stats_start_console(void)
+{
+    BaseType_t created;
+    cy_stc_sysint_t uart_intr_cfg =
+    {
+        .intrSrc = CYBSP_DEBUG_UART_IRQ,
+        .intrPriority = TASK_STATS_UART_INTERRUPT_PRIORITY
+    };
+
+    /* The console task unmasks the receive interrupt once it runs. */
+    Cy_SCB_SetRxInterruptMask(CYBSP_DEBUG_UART_HW, 0U);
+    if (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&uart_intr_cfg, debug_uart_rx_interrupt_handler))
+    {
+        printf("Failed to set up the debug UART interrupt\n");
+        return TASK_STATS_RSLT_UART_FAILED;
+    }
+    NVIC_EnableIRQ(CYBSP_DEBUG_UART_IRQ);
+
+#if (STATIC_ALLOCATION_PROFILE)
+    created = (NULL != xTaskCreateStatic(task_stats_console_task, "Stats console",
+                                         TASK_STATS_CONSOLE_STACK_SIZE, NULL,
+                                         TASK_STATS_CONSOLE_PRIORITY,
+                                         console_task_stack, &console_task_tcb)) ? pdPASS : pdFAIL;
+    static_rtos_account("Stats console", sizeof(console_task_stack) +
+                        sizeof(console_task_tcb), true);
+#else
+    created = xTaskCreate(task_stats_console_task, "Stats console",
+                          TASK_STATS_CONSOLE_STACK_SIZE, NULL,
+                          TASK_STATS_CONSOLE_PRIORITY, NULL);
+#endif
+
+    if (pdPASS != created)
+    {
+        printf("Failed to create the statistics console task\n");
+        return TASK_STATS_RSLT_TASK_FAILED;
+    }
+
+    printf("Press '%c' to print the task statistics\n", TASK_STATS_KEY);
+
+    return CY_RSLT_SUCCESS;
+}
+
+#endif /* TASK_STATS */
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/*******************************************************************************
+* File Name:   task_stats.h
+*
+* Description: This file contains the configuration and declarations of the
+* per-task CPU run-time and stack high-water mark statistics, printed on
+* demand over the debug UART.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TASK_STATS_H_
+#define TASK_STATS_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include "mtb_hal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Build with TASK_STATS=1 to enable the FreeRTOS run-time statistics. The
+ * same switch is read by FreeRTOSConfig.h.
+ */
+#ifndef TASK_STATS
+#define TASK_STATS                               (0U)
+#endif
+
+/* Key on the debug UART that prints the statistics. */
+#define TASK_STATS_KEY                           ('s')
+
+/* Priority of the debug UART receive interrupt that wakes the console task.
+ * It calls FreeRTOS, so it must not be above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+#define TASK_STATS_UART_INTERRUPT_PRIORITY       (7U)
+
+#define TASK_STATS_MAX_TASKS                     (16U)
+#define TASK_STATS_CONSOLE_STACK_SIZE            (configMINIMAL_STACK_SIZE * 2U)
+#define TASK_STATS_CONSOLE_PRIORITY              (tskIDLE_PRIORITY + 1U)
+
+/* Results returned by this module. */
+#define TASK_STATS_RSLT_TASK_FAILED              APP_RSLT_ERROR(APP_RSLT_GROUP_TASK_STATS, 1U)
+#define TASK_STATS_RSLT_UART_FAILED              APP_RSLT_ERROR(APP_RSLT_GROUP_TASK_STATS, 2U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void task_stats_set_lptimer(mtb_hal_lptimer_t *lptimer);
+cy_rslt_t task_stats_start_console(void);
+void task_stats_print(void);
+
+/* Hooks called by the FreeRTOS kernel, see FreeRTOSConfig.h. */
+uint32_t task_stats_get_counter(void);
+void task_stats_sleep_begin(void);
+void task_stats_sleep_end(void);
+
+#endif /* TASK_STATS_H_ */
+
+/* [] END OF FILE */
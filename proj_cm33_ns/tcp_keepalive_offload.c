@@ -69,12 +69,75 @@
 /* Low Power Assistant header files. */
 #include "network_activity_handler.h"
 
+/* Runtime ARP offload configuration header file. */
+#include "arp_offload.h"
+
+/* MQTT client mode header file. */
+#include "mqtt_client.h"
+
+/* Runtime WOWL pattern builder header file. */
+#include "wowl_pattern.h"
+
+/* TLS client mode header file. */
+#include "tls_client.h"
+
+/* TLS and socket memory pool header file. */
+#include "tls_mem_pool.h"
+
+/* Static-allocation build profile header file. */
+#include "static_rtos.h"
+
+/* Task run-time statistics header file. */
+#include "task_stats.h"
+
+/* Boot-phase timing profiler header file. */
+#include "boot_profile.h"
+
+/* Persistent configuration store header file. */
+#include "config_store.h"
+
+/* Named power profiles header file. */
+#include "power_profile.h"
+
+/* WLAN power-save control header file. */
+#include "wlan_power_save.h"
+
+/* Event tracer header file. */
+#include "event_trace.h"
+
+/* Energy accounting header file. */
+#include "energy_stats.h"
+
+/* TCP server failover header file. */
+#include "server_failover.h"
+
+/* Asynchronous connect header file. */
+#include "async_connect.h"
+
+/* Transmit coalescing header file. */
+#include "tx_coalesce.h"
+
+/* Wake dispatch header file. */
+#include "wake_dispatch.h"
+#if (WAKE_DISPATCH)
+#include "lwip/prot/ethernet.h"
+#endif
+
+/* Packet filter statistics header file. */
+#include "pf_stats.h"
+
+/* lwIP memory pool statistics header file. */
+#include "lwip_pool_stats.h"
+
 /*******************************************************************************
 * Macros
 *******************************************************************************/
-/* To use the Wi-Fi device in AP interface mode, set this macro as '1' */
-
+/* Set this macro to '1' to connect to the TCP server (tcp_server.py) and
+ * handle its LED commands. The host benchmark (bench/) builds with it set.
+ */
+#ifndef TCP_KEEPALIVE_OFFLOAD
 #define TCP_KEEPALIVE_OFFLOAD                    (0U)
+#endif
 
 
 #define MAKE_IP_PARAMETERS(a, b, c, d)           ((((uint32_t) d) << 24) | \
@@ -85,7 +148,8 @@
 #define WIFI_INTERFACE_TYPE                     CY_WCM_INTERFACE_TYPE_STA
 
 /* Wi-Fi Credentials: Modify WIFI_SSID, WIFI_PASSWORD, and WIFI_SECURITY_TYPE
- * to match your Wi-Fi network credentials.
+ * to match your Wi-Fi network credentials. When CONFIG_STORE is enabled,
+ * these are the defaults for credentials not found in the store.
  * Note: Maximum length of the Wi-Fi SSID and password is set to
  * CY_WCM_MAX_SSID_LEN and CY_WCM_MAX_PASSPHRASE_LEN as defined in cy_wcm.h file.
  */
@@ -106,6 +170,13 @@
 /* Maximum number of connection retries to the TCP server. */
 #define MAX_TCP_SERVER_CONN_RETRIES               (5U)
 
+/* Suspend time between reconnects while the TCP server is unreachable. It
+ * doubles after every failed reconnect, up to the maximum, and starts over
+ * once connected.
+ */
+#define RECONNECT_BACKOFF_MIN_MS                  (1000U)
+#define RECONNECT_BACKOFF_MAX_MS                  (60000U)
+
 /* Length of the TCP data packet. */
 #define MAX_TCP_DATA_PACKET_LENGTH                (20u)
 
@@ -164,11 +235,28 @@
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
-cy_rslt_t create_tcp_client_socket(void);
+cy_rslt_t create_tcp_client_socket(cy_socket_t *socket_handle);
+cy_rslt_t tcp_client_recv_handler(cy_socket_t socket_handle, void *arg);
 cy_rslt_t tcp_disconnection_handler(cy_socket_t socket_handle, void *arg);
 cy_rslt_t connect_to_tcp_server(cy_socket_sockaddr_t address);
 
 static cy_rslt_t connect_to_wifi_ap(void);
+static cy_rslt_t open_server_connection(cy_socket_t *socket_handle, void *arg);
+static void server_connected(void);
+#if (TX_COALESCE)
+static cy_rslt_t send_to_server(const uint8_t *data, uint32_t length);
+#endif
+static const char *run_led_command(char command);
+#if (WAKE_DISPATCH)
+static wake_dispatch_action_t led_command_wake_handler(const wake_dispatch_frame_t *frame,
+                                                       void *arg);
+#if(WOWL_RUNTIME_PATTERNS)
+static wake_dispatch_action_t peer_wake_handler(const wake_dispatch_frame_t *frame, void *arg);
+#endif
+#endif
+#if (ASYNC_CONNECT)
+static cy_rslt_t start_server_connect(cy_socket_sockaddr_t *address);
+#endif
 
 /*******************************************************************************
 * Global Variables
@@ -176,9 +264,34 @@ static cy_rslt_t connect_to_wifi_ap(void);
 /* TCP client socket handle */
 cy_socket_t client_handle;
 
+#if (WAKE_DISPATCH)
+/* Server whose LED commands the wake dispatch handles. */
+static cy_socket_sockaddr_t led_command_server;
+#endif
+
+#if (SERVER_FAILOVER)
+/* Endpoint that won the last failover race. */
+static uint32_t connected_endpoint;
+#endif
+
+#if (ASYNC_CONNECT)
+/* Attempts made by the connect running in the background. */
+static uint32_t async_conn_retries;
+#endif
+
 /* Binary semaphore handle to keep track of TCP server connection. */
 cy_semaphore_t connect_to_server;
 
+#if(TCP_KEEPALIVE_OFFLOAD)
+/* Suspend time before the next reconnect; see RECONNECT_BACKOFF_MIN_MS. */
+static uint32_t reconnect_backoff_ms = RECONNECT_BACKOFF_MIN_MS;
+#endif
+
+#if (STATIC_ALLOCATION_PROFILE)
+/* Control block of the connect_to_server semaphore. */
+STATIC_RTOS_SECTION static StaticSemaphore_t connect_to_server_buffer;
+#endif
+
 /* Holds the IP address obtained for SoftAP using Wi-Fi Connection Manager (WCM). */
 cy_wcm_ip_address_t softap_ip_address;
 
@@ -187,6 +300,28 @@ static mtb_hal_sdio_t sdio_instance;
 static cy_stc_sd_host_context_t sdhc_host_context;
 static cy_wcm_config_t wcm_config;
 
+/* Compile-time network settings. A server IP of zero is asked for on the
+ * UART.
+ */
+static const config_store_net_t net_config_defaults =
+{
+    .ssid                  = WIFI_SSID,
+    .password              = WIFI_PASSWORD,
+    .security              = WIFI_SECURITY_TYPE,
+    .server_ip             = 0U,
+    .server_port           = TCP_SERVER_PORT,
+    .keepalive_idle_ms     = TCP_KEEP_ALIVE_IDLE_TIME_MS,
+    .keepalive_interval_ms = TCP_KEEP_ALIVE_INTERVAL_MS,
+    .keepalive_count       = TCP_KEEP_ALIVE_RETRY_COUNT,
+    .inactive_interval_ms  = INACTIVE_INTERVAL_MS,
+    .inactive_window_ms    = INACTIVE_WINDOW_MS
+};
+
+/* Network settings in use; replaced by the stored settings when
+ * CONFIG_STORE is enabled.
+ */
+static const config_store_net_t *net_config = &net_config_defaults;
+
 
 #if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
 
@@ -219,7 +354,9 @@ static cy_stc_syspm_callback_t sdhcDeepSleepCallbackHandler =
 *******************************************************************************/
 static void sdio_interrupt_handler(void)
 {
+    EVENT_TRACE_ISR_BEGIN(EVENT_TRACE_IRQ_SDIO);
     mtb_hal_sdio_process_interrupt(&sdio_instance);
+    EVENT_TRACE_ISR_END(EVENT_TRACE_IRQ_SDIO);
 }
 
 /*******************************************************************************
@@ -230,7 +367,18 @@ static void sdio_interrupt_handler(void)
 *******************************************************************************/
 static void host_wake_interrupt_handler(void)
 {
+    EVENT_TRACE_ISR_BEGIN(EVENT_TRACE_IRQ_HOST_WAKE);
+#if (WLAN_PS_MEASURE)
+    wlan_ps_measure_note_wake();
+#endif
+#if (ENERGY_STATS)
+    energy_stats_note_host_wake();
+#endif
+#if (WAKE_DISPATCH)
+    wake_dispatch_note_wake();
+#endif
     mtb_hal_gpio_process_interrupt(&wcm_config.wifi_host_wake_pin);
+    EVENT_TRACE_ISR_END(EVENT_TRACE_IRQ_HOST_WAKE);
 }
 
 /*******************************************************************************
@@ -423,6 +571,90 @@ static void read_uart_input(uint8_t* input_buffer_ptr)
 }
 #endif
 
+/*******************************************************************************
+* Function Name: radio_bring_up
+********************************************************************************
+* Summary:
+*  Configures the SDIO interface to the Wi-Fi device and initializes the Wi-Fi
+*  connection manager, which resets the device through WL_REG_ON and
+*  downloads its firmware.
+*
+*******************************************************************************/
+static void radio_bring_up(void)
+{
+    cy_rslt_t result;
+
+#if(TLS_MEM_POOL)
+    /* Install the TLS memory pool before WCM and secure sockets allocate. */
+    result = tls_mem_pool_init();
+    if(CY_RSLT_SUCCESS != result)
+    {
+        handle_app_error();
+    }
+#endif
+
+#if !(PARALLEL_STARTUP)
+    /* With PARALLEL_STARTUP, radio_power_up() did this in main(). */
+    app_sdio_init();
+    BOOT_PROFILE_MARK("app_sdio_init");
+#endif
+
+    wcm_config.interface = WIFI_INTERFACE_TYPE;
+    wcm_config.wifi_interface_instance = &sdio_instance;
+
+    /* Initialize Wi-Fi connection manager. */
+    result = cy_wcm_init(&wcm_config);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Wi-Fi Connection Manager initialization failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+       
+        handle_app_error();
+    }
+    printf("Wi-Fi Connection Manager initialized.\r\n");
+    BOOT_PROFILE_MARK("cy_wcm_init");
+}
+
+#if (PARALLEL_STARTUP)
+/*******************************************************************************
+* Function Name: radio_power_up
+********************************************************************************
+* Summary:
+*  Called from main() right after cybsp_init(), before the serial and timer
+*  set-up. Configures the SDIO interface and raises WL_REG_ON, so that the
+*  Wi-Fi device powers up while the rest of the board start-up runs and the
+*  radio init task finds the bus ready.
+*
+*******************************************************************************/
+void radio_power_up(void)
+{
+    app_sdio_init();
+
+    Cy_GPIO_Write(CYBSP_WIFI_WL_REG_ON_PORT, CYBSP_WIFI_WL_REG_ON_PIN, 1U);
+    BOOT_PROFILE_MARK("radio_power_up");
+}
+
+/*******************************************************************************
+* Function Name: radio_init_task
+********************************************************************************
+* Summary:
+*  Brings up the Wi-Fi device right after the scheduler starts, in parallel
+*  with the rest of the board start-up, and then wakes up the network task.
+*
+* Parameters:
+*  void *arg: Handle of the network task
+*
+*******************************************************************************/
+void radio_init_task(void *arg)
+{
+    radio_bring_up();
+
+    xTaskNotifyGive((TaskHandle_t)arg);
+
+    vTaskDelete(NULL);
+}
+#endif
+
 /*******************************************************************************
 * Function Name: network_idle_task
 ********************************************************************************
@@ -442,13 +674,16 @@ void network_idle_task(void *arg)
 #if(TCP_KEEPALIVE_OFFLOAD)
     uint8_t uart_input[UART_BUFFER_SIZE];
 
+    /* Set while the connection to the TCP server is to be re-established. */
+    bool reconnect_pending = false;
+
     /* IP address and TCP port number of the TCP server to which the TCP client
      * connects to.
      */
     cy_socket_sockaddr_t tcp_server_address =
     {
         .ip_address.version = CY_SOCKET_IP_VER_V4,
-        .port = TCP_SERVER_PORT
+        .port = VALUE_TO_BE_FILLED
     };
 
     /* IP variable for network utility functions */
@@ -458,21 +693,21 @@ void network_idle_task(void *arg)
     };
 #endif
 
-    app_sdio_init();
-
-    wcm_config.interface = WIFI_INTERFACE_TYPE;
-    wcm_config.wifi_interface_instance = &sdio_instance;
+    BOOT_PROFILE_MARK("Scheduler start");
 
-    /* Initialize Wi-Fi connection manager. */
-    result = cy_wcm_init(&wcm_config);
+#if (CONFIG_STORE)
+    /* Load the stored settings; the compile-time defaults fill any gaps. */
+    (void)config_store_init(&net_config_defaults);
+    net_config = config_store_get_net();
+    BOOT_PROFILE_MARK("config_store_init");
+#endif
 
-    if (CY_RSLT_SUCCESS != result)
-    {
-        printf("Wi-Fi Connection Manager initialization failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
-       
-        handle_app_error();
-    }
-    printf("Wi-Fi Connection Manager initialized.\r\n");
+#if (PARALLEL_STARTUP)
+    /* The radio init task brings up WCM; continue as soon as it is ready. */
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#else
+    radio_bring_up();
+#endif
 
     /* Connect to Wi-Fi AP */
     result = connect_to_wifi_ap();
@@ -481,10 +716,81 @@ void network_idle_task(void *arg)
         printf("\n Failed to connect to Wi-Fi AP! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
         handle_app_error();
     }
-    
+    BOOT_PROFILE_MARK("connect_to_wifi_ap");
+
+    /* Obtain the pointer to the lwIP network interface. This pointer is used to
+     * access the Wi-Fi driver interface to configure the WLAN power-save mode.
+     */
+    wifi = (struct netif*)cy_network_get_nw_interface
+                         (CY_NETWORK_WIFI_STA_INTERFACE, INTERFACE_ID);
+
+#if (POWER_PROFILES)
+    /* Apply the stored or default power profile now that the AP is joined. */
+    (void)power_profile_init(net_config);
+#elif (WLAN_PS_CONTROL)
+    /* Select the WLAN power-save mode and listen interval explicitly. */
+    static const wlan_ps_config_t wlan_ps_config =
+    {
+        .mode                 = WLAN_PS_DEFAULT_MODE,
+        .pm2_sleep_ret_ms     = WLAN_PS_DEFAULT_PM2_SLEEP_RET_MS,
+        .listen_interval_dtim = WLAN_PS_DEFAULT_LISTEN_INTERVAL
+    };
+
+    (void)wlan_ps_apply(&wlan_ps_config);
+#endif
+
+#if (ENERGY_STATS)
+    /* Account residency and traffic from here on. */
+    (void)energy_stats_init(wifi);
+#endif
+
+#if (PF_STATS)
+    /* The packet filter offload is configured once the AP is joined. */
+    (void)pf_stats_init();
+#endif
+
+#if (LWIP_POOL_STATS)
+    /* Sample the lwIP pools around each suspend from here on. */
+    (void)lwip_pool_stats_init();
+#endif
+
+#if(ARP_OFFLOAD_RUNTIME_CONFIG)
+    /* Program the ARP offload for the assigned IP and prewarm the gateway. */
+    arp_offload_configure(wifi);
+#endif
+
+#if (WAKE_DISPATCH)
+    /* Look at the frame that wakes the host before lwIP does. */
+    if (CY_RSLT_SUCCESS != wake_dispatch_init(wifi))
+    {
+        handle_app_error();
+    }
+#endif
+
+#if(WOWL_RUNTIME_PATTERNS)
+    /* Build the "{device MAC}{peer MAC}" wake pattern for this unit. */
+    static const cy_wcm_mac_t wowl_peer_mac = WOWL_PEER_MAC;
+    uint32_t wowl_peer_pattern_id;
+
+    /* WOWL is activated around each suspend in the loop below. */
+    if((CY_RSLT_SUCCESS == wowl_pattern_init()) &&
+       (CY_RSLT_SUCCESS == wowl_pattern_add_peer(wowl_peer_mac, &wowl_peer_pattern_id)))
+    {
+#if (WAKE_DISPATCH)
+        (void)wake_dispatch_register_wowl(wowl_peer_pattern_id, peer_wake_handler, NULL);
+#endif
+    }
+#endif
+
 #if(TCP_KEEPALIVE_OFFLOAD)
     /* Create a binary semaphore to keep track of TCP server connection. */
+#if (STATIC_ALLOCATION_PROFILE)
+    connect_to_server = xSemaphoreCreateCountingStatic(SEMAPHORE_LIMIT,
+                            INIT_COUNT_FOR_SEMAPHORE, &connect_to_server_buffer);
+    static_rtos_account("connect_to_server", sizeof(connect_to_server_buffer), true);
+#else
     cy_rtos_semaphore_init(&connect_to_server, SEMAPHORE_LIMIT, INIT_COUNT_FOR_SEMAPHORE);
+#endif
 
     /* Give the semaphore so as to connect to TCP server.  */
     cy_rtos_semaphore_set(&connect_to_server);
@@ -498,58 +804,302 @@ void network_idle_task(void *arg)
         handle_app_error();
     }
     printf("Secure Socket initialized\n");
+    BOOT_PROFILE_MARK("cy_socket_init");
+
+#if (TX_COALESCE)
+    result = tx_coalesce_init(send_to_server);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        handle_app_error();
+    }
+#endif
 
     /* Wait till semaphore is acquired so as to connect to a TCP server. */
     cy_rtos_semaphore_get(&connect_to_server, CY_RTOS_NEVER_TIMEOUT);
 
     printf("Connect to TCP server\n");
-    printf("Enter the IPv4 address of the TCP Server:\n");
 
-    /* Clear the UART input buffer. */
-    memset(uart_input, VALUE_TO_BE_FILLED, UART_BUFFER_SIZE);
+    if (0U != net_config->server_ip)
+    {
+        nw_ip_addr.ip.v4 = net_config->server_ip;
+    }
+    else
+    {
+        printf("Enter the IPv4 address of the TCP Server:\n");
 
-    /* Read the TCP server's IPv4 address from  the user via the
-     * UART terminal.
-     */
-    read_uart_input(uart_input);
+        /* Clear the UART input buffer. */
+        memset(uart_input, VALUE_TO_BE_FILLED, UART_BUFFER_SIZE);
+
+        /* Read the TCP server's IPv4 address from  the user via the
+         * UART terminal.
+         */
+        read_uart_input(uart_input);
+        BOOT_PROFILE_MARK_WAIT("Server address entry");
+
+        cy_nw_str_to_ipv4((char *)uart_input, (cy_nw_ip_address_t *)&nw_ip_addr);
+
+#if (CONFIG_STORE)
+        /* Remember the address so that later boots skip the prompt. */
+        config_store_net_t updated_config = *net_config;
+
+        updated_config.server_ip = nw_ip_addr.ip.v4;
+        (void)config_store_set_net(&updated_config);
+#endif
+    }
 
-    cy_nw_str_to_ipv4((char *)uart_input, (cy_nw_ip_address_t *)&nw_ip_addr);
     tcp_server_address.ip_address.ip.v4 = nw_ip_addr.ip.v4;
+    tcp_server_address.port = net_config->server_port;
+
+#if (SERVER_FAILOVER)
+    /* The entered or stored server is the primary of the failover list. */
+    result = server_failover_init(&tcp_server_address, create_tcp_client_socket);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        handle_app_error();
+    }
+#endif
+
+#if (WAKE_DISPATCH)
+    /* Drive the LED from the waking command frame of the connection to the
+     * server. Registered before the connect so that the dispatch sees the
+     * handshake. TLS records are encrypted and never match.
+     */
+    static const uint8_t led_on_prefix[] = { LED_ON_CMD };
+    static const uint8_t led_off_prefix[] = { LED_OFF_CMD };
+
+    led_command_server = tcp_server_address;
+    (void)wake_dispatch_register_tcp_prefix(led_command_server.ip_address.ip.v4,
+                                            led_command_server.port, led_on_prefix,
+                                            sizeof(led_on_prefix), led_command_wake_handler, NULL);
+    (void)wake_dispatch_register_tcp_prefix(led_command_server.ip_address.ip.v4,
+                                            led_command_server.port, led_off_prefix,
+                                            sizeof(led_off_prefix), led_command_wake_handler, NULL);
+#endif
+
+#if(ARP_OFFLOAD_RUNTIME_CONFIG)
+    /* Resolve the TCP server (or its gateway) before the first send. */
+    arp_offload_prewarm(wifi, tcp_server_address.ip_address.ip.v4);
+#endif
 
     /* Connect to the TCP server. If the connection fails, retry
      * to connect to the server for MAX_TCP_SERVER_CONN_RETRIES times.
      */
     cy_nw_ntoa(&nw_ip_addr, (char *)&uart_input);
     printf("Connecting to TCP Server (IP Address: %s, Port: %d)\n\n",
-                  uart_input, TCP_SERVER_PORT);
+                  uart_input, (int)net_config->server_port);
+
+#if (ASYNC_CONNECT)
+    result = async_connect_init();
+    if (CY_RSLT_SUCCESS != result)
+    {
+        handle_app_error();
+    }
 
+    /* Connect in the background; the suspend loop below reports the
+     * outcome and the stack keeps suspending meanwhile.
+     */
+    result = start_server_connect(&tcp_server_address);
+#else
     result = connect_to_tcp_server(tcp_server_address);
+    BOOT_PROFILE_MARK("connect_to_tcp_server");
+#endif
 
     if(CY_RSLT_SUCCESS != result)
     {
         printf("Failed to connect to TCP server.\n");
 
-        /* Give the semaphore so as to connect to TCP server.  */
-        cy_rtos_semaphore_set(&connect_to_server);
+        /* Retry from the suspend loop after the backoff. */
+        reconnect_pending = true;
     }
 #endif
-        
-          /* Obtain the pointer to the lwIP network interface. This pointer is used to
-    * access the Wi-Fi driver interface to configure the WLAN power-save mode.
-    */
-    wifi = (struct netif*)cy_network_get_nw_interface
-                         (CY_NETWORK_WIFI_STA_INTERFACE, INTERFACE_ID);
+
+#if(MQTT_CLIENT_MODE)
+    /* Start the MQTT client. Its reconnect task connects to the broker and
+     * re-establishes the session whenever it is lost.
+     */
+    result = mqtt_client_start();
+    BOOT_PROFILE_MARK("mqtt_client_start");
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to start the MQTT client.\n");
+    }
+#endif
+
+#if (BOOT_PROFILE)
+    /* The device is online; break down the time it took. */
+    boot_profile_report();
+#endif
+
+#if (EVENT_TRACE)
+    /* The debug UART is free from here on; dump the trace on demand. This
+     * console also serves the task statistics key.
+     */
+    event_trace_start_console();
+#elif (TASK_STATS)
+    /* The debug UART is free from here on; print statistics on demand. */
+    task_stats_start_console();
+#endif
+
+#if (STATIC_ALLOCATION_PROFILE)
+    /* Report the statically placed RTOS objects and the heap they save. */
+    static_rtos_report();
+#endif
 
     while (true)
     {
+        uint32_t inactive_interval_ms = net_config->inactive_interval_ms;
+        uint32_t inactive_window_ms = net_config->inactive_window_ms;
+        uint32_t wait_ms = portMAX_DELAY;
+
+#if(TCP_KEEPALIVE_OFFLOAD)
+        /* While the server is unreachable, nothing on the network may wake
+         * the host again; resume after the backoff to retry. Without the
+         * access point there is nothing to retry; WCM rejoining wakes the
+         * host.
+         */
+        if (reconnect_pending && cy_wcm_is_connected_to_ap())
+        {
+            wait_ms = reconnect_backoff_ms;
+        }
+#endif
+
+#if (POWER_PROFILES)
+        /* The active power profile owns the suspend window. */
+        power_profile_get_suspend_window(&inactive_interval_ms, &inactive_window_ms);
+#endif
+
+#if(MQTT_CLIENT_MODE)
+        /* Handle received commands and set up the MQTT keepalive offload
+         * before the network stack is suspended.
+         */
+        result = mqtt_client_prepare_suspend();
+        if(CY_RSLT_SUCCESS != result)
+        {
+            printf("MQTT suspend preparation failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        }
+#endif
+
        /* Configures an emac activity callback to the Wi-Fi interface and
         * suspends the network if the network is inactive for a duration of
-        * INACTIVE_WINDOW_MS inside an interval of INACTIVE_INTERVAL_MS. The
-        * callback is used to signal the presence/absence of network activity
-        * to resume/suspend the network stack.
+        * the inactive window inside the inactive interval. The callback is
+        * used to signal the presence/absence of network activity to
+        * resume/suspend the network stack. Both are re-read every cycle so
+        * that configuration store and power profile updates apply without a
+        * reboot.
         */
-        wait_net_suspend(wifi, portMAX_DELAY, INACTIVE_INTERVAL_MS,
-                INACTIVE_WINDOW_MS);
+#if (ASYNC_CONNECT)
+        /* Resume no later than the deadline of a connect in flight. */
+        if (async_connect_in_flight() && (async_connect_time_left_ms() < wait_ms))
+        {
+            wait_ms = async_connect_time_left_ms();
+        }
+#endif
+
+#if (TX_COALESCE)
+        /* Resume no later than held replies are due; they are sent below. */
+        if (tx_coalesce_time_left_ms() < wait_ms)
+        {
+            wait_ms = tx_coalesce_time_left_ms();
+        }
+#endif
+
+#if (LWIP_POOL_STATS)
+        /* Buffers still held here stay allocated while the host sleeps. */
+        lwip_pool_stats_sample(LWIP_POOL_STATS_SUSPEND);
+#endif
+
+#if(WOWL_RUNTIME_PATTERNS) || (MQTT_CLIENT_MODE)
+        /* Only the programmed patterns wake the host while it sleeps. */
+        (void)wowl_pattern_activate();
+#endif
+
+        EVENT_TRACE_RECORD(EVENT_TRACE_NET_WAIT, 0U, 0U);
+        wait_net_suspend(wifi, wait_ms, inactive_interval_ms,
+                inactive_window_ms);
+        EVENT_TRACE_RECORD(EVENT_TRACE_NET_RESUME, 0U, 0U);
+
+#if(WOWL_RUNTIME_PATTERNS) || (MQTT_CLIENT_MODE)
+        /* The host is awake; let all traffic through again. */
+        (void)wowl_pattern_deactivate();
+#endif
+
+#if (LWIP_POOL_STATS)
+        /* Frames queued during the suspend are in the pools now. */
+        lwip_pool_stats_sample(LWIP_POOL_STATS_RESUME);
+        lwip_pool_stats_poll();
+#endif
+
+#if (WLAN_PS_MEASURE)
+        wlan_ps_measure_note_resume();
+        wlan_ps_measure_poll();
+#endif
+
+#if (ENERGY_STATS)
+        energy_stats_poll();
+#endif
+
+#if (WAKE_DISPATCH)
+        wake_dispatch_poll();
+#endif
+
+#if (ARP_OFFLOAD_RUNTIME_CONFIG)
+        /* Program the offload again after a reconnect or new IP address. */
+        arp_offload_poll();
+#endif
+
+#if (PF_STATS)
+        /* Awake anyway; reading the filter counters costs no extra wake. */
+        pf_stats_poll();
+#endif
+
+#if(MQTT_CLIENT_MODE)
+        /* Reconnect if the broker stopped answering while the host slept. */
+        (void)mqtt_client_resume();
+#endif
+
+#if(TCP_KEEPALIVE_OFFLOAD)
+#if (TX_COALESCE)
+        /* The radio is awake; send held acknowledgements along. This is
+         * also the deadline flush, so that the TLS record is encrypted on
+         * this task's stack rather than the timer task's.
+         */
+        tx_coalesce_radio_awake();
+#endif
+
+#if (ASYNC_CONNECT)
+        /* Handle a connect that finished or ran out of time. A failure that
+         * uses up the retries gives the semaphore for a reconnect below.
+         */
+        async_connect_poll();
+#endif
+
+        /* The disconnection handler gives the semaphore when the server
+         * drops the connection; reconnect now that the stack is awake.
+         */
+        if (!reconnect_pending &&
+            (CY_RSLT_SUCCESS == cy_rtos_semaphore_get(&connect_to_server, 0U)))
+        {
+            reconnect_pending = true;
+        }
+
+        if (reconnect_pending && cy_wcm_is_connected_to_ap())
+        {
+            /* Doubled before the attempt; a successful connect starts over. */
+            reconnect_backoff_ms = ((2U * reconnect_backoff_ms) < RECONNECT_BACKOFF_MAX_MS) ?
+                                   (2U * reconnect_backoff_ms) : RECONNECT_BACKOFF_MAX_MS;
+
+#if (ASYNC_CONNECT)
+            result = start_server_connect(&tcp_server_address);
+#else
+            result = connect_to_tcp_server(tcp_server_address);
+#endif
+
+            /* Otherwise try again after the backoff. A background connect
+             * that uses up its retries gives the semaphore again.
+             */
+            reconnect_pending = (CY_RSLT_SUCCESS != result);
+        }
+#endif
     }
 
  }
@@ -585,11 +1135,13 @@ cy_rslt_t connect_to_wifi_ap(void)
 
      /* Set the Wi-Fi SSID, password and security type. */
     memset(&wifi_conn_param, RESET_VAL, sizeof(cy_wcm_connect_params_t));
-    memcpy(wifi_conn_param.ap_credentials.SSID, WIFI_SSID, sizeof(WIFI_SSID));
-    memcpy(wifi_conn_param.ap_credentials.password, WIFI_PASSWORD, sizeof(WIFI_PASSWORD));
-    wifi_conn_param.ap_credentials.security = WIFI_SECURITY_TYPE;
+    memcpy(wifi_conn_param.ap_credentials.SSID, net_config->ssid,
+           strnlen(net_config->ssid, CY_WCM_MAX_SSID_LEN));
+    memcpy(wifi_conn_param.ap_credentials.password, net_config->password,
+           strnlen(net_config->password, CY_WCM_MAX_PASSPHRASE_LEN));
+    wifi_conn_param.ap_credentials.security = net_config->security;
 
-    printf("Connecting to Wi-Fi Network: %s\n", WIFI_SSID);
+    printf("Connecting to Wi-Fi Network: %s\n", net_config->ssid);
 
     /* Join the Wi-Fi AP. */
     for(uint32_t conn_retries = 0; conn_retries < MAX_WIFI_CONN_RETRIES; conn_retries++ )
@@ -626,23 +1178,23 @@ cy_rslt_t connect_to_wifi_ap(void)
 *  to set call back function for handling incoming messages, call back
 *  function to handle disconnection.
 * Parameters:
-*  void
+*  cy_socket_t *socket_handle: Receives the handle of the new socket
 *
 * Return:
 *  cy_rslt_t: Returns CY_RSLT_SUCCESS if the TCP server socket is created
 * successfully.
 *
 *******************************************************************************/
-cy_rslt_t create_tcp_client_socket(void)
+cy_rslt_t create_tcp_client_socket(cy_socket_t *socket_handle)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;;
 
     /* TCP keep alive parameters. */
     int keep_alive = 1;
 #if defined (COMPONENT_LWIP)
-    uint32_t keep_alive_interval = TCP_KEEP_ALIVE_INTERVAL_MS;
-    uint32_t keep_alive_count    = TCP_KEEP_ALIVE_RETRY_COUNT;
-    uint32_t keep_alive_idle_time = TCP_KEEP_ALIVE_IDLE_TIME_MS;
+    uint32_t keep_alive_interval = net_config->keepalive_interval_ms;
+    uint32_t keep_alive_count    = net_config->keepalive_count;
+    uint32_t keep_alive_idle_time = net_config->keepalive_idle_ms;
 #endif
 
     /* Variables used to set socket options. */
@@ -651,7 +1203,7 @@ cy_rslt_t create_tcp_client_socket(void)
 
     /* Create a new secure TCP socket. */
     result = cy_socket_create(CY_SOCKET_DOMAIN_AF_INET, CY_SOCKET_TYPE_STREAM,
-                              CY_SOCKET_IPPROTO_TCP, &client_handle);
+                              CY_SOCKET_IPPROTO_TCP, socket_handle);
 
     if (CY_RSLT_SUCCESS != result)
     {
@@ -659,7 +1211,13 @@ cy_rslt_t create_tcp_client_socket(void)
         return result;
     }
 
-    result = cy_socket_setsockopt(client_handle, CY_SOCKET_SOL_SOCKET,
+    /* Register the callback function to handle messages received from the
+     * TCP server.
+     */
+    tcp_recv_option.callback = tcp_client_recv_handler;
+    tcp_recv_option.arg = NULL;
+
+    result = cy_socket_setsockopt(*socket_handle, CY_SOCKET_SOL_SOCKET,
                                   CY_SOCKET_SO_RECEIVE_CALLBACK,
                                   &tcp_recv_option, sizeof(cy_socket_opt_callback_t));
     if (CY_RSLT_SUCCESS != result)
@@ -672,7 +1230,7 @@ cy_rslt_t create_tcp_client_socket(void)
     tcp_disconnect_option.callback = tcp_disconnection_handler;
     tcp_disconnect_option.arg = NULL;
 
-    result = cy_socket_setsockopt(client_handle, CY_SOCKET_SOL_SOCKET,
+    result = cy_socket_setsockopt(*socket_handle, CY_SOCKET_SOL_SOCKET,
                                   CY_SOCKET_SO_DISCONNECT_CALLBACK,
                                   &tcp_disconnect_option, sizeof(cy_socket_opt_callback_t));
     if(CY_RSLT_SUCCESS != result)
@@ -682,7 +1240,7 @@ cy_rslt_t create_tcp_client_socket(void)
 
 #if defined (COMPONENT_LWIP)
     /* Set the TCP keep alive interval. */
-    result = cy_socket_setsockopt(client_handle, CY_SOCKET_SOL_TCP,
+    result = cy_socket_setsockopt(*socket_handle, CY_SOCKET_SOL_TCP,
                                   CY_SOCKET_SO_TCP_KEEPALIVE_INTERVAL,
                                   &keep_alive_interval, sizeof(keep_alive_interval));
     if(CY_RSLT_SUCCESS != result)
@@ -692,7 +1250,7 @@ cy_rslt_t create_tcp_client_socket(void)
     }
 
     /* Set the retry count for TCP keep alive packet. */
-    result = cy_socket_setsockopt(client_handle, CY_SOCKET_SOL_TCP,
+    result = cy_socket_setsockopt(*socket_handle, CY_SOCKET_SOL_TCP,
                                   CY_SOCKET_SO_TCP_KEEPALIVE_COUNT,
                                   &keep_alive_count, sizeof(keep_alive_count));
     if(CY_RSLT_SUCCESS != result)
@@ -702,7 +1260,7 @@ cy_rslt_t create_tcp_client_socket(void)
     }
 
     /* Set the network idle time before sending the TCP keep alive packet. */
-    result = cy_socket_setsockopt(client_handle, CY_SOCKET_SOL_TCP,
+    result = cy_socket_setsockopt(*socket_handle, CY_SOCKET_SOL_TCP,
                                   CY_SOCKET_SO_TCP_KEEPALIVE_IDLE_TIME,
                                   &keep_alive_idle_time, sizeof(keep_alive_idle_time));
     if(CY_RSLT_SUCCESS != result)
@@ -713,7 +1271,7 @@ cy_rslt_t create_tcp_client_socket(void)
 #endif
 
     /* Enable TCP keep alive. */
-    result = cy_socket_setsockopt(client_handle, CY_SOCKET_SOL_SOCKET,
+    result = cy_socket_setsockopt(*socket_handle, CY_SOCKET_SOL_SOCKET,
                                       CY_SOCKET_SO_TCP_KEEPALIVE_ENABLE,
                                           &keep_alive, sizeof(keep_alive));
     if(CY_RSLT_SUCCESS != result)
@@ -725,6 +1283,102 @@ cy_rslt_t create_tcp_client_socket(void)
     return result;
 }
 
+/*******************************************************************************
+* Function Name: open_server_connection
+********************************************************************************
+* Summary:
+*  Makes one attempt to connect to the TCP server, including the TLS
+*  handshake. With ASYNC_CONNECT it runs in the connect task.
+*
+* Parameters:
+*  cy_socket_t *socket_handle: Receives the connected socket
+*  void *arg: Address of the TCP server (cy_socket_sockaddr_t)
+*
+* Return:
+*  cy_result result: Returns CY_RSLT_SUCCESS if the socket is connected;
+*  otherwise the socket is deleted and *socket_handle is NULL.
+*
+*******************************************************************************/
+static cy_rslt_t open_server_connection(cy_socket_t *socket_handle, void *arg)
+{
+    cy_rslt_t conn_result;
+
+#if (SERVER_FAILOVER)
+    /* Race the servers; the first connection wins. */
+    CY_UNUSED_PARAMETER(arg);
+    conn_result = server_failover_connect(socket_handle, &connected_endpoint);
+#else
+    /* Create a TCP socket */
+    conn_result = create_tcp_client_socket(socket_handle);
+
+    if(CY_RSLT_SUCCESS != conn_result)
+    {
+        printf("Socket creation failed!\n");
+        handle_app_error();
+    }
+
+    conn_result = cy_socket_connect(*socket_handle, (cy_socket_sockaddr_t *)arg,
+                                    sizeof(cy_socket_sockaddr_t));
+#endif
+    EVENT_TRACE_RECORD(EVENT_TRACE_SOCKET, EVENT_TRACE_SOCK_CONNECT,
+                       (uint16_t)CY_RSLT_GET_CODE(conn_result));
+
+#if(TLS_CLIENT_MODE)
+    /* Run the TLS handshake on the connected socket, resuming the cached
+     * session when the server accepts it.
+     */
+    if (CY_RSLT_SUCCESS == conn_result)
+    {
+        conn_result = tls_client_handshake(*socket_handle);
+        tls_client_print_stats();
+#if(TLS_MEM_POOL)
+        tls_mem_pool_print_stats();
+#endif
+    }
+#endif
+
+    /* The resources allocated during the socket creation (cy_socket_create)
+     * should be deleted. A failed failover race leaves no socket behind.
+     */
+    if ((CY_RSLT_SUCCESS != conn_result) && (NULL != *socket_handle))
+    {
+        cy_socket_delete(*socket_handle);
+        *socket_handle = NULL;
+    }
+
+    return conn_result;
+}
+
+/*******************************************************************************
+* Function Name: server_connected
+********************************************************************************
+* Summary:
+*  Finishes a connect once client_handle holds the connected socket.
+*
+*******************************************************************************/
+static void server_connected(void)
+{
+#if(TCP_KEEPALIVE_OFFLOAD)
+    reconnect_backoff_ms = RECONNECT_BACKOFF_MIN_MS;
+#endif
+
+#if (POWER_PROFILES)
+    /* Keep the keepalive of this connection in line with the profile. */
+    power_profile_attach_socket(client_handle);
+#endif
+    printf("============================================================\n");
+    printf("Connected to TCP server\n");
+
+#if (SERVER_FAILOVER)
+    printf("Server failover: connected to endpoint %"PRIu32"\n", connected_endpoint);
+    server_failover_print_stats();
+#endif
+
+#if (ENERGY_STATS)
+    energy_stats_op_end(ENERGY_OP_CONNECT);
+#endif
+}
+
 /*******************************************************************************
 * Function Name: connect_to_tcp_server
 ********************************************************************************
@@ -744,42 +1398,360 @@ cy_rslt_t connect_to_tcp_server(cy_socket_sockaddr_t address)
     cy_rslt_t result = CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
     cy_rslt_t conn_result= CY_RSLT_SUCCESS;
 
+#if (ENERGY_STATS)
+    /* All attempts, including the TLS handshake, count as one connect. */
+    energy_stats_op_begin(ENERGY_OP_CONNECT);
+#endif
+
     for(uint32_t conn_retries = 0; conn_retries < MAX_TCP_SERVER_CONN_RETRIES; conn_retries++)
     {
-        /* Create a TCP socket */
-        conn_result = create_tcp_client_socket();
-
-        if(CY_RSLT_SUCCESS != conn_result)
-        {
-            printf("Socket creation failed!\n");
-            handle_app_error();
-        }
-
-        conn_result = cy_socket_connect(client_handle, &address, sizeof(cy_socket_sockaddr_t));
+        client_handle = NULL;
+        conn_result = open_server_connection(&client_handle, &address);
 
         if (CY_RSLT_SUCCESS == conn_result)
         {
-            printf("============================================================\n");
-            printf("Connected to TCP server\n");
-
+            server_connected();
             return conn_result;
         }
 
-        printf("Could not connect to TCP server. Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        printf("Could not connect to TCP server. Error code: 0x%08"PRIx32"\n", (uint32_t)conn_result);
         printf("Trying to reconnect to TCP server... Please check if the server is listening\n");
-
-        /* The resources allocated during the socket creation (cy_socket_create)
-         * should be deleted.
-         */
-        cy_socket_delete(client_handle);
     }
 
      /* Stop retrying after maximum retry attempts. */
      printf("Exceeded maximum connection attempts to the TCP server\n");
 
+#if (ENERGY_STATS)
+     energy_stats_op_end(ENERGY_OP_CONNECT);
+#endif
+
      return result;
 }
 
+#if (ASYNC_CONNECT)
+/*******************************************************************************
+* Function Name: server_connect_complete
+********************************************************************************
+* Summary:
+*  Outcome of a background attempt, called from async_connect_poll() in the
+*  network task. Starts the next attempt until MAX_TCP_SERVER_CONN_RETRIES
+*  are used up, then leaves the reconnect to the suspend loop.
+*
+* Parameters:
+*  cy_rslt_t result: Outcome of the attempt
+*  cy_socket_t socket_handle: Connected socket on success
+*  void *arg: Address of the TCP server (cy_socket_sockaddr_t)
+*
+*******************************************************************************/
+static void server_connect_complete(cy_rslt_t result, cy_socket_t socket_handle, void *arg)
+{
+    if (CY_RSLT_SUCCESS == result)
+    {
+        client_handle = socket_handle;
+        server_connected();
+        return;
+    }
+
+    printf("Could not connect to TCP server. Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+
+    if (++async_conn_retries < MAX_TCP_SERVER_CONN_RETRIES)
+    {
+        printf("Trying to reconnect to TCP server... Please check if the server is listening\n");
+
+        if (CY_RSLT_SUCCESS == async_connect_start(open_server_connection, arg,
+                                                   ASYNC_CONNECT_DEADLINE_MS,
+                                                   server_connect_complete, arg))
+        {
+            return;
+        }
+    }
+
+    printf("Exceeded maximum connection attempts to the TCP server\n");
+
+#if (ENERGY_STATS)
+    energy_stats_op_end(ENERGY_OP_CONNECT);
+#endif
+
+    cy_rtos_semaphore_set(&connect_to_server);
+}
+
+/*******************************************************************************
+* Function Name: start_server_connect
+********************************************************************************
+* Summary:
+*  Starts connecting to the TCP server in the background and returns at once.
+*  A connect already in flight is abandoned.
+*
+* Parameters:
+*  cy_socket_sockaddr_t *address: Address of TCP server socket; must stay
+*  valid until the connect completes
+*
+* Return:
+*  cy_result result: Returns CY_RSLT_SUCCESS if the first attempt started
+*
+*******************************************************************************/
+static cy_rslt_t start_server_connect(cy_socket_sockaddr_t *address)
+{
+    cy_rslt_t result;
+
+    async_connect_cancel();
+    async_conn_retries = 0U;
+
+#if (ENERGY_STATS)
+    /* All attempts, including the TLS handshake, count as one connect. */
+    energy_stats_op_begin(ENERGY_OP_CONNECT);
+#endif
+
+    result = async_connect_start(open_server_connection, address, ASYNC_CONNECT_DEADLINE_MS,
+                                 server_connect_complete, address);
+
+#if (ENERGY_STATS)
+    if (CY_RSLT_SUCCESS != result)
+    {
+        energy_stats_op_end(ENERGY_OP_CONNECT);
+    }
+#endif
+
+    return result;
+}
+#endif /* ASYNC_CONNECT */
+
+/*******************************************************************************
+* Function Name: run_led_command
+********************************************************************************
+* Summary:
+*  Turns the user LED on or off for the LED_ON_CMD/LED_OFF_CMD commands.
+*
+* Parameters:
+*  char command: Command received from the TCP server
+*
+* Return:
+*  const char *: Acknowledgement to send back to the server
+*
+*******************************************************************************/
+static const char *run_led_command(char command)
+{
+    switch (command)
+    {
+        case LED_ON_CMD:
+            Cy_GPIO_Write(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN, CYBSP_LED_STATE_ON);
+            printf("LED turned ON\n");
+            return ACK_LED_ON;
+
+        case LED_OFF_CMD:
+            Cy_GPIO_Write(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN, CYBSP_LED_STATE_OFF);
+            printf("LED turned OFF\n");
+            return ACK_LED_OFF;
+
+        default:
+            printf("Invalid command\n");
+            return MSG_INVALID_CMD;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tcp_client_recv_handler
+********************************************************************************
+* Summary:
+*  Callback function to handle incoming TCP server messages. Turns the user
+*  LED on or off for the LED_ON_CMD/LED_OFF_CMD commands and sends the
+*  acknowledgement back to the server.
+*
+* Parameters:
+*  cy_socket_t socket_handle: Connection handle for the TCP client socket
+*  void *args : Parameter passed on to the function (unused)
+*
+* Return:
+*  cy_result result: Result of the operation
+*
+*******************************************************************************/
+cy_rslt_t tcp_client_recv_handler(cy_socket_t socket_handle, void *arg)
+{
+    cy_rslt_t result;
+    char message_buffer[MAX_TCP_DATA_PACKET_LENGTH];
+    const char *ack;
+    uint32_t bytes_received = 0;
+    uint32_t bytes_sent = 0;
+
+    CY_UNUSED_PARAMETER(arg);
+
+#if(TLS_CLIENT_MODE)
+    CY_UNUSED_PARAMETER(socket_handle);
+    result = tls_client_recv((uint8_t *)message_buffer, TCP_LED_CMD_LEN, &bytes_received);
+#else
+    result = cy_socket_recv(socket_handle, message_buffer, TCP_LED_CMD_LEN,
+                            CY_SOCKET_FLAGS_NONE, &bytes_received);
+    EVENT_TRACE_RECORD(EVENT_TRACE_SOCKET, EVENT_TRACE_SOCK_RECEIVE, (uint16_t)bytes_received);
+#endif
+
+    if ((CY_RSLT_SUCCESS != result) || (0U == bytes_received))
+    {
+        return result;
+    }
+
+#if (ENERGY_STATS)
+    energy_stats_op_begin(ENERGY_OP_COMMAND);
+#endif
+
+#if (WAKE_DISPATCH)
+    /* The wake dispatch drove the LED for this command already; only the
+     * acknowledgement is left.
+     */
+    if (0U != wake_dispatch_take_handled(led_command_server.ip_address.ip.v4,
+                                         led_command_server.port, bytes_received))
+    {
+        ack = (LED_ON_CMD == message_buffer[0]) ? ACK_LED_ON : ACK_LED_OFF;
+    }
+    else
+    {
+        ack = run_led_command(message_buffer[0]);
+    }
+#else
+    ack = run_led_command(message_buffer[0]);
+#endif
+
+    /* Send the acknowledgement to the TCP server. */
+#if (TX_COALESCE)
+    /* Sent at once unless it follows another reply within the budget; the
+     * rest of a burst of commands is answered in one segment.
+     */
+    CY_UNUSED_PARAMETER(bytes_sent);
+    result = tx_coalesce_write((const uint8_t *)ack, strlen(ack));
+#elif(TLS_CLIENT_MODE)
+    result = tls_client_send((const uint8_t *)ack, strlen(ack), &bytes_sent);
+#else
+    result = cy_socket_send(socket_handle, ack, strlen(ack),
+                            CY_SOCKET_FLAGS_NONE, &bytes_sent);
+    EVENT_TRACE_RECORD(EVENT_TRACE_SOCKET, EVENT_TRACE_SOCK_SEND, (uint16_t)bytes_sent);
+#endif
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to send the acknowledgement. Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+    }
+
+#if (LWIP_POOL_STATS)
+    /* The acknowledgement is queued until the server acknowledges it. */
+    lwip_pool_stats_sample(LWIP_POOL_STATS_SOCKET);
+#endif
+
+#if (ENERGY_STATS)
+    energy_stats_op_end(ENERGY_OP_COMMAND);
+#endif
+
+    return result;
+}
+
+#if (TX_COALESCE)
+/*******************************************************************************
+* Function Name: send_to_server
+********************************************************************************
+* Summary:
+*  Sends coalesced data on the connection to the TCP server.
+*
+* Parameters:
+*  const uint8_t *data: Data to send
+*  uint32_t length: Length of data
+*
+* Return:
+*  cy_result result: Result of the send
+*
+*******************************************************************************/
+static cy_rslt_t send_to_server(const uint8_t *data, uint32_t length)
+{
+    cy_rslt_t result;
+    uint32_t bytes_sent = 0;
+
+#if(TLS_CLIENT_MODE)
+    result = tls_client_send(data, length, &bytes_sent);
+#else
+    result = cy_socket_send(client_handle, data, length,
+                            CY_SOCKET_FLAGS_NONE, &bytes_sent);
+    EVENT_TRACE_RECORD(EVENT_TRACE_SOCKET, EVENT_TRACE_SOCK_SEND, (uint16_t)bytes_sent);
+#endif
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to send the acknowledgement. Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+    }
+
+#if (LWIP_POOL_STATS)
+    lwip_pool_stats_sample(LWIP_POOL_STATS_SOCKET);
+#endif
+
+    return result;
+}
+#endif /* TX_COALESCE */
+
+#if (WAKE_DISPATCH)
+/*******************************************************************************
+* Function Name: led_command_wake_handler
+********************************************************************************
+* Summary:
+*  Drives the user LED as soon as a command frame wakes the host, ahead of the
+*  network stack resume. The dispatch calls it only for the next in-order
+*  segment of the connection to the server. The segment still reaches lwIP;
+*  the receive handler then only sends the acknowledgement.
+*
+* Parameters:
+*  const wake_dispatch_frame_t *frame: Waking frame
+*  void *arg: Unused
+*
+* Return:
+*  wake_dispatch_action_t: WAKE_DISPATCH_CONSUMED for a single command
+*
+*******************************************************************************/
+static wake_dispatch_action_t led_command_wake_handler(const wake_dispatch_frame_t *frame,
+                                                       void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    /* Anything but one command is left to the receive handler. */
+    if (TCP_LED_CMD_LEN != frame->payload_length)
+    {
+        return WAKE_DISPATCH_PASS;
+    }
+
+    Cy_GPIO_Write(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN,
+                  (LED_ON_CMD == frame->payload[0]) ? CYBSP_LED_STATE_ON : CYBSP_LED_STATE_OFF);
+
+    return WAKE_DISPATCH_CONSUMED;
+}
+
+#if(WOWL_RUNTIME_PATTERNS)
+/*******************************************************************************
+* Function Name: peer_wake_handler
+********************************************************************************
+* Summary:
+*  Handles a wake frame from the WOWL peer. A frame that is neither IP nor
+*  ARP only wakes the host and lwIP would drop it, so it is kept from the
+*  network stack.
+*
+* Parameters:
+*  const wake_dispatch_frame_t *frame: Waking frame
+*  void *arg: Unused
+*
+* Return:
+*  wake_dispatch_action_t: WAKE_DISPATCH_CONSUMED for non-IP frames
+*
+*******************************************************************************/
+static wake_dispatch_action_t peer_wake_handler(const wake_dispatch_frame_t *frame, void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    switch (frame->ether_type)
+    {
+        case ETHTYPE_IP:
+        case ETHTYPE_ARP:
+        case ETHTYPE_IPV6:
+            return WAKE_DISPATCH_PASS;
+
+        default:
+            return WAKE_DISPATCH_CONSUMED;
+    }
+}
+#endif
+#endif /* WAKE_DISPATCH */
 
 /*******************************************************************************
 * Function Name: tcp_disconnection_handler
@@ -799,6 +1771,23 @@ cy_rslt_t tcp_disconnection_handler(cy_socket_t socket_handle, void *arg)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
 
+#if(TLS_CLIENT_MODE)
+    /* Release the TLS context; the session stays cached for the reconnect. */
+    tls_client_close();
+#endif
+
+#if (POWER_PROFILES)
+    power_profile_detach_socket();
+#endif
+
+    EVENT_TRACE_RECORD(EVENT_TRACE_SOCKET, EVENT_TRACE_SOCK_DISCONNECT, 0U);
+
+#if (TX_COALESCE)
+    /* Nothing may be sent on the socket once it is deleted. */
+    tx_coalesce_discard();
+    tx_coalesce_print_stats();
+#endif
+
     /* Disconnect the TCP client. */
     result = cy_socket_disconnect(socket_handle, DISCONNECTION_TIMEOUT);
 
@@ -42,9 +42,24 @@
 #ifndef TCP_KEEPALIVE_OFFLOAD_H_
 #define TCP_KEEPALIVE_OFFLOAD_H_
 
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to bring up the Wi-Fi device in its own task, right
+ * after the scheduler starts, while the rest of the board start-up runs.
+ */
+#ifndef PARALLEL_STARTUP
+#define PARALLEL_STARTUP                         (0U)
+#endif
+
+#define RADIO_INIT_TASK_STACK_SIZE               (1024U * 2U)
+#define RADIO_INIT_TASK_PRIORITY                 (2U)
+
 /*******************************************************************************
 * Function Prototype
 *******************************************************************************/
 void network_idle_task(void *arg);
+void radio_power_up(void);
+void radio_init_task(void *arg);
 
 #endif /* TCP_CLIENT_H_ */
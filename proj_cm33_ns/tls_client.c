@@ -0,0 +1,720 @@
+/*******************************************************************************
+* File Name:   tls_client.c
+*
+* Description: This file contains the TLS client mode. The TLS handshake runs
+* with mbedTLS over the connected secure-sockets TCP socket so that the
+* negotiated session can be saved after every handshake and offered again on
+* the next reconnect, turning a full asymmetric handshake into an abbreviated
+* one.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include "cyabs_rtos.h"
+#include <inttypes.h>
+
+#include "tls_client.h"
+#include "event_trace.h"
+
+#if (TLS_CLIENT_MODE)
+
+/* mbedTLS header files */
+#include "mbedtls/ssl.h"
+#include "mbedtls/net_sockets.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/x509_crt.h"
+#if defined(MBEDTLS_USE_PSA_CRYPTO)
+#include "psa/crypto.h"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TLS_SESSION_CACHE_MAGIC                  (0x544C5353UL)
+#define TLS_DRBG_PERSONALIZATION                 "tls_client"
+
+/* FNV-1a parameters used to validate the retained session cache. */
+#define FNV1A_OFFSET_BASIS                       (0x811C9DC5UL)
+#define FNV1A_PRIME                              (0x01000193UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Serialized session kept in RAM that is not cleared at start-up. */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t length;
+    uint32_t checksum;
+    uint8_t data[TLS_SESSION_CACHE_SIZE];
+} tls_session_cache_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Placed in the no-init section so that it survives deep sleep and warm
+ * resets. It is validated with the magic value and checksum before use.
+ */
+CY_NOINIT static tls_session_cache_t session_cache;
+
+static mbedtls_ssl_context ssl;
+static mbedtls_ssl_config conf;
+static mbedtls_x509_crt ca_cert;
+static mbedtls_entropy_context entropy;
+static mbedtls_ctr_drbg_context ctr_drbg;
+static cy_socket_t tls_socket;
+static bool config_ready = false;
+static bool session_active = false;
+
+static tls_client_stats_t stats;
+
+/*******************************************************************************
+* Function Name: session_cache_checksum
+********************************************************************************
+* Summary:
+*  Computes the FNV-1a hash of the cached session.
+*
+* Return:
+*  uint32_t: Hash of the length field and the session data
+*
+*******************************************************************************/
+static uint32_t session_cache_checksum(void)
+{
+    uint32_t hash = FNV1A_OFFSET_BASIS ^ session_cache.length;
+
+    for (uint32_t i = 0; i < session_cache.length; i++)
+    {
+        hash = (hash ^ session_cache.data[i]) * FNV1A_PRIME;
+    }
+
+    return hash;
+}
+
+/*******************************************************************************
+* Function Name: session_cache_valid
+********************************************************************************
+* Summary:
+*  Checks whether the retained session cache holds a session. If it does not
+*  and persistence is enabled, the session is loaded from persistent storage.
+*
+* Return:
+*  bool: true if a session is available
+*
+*******************************************************************************/
+static bool session_cache_valid(void)
+{
+    if ((TLS_SESSION_CACHE_MAGIC == session_cache.magic) &&
+        (session_cache.length <= TLS_SESSION_CACHE_SIZE) &&
+        (session_cache_checksum() == session_cache.checksum))
+    {
+        return true;
+    }
+
+    session_cache.magic = 0U;
+    session_cache.length = 0U;
+
+#if (TLS_SESSION_PERSIST)
+    uint32_t length = 0U;
+
+    if ((CY_RSLT_SUCCESS == tls_session_persist_load(session_cache.data,
+                                                     TLS_SESSION_CACHE_SIZE,
+                                                     &length)) &&
+        (0U != length) && (length <= TLS_SESSION_CACHE_SIZE))
+    {
+        session_cache.length = length;
+        session_cache.checksum = session_cache_checksum();
+        session_cache.magic = TLS_SESSION_CACHE_MAGIC;
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: session_cache_store
+********************************************************************************
+* Summary:
+*  Serializes the session negotiated on the current connection into the
+*  retained cache, and into persistent storage when enabled.
+*
+*******************************************************************************/
+static void session_cache_store(void)
+{
+    mbedtls_ssl_session session;
+    size_t length = 0U;
+    int ret;
+
+    mbedtls_ssl_session_init(&session);
+
+    ret = mbedtls_ssl_get_session(&ssl, &session);
+    if (0 == ret)
+    {
+        ret = mbedtls_ssl_session_save(&session, session_cache.data,
+                                       TLS_SESSION_CACHE_SIZE, &length);
+    }
+
+    mbedtls_ssl_session_free(&session);
+
+    if (0 != ret)
+    {
+        printf("TLS session could not be cached (-0x%04x)\n", (unsigned int)-ret);
+        session_cache.magic = 0U;
+        return;
+    }
+
+    session_cache.length = (uint32_t)length;
+    session_cache.checksum = session_cache_checksum();
+    session_cache.magic = TLS_SESSION_CACHE_MAGIC;
+
+#if (TLS_SESSION_PERSIST)
+    (void)tls_session_persist_save(session_cache.data, session_cache.length);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: tls_bio_send
+********************************************************************************
+* Summary:
+*  mbedTLS send callback on top of the secure-sockets TCP socket.
+*
+*******************************************************************************/
+static int tls_bio_send(void *ctx, const unsigned char *buf, size_t len)
+{
+    uint32_t bytes_sent = 0U;
+    cy_rslt_t result;
+
+    result = cy_socket_send(*(cy_socket_t *)ctx, buf, (uint32_t)len,
+                            CY_SOCKET_FLAGS_NONE, &bytes_sent);
+    EVENT_TRACE_RECORD(EVENT_TRACE_SOCKET, EVENT_TRACE_SOCK_SEND, (uint16_t)bytes_sent);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        return (int)bytes_sent;
+    }
+
+    if (CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT == result)
+    {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+
+    return MBEDTLS_ERR_NET_SEND_FAILED;
+}
+
+/*******************************************************************************
+* Function Name: tls_bio_recv
+********************************************************************************
+* Summary:
+*  mbedTLS receive callback on top of the secure-sockets TCP socket. The
+*  socket receive timeout bounds the wait.
+*
+*******************************************************************************/
+static int tls_bio_recv(void *ctx, unsigned char *buf, size_t len)
+{
+    uint32_t bytes_received = 0U;
+    cy_rslt_t result;
+
+    result = cy_socket_recv(*(cy_socket_t *)ctx, buf, (uint32_t)len,
+                            CY_SOCKET_FLAGS_NONE, &bytes_received);
+    EVENT_TRACE_RECORD(EVENT_TRACE_SOCKET, EVENT_TRACE_SOCK_RECEIVE, (uint16_t)bytes_received);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        return (int)bytes_received;
+    }
+
+    if (CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT == result)
+    {
+        return MBEDTLS_ERR_SSL_TIMEOUT;
+    }
+
+    if (CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED == result)
+    {
+        return MBEDTLS_ERR_NET_CONN_RESET;
+    }
+
+    return MBEDTLS_ERR_NET_RECV_FAILED;
+}
+
+/*******************************************************************************
+* Function Name: tls_config_init
+********************************************************************************
+* Summary:
+*  One-time set-up of the random number generator, the trusted root CA, and
+*  the client configuration. Session tickets are requested when the mbedTLS
+*  configuration supports them; session-ID resumption is always available.
+*  TLS 1.2 is used because its tickets and session IDs are available right
+*  after the handshake.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the configuration is ready
+*
+*******************************************************************************/
+static cy_rslt_t tls_config_init(void)
+{
+    int ret;
+
+    if (config_ready)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+#if defined(MBEDTLS_USE_PSA_CRYPTO)
+    if (PSA_SUCCESS != psa_crypto_init())
+    {
+        printf("PSA crypto initialization failed\n");
+        return TLS_CLIENT_RSLT_SETUP_FAILED;
+    }
+#endif
+
+    mbedtls_ssl_config_init(&conf);
+    mbedtls_x509_crt_init(&ca_cert);
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&ctr_drbg);
+
+    ret = mbedtls_ctr_drbg_seed(&ctr_drbg, mbedtls_entropy_func, &entropy,
+                                (const unsigned char *)TLS_DRBG_PERSONALIZATION,
+                                sizeof(TLS_DRBG_PERSONALIZATION) - 1U);
+
+    if (0 == ret)
+    {
+        ret = mbedtls_x509_crt_parse(&ca_cert,
+                                     (const unsigned char *)TLS_ROOT_CA_CERTIFICATE,
+                                     sizeof(TLS_ROOT_CA_CERTIFICATE));
+    }
+
+    if (0 == ret)
+    {
+        ret = mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_CLIENT,
+                                          MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+
+    if (0 != ret)
+    {
+        printf("TLS configuration failed (-0x%04x)\n", (unsigned int)-ret);
+        mbedtls_ctr_drbg_free(&ctr_drbg);
+        mbedtls_entropy_free(&entropy);
+        mbedtls_x509_crt_free(&ca_cert);
+        mbedtls_ssl_config_free(&conf);
+        return TLS_CLIENT_RSLT_SETUP_FAILED;
+    }
+
+    mbedtls_ssl_conf_authmode(&conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+    mbedtls_ssl_conf_ca_chain(&conf, &ca_cert, NULL);
+    mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &ctr_drbg);
+    mbedtls_ssl_conf_max_tls_version(&conf, MBEDTLS_SSL_VERSION_TLS1_2);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    mbedtls_ssl_conf_session_tickets(&conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+
+    config_ready = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: tls_client_handshake
+********************************************************************************
+* Summary:
+*  Runs the TLS handshake on a connected TCP socket. The cached session, if
+*  any, is offered to the server; the server decides whether to resume it.
+*  The handshake is timed and counted as full or resumed, and the resulting
+*  session is cached for the next reconnect.
+*
+* Parameters:
+*  cy_socket_t socket_handle: Connected TCP client socket
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the TLS session is established
+*
+*******************************************************************************/
+cy_rslt_t tls_client_handshake(cy_socket_t socket_handle)
+{
+    cy_rslt_t result;
+    mbedtls_ssl_session cached;
+    bool offered = false;
+    bool resumed = false;
+    uint32_t timeout_ms = TLS_HANDSHAKE_TIMEOUT_MS;
+    cy_time_t start_ms;
+    cy_time_t end_ms;
+    int ret;
+
+    result = tls_config_init();
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    tls_client_close();
+
+    result = cy_socket_setsockopt(socket_handle, CY_SOCKET_SOL_SOCKET,
+                                  CY_SOCKET_SO_RCVTIMEO, &timeout_ms,
+                                  sizeof(timeout_ms));
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Set socket option: CY_SOCKET_SO_RCVTIMEO failed\n");
+        return result;
+    }
+
+    tls_socket = socket_handle;
+    mbedtls_ssl_init(&ssl);
+
+    ret = mbedtls_ssl_setup(&ssl, &conf);
+    if (0 == ret)
+    {
+        ret = mbedtls_ssl_set_hostname(&ssl, TLS_SERVER_NAME);
+    }
+
+    if (0 != ret)
+    {
+        printf("TLS setup failed (-0x%04x)\n", (unsigned int)-ret);
+        mbedtls_ssl_free(&ssl);
+        return TLS_CLIENT_RSLT_SETUP_FAILED;
+    }
+
+    mbedtls_ssl_set_bio(&ssl, &tls_socket, tls_bio_send, tls_bio_recv, NULL);
+
+    /* Offer the cached session. A session that no longer loads is dropped
+     * and a full handshake is done instead.
+     */
+    if (session_cache_valid())
+    {
+        mbedtls_ssl_session_init(&cached);
+
+        if ((0 == mbedtls_ssl_session_load(&cached, session_cache.data,
+                                           session_cache.length)) &&
+            (0 == mbedtls_ssl_set_session(&ssl, &cached)))
+        {
+            offered = true;
+        }
+        else
+        {
+            tls_client_forget_session();
+        }
+
+        mbedtls_ssl_session_free(&cached);
+    }
+
+    cy_rtos_get_time(&start_ms);
+
+    /* Stepped rather than run in one call: the handshake context, which
+     * records whether the server resumed the session, is freed by the last
+     * step. The session ID the client offered is no proof, because a
+     * client that offers a session ticket sends a fresh random ID. The flag
+     * is set as soon as a session is offered and cleared when the
+     * ServerHello turns it down, so only the value sampled before the last
+     * step counts.
+     */
+    ret = 0;
+    while (!mbedtls_ssl_is_handshake_over(&ssl))
+    {
+        resumed = (0 != mbedtls_ssl_session_reused(&ssl));
+
+        ret = mbedtls_ssl_handshake_step(&ssl);
+        if ((MBEDTLS_ERR_SSL_WANT_READ == ret) || (MBEDTLS_ERR_SSL_WANT_WRITE == ret))
+        {
+            ret = 0;
+        }
+        else if (0 != ret)
+        {
+            break;
+        }
+    }
+
+    cy_rtos_get_time(&end_ms);
+    stats.last_ms = (uint32_t)(end_ms - start_ms);
+
+    if (0 != ret)
+    {
+        printf("TLS handshake failed (-0x%04x) after %"PRIu32" ms\n",
+               (unsigned int)-ret, stats.last_ms);
+        stats.failed_count++;
+        mbedtls_ssl_free(&ssl);
+
+        /* A rejected resumption must not be retried with the same session. */
+        if (offered)
+        {
+            tls_client_forget_session();
+        }
+
+        return TLS_CLIENT_RSLT_HANDSHAKE_FAILED;
+    }
+
+    session_active = true;
+
+    stats.last_resumed = offered && resumed;
+
+    if (stats.last_resumed)
+    {
+        stats.resumed_count++;
+        stats.resumed_total_ms += stats.last_ms;
+    }
+    else
+    {
+        stats.full_count++;
+        stats.full_total_ms += stats.last_ms;
+    }
+
+    printf("TLS %s handshake completed in %"PRIu32" ms (%s)\n",
+           stats.last_resumed ? "resumed" : "full", stats.last_ms,
+           mbedtls_ssl_get_ciphersuite(&ssl));
+
+    session_cache_store();
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: tls_client_send
+********************************************************************************
+* Summary:
+*  Sends application data over the TLS session.
+*
+* Parameters:
+*  const uint8_t *data: Data to send
+*  uint32_t length: Number of bytes to send
+*  uint32_t *bytes_sent: Number of bytes sent
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the data is sent
+*
+*******************************************************************************/
+cy_rslt_t tls_client_send(const uint8_t *data, uint32_t length, uint32_t *bytes_sent)
+{
+    int ret;
+
+    *bytes_sent = 0U;
+
+    if (!session_active)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOT_CONNECTED;
+    }
+
+    while (*bytes_sent < length)
+    {
+        ret = mbedtls_ssl_write(&ssl, &data[*bytes_sent], length - *bytes_sent);
+
+        if ((MBEDTLS_ERR_SSL_WANT_READ == ret) || (MBEDTLS_ERR_SSL_WANT_WRITE == ret))
+        {
+            continue;
+        }
+
+        if (ret < 0)
+        {
+            printf("TLS send failed (-0x%04x)\n", (unsigned int)-ret);
+            return TLS_CLIENT_RSLT_SEND_FAILED;
+        }
+
+        *bytes_sent += (uint32_t)ret;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: tls_client_recv
+********************************************************************************
+* Summary:
+*  Receives application data from the TLS session.
+*
+* Parameters:
+*  uint8_t *buffer: Buffer for the received data
+*  uint32_t length: Size of the buffer
+*  uint32_t *bytes_received: Number of bytes received
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if data is received
+*
+*******************************************************************************/
+cy_rslt_t tls_client_recv(uint8_t *buffer, uint32_t length, uint32_t *bytes_received)
+{
+    int ret;
+
+    *bytes_received = 0U;
+
+    if (!session_active)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOT_CONNECTED;
+    }
+
+    ret = mbedtls_ssl_read(&ssl, buffer, length);
+
+    if ((MBEDTLS_ERR_SSL_TIMEOUT == ret) || (MBEDTLS_ERR_SSL_WANT_READ == ret))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+    }
+
+    if ((0 == ret) || (MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY == ret))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED;
+    }
+
+    if (ret < 0)
+    {
+        printf("TLS receive failed (-0x%04x)\n", (unsigned int)-ret);
+        return TLS_CLIENT_RSLT_RECV_FAILED;
+    }
+
+    *bytes_received = (uint32_t)ret;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: tls_client_close
+********************************************************************************
+* Summary:
+*  Frees the TLS context of the current connection. The cached session is
+*  kept so that the next reconnect can resume it. Must be called before the
+*  underlying socket is deleted.
+*
+*******************************************************************************/
+void tls_client_close(void)
+{
+    if (session_active)
+    {
+        session_active = false;
+        mbedtls_ssl_free(&ssl);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tls_client_forget_session
+********************************************************************************
+* Summary:
+*  Drops the cached session so that the next handshake is a full one.
+*
+*******************************************************************************/
+void tls_client_forget_session(void)
+{
+    session_cache.magic = 0U;
+    session_cache.length = 0U;
+
+#if (TLS_SESSION_PERSIST)
+    (void)tls_session_persist_save(NULL, 0U);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: tls_client_get_stats
+********************************************************************************
+* Summary:
+*  Copies the handshake statistics.
+*
+* Parameters:
+*  tls_client_stats_t *out: Destination of the statistics
+*
+*******************************************************************************/
+void tls_client_get_stats(tls_client_stats_t *out)
+{
+    *out = stats;
+}
+
+/*******************************************************************************
+* Function Name: tls_client_print_stats
+********************************************************************************
+* Summary:
+*  Prints the number and the average duration of full and resumed handshakes.
+*
+*******************************************************************************/
+void tls_client_print_stats(void)
+{
+    printf("TLS handshakes: %"PRIu32" full (avg %"PRIu32" ms), "
+           "%"PRIu32" resumed (avg %"PRIu32" ms), %"PRIu32" failed\n",
+           stats.full_count,
+           (0U != stats.full_count) ? (stats.full_total_ms / stats.full_count) : 0U,
+           stats.resumed_count,
+           (0U != stats.resumed_count) ? (stats.resumed_total_ms / stats.resumed_count) : 0U,
+           stats.failed_count);
+}
+
+#endif /* TLS_CLIENT_MODE */
+
+/*******************************************************************************
+* Function Name: tls_session_persist_save
+********************************************************************************
+* Summary:
+*  Stores the serialized session in persistent storage. The default does
+*  nothing; provide a strong definition to persist the session. A zero length
+*  erases the stored session.
+*
+* Parameters:
+*  const uint8_t *data: Serialized session
+*  uint32_t length: Length of the serialized session
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the session is stored
+*
+*******************************************************************************/
+__WEAK cy_rslt_t tls_session_persist_save(const uint8_t *data, uint32_t length)
+{
+    (void)data;
+    (void)length;
+
+    return TLS_CLIENT_RSLT_NO_PERSIST;
+}
+
+/*******************************************************************************
+* Function Name: tls_session_persist_load
+********************************************************************************
+* Summary:
+*  Loads the serialized session from persistent storage. The default reports
+*  that no session is stored.
+*
+* Parameters:
+*  uint8_t *data: Buffer for the serialized session
+*  uint32_t size: Size of the buffer
+*  uint32_t *length: Length of the loaded session
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if a session is loaded
+*
+*******************************************************************************/
+__WEAK cy_rslt_t tls_session_persist_load(uint8_t *data, uint32_t size, uint32_t *length)
+{
+    (void)data;
+    (void)size;
+    *length = 0U;
+
+    return TLS_CLIENT_RSLT_NO_PERSIST;
+}
+
+/* [] END OF FILE */
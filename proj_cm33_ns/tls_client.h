@@ -0,0 +1,122 @@
+/*******************************************************************************
+* File Name:   tls_client.h
+*
+* Description: This file contains the configuration and declarations of the
+* TLS client mode, which resumes TLS sessions across reconnects using session
+* tickets or session IDs cached in retained RAM.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TLS_CLIENT_H_
+#define TLS_CLIENT_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include "cy_secure_sockets.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to run TLS over the TCP client connection. */
+#ifndef TLS_CLIENT_MODE
+#define TLS_CLIENT_MODE                          (0U)
+#endif
+
+/* Set this macro to '1' to also persist the cached session through
+ * tls_session_persist_save()/tls_session_persist_load() so that it survives
+ * a power cycle.
+ */
+#ifndef TLS_SESSION_PERSIST
+#define TLS_SESSION_PERSIST                      (0U)
+#endif
+
+/* Server name used for SNI and certificate verification. */
+#define TLS_SERVER_NAME                          "MY_TLS_SERVER"
+
+/* Root CA certificate of the TLS server in PEM format. */
+#define TLS_ROOT_CA_CERTIFICATE \
+"-----BEGIN CERTIFICATE-----\n" \
+"MY_ROOT_CA_CERTIFICATE\n" \
+"-----END CERTIFICATE-----\n"
+
+#define TLS_HANDSHAKE_TIMEOUT_MS                 (10000U)
+
+/* Size of the serialized session kept in retained RAM. */
+#define TLS_SESSION_CACHE_SIZE                   (512U)
+
+/* Results returned by this module. */
+#define TLS_CLIENT_RSLT_SETUP_FAILED             APP_RSLT_ERROR(APP_RSLT_GROUP_TLS_CLIENT, 1U)
+#define TLS_CLIENT_RSLT_HANDSHAKE_FAILED         APP_RSLT_ERROR(APP_RSLT_GROUP_TLS_CLIENT, 2U)
+#define TLS_CLIENT_RSLT_SEND_FAILED              APP_RSLT_ERROR(APP_RSLT_GROUP_TLS_CLIENT, 3U)
+#define TLS_CLIENT_RSLT_RECV_FAILED              APP_RSLT_ERROR(APP_RSLT_GROUP_TLS_CLIENT, 4U)
+#define TLS_CLIENT_RSLT_NO_PERSIST               APP_RSLT_ERROR(APP_RSLT_GROUP_TLS_CLIENT, 5U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Handshake statistics reported by tls_client_print_stats(). */
+typedef struct
+{
+    uint32_t full_count;
+    uint32_t resumed_count;
+    uint32_t failed_count;
+    uint32_t full_total_ms;
+    uint32_t resumed_total_ms;
+    uint32_t last_ms;
+    bool last_resumed;
+} tls_client_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t tls_client_handshake(cy_socket_t socket_handle);
+cy_rslt_t tls_client_send(const uint8_t *data, uint32_t length, uint32_t *bytes_sent);
+cy_rslt_t tls_client_recv(uint8_t *buffer, uint32_t length, uint32_t *bytes_received);
+void tls_client_close(void);
+void tls_client_forget_session(void);
+void tls_client_get_stats(tls_client_stats_t *stats);
+void tls_client_print_stats(void);
+
+/* Persistent storage hooks, weak no-op implementations by default. */
+cy_rslt_t tls_session_persist_save(const uint8_t *data, uint32_t length);
+cy_rslt_t tls_session_persist_load(uint8_t *data, uint32_t size, uint32_t *length);
+
+#endif /* TLS_CLIENT_H_ */
+
+/* [] END OF FILE */
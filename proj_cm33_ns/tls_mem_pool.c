@@ -0,0 +1,322 @@
+/*******************************************************************************
+* File Name:   tls_mem_pool.c
+*
+* Description: This file contains the fixed-block, size-class memory pool for
+* the TLS and socket layers. Every class is a free list of equally sized
+* blocks carved from a static arena, so the variable-sized mbedTLS buffers no
+* longer fragment the general heap over long uptimes.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "tls_mem_pool.h"
+
+#if (TLS_MEM_POOL)
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "mbedtls/platform.h"
+#include "mbedtls/ssl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TLS_MEM_POOL_ALIGNMENT                   (8U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Free blocks are chained through their first word. */
+typedef struct pool_block
+{
+    struct pool_block *next;
+} pool_block_t;
+
+typedef struct
+{
+    uint8_t *start;
+    uint8_t *end;
+    pool_block_t *free_list;
+    tls_mem_pool_class_stats_t stats;
+} pool_class_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint32_t class_sizes[TLS_MEM_POOL_CLASS_COUNT] = TLS_MEM_POOL_CLASS_SIZES;
+static const uint32_t class_blocks[TLS_MEM_POOL_CLASS_COUNT] = TLS_MEM_POOL_CLASS_BLOCKS;
+
+static uint8_t pool_arena[TLS_MEM_POOL_ARENA_SIZE] __ALIGNED(TLS_MEM_POOL_ALIGNMENT);
+static pool_class_t pool_classes[TLS_MEM_POOL_CLASS_COUNT];
+
+/* Requests no class could serve; these are passed on to the heap. */
+static uint32_t heap_fallbacks = 0U;
+static bool pool_ready = false;
+
+/*******************************************************************************
+* Function Name: tls_mem_pool_init
+********************************************************************************
+* Summary:
+*  Carves the arena into the configured size classes and installs the pool as
+*  the mbedTLS allocator. Must be called before the first TLS or secure
+*  sockets allocation; blocks allocated earlier are still freed to the heap.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the pool is installed
+*
+*******************************************************************************/
+cy_rslt_t tls_mem_pool_init(void)
+{
+    uint8_t *cursor = pool_arena;
+    uint32_t class_bytes;
+
+    if (pool_ready)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    for (uint32_t i = 0; i < TLS_MEM_POOL_CLASS_COUNT; i++)
+    {
+        pool_class_t *pool = &pool_classes[i];
+
+        class_bytes = class_sizes[i] * class_blocks[i];
+        if ((0U != (class_sizes[i] % TLS_MEM_POOL_ALIGNMENT)) ||
+            ((i > 0U) && (class_sizes[i] <= class_sizes[i - 1U])) ||
+            (class_bytes > (uint32_t)(&pool_arena[TLS_MEM_POOL_ARENA_SIZE] - cursor)))
+        {
+            printf("TLS memory pool: invalid configuration of class %"PRIu32"\n", i);
+            return TLS_MEM_POOL_RSLT_BAD_CONFIG;
+        }
+
+        pool->start = cursor;
+        pool->end = cursor + class_bytes;
+        pool->free_list = NULL;
+        pool->stats.block_size = class_sizes[i];
+        pool->stats.block_count = class_blocks[i];
+
+        /* Chain the blocks so that the lowest address is handed out first. */
+        for (uint32_t block = class_blocks[i]; block > 0U; block--)
+        {
+            pool_block_t *free_block =
+                (pool_block_t *)(void *)(cursor + ((block - 1U) * class_sizes[i]));
+            free_block->next = pool->free_list;
+            pool->free_list = free_block;
+        }
+
+        cursor += class_bytes;
+    }
+
+    if (0 != mbedtls_platform_set_calloc_free(tls_mem_pool_calloc, tls_mem_pool_free))
+    {
+        printf("TLS memory pool: mbedTLS allocator hook failed\n");
+        return TLS_MEM_POOL_RSLT_HOOK_FAILED;
+    }
+
+    pool_ready = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: tls_mem_pool_calloc
+********************************************************************************
+* Summary:
+*  Allocates a zeroed block from the smallest class that fits and has a free
+*  block. Requests larger than the largest class, or made while every fitting
+*  class is exhausted, are served by the heap and counted.
+*
+* Parameters:
+*  size_t count: Number of elements
+*  size_t size: Size of one element
+*
+* Return:
+*  void*: The zeroed block, or NULL on failure
+*
+*******************************************************************************/
+void *tls_mem_pool_calloc(size_t count, size_t size)
+{
+    pool_block_t *block = NULL;
+    size_t length;
+
+    if ((0U != size) && (count > (SIZE_MAX / size)))
+    {
+        return NULL;
+    }
+
+    length = count * size;
+
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < TLS_MEM_POOL_CLASS_COUNT; i++)
+    {
+        pool_class_t *pool = &pool_classes[i];
+
+        if (length > pool->stats.block_size)
+        {
+            continue;
+        }
+
+        if (NULL == pool->free_list)
+        {
+            pool->stats.exhausted++;
+            continue;
+        }
+
+        block = pool->free_list;
+        pool->free_list = block->next;
+        pool->stats.allocations++;
+        pool->stats.in_use++;
+        if (pool->stats.in_use > pool->stats.high_water)
+        {
+            pool->stats.high_water = pool->stats.in_use;
+        }
+        break;
+    }
+
+    if (NULL == block)
+    {
+        heap_fallbacks++;
+    }
+    taskEXIT_CRITICAL();
+
+    if (NULL == block)
+    {
+        return calloc(count, size);
+    }
+
+    memset(block, 0, length);
+
+    return block;
+}
+
+/*******************************************************************************
+* Function Name: tls_mem_pool_free
+********************************************************************************
+* Summary:
+*  Returns a block to its class. Pointers outside the arena came from the
+*  heap and are freed there.
+*
+* Parameters:
+*  void *ptr: Block to free
+*
+*******************************************************************************/
+void tls_mem_pool_free(void *ptr)
+{
+    uint8_t *address = (uint8_t *)ptr;
+
+    if (NULL == ptr)
+    {
+        return;
+    }
+
+    if ((address < pool_arena) || (address >= &pool_arena[TLS_MEM_POOL_ARENA_SIZE]))
+    {
+        free(ptr);
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < TLS_MEM_POOL_CLASS_COUNT; i++)
+    {
+        pool_class_t *pool = &pool_classes[i];
+
+        if ((address >= pool->start) && (address < pool->end))
+        {
+            ((pool_block_t *)ptr)->next = pool->free_list;
+            pool->free_list = (pool_block_t *)ptr;
+            pool->stats.in_use--;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tls_mem_pool_get_class_stats
+********************************************************************************
+* Summary:
+*  Copies the usage of one size class.
+*
+* Parameters:
+*  uint32_t index: Size class index
+*  tls_mem_pool_class_stats_t *stats: Destination of the usage
+*
+*******************************************************************************/
+void tls_mem_pool_get_class_stats(uint32_t index, tls_mem_pool_class_stats_t *stats)
+{
+    if (index < TLS_MEM_POOL_CLASS_COUNT)
+    {
+        taskENTER_CRITICAL();
+        *stats = pool_classes[index].stats;
+        taskEXIT_CRITICAL();
+    }
+}
+
+/*******************************************************************************
+* Function Name: tls_mem_pool_print_stats
+********************************************************************************
+* Summary:
+*  Prints the usage and high-water mark of every size class and the number
+*  of requests that fell back to the heap.
+*
+*******************************************************************************/
+void tls_mem_pool_print_stats(void)
+{
+    tls_mem_pool_class_stats_t stats;
+
+    printf("TLS memory pool   size  blocks  in use  high  allocs  exhausted\n");
+
+    for (uint32_t i = 0; i < TLS_MEM_POOL_CLASS_COUNT; i++)
+    {
+        tls_mem_pool_get_class_stats(i, &stats);
+        printf("                %6"PRIu32"  %6"PRIu32"  %6"PRIu32"  %4"PRIu32"  %6"PRIu32"  %9"PRIu32"\n",
+               stats.block_size, stats.block_count, stats.in_use,
+               stats.high_water, stats.allocations, stats.exhausted);
+    }
+
+    printf("TLS memory pool heap fallbacks: %"PRIu32"\n", heap_fallbacks);
+}
+
+#endif /* TLS_MEM_POOL */
+
+/* [] END OF FILE */
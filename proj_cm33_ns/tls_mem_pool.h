@@ -0,0 +1,120 @@
+/*******************************************************************************
+* File Name:   tls_mem_pool.h
+*
+* Description: This file contains the configuration and declarations of the
+* fixed-block, size-class memory pool that serves the mbedTLS and secure
+* sockets allocations outside of the general heap.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TLS_MEM_POOL_H_
+#define TLS_MEM_POOL_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set TLS_MEM_POOL=1 in proj_cm33_ns/Makefile to route the mbedTLS
+ * allocations through the pool. The Makefile also enables
+ * MBEDTLS_PLATFORM_MEMORY, which the allocation hooks require.
+ */
+#ifndef TLS_MEM_POOL
+#define TLS_MEM_POOL                             (0U)
+#endif
+
+/* Room for the record header, IV, MAC and CBC padding that mbedTLS adds to
+ * MBEDTLS_SSL_IN_CONTENT_LEN and MBEDTLS_SSL_OUT_CONTENT_LEN when it
+ * allocates the record buffers.
+ */
+#define TLS_MEM_POOL_RECORD_OVERHEAD             (512U)
+
+/* Block size of the top class, which holds the input and output record
+ * buffers of one connection. Only evaluated in tls_mem_pool.c, after the
+ * mbedTLS configuration.
+ */
+#define TLS_MEM_POOL_RECORD_SIZE                                                    \
+    ((((MBEDTLS_SSL_IN_CONTENT_LEN > MBEDTLS_SSL_OUT_CONTENT_LEN) ?                  \
+       MBEDTLS_SSL_IN_CONTENT_LEN : MBEDTLS_SSL_OUT_CONTENT_LEN) +                   \
+      TLS_MEM_POOL_RECORD_OVERHEAD + 7U) & ~7U)
+
+/* Size classes in bytes (ascending, multiples of 8) and the number of blocks
+ * in each class. Size them from the high-water marks printed by
+ * tls_mem_pool_print_stats().
+ */
+#define TLS_MEM_POOL_CLASS_COUNT                 (8U)
+#define TLS_MEM_POOL_CLASS_SIZES                 { 32U, 64U, 128U, 256U, 512U, 1024U, 2048U, TLS_MEM_POOL_RECORD_SIZE }
+#define TLS_MEM_POOL_CLASS_BLOCKS                { 48U, 32U,  24U,  16U,   8U,    4U,    4U,    2U }
+
+/* Memory reserved for all classes together: the small classes and the two
+ * record buffers.
+ */
+#define TLS_MEM_POOL_ARENA_SIZE                  ((27U * 1024U) + (2U * TLS_MEM_POOL_RECORD_SIZE))
+
+/* Results returned by this module. */
+#define TLS_MEM_POOL_RSLT_BAD_CONFIG             APP_RSLT_ERROR(APP_RSLT_GROUP_TLS_MEM_POOL, 1U)
+#define TLS_MEM_POOL_RSLT_HOOK_FAILED            APP_RSLT_ERROR(APP_RSLT_GROUP_TLS_MEM_POOL, 2U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Usage of one size class. */
+typedef struct
+{
+    uint32_t block_size;
+    uint32_t block_count;
+    uint32_t in_use;
+    uint32_t high_water;
+    uint32_t allocations;
+    uint32_t exhausted;           /* Requests passed on to a larger class */
+} tls_mem_pool_class_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t tls_mem_pool_init(void);
+void *tls_mem_pool_calloc(size_t count, size_t size);
+void tls_mem_pool_free(void *ptr);
+void tls_mem_pool_get_class_stats(uint32_t index, tls_mem_pool_class_stats_t *stats);
+void tls_mem_pool_print_stats(void);
+
+#endif /* TLS_MEM_POOL_H_ */
+
+/* [] END OF FILE */
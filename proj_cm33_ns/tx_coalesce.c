@@ -0,0 +1,384 @@
+/*******************************************************************************
+* File Name:   tx_coalesce.c
+*
+* Description: This file contains the transmit coalescing for the TCP client.
+* Each acknowledgement used to go out as its own segment, resuming the network
+* stack and waking the radio every time. A write on an idle connection still
+* goes out at once; writes that follow a segment within TX_COALESCE_BUDGET_MS
+* are held and sent together: when the network stack resumes, when the budget
+* runs out, or when the buffer fills. The network task does the deadline
+* flush; it bounds its suspend to tx_coalesce_time_left_ms().
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include "cyabs_rtos.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "tx_coalesce.h"
+
+#if (TX_COALESCE)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    FLUSH_DEADLINE,
+    FLUSH_FULL,
+    FLUSH_PIGGYBACK,
+    FLUSH_REQUEST
+} flush_reason_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static tx_coalesce_send_t send_fn;
+static cy_mutex_t tx_mutex;
+
+/* Held data, the time the oldest byte was written and the time the last
+ * segment went out. Guarded by tx_mutex.
+ */
+static uint8_t tx_buffer[TX_COALESCE_BUFFER_SIZE];
+static uint32_t tx_length;
+static cy_time_t held_since;
+static cy_time_t last_sent;
+static bool sent_before;
+static tx_coalesce_stats_t stats;
+
+/*******************************************************************************
+* Function Name: flush_locked
+********************************************************************************
+* Summary:
+*  Sends the held data as one write. Must be called with tx_mutex taken.
+*
+* Parameters:
+*  flush_reason_t reason: What triggered the flush, for the statistics
+*
+* Return:
+*  cy_rslt_t: Result of the send
+*
+*******************************************************************************/
+static cy_rslt_t flush_locked(flush_reason_t reason)
+{
+    cy_rslt_t result;
+
+    if (0U == tx_length)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    result = send_fn(tx_buffer, tx_length);
+    tx_length = 0U;
+    (void)cy_rtos_get_time(&last_sent);
+    sent_before = true;
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        stats.send_errors++;
+        return result;
+    }
+
+    stats.segments++;
+    switch (reason)
+    {
+        case FLUSH_DEADLINE:
+            stats.flush_deadline++;
+            break;
+
+        case FLUSH_FULL:
+            stats.flush_full++;
+            break;
+
+        case FLUSH_PIGGYBACK:
+            stats.flush_piggyback++;
+            break;
+
+        case FLUSH_REQUEST:
+        default:
+            break;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: send_now_locked
+********************************************************************************
+* Summary:
+*  Sends a write without holding it. Must be called with tx_mutex taken.
+*
+* Parameters:
+*  const uint8_t *data: Data to send
+*  uint32_t length: Length of data
+*
+* Return:
+*  cy_rslt_t: Result of the send
+*
+*******************************************************************************/
+static cy_rslt_t send_now_locked(const uint8_t *data, uint32_t length)
+{
+    cy_rslt_t result = send_fn(data, length);
+
+    (void)cy_rtos_get_time(&last_sent);
+    sent_before = true;
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        stats.send_errors++;
+        return result;
+    }
+
+    stats.direct++;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: tx_coalesce_init
+********************************************************************************
+* Summary:
+*  Sets up the transmit coalescing.
+*
+* Parameters:
+*  tx_coalesce_send_t send: Sends on the current connection
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the coalescing is ready
+*
+*******************************************************************************/
+cy_rslt_t tx_coalesce_init(tx_coalesce_send_t send)
+{
+    send_fn = send;
+
+    return cy_rtos_mutex_init(&tx_mutex, false);
+}
+
+/*******************************************************************************
+* Function Name: tx_coalesce_write
+********************************************************************************
+* Summary:
+*  Sends a write at once when nothing is held and no segment went out within
+*  the budget, so a lone write is not delayed. A write that follows a segment
+*  within the budget is held until the network task flushes it. A write
+*  larger than the buffer is sent at once, after the data held before it.
+*
+* Parameters:
+*  const uint8_t *data: Data to send
+*  uint32_t length: Length of data
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the data is held or sent; the error of a
+*  send made on the way otherwise
+*
+*******************************************************************************/
+cy_rslt_t tx_coalesce_write(const uint8_t *data, uint32_t length)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_time_t now;
+
+    cy_rtos_mutex_get(&tx_mutex, CY_RTOS_NEVER_TIMEOUT);
+    (void)cy_rtos_get_time(&now);
+
+    if ((tx_length + length) > TX_COALESCE_BUFFER_SIZE)
+    {
+        result = flush_locked(FLUSH_FULL);
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        /* Nothing else goes out behind a failed send. */
+    }
+    else if ((length > TX_COALESCE_BUFFER_SIZE) ||
+             ((0U == tx_length) &&
+              (!sent_before || ((now - last_sent) >= TX_COALESCE_BUDGET_MS))))
+    {
+        /* Too large to hold, or nothing to coalesce with: holding it would
+         * only delay the reply.
+         */
+        result = send_now_locked(data, length);
+    }
+    else
+    {
+        if (0U == tx_length)
+        {
+            held_since = now;
+        }
+
+        memcpy(&tx_buffer[tx_length], data, length);
+        tx_length += length;
+        stats.writes++;
+        stats.bytes += length;
+
+        if (TX_COALESCE_BUFFER_SIZE == tx_length)
+        {
+            result = flush_locked(FLUSH_FULL);
+        }
+    }
+
+    cy_rtos_mutex_set(&tx_mutex);
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: tx_coalesce_time_left_ms
+********************************************************************************
+* Summary:
+*  Time until the held data is due: zero once the budget has run out, and
+*  TX_COALESCE_NO_DEADLINE when nothing is held. The network task bounds its
+*  suspend to this so that the deadline flush runs in its context.
+*
+*******************************************************************************/
+uint32_t tx_coalesce_time_left_ms(void)
+{
+    uint32_t left = TX_COALESCE_NO_DEADLINE;
+    cy_time_t now;
+
+    cy_rtos_mutex_get(&tx_mutex, CY_RTOS_NEVER_TIMEOUT);
+    if (0U != tx_length)
+    {
+        (void)cy_rtos_get_time(&now);
+        left = ((now - held_since) < TX_COALESCE_BUDGET_MS) ?
+               (TX_COALESCE_BUDGET_MS - (now - held_since)) : 0U;
+    }
+    cy_rtos_mutex_set(&tx_mutex);
+
+    return left;
+}
+
+/*******************************************************************************
+* Function Name: tx_coalesce_radio_awake
+********************************************************************************
+* Summary:
+*  Sends the held data now that the radio is awake. Called by the network
+*  task after every resume; this is also where the data is sent once its
+*  budget has run out. A flush before the deadline is a wake saved.
+*
+*******************************************************************************/
+void tx_coalesce_radio_awake(void)
+{
+    cy_time_t now;
+
+    cy_rtos_mutex_get(&tx_mutex, CY_RTOS_NEVER_TIMEOUT);
+    (void)cy_rtos_get_time(&now);
+    if (0U != tx_length)
+    {
+        (void)flush_locked(((now - held_since) >= TX_COALESCE_BUDGET_MS) ?
+                           FLUSH_DEADLINE : FLUSH_PIGGYBACK);
+    }
+    cy_rtos_mutex_set(&tx_mutex);
+}
+
+/*******************************************************************************
+* Function Name: tx_coalesce_flush
+********************************************************************************
+* Summary:
+*  Sends the held data now.
+*
+* Return:
+*  cy_rslt_t: Result of the send
+*
+*******************************************************************************/
+cy_rslt_t tx_coalesce_flush(void)
+{
+    cy_rslt_t result;
+
+    cy_rtos_mutex_get(&tx_mutex, CY_RTOS_NEVER_TIMEOUT);
+    result = flush_locked(FLUSH_REQUEST);
+    cy_rtos_mutex_set(&tx_mutex);
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: tx_coalesce_discard
+********************************************************************************
+* Summary:
+*  Drops the held data. Called when the connection closes.
+*
+*******************************************************************************/
+void tx_coalesce_discard(void)
+{
+    cy_rtos_mutex_get(&tx_mutex, CY_RTOS_NEVER_TIMEOUT);
+    stats.dropped_bytes += tx_length;
+    tx_length = 0U;
+    cy_rtos_mutex_set(&tx_mutex);
+}
+
+/*******************************************************************************
+* Function Name: tx_coalesce_get_stats
+*******************************************************************************/
+void tx_coalesce_get_stats(tx_coalesce_stats_t *out)
+{
+    cy_rtos_mutex_get(&tx_mutex, CY_RTOS_NEVER_TIMEOUT);
+    *out = stats;
+    cy_rtos_mutex_set(&tx_mutex);
+}
+
+/*******************************************************************************
+* Function Name: tx_coalesce_print_stats
+********************************************************************************
+* Summary:
+*  Prints the counters. Every held write beyond the first of a flush is a
+*  segment saved; every flush before the deadline is a wake saved.
+*
+*******************************************************************************/
+void tx_coalesce_print_stats(void)
+{
+    tx_coalesce_stats_t snapshot;
+
+    tx_coalesce_get_stats(&snapshot);
+
+    printf("TX coalescing: %"PRIu32" writes (%"PRIu32" bytes) held in %"PRIu32" segments, "
+           "%"PRIu32" segments saved\n", snapshot.writes, snapshot.bytes,
+           snapshot.segments, snapshot.writes - snapshot.segments);
+    printf("TX coalescing: flushes %"PRIu32" deadline, %"PRIu32" full, %"PRIu32
+           " on resume (wakes saved); %"PRIu32" sent at once, %"PRIu32" bytes dropped, "
+           "%"PRIu32" send errors\n", snapshot.flush_deadline, snapshot.flush_full,
+           snapshot.flush_piggyback, snapshot.direct, snapshot.dropped_bytes,
+           snapshot.send_errors);
+}
+
+#endif /* TX_COALESCE */
+
+/* [] END OF FILE */
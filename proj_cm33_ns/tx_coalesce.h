@@ -0,0 +1,106 @@
+/*******************************************************************************
+* File Name:   tx_coalesce.h
+*
+* Description: This file contains the configuration and declarations of the
+* transmit coalescing, which holds small writes to the TCP server for a
+* latency budget and sends them as one segment.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TX_COALESCE_H_
+#define TX_COALESCE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Build with TX_COALESCE=1 to coalesce the writes to the TCP server. */
+#ifndef TX_COALESCE
+#define TX_COALESCE                              (0U)
+#endif
+
+/* Longest a write is held back, and how soon after a segment a write is held
+ * at all. Kept well below the lwIP delayed ACK so that the reply still
+ * carries the ACK of the command it answers.
+ */
+#define TX_COALESCE_BUDGET_MS                    (40U)
+
+/* Returned by tx_coalesce_time_left_ms() when nothing is held. */
+#define TX_COALESCE_NO_DEADLINE                  (0xFFFFFFFFUL)
+
+/* Data held at most; a write that fills it is sent at once. */
+#define TX_COALESCE_BUFFER_SIZE                  (128U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Sends on the current connection. */
+typedef cy_rslt_t (*tx_coalesce_send_t)(const uint8_t *data, uint32_t length);
+
+typedef struct
+{
+    uint32_t writes;             /* Writes held back */
+    uint32_t bytes;
+    uint32_t segments;           /* Flushes of held writes */
+    uint32_t direct;             /* Writes on an idle connection or too large
+                                  * to hold, sent at once */
+    uint32_t flush_deadline;     /* Flushes at the end of the budget */
+    uint32_t flush_full;
+    uint32_t flush_piggyback;    /* Flushes on a resume before the deadline */
+    uint32_t dropped_bytes;      /* Held when the connection closed */
+    uint32_t send_errors;
+} tx_coalesce_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t tx_coalesce_init(tx_coalesce_send_t send);
+cy_rslt_t tx_coalesce_write(const uint8_t *data, uint32_t length);
+uint32_t tx_coalesce_time_left_ms(void);
+void tx_coalesce_radio_awake(void);
+cy_rslt_t tx_coalesce_flush(void);
+void tx_coalesce_discard(void);
+void tx_coalesce_get_stats(tx_coalesce_stats_t *stats);
+void tx_coalesce_print_stats(void);
+
+#endif /* TX_COALESCE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,818 @@
+/*******************************************************************************
+* File Name:   wake_dispatch.c
+*
+* Description: This file contains the wake dispatch. When the host wake line
+* fires, WHD reads the waking frame and hands it to lwIP through the input
+* function of the STA network interface. The dispatch takes the place of that
+* input function: it matches the first frame after a host wake against the
+* registered handlers (WOWL pattern, MQTT PUBLISH, TCP payload prefix). LPA
+* has already seen the frame as network activity by then, so the network
+* stack resumes either way; the dispatch only acts on the frame before lwIP
+* and the application get to it. A handler that consumes a non-TCP frame
+* keeps it from lwIP. A TCP segment always reaches lwIP, which acknowledges
+* it; a handler that consumes one is only run once, and the application
+* skips the data when it reads it.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include "cyabs_rtos.h"
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/* lwIP header files */
+#include "lwip/netif.h"
+#include "lwip/pbuf.h"
+#include "lwip/tcpip.h"
+
+#include "wake_dispatch.h"
+#include "wowl_pattern.h"
+
+#if (WAKE_DISPATCH)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ETH_HEADER_LEN                           (14U)
+#define ETH_TYPE_OFFSET                          (12U)
+#define ETH_TYPE_IPV4                            (0x0800U)
+#define IPV4_MIN_HEADER_LEN                      (20U)
+#define IPV4_PROTOCOL_TCP                        (6U)
+#define IPV4_SRC_OFFSET                          (12U)
+#define IPV4_DST_OFFSET                          (16U)
+#define TCP_MIN_HEADER_LEN                       (20U)
+#define TCP_SEQ_OFFSET                           (4U)
+#define TCP_FLAGS_OFFSET                         (13U)
+#define TCP_FLAG_FIN                             (0x01U)
+#define TCP_FLAG_SYN                             (0x02U)
+#define TCP_FLAG_RST                             (0x04U)
+#define TCP_FLAG_ACK                             (0x10U)
+
+#define MQTT_PUBLISH                             (0x30U)
+#define MQTT_PACKET_TYPE_MASK                    (0xF0U)
+#define MQTT_MAX_LENGTH_BYTES                    (4U)
+
+#define GET_U16(p)                               ((uint16_t)(((uint16_t)(p)[0] << 8) | (p)[1]))
+#define GET_U32(p)                               (((uint32_t)GET_U16(p) << 16) | GET_U16(&(p)[2]))
+
+/* Addresses are compared as they appear in the frame, like lwIP's ip4_addr_t. */
+#define GET_ADDR(p)                              ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | \
+                                                  ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+/* Sequence number comparison modulo 2^32. */
+#define SEQ_AFTER(a, b)                          ((int32_t)((a) - (b)) > 0)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    MATCH_WOWL_PATTERN,
+    MATCH_MQTT_PATTERN,
+    MATCH_TCP_PREFIX
+} match_type_t;
+
+/* Connection to a server, learned from its SYN-ACK. Only the next in-order
+ * segment of the established connection is handed to the TCP handlers.
+ */
+typedef struct
+{
+    uint32_t remote_ip;
+    uint16_t remote_port;
+    uint16_t local_port;         /* 0 until the handshake is seen */
+    uint32_t next_seq;           /* Next sequence number expected */
+    uint32_t read_seq;           /* Next sequence number the application reads */
+    uint32_t handled_seq;        /* Start of the data consumed by a handler */
+    uint32_t handled_bytes;      /* Consumed by a handler, not yet read */
+} tcp_conn_t;
+
+/* Strings and prefixes are not copied and must stay valid. */
+typedef struct
+{
+    match_type_t type;
+    uint32_t pattern_id;
+    tcp_conn_t *conn;
+    const uint8_t *prefix;       /* TCP prefix, or MQTT topic */
+    uint32_t prefix_len;
+    const char *wake_word;
+    wake_dispatch_handler_t handler;
+    void *arg;
+} dispatch_entry_t;
+
+/* TCP segment of the waking frame. */
+typedef struct
+{
+    uint32_t src_ip;
+    uint32_t dst_ip;
+    uint16_t src_port;
+    uint16_t dst_port;
+    uint32_t seq;
+    uint8_t flags;
+} tcp_segment_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static dispatch_entry_t entries[WAKE_DISPATCH_MAX_HANDLERS];
+static uint32_t entry_count;
+
+static tcp_conn_t conns[WAKE_DISPATCH_MAX_CONNECTIONS];
+static uint32_t conn_count;
+
+/* Interface the dispatch is placed on, and the input function it replaced. */
+static struct netif *dispatch_netif;
+static netif_input_fn stack_input;
+
+/* Set by the host wake interrupt; the next frame is the waking frame. */
+static volatile bool wake_pending;
+static volatile wake_dispatch_stats_t stats;
+static cy_time_t last_report_ms;
+
+/*******************************************************************************
+* Function Name: parse_tcp
+********************************************************************************
+* Summary:
+*  Finds the TCP header and payload of an IPv4 frame.
+*
+* Parameters:
+*  wake_dispatch_frame_t *frame: Frame; payload and payload_length are set
+*  tcp_segment_t *segment: Addresses, ports, sequence number and flags
+*
+* Return:
+*  bool: true if the frame is a TCP segment
+*
+*******************************************************************************/
+static bool parse_tcp(wake_dispatch_frame_t *frame, tcp_segment_t *segment)
+{
+    const uint8_t *ip = &frame->frame[ETH_HEADER_LEN];
+    const uint8_t *tcp;
+    uint32_t ip_header_len;
+    uint32_t ip_total_len;
+    uint32_t tcp_header_len;
+
+    if ((frame->length < (ETH_HEADER_LEN + IPV4_MIN_HEADER_LEN)) ||
+        (ETH_TYPE_IPV4 != frame->ether_type) ||
+        (4U != (ip[0] >> 4)) || (IPV4_PROTOCOL_TCP != ip[9]))
+    {
+        return false;
+    }
+
+    ip_header_len = (uint32_t)(ip[0] & 0x0FU) * 4U;
+    ip_total_len = GET_U16(&ip[2]);
+    if ((ip_header_len < IPV4_MIN_HEADER_LEN) ||
+        ((ETH_HEADER_LEN + ip_total_len) > frame->length) ||
+        ((ip_header_len + TCP_MIN_HEADER_LEN) > ip_total_len))
+    {
+        return false;
+    }
+
+    tcp = &ip[ip_header_len];
+    tcp_header_len = (uint32_t)(tcp[12] >> 4) * 4U;
+    if ((tcp_header_len < TCP_MIN_HEADER_LEN) ||
+        ((ip_header_len + tcp_header_len) > ip_total_len))
+    {
+        return false;
+    }
+
+    segment->src_ip = GET_ADDR(&ip[IPV4_SRC_OFFSET]);
+    segment->dst_ip = GET_ADDR(&ip[IPV4_DST_OFFSET]);
+    segment->src_port = GET_U16(tcp);
+    segment->dst_port = GET_U16(&tcp[2]);
+    segment->seq = GET_U32(&tcp[TCP_SEQ_OFFSET]);
+    segment->flags = tcp[TCP_FLAGS_OFFSET];
+    frame->payload = &tcp[tcp_header_len];
+    frame->payload_length = ip_total_len - ip_header_len - tcp_header_len;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: find_conn
+********************************************************************************
+* Summary:
+*  Returns the tracked connection to the sender of a segment addressed to this
+*  interface, or NULL.
+*
+*******************************************************************************/
+static tcp_conn_t *find_conn(const tcp_segment_t *segment, const struct netif *inp)
+{
+    if (segment->dst_ip != ip4_addr_get_u32(netif_ip4_addr(inp)))
+    {
+        return NULL;
+    }
+
+    for (uint32_t index = 0U; index < conn_count; index++)
+    {
+        if ((conns[index].remote_ip == segment->src_ip) &&
+            (conns[index].remote_port == segment->src_port))
+        {
+            return &conns[index];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: track_segment
+********************************************************************************
+* Summary:
+*  Follows the connection state from the segments that reach lwIP. A SYN-ACK
+*  starts a connection, a RST or FIN ends it, and the expected sequence number
+*  moves past every segment further ahead in the stream.
+*
+*******************************************************************************/
+static void track_segment(tcp_conn_t *conn, const tcp_segment_t *segment, uint32_t payload_length)
+{
+    uint32_t end = segment->seq + payload_length;
+
+    if ((TCP_FLAG_SYN | TCP_FLAG_ACK) == (segment->flags & (TCP_FLAG_SYN | TCP_FLAG_ACK | TCP_FLAG_RST)))
+    {
+        conn->local_port = segment->dst_port;
+        conn->next_seq = end + 1U;
+        conn->read_seq = end + 1U;
+        conn->handled_bytes = 0U;
+        return;
+    }
+
+    if (segment->dst_port != conn->local_port)
+    {
+        return;
+    }
+
+    if (0U != (segment->flags & (TCP_FLAG_RST | TCP_FLAG_FIN)))
+    {
+        conn->local_port = 0U;
+        return;
+    }
+
+    if (SEQ_AFTER(end, conn->next_seq))
+    {
+        conn->next_seq = end;
+    }
+}
+
+/*******************************************************************************
+* Function Name: mqtt_publish_matches
+********************************************************************************
+* Summary:
+*  Checks whether a TCP payload is a PUBLISH on 'topic' that contains the wake
+*  word.
+*
+*******************************************************************************/
+static bool mqtt_publish_matches(const uint8_t *data, uint32_t length,
+                                 const dispatch_entry_t *entry)
+{
+    uint32_t index = 1U;
+    uint32_t remaining = 0U;
+    uint32_t end;
+    uint32_t word_len = (uint32_t)strlen(entry->wake_word);
+    uint8_t byte;
+
+    if ((length < 2U) || (MQTT_PUBLISH != (data[0] & MQTT_PACKET_TYPE_MASK)))
+    {
+        return false;
+    }
+
+    /* Variable length encoding of the remaining length. */
+    do
+    {
+        if ((index >= length) || (index > MQTT_MAX_LENGTH_BYTES))
+        {
+            return false;
+        }
+        byte = data[index];
+        remaining |= (uint32_t)(byte & 0x7FU) << (7U * (index - 1U));
+        index++;
+    } while (0U != (byte & 0x80U));
+
+    end = index + remaining;
+    if ((end > length) || ((index + 2U) > end) ||
+        (entry->prefix_len != GET_U16(&data[index])))
+    {
+        return false;
+    }
+    index += 2U;
+
+    if (((index + entry->prefix_len) > end) ||
+        (0 != memcmp(&data[index], entry->prefix, entry->prefix_len)))
+    {
+        return false;
+    }
+    index += entry->prefix_len;
+
+    /* QoS 1 and 2 carry a packet identifier before the payload. */
+    if (0U != (data[0] & 0x06U))
+    {
+        index += 2U;
+    }
+
+    for (; (index + word_len) <= end; index++)
+    {
+        if (0 == memcmp(&data[index], entry->wake_word, word_len))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: entry_matches
+********************************************************************************
+* Summary:
+*  Checks an entry against the waking frame. TCP entries match only the next
+*  in-order data segment of their established connection, so retransmitted,
+*  stale and spoofed segments are left to lwIP.
+*
+*******************************************************************************/
+static bool entry_matches(const dispatch_entry_t *entry, const wake_dispatch_frame_t *frame,
+                          const tcp_conn_t *conn, const tcp_segment_t *segment)
+{
+    bool in_order = (NULL != conn) && (entry->conn == conn) && (0U != conn->local_port) &&
+                    (segment->dst_port == conn->local_port) && (segment->seq == conn->next_seq) &&
+                    (0U == (segment->flags & (TCP_FLAG_SYN | TCP_FLAG_RST | TCP_FLAG_FIN))) &&
+                    (0U != frame->payload_length);
+
+    switch (entry->type)
+    {
+        case MATCH_WOWL_PATTERN:
+            return (entry->pattern_id == frame->pattern_id);
+
+        case MATCH_MQTT_PATTERN:
+            return in_order &&
+                   mqtt_publish_matches(frame->payload, frame->payload_length, entry);
+
+        case MATCH_TCP_PREFIX:
+            return in_order && (frame->payload_length >= entry->prefix_len) &&
+                   (0 == memcmp(frame->payload, entry->prefix, entry->prefix_len));
+
+        default:
+            return false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: dispatch_frame
+********************************************************************************
+* Summary:
+*  Tracks TCP connection state and, for the waking frame, runs the first
+*  handler that matches it.
+*
+* Parameters:
+*  const uint8_t *data: Frame, starting at the Ethernet header
+*  uint32_t length: Length of the frame
+*  const struct netif *inp: Interface the frame was received on
+*  bool waking: true for the first frame after a host wake
+*
+* Return:
+*  bool: true if the frame is consumed and must not reach lwIP
+*
+*******************************************************************************/
+static bool dispatch_frame(const uint8_t *data, uint32_t length, const struct netif *inp,
+                           bool waking)
+{
+    wake_dispatch_frame_t frame = { data, length, 0U, NULL, 0U, WAKE_DISPATCH_NO_PATTERN };
+    tcp_segment_t segment = { 0 };
+    tcp_conn_t *conn = NULL;
+    bool consumed = false;
+
+    if (length < ETH_HEADER_LEN)
+    {
+        return false;
+    }
+
+    frame.ether_type = GET_U16(&data[ETH_TYPE_OFFSET]);
+    if (parse_tcp(&frame, &segment))
+    {
+        conn = find_conn(&segment, inp);
+    }
+
+    if (waking)
+    {
+        stats.inspected++;
+        (void)wowl_pattern_match(data, length, &frame.pattern_id);
+
+        for (uint32_t index = 0U; index < entry_count; index++)
+        {
+            if (!entry_matches(&entries[index], &frame, conn, &segment))
+            {
+                continue;
+            }
+
+            stats.matched++;
+            if (WAKE_DISPATCH_CONSUMED != entries[index].handler(&frame, entries[index].arg))
+            {
+                break;
+            }
+
+            if (NULL != frame.payload)
+            {
+                /* lwIP still acknowledges the segment; the application
+                 * skips the data when it reads it. A segment that does not
+                 * follow the unread handled data replaces it.
+                 */
+                taskENTER_CRITICAL();
+                if ((0U == conn->handled_bytes) ||
+                    ((conn->handled_seq + conn->handled_bytes) != segment.seq))
+                {
+                    conn->handled_seq = segment.seq;
+                    conn->handled_bytes = 0U;
+                }
+                conn->handled_bytes += frame.payload_length;
+                taskEXIT_CRITICAL();
+                stats.early++;
+            }
+            else
+            {
+                stats.consumed++;
+                consumed = true;
+            }
+            break;
+        }
+    }
+
+    if ((NULL != conn) && !consumed)
+    {
+        track_segment(conn, &segment, frame.payload_length);
+    }
+
+    return consumed;
+}
+
+/*******************************************************************************
+* Function Name: dispatch_input
+********************************************************************************
+* Summary:
+*  Input function of the STA interface while the dispatch is in place. WHD
+*  calls it for every received frame.
+*
+* Parameters:
+*  struct pbuf *p: Received frame
+*  struct netif *inp: Interface the frame was received on
+*
+* Return:
+*  err_t: Result of the lwIP input function, or ERR_OK if consumed
+*
+*******************************************************************************/
+static err_t dispatch_input(struct pbuf *p, struct netif *inp)
+{
+    bool waking = wake_pending;
+
+    wake_pending = false;
+
+    /* Frames are received into a single pbuf; a chained one is left alone. */
+    if ((p->len == p->tot_len) &&
+        dispatch_frame((const uint8_t *)p->payload, p->len, inp, waking))
+    {
+        (void)pbuf_free(p);
+        return ERR_OK;
+    }
+
+    return stack_input(p, inp);
+}
+
+/*******************************************************************************
+* Function Name: add_entry
+*******************************************************************************/
+static cy_rslt_t add_entry(const dispatch_entry_t *entry)
+{
+    if ((WAKE_DISPATCH_MAX_HANDLERS <= entry_count) || (NULL == entry->handler))
+    {
+        return WAKE_DISPATCH_RSLT_TABLE_FULL;
+    }
+
+    entries[entry_count] = *entry;
+    entry_count++;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: get_conn
+********************************************************************************
+* Summary:
+*  Returns the tracked connection to a server, adding it if needed.
+*
+*******************************************************************************/
+static tcp_conn_t *get_conn(uint32_t server_ip, uint16_t server_port)
+{
+    for (uint32_t index = 0U; index < conn_count; index++)
+    {
+        if ((conns[index].remote_ip == server_ip) && (conns[index].remote_port == server_port))
+        {
+            return &conns[index];
+        }
+    }
+
+    if (WAKE_DISPATCH_MAX_CONNECTIONS <= conn_count)
+    {
+        return NULL;
+    }
+
+    conns[conn_count].remote_ip = server_ip;
+    conns[conn_count].remote_port = server_port;
+    conns[conn_count].local_port = 0U;
+    conn_count++;
+
+    return &conns[conn_count - 1U];
+}
+
+/*******************************************************************************
+* Function Name: wake_dispatch_init
+********************************************************************************
+* Summary:
+*  Places the dispatch in front of the input function of the STA interface.
+*  Call after the interface is up, and register TCP handlers before the
+*  connection to their server is opened so that its handshake is seen.
+*
+* Parameters:
+*  struct netif *wifi: lwIP network interface
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the dispatch is in place
+*
+*******************************************************************************/
+cy_rslt_t wake_dispatch_init(struct netif *wifi)
+{
+    if ((NULL == wifi) || (NULL == wifi->input))
+    {
+        printf("Wake dispatch: no network interface!\n");
+        return WAKE_DISPATCH_RSLT_NO_NETIF;
+    }
+
+    if (NULL == dispatch_netif)
+    {
+        LOCK_TCPIP_CORE();
+        stack_input = wifi->input;
+        wifi->input = dispatch_input;
+        UNLOCK_TCPIP_CORE();
+        dispatch_netif = wifi;
+    }
+
+    (void)cy_rtos_get_time(&last_report_ms);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wake_dispatch_register_wowl
+********************************************************************************
+* Summary:
+*  Registers a handler for frames matching a WOWL pattern.
+*
+* Parameters:
+*  uint32_t pattern_id: ID returned by wowl_pattern_add()
+*  wake_dispatch_handler_t handler: Handler
+*  void *arg: Argument of the handler
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if registered
+*
+*******************************************************************************/
+cy_rslt_t wake_dispatch_register_wowl(uint32_t pattern_id, wake_dispatch_handler_t handler,
+                                      void *arg)
+{
+    dispatch_entry_t entry = { MATCH_WOWL_PATTERN, pattern_id, NULL, NULL, 0U, NULL, handler, arg };
+
+    return add_entry(&entry);
+}
+
+/*******************************************************************************
+* Function Name: wake_dispatch_register_mqtt
+********************************************************************************
+* Summary:
+*  Registers a handler for a PUBLISH from the broker on 'topic' that contains
+*  'wake_word'.
+*
+* Parameters:
+*  uint32_t broker_ip: IPv4 address of the broker, as in ip4_addr_t
+*  uint16_t broker_port: TCP port of the broker
+*  const char *topic: Topic
+*  const char *wake_word: Word the payload contains
+*  wake_dispatch_handler_t handler: Handler
+*  void *arg: Argument of the handler
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if registered
+*
+*******************************************************************************/
+cy_rslt_t wake_dispatch_register_mqtt(uint32_t broker_ip, uint16_t broker_port, const char *topic,
+                                      const char *wake_word, wake_dispatch_handler_t handler,
+                                      void *arg)
+{
+    dispatch_entry_t entry = { MATCH_MQTT_PATTERN, WAKE_DISPATCH_NO_PATTERN,
+                               get_conn(broker_ip, broker_port),
+                               (const uint8_t *)topic, (uint32_t)strlen(topic), wake_word,
+                               handler, arg };
+
+    if (NULL == entry.conn)
+    {
+        return WAKE_DISPATCH_RSLT_TABLE_FULL;
+    }
+
+    return add_entry(&entry);
+}
+
+/*******************************************************************************
+* Function Name: wake_dispatch_register_tcp_prefix
+********************************************************************************
+* Summary:
+*  Registers a handler for TCP data from the server that starts with 'prefix'.
+*
+* Parameters:
+*  uint32_t server_ip: IPv4 address of the server, as in ip4_addr_t
+*  uint16_t server_port: TCP port of the server
+*  const uint8_t *prefix: Leading payload bytes
+*  uint32_t prefix_len: Length of prefix
+*  wake_dispatch_handler_t handler: Handler
+*  void *arg: Argument of the handler
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if registered
+*
+*******************************************************************************/
+cy_rslt_t wake_dispatch_register_tcp_prefix(uint32_t server_ip, uint16_t server_port,
+                                            const uint8_t *prefix, uint32_t prefix_len,
+                                            wake_dispatch_handler_t handler, void *arg)
+{
+    dispatch_entry_t entry = { MATCH_TCP_PREFIX, WAKE_DISPATCH_NO_PATTERN,
+                               get_conn(server_ip, server_port),
+                               prefix, prefix_len, NULL, handler, arg };
+
+    if (NULL == entry.conn)
+    {
+        return WAKE_DISPATCH_RSLT_TABLE_FULL;
+    }
+
+    return add_entry(&entry);
+}
+
+/*******************************************************************************
+* Function Name: wake_dispatch_take_handled
+********************************************************************************
+* Summary:
+*  Called by the application for every read of data from the server, in
+*  order. Reports how many of the bytes read a handler already consumed, so
+*  that they are acted on only once. The data is located by its sequence
+*  number, so handled bytes read together with other data, or after data
+*  still unread when they arrived, are found all the same.
+*
+* Parameters:
+*  uint32_t server_ip: IPv4 address of the server, as in ip4_addr_t
+*  uint16_t server_port: TCP port of the server
+*  uint32_t length: Number of bytes read
+*
+* Return:
+*  uint32_t: Number of the bytes read that were consumed by a handler
+*
+*******************************************************************************/
+uint32_t wake_dispatch_take_handled(uint32_t server_ip, uint16_t server_port, uint32_t length)
+{
+    uint32_t handled = 0U;
+    uint32_t start;
+    uint32_t end;
+    tcp_conn_t *conn;
+
+    for (uint32_t index = 0U; index < conn_count; index++)
+    {
+        if ((conns[index].remote_ip != server_ip) || (conns[index].remote_port != server_port))
+        {
+            continue;
+        }
+
+        conn = &conns[index];
+
+        taskENTER_CRITICAL();
+        if (0U != conn->handled_bytes)
+        {
+            /* Overlap of this read with the handled data. */
+            start = SEQ_AFTER(conn->handled_seq, conn->read_seq) ? conn->handled_seq :
+                    conn->read_seq;
+            end = SEQ_AFTER(conn->read_seq + length, conn->handled_seq + conn->handled_bytes) ?
+                  (conn->handled_seq + conn->handled_bytes) : (conn->read_seq + length);
+            if (SEQ_AFTER(end, start))
+            {
+                handled = end - start;
+            }
+
+            /* Forget the handled data once the application read past it. */
+            if (!SEQ_AFTER(conn->handled_seq + conn->handled_bytes, conn->read_seq + length))
+            {
+                conn->handled_bytes = 0U;
+            }
+        }
+        conn->read_seq += length;
+        taskEXIT_CRITICAL();
+        break;
+    }
+
+    return handled;
+}
+
+/*******************************************************************************
+* Function Name: wake_dispatch_note_wake
+********************************************************************************
+* Summary:
+*  Called from the host wake interrupt; marks the next frame as the waking
+*  frame.
+*
+*******************************************************************************/
+void wake_dispatch_note_wake(void)
+{
+    stats.wakes++;
+    wake_pending = true;
+}
+
+/*******************************************************************************
+* Function Name: wake_dispatch_get_stats
+*******************************************************************************/
+void wake_dispatch_get_stats(wake_dispatch_stats_t *out)
+{
+    out->wakes = stats.wakes;
+    out->inspected = stats.inspected;
+    out->matched = stats.matched;
+    out->consumed = stats.consumed;
+    out->early = stats.early;
+}
+
+/*******************************************************************************
+* Function Name: wake_dispatch_poll
+********************************************************************************
+* Summary:
+*  Called by the network task after each resume. Prints the counters every
+*  WAKE_DISPATCH_REPORT_INTERVAL_S seconds.
+*
+*******************************************************************************/
+void wake_dispatch_poll(void)
+{
+    cy_time_t now;
+
+    (void)cy_rtos_get_time(&now);
+    if ((now - last_report_ms) >= (WAKE_DISPATCH_REPORT_INTERVAL_S * 1000U))
+    {
+        last_report_ms = now;
+        wake_dispatch_print_stats();
+    }
+}
+
+/*******************************************************************************
+* Function Name: wake_dispatch_print_stats
+*******************************************************************************/
+void wake_dispatch_print_stats(void)
+{
+    wake_dispatch_stats_t snapshot;
+
+    wake_dispatch_get_stats(&snapshot);
+
+    printf("Wake dispatch: %"PRIu32" host wakes, %"PRIu32" frames inspected, %"PRIu32
+           " matched, %"PRIu32" kept from the network stack, %"PRIu32
+           " TCP commands handled ahead of the stack\n", snapshot.wakes, snapshot.inspected,
+           snapshot.matched, snapshot.consumed, snapshot.early);
+}
+
+#endif /* WAKE_DISPATCH */
+
+/* [] END OF FILE */
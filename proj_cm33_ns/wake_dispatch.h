@@ -0,0 +1,137 @@
+/*******************************************************************************
+* File Name:   wake_dispatch.h
+*
+* Description: This file contains the configuration and declarations of the
+* wake dispatch, which hands the frame that woke the host to a registered
+* handler before lwIP processes it. The network stack is resumed for the
+* frame all the same.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef WAKE_DISPATCH_H_
+#define WAKE_DISPATCH_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to inspect the frame that wakes the host. */
+#ifndef WAKE_DISPATCH
+#define WAKE_DISPATCH                            (0U)
+#endif
+
+#define WAKE_DISPATCH_MAX_HANDLERS               (8U)
+
+/* Server connections whose segments TCP and MQTT handlers are matched on. */
+#define WAKE_DISPATCH_MAX_CONNECTIONS            (2U)
+
+/* Interval at which the network task prints the dispatch counters. */
+#define WAKE_DISPATCH_REPORT_INTERVAL_S          (300U)
+
+/* pattern_id of a frame that matches no WOWL pattern. */
+#define WAKE_DISPATCH_NO_PATTERN                 (0xFFFFFFFFUL)
+
+/* Results returned by this module. */
+#define WAKE_DISPATCH_RSLT_TABLE_FULL            APP_RSLT_ERROR(APP_RSLT_GROUP_WAKE_DISPATCH, 1U)
+#define WAKE_DISPATCH_RSLT_NO_NETIF              APP_RSLT_ERROR(APP_RSLT_GROUP_WAKE_DISPATCH, 2U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+struct netif;
+
+typedef enum
+{
+    WAKE_DISPATCH_PASS,          /* Deliver the frame to the network stack */
+    WAKE_DISPATCH_CONSUMED       /* Handled; keep it from the application */
+} wake_dispatch_action_t;
+
+/* Frame that woke the host. */
+typedef struct
+{
+    const uint8_t *frame;        /* Starts at the Ethernet header */
+    uint32_t length;
+    uint16_t ether_type;
+    const uint8_t *payload;      /* TCP payload, or NULL if not TCP */
+    uint32_t payload_length;
+    uint32_t pattern_id;         /* WOWL pattern matched */
+} wake_dispatch_frame_t;
+
+/* Runs in the WHD thread: must not block or call into WHD or lwIP. A
+ * consumed non-TCP frame is dropped. A consumed TCP segment still reaches
+ * lwIP, which acknowledges it, and wake_dispatch_take_handled() tells the
+ * application that its data was already acted on.
+ */
+typedef wake_dispatch_action_t (*wake_dispatch_handler_t)(const wake_dispatch_frame_t *frame,
+                                                          void *arg);
+
+typedef struct
+{
+    uint32_t wakes;              /* Host wake interrupts */
+    uint32_t inspected;          /* Waking frames looked at */
+    uint32_t matched;
+    uint32_t consumed;           /* Frames kept from the network stack */
+    uint32_t early;              /* TCP data handled ahead of the stack */
+} wake_dispatch_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t wake_dispatch_init(struct netif *wifi);
+cy_rslt_t wake_dispatch_register_wowl(uint32_t pattern_id, wake_dispatch_handler_t handler,
+                                      void *arg);
+cy_rslt_t wake_dispatch_register_mqtt(uint32_t broker_ip, uint16_t broker_port, const char *topic,
+                                      const char *wake_word, wake_dispatch_handler_t handler,
+                                      void *arg);
+cy_rslt_t wake_dispatch_register_tcp_prefix(uint32_t server_ip, uint16_t server_port,
+                                            const uint8_t *prefix, uint32_t prefix_len,
+                                            wake_dispatch_handler_t handler, void *arg);
+uint32_t wake_dispatch_take_handled(uint32_t server_ip, uint16_t server_port, uint32_t length);
+void wake_dispatch_note_wake(void);
+void wake_dispatch_get_stats(wake_dispatch_stats_t *stats);
+void wake_dispatch_poll(void);
+void wake_dispatch_print_stats(void);
+
+#endif /* WAKE_DISPATCH_H_ */
+
+/* [] END OF FILE */
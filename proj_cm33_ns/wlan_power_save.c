@@ -0,0 +1,461 @@
+/*******************************************************************************
+* File Name:   wlan_power_save.c
+*
+* Description: This file contains the WLAN power-save control. It programs
+* the power-save mode, the PM2 return-to-sleep time and the DTIM listen
+* interval, and reads them back from the firmware. The measurement mode
+* records, for every setting applied, how often the WLAN device woke the host
+* and how long a command took from the host wakeup to the application.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <string.h>
+#include <inttypes.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Wi-Fi connection manager and Wi-Fi host driver header files. */
+#include "cy_wcm.h"
+#include "whd_wifi_api.h"
+
+#include "wlan_power_save.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PM2_SLEEP_RET_STEP_MS                    (10U)
+#define US_PER_SECOND                            (1000000U)
+#define US_PER_MS                                (1000U)
+#define SECONDS_PER_MINUTE                       (60U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+#if (WLAN_PS_MEASURE)
+/* Observations made while one setting was applied. */
+typedef struct
+{
+    wlan_ps_config_t config;
+    uint32_t start_count;                 /* LPTimer count when applied */
+    uint32_t elapsed_count;               /* LPTimer counts once closed */
+    uint32_t wakes;                       /* Host wake interrupts */
+    uint32_t resumes;                     /* Network stack resumes */
+    uint32_t commands;
+    uint32_t timed_commands;              /* Commands that followed a wakeup */
+    uint64_t latency_total_us;
+    uint32_t latency_max_us;
+} wlan_ps_measure_slot_t;
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Last applied setting; the firmware does not report the PM2 time. */
+static wlan_ps_config_t applied_config =
+{
+    .mode                 = WLAN_PS_PM2,
+    .pm2_sleep_ret_ms     = 0U,
+    .listen_interval_dtim = 0U
+};
+
+#if (WLAN_PS_MEASURE)
+static mtb_hal_lptimer_t *measure_lptimer = NULL;
+static wlan_ps_measure_slot_t slots[WLAN_PS_MEASURE_SLOTS];
+static uint32_t slot_count = 0U;
+static uint32_t last_report_count;
+
+/* Written by the host wake interrupt. */
+static volatile uint32_t last_wake_count;
+static volatile bool wake_pending = false;
+
+/*******************************************************************************
+* Function Name: measure_now
+********************************************************************************
+* Summary:
+*  Reads the LPTimer, which keeps counting in deep sleep.
+*
+* Return:
+*  uint32_t: LPTimer count, or 0 before the LPTimer is set up
+*
+*******************************************************************************/
+static uint32_t measure_now(void)
+{
+    return (NULL != measure_lptimer) ? mtb_hal_lptimer_read(measure_lptimer) : 0U;
+}
+
+/*******************************************************************************
+* Function Name: counts_to_us
+********************************************************************************
+* Summary:
+*  Converts LPTimer counts to microseconds.
+*
+*******************************************************************************/
+static uint64_t counts_to_us(uint32_t counts)
+{
+    return ((uint64_t)counts * US_PER_SECOND) / Cy_SysClk_ClkLfGetFrequency();
+}
+
+/*******************************************************************************
+* Function Name: current_slot
+********************************************************************************
+* Summary:
+*  Returns the slot of the setting currently applied.
+*
+*******************************************************************************/
+static wlan_ps_measure_slot_t *current_slot(void)
+{
+    return (0U != slot_count) ? &slots[(slot_count - 1U) % WLAN_PS_MEASURE_SLOTS] : NULL;
+}
+
+/*******************************************************************************
+* Function Name: open_slot
+********************************************************************************
+* Summary:
+*  Closes the slot of the previous setting and starts one for a new setting.
+*  The oldest slot is reused once all are in use.
+*
+* Parameters:
+*  const wlan_ps_config_t *config: Setting just applied
+*
+*******************************************************************************/
+static void open_slot(const wlan_ps_config_t *config)
+{
+    wlan_ps_measure_slot_t *slot;
+    uint32_t now = measure_now();
+
+    taskENTER_CRITICAL();
+    slot = current_slot();
+    if (NULL != slot)
+    {
+        slot->elapsed_count = now - slot->start_count;
+    }
+
+    slot = &slots[slot_count % WLAN_PS_MEASURE_SLOTS];
+    memset(slot, 0, sizeof(*slot));
+    slot->config = *config;
+    slot->start_count = now;
+    slot_count++;
+    wake_pending = false;
+    taskEXIT_CRITICAL();
+}
+#endif /* WLAN_PS_MEASURE */
+
+/*******************************************************************************
+* Function Name: wlan_ps_apply
+********************************************************************************
+* Summary:
+*  Programs the WLAN power-save mode, the PM2 return-to-sleep time and the
+*  DTIM listen interval. Must be called once the Wi-Fi device has joined the
+*  AP. The listen interval is the number of DTIMs the radio may sleep
+*  through; it trades downlink latency for radio current.
+*
+* Parameters:
+*  const wlan_ps_config_t *config: Setting to apply
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the setting is applied
+*
+*******************************************************************************/
+cy_rslt_t wlan_ps_apply(const wlan_ps_config_t *config)
+{
+    cy_rslt_t result;
+    whd_interface_t whd_ifp;
+
+    if ((WLAN_PS_PM2 == config->mode) &&
+        ((config->pm2_sleep_ret_ms < WLAN_PS_PM2_SLEEP_RET_MIN_MS) ||
+         (config->pm2_sleep_ret_ms > WLAN_PS_PM2_SLEEP_RET_MAX_MS) ||
+         (0U != (config->pm2_sleep_ret_ms % PM2_SLEEP_RET_STEP_MS))))
+    {
+        printf("WLAN power save: PM2 return-to-sleep time must be %u..%u ms in "
+               "steps of %u ms\n", WLAN_PS_PM2_SLEEP_RET_MIN_MS,
+               WLAN_PS_PM2_SLEEP_RET_MAX_MS, PM2_SLEEP_RET_STEP_MS);
+        return WLAN_PS_RSLT_INVALID_CONFIG;
+    }
+
+    result = cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &whd_ifp);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    switch (config->mode)
+    {
+        case WLAN_PS_PM1:
+            result = whd_wifi_enable_powersave(whd_ifp);
+            break;
+
+        case WLAN_PS_PM2:
+            result = whd_wifi_enable_powersave_with_throughput(whd_ifp,
+                                                               config->pm2_sleep_ret_ms);
+            break;
+
+        default:
+            result = whd_wifi_disable_powersave(whd_ifp);
+            break;
+    }
+
+    if ((CY_RSLT_SUCCESS == result) && (0U != config->listen_interval_dtim))
+    {
+        result = whd_wifi_set_listen_interval(whd_ifp, config->listen_interval_dtim,
+                                              WHD_LISTEN_INTERVAL_TIME_UNIT_DTIM);
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("WLAN power save setting failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        return result;
+    }
+
+    applied_config = *config;
+
+#if (WLAN_PS_MEASURE)
+    open_slot(config);
+#endif
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wlan_ps_get
+********************************************************************************
+* Summary:
+*  Reads the power-save mode and DTIM listen interval back from the firmware.
+*  The PM2 return-to-sleep time is the one last applied.
+*
+* Parameters:
+*  wlan_ps_config_t *config: Setting in use
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the setting is read
+*
+*******************************************************************************/
+cy_rslt_t wlan_ps_get(wlan_ps_config_t *config)
+{
+    cy_rslt_t result;
+    whd_interface_t whd_ifp;
+    uint32_t mode;
+    whd_listen_interval_t listen_interval;
+
+    result = cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &whd_ifp);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_wifi_get_powersave_mode(whd_ifp, &mode);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_wifi_get_listen_interval(whd_ifp, &listen_interval);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        config->mode = (wlan_ps_mode_t)mode;
+        config->pm2_sleep_ret_ms = applied_config.pm2_sleep_ret_ms;
+        config->listen_interval_dtim = listen_interval.dtim;
+    }
+
+    return result;
+}
+
+#if (WLAN_PS_MEASURE)
+/*******************************************************************************
+* Function Name: wlan_ps_measure_set_lptimer
+********************************************************************************
+* Summary:
+*  Sets the LPTimer used to time the measurements. This is the same timer
+*  that the RTOS abstraction library uses for tickless idle.
+*
+* Parameters:
+*  mtb_hal_lptimer_t *lptimer: Initialized LPTimer object
+*
+*******************************************************************************/
+void wlan_ps_measure_set_lptimer(mtb_hal_lptimer_t *lptimer)
+{
+    measure_lptimer = lptimer;
+    last_report_count = mtb_hal_lptimer_read(lptimer);
+}
+
+/*******************************************************************************
+* Function Name: wlan_ps_measure_note_wake
+********************************************************************************
+* Summary:
+*  Called from the host wake interrupt. Counts the wakeup and starts timing
+*  the command it may carry.
+*
+*******************************************************************************/
+void wlan_ps_measure_note_wake(void)
+{
+    wlan_ps_measure_slot_t *slot = current_slot();
+
+    if (NULL != slot)
+    {
+        slot->wakes++;
+        if (!wake_pending)
+        {
+            last_wake_count = measure_now();
+            wake_pending = true;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: wlan_ps_measure_note_resume
+********************************************************************************
+* Summary:
+*  Called by the network task each time wait_net_suspend() returns.
+*
+*******************************************************************************/
+void wlan_ps_measure_note_resume(void)
+{
+    wlan_ps_measure_slot_t *slot;
+
+    taskENTER_CRITICAL();
+    slot = current_slot();
+    if (NULL != slot)
+    {
+        slot->resumes++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: wlan_ps_measure_note_command
+********************************************************************************
+* Summary:
+*  Called when a command reaches the application. A command that follows a
+*  host wakeup is timed from that wakeup; this covers the MCU wakeup, the
+*  SDIO transfer and the network stack resume.
+*
+*******************************************************************************/
+void wlan_ps_measure_note_command(void)
+{
+    wlan_ps_measure_slot_t *slot;
+    uint32_t latency_us;
+    uint32_t now = measure_now();
+
+    taskENTER_CRITICAL();
+    slot = current_slot();
+    if (NULL != slot)
+    {
+        slot->commands++;
+        if (wake_pending)
+        {
+            latency_us = (uint32_t)counts_to_us(now - last_wake_count);
+            slot->timed_commands++;
+            slot->latency_total_us += latency_us;
+            if (latency_us > slot->latency_max_us)
+            {
+                slot->latency_max_us = latency_us;
+            }
+            wake_pending = false;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: wlan_ps_measure_poll
+********************************************************************************
+* Summary:
+*  Called by the network task after each resume. Prints the report every
+*  WLAN_PS_MEASURE_REPORT_INTERVAL_S seconds.
+*
+*******************************************************************************/
+void wlan_ps_measure_poll(void)
+{
+    uint32_t now = measure_now();
+
+    if (counts_to_us(now - last_report_count) >=
+        ((uint64_t)WLAN_PS_MEASURE_REPORT_INTERVAL_S * US_PER_SECOND))
+    {
+        last_report_count = now;
+        wlan_ps_measure_report();
+    }
+}
+
+/*******************************************************************************
+* Function Name: wlan_ps_measure_report
+********************************************************************************
+* Summary:
+*  Prints one line per setting applied: how long it was applied, the host
+*  wakeups per minute, the network resumes, and the average and maximum
+*  time from host wakeup to command.
+*
+*******************************************************************************/
+void wlan_ps_measure_report(void)
+{
+    static const char *mode_names[] = { "PM0", "PM1", "PM2" };
+    wlan_ps_measure_slot_t slot;
+    uint32_t first = (slot_count > WLAN_PS_MEASURE_SLOTS) ?
+                     (slot_count - WLAN_PS_MEASURE_SLOTS) : 0U;
+    uint32_t now = measure_now();
+    uint32_t elapsed_s;
+
+    printf("WLAN power save  ret(ms) LI   time(s)  wakes  wakes/min  resumes  "
+           "cmds  lat avg(ms)  lat max(ms)\n");
+
+    for (uint32_t index = first; index < slot_count; index++)
+    {
+        taskENTER_CRITICAL();
+        slot = slots[index % WLAN_PS_MEASURE_SLOTS];
+        taskEXIT_CRITICAL();
+
+        if (index == (slot_count - 1U))
+        {
+            slot.elapsed_count = now - slot.start_count;
+        }
+        elapsed_s = (uint32_t)(counts_to_us(slot.elapsed_count) / US_PER_SECOND);
+
+        printf("  %-14s %7u %2u %9"PRIu32" %6"PRIu32" %10"PRIu32" %8"PRIu32" %5"PRIu32
+               " %12"PRIu32" %12"PRIu32"\n",
+               mode_names[slot.config.mode], slot.config.pm2_sleep_ret_ms,
+               slot.config.listen_interval_dtim, elapsed_s, slot.wakes,
+               (0U != elapsed_s) ? ((slot.wakes * SECONDS_PER_MINUTE) / elapsed_s) : 0U,
+               slot.resumes, slot.commands,
+               (0U != slot.timed_commands) ?
+                   (uint32_t)(slot.latency_total_us / slot.timed_commands / US_PER_MS) : 0U,
+               slot.latency_max_us / US_PER_MS);
+    }
+}
+#endif /* WLAN_PS_MEASURE */
+
+/* [] END OF FILE */
@@ -0,0 +1,117 @@
+/*******************************************************************************
+* File Name:   wlan_power_save.h
+*
+* Description: This file contains the configuration and declarations of the
+* WLAN power-save control, which selects the power-save mode, the PM2
+* return-to-sleep time and the DTIM listen interval, and of its measurement
+* mode.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef WLAN_POWER_SAVE_H_
+#define WLAN_POWER_SAVE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include "mtb_hal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to apply the settings below once the Wi-Fi device
+ * has joined the AP. Leave it '0' to keep the firmware defaults, or when
+ * POWER_PROFILES manages the power-save settings.
+ */
+#ifndef WLAN_PS_CONTROL
+#define WLAN_PS_CONTROL                          (0U)
+#endif
+
+#define WLAN_PS_DEFAULT_MODE                     WLAN_PS_PM2
+#define WLAN_PS_DEFAULT_PM2_SLEEP_RET_MS         (200U)
+#define WLAN_PS_DEFAULT_LISTEN_INTERVAL          (1U)
+
+/* Set this macro to '1' to count the host wakeups, network resumes and
+ * commands, and to time the commands, for every power-save setting applied.
+ */
+#ifndef WLAN_PS_MEASURE
+#define WLAN_PS_MEASURE                          (0U)
+#endif
+
+#define WLAN_PS_MEASURE_SLOTS                    (6U)
+#define WLAN_PS_MEASURE_REPORT_INTERVAL_S        (60U)
+
+/* Limits of the PM2 return-to-sleep time accepted by the firmware. */
+#define WLAN_PS_PM2_SLEEP_RET_MIN_MS             (10U)
+#define WLAN_PS_PM2_SLEEP_RET_MAX_MS             (2000U)
+
+/* Results returned by this module. */
+#define WLAN_PS_RSLT_INVALID_CONFIG              APP_RSLT_ERROR(APP_RSLT_GROUP_WLAN_PS, 1U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    WLAN_PS_PM0,                          /* Power save off: radio always awake */
+    WLAN_PS_PM1,                          /* Sleep between beacons, PS-Poll */
+    WLAN_PS_PM2                           /* Stay awake after traffic */
+} wlan_ps_mode_t;
+
+typedef struct
+{
+    wlan_ps_mode_t mode;
+    uint16_t pm2_sleep_ret_ms;            /* PM2 return-to-sleep time */
+    uint8_t listen_interval_dtim;         /* 0 keeps the firmware default */
+} wlan_ps_config_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t wlan_ps_apply(const wlan_ps_config_t *config);
+cy_rslt_t wlan_ps_get(wlan_ps_config_t *config);
+void wlan_ps_measure_set_lptimer(mtb_hal_lptimer_t *lptimer);
+void wlan_ps_measure_note_wake(void);
+void wlan_ps_measure_note_resume(void);
+void wlan_ps_measure_note_command(void);
+void wlan_ps_measure_poll(void);
+void wlan_ps_measure_report(void);
+
+#endif /* WLAN_POWER_SAVE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,620 @@
+/*******************************************************************************
+* File Name:   wowl_pattern.c
+*
+* Description: This file contains functions that build Wake on Wireless LAN
+* (WOWL) pattern and mask bytes from the device MAC address, peer MAC addresses
+* or payload templates, and program them into the WLAN firmware at runtime.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include <string.h>
+#include <ctype.h>
+#include <inttypes.h>
+
+/* Wi-Fi host driver header file. */
+#include "whd_wifi_api.h"
+
+#include "wowl_pattern.h"
+#include "wake_dispatch.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Firmware iovars used to program the WOWL patterns. */
+#define WOWL_IOVAR                               "wowl"
+#define WOWL_PATTERN_IOVAR                       "wowl_pattern"
+#define WOWL_ACTIVATE_IOVAR                      "wowl_activate"
+#define WOWL_PATTERN_CMD_ADD                     "add"
+#define WOWL_PATTERN_CMD_DELETE                  "del"
+#define WOWL_PATTERN_CMD_LEN                     (4U)
+
+/* Wake up on a received frame matching a network pattern (WL_WOWL_NET). */
+#define WOWL_CAP_NET_PATTERN                     (0x00000002U)
+#define WOWL_ACTIVATE                            (1U)
+#define WOWL_DEACTIVATE                          (0U)
+
+#define WOWL_MAC_LEN                             (6U)
+#define WOWL_BITS_PER_MASK_BYTE                  (8U)
+#define WOWL_MASK_LEN(len)                       (((len) + WOWL_BITS_PER_MASK_BYTE - 1U) / \
+                                                 WOWL_BITS_PER_MASK_BYTE)
+#define WOWL_BYTE_MATCH                          (0xFFU)
+#define WOWL_BYTE_ANY                            (0x00U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Pattern descriptor as expected by the firmware. The mask follows the
+ * descriptor and the pattern follows the mask at 'pattern_offset'.
+ */
+typedef struct
+{
+    uint32_t mask_size;
+    uint32_t offset;
+    uint32_t pattern_offset;
+    uint32_t pattern_size;
+    uint32_t id;
+    uint32_t reason_size;
+    uint32_t type;
+} wowl_pattern_desc_t;
+
+/* Host copy of a pattern this module programmed. It is used to delete the
+ * pattern again, and wake_dispatch.c matches the waking frame against it.
+ */
+typedef struct
+{
+    uint32_t offset;
+    uint32_t len;
+    uint32_t id;
+    uint8_t mask[WOWL_MASK_LEN(WOWL_MAX_PATTERN_LEN)];
+    uint8_t pattern[WOWL_MAX_PATTERN_LEN];
+} wowl_pattern_copy_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static cy_wcm_mac_t device_mac;
+static uint32_t pattern_count = 0U;
+static uint32_t next_pattern_id = 0U;
+static bool wowl_active = false;
+
+static uint8_t wowl_iovar_buffer[WOWL_PATTERN_CMD_LEN + sizeof(wowl_pattern_desc_t) +
+                                 WOWL_MASK_LEN(WOWL_MAX_PATTERN_LEN) + WOWL_MAX_PATTERN_LEN];
+
+static wowl_pattern_copy_t pattern_copies[WOWL_MAX_PATTERNS];
+
+/*******************************************************************************
+* Function Name: get_whd_interface
+********************************************************************************
+* Summary:
+*  Returns the WHD interface of the STA interface.
+*
+* Parameters:
+*  whd_interface_t *whd_ifp: WHD interface
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the interface is available
+*
+*******************************************************************************/
+static cy_rslt_t get_whd_interface(whd_interface_t *whd_ifp)
+{
+    return cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, whd_ifp);
+}
+
+/*******************************************************************************
+* Function Name: hex_value
+********************************************************************************
+* Summary:
+*  Converts a hexadecimal digit to its value.
+*
+* Parameters:
+*  char digit: Hexadecimal digit
+*
+* Return:
+*  int: Value of the digit, or -1 if it is not a hexadecimal digit
+*
+*******************************************************************************/
+static int hex_value(char digit)
+{
+    if (isdigit((unsigned char)digit))
+    {
+        return digit - '0';
+    }
+
+    digit = (char)tolower((unsigned char)digit);
+    if ((digit >= 'a') && (digit <= 'f'))
+    {
+        return digit - 'a' + 10;
+    }
+
+    return -1;
+}
+
+/*******************************************************************************
+* Function Name: send_pattern_command
+********************************************************************************
+* Summary:
+*  Sends a "wowl_pattern" add or delete command for one pattern. Both take
+*  the same descriptor, mask and pattern.
+*
+* Parameters:
+*  const char *command: WOWL_PATTERN_CMD_ADD or WOWL_PATTERN_CMD_DELETE
+*  const wowl_pattern_copy_t *copy: Pattern
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the firmware accepted the command
+*
+*******************************************************************************/
+static cy_rslt_t send_pattern_command(const char *command, const wowl_pattern_copy_t *copy)
+{
+    cy_rslt_t result;
+    whd_interface_t whd_ifp;
+    wowl_pattern_desc_t desc;
+    uint32_t mask_len = WOWL_MASK_LEN(copy->len);
+
+    desc.mask_size = mask_len;
+    desc.offset = copy->offset;
+    desc.pattern_offset = sizeof(desc) + mask_len;
+    desc.pattern_size = copy->len;
+    desc.id = copy->id;
+    desc.reason_size = 0U;
+    desc.type = 0U;
+
+    memset(wowl_iovar_buffer, 0, sizeof(wowl_iovar_buffer));
+    memcpy(wowl_iovar_buffer, command, strlen(command) + 1U);
+    memcpy(&wowl_iovar_buffer[WOWL_PATTERN_CMD_LEN], &desc, sizeof(desc));
+    memcpy(&wowl_iovar_buffer[WOWL_PATTERN_CMD_LEN + sizeof(desc)], copy->mask, mask_len);
+    memcpy(&wowl_iovar_buffer[WOWL_PATTERN_CMD_LEN + desc.pattern_offset], copy->pattern,
+           copy->len);
+
+    result = get_whd_interface(&whd_ifp);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_wifi_set_iovar_buffer(whd_ifp, WOWL_PATTERN_IOVAR, wowl_iovar_buffer,
+                        (uint16_t)(WOWL_PATTERN_CMD_LEN + desc.pattern_offset + copy->len));
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: wowl_pattern_init
+********************************************************************************
+* Summary:
+*  Reads the device MAC address from WCM and removes the patterns this module
+*  added before. Patterns configured through LPA are left in place. Call after
+*  cy_wcm_init().
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS on success
+*
+*******************************************************************************/
+cy_rslt_t wowl_pattern_init(void)
+{
+    cy_rslt_t result = cy_wcm_get_mac_addr(CY_WCM_INTERFACE_TYPE_STA, &device_mac);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to read the device MAC address! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        return result;
+    }
+
+    return wowl_pattern_clear();
+}
+
+/*******************************************************************************
+* Function Name: wowl_pattern_add
+********************************************************************************
+* Summary:
+*  Programs one WOWL pattern. A frame wakes the host when the bytes starting at
+*  'offset' match 'pattern' for every byte whose 'mask' entry is non-zero.
+*
+* Parameters:
+*  uint32_t offset: Offset of the pattern from the start of the frame
+*  const uint8_t *pattern: Pattern bytes
+*  const uint8_t *mask: Per-byte match flags, or NULL to match every byte
+*  uint32_t pattern_len: Number of pattern bytes
+*  uint32_t *pattern_id: ID assigned to the pattern (may be NULL)
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the pattern was programmed
+*
+*******************************************************************************/
+cy_rslt_t wowl_pattern_add(uint32_t offset, const uint8_t *pattern,
+                           const uint8_t *mask, uint32_t pattern_len,
+                           uint32_t *pattern_id)
+{
+    cy_rslt_t result;
+    wowl_pattern_copy_t *copy;
+
+    if ((0U == pattern_len) || (WOWL_MAX_PATTERN_LEN < pattern_len) ||
+        (WOWL_MAX_PATTERNS <= pattern_count))
+    {
+        return WOWL_PATTERN_RSLT_INVALID;
+    }
+
+    copy = &pattern_copies[pattern_count];
+    memset(copy, 0, sizeof(*copy));
+    copy->offset = offset;
+    copy->len = pattern_len;
+    copy->id = next_pattern_id;
+
+    /* One mask bit per pattern byte, least significant bit first. */
+    for (uint32_t i = 0; i < pattern_len; i++)
+    {
+        if ((NULL == mask) || (WOWL_BYTE_ANY != mask[i]))
+        {
+            copy->mask[i / WOWL_BITS_PER_MASK_BYTE] |= (uint8_t)(1U << (i % WOWL_BITS_PER_MASK_BYTE));
+        }
+    }
+    memcpy(copy->pattern, pattern, pattern_len);
+
+    result = send_pattern_command(WOWL_PATTERN_CMD_ADD, copy);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to add WOWL pattern! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        return result;
+    }
+
+    if (NULL != pattern_id)
+    {
+        *pattern_id = copy->id;
+    }
+
+    next_pattern_id++;
+    pattern_count++;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wowl_pattern_add_peer
+********************************************************************************
+* Summary:
+*  Adds a pattern matching unicast frames from 'peer_mac' to this device. This
+*  is the runtime equivalent of the "0x{dut_mac}{peer_mac}" magic pattern: the
+*  destination and source MAC addresses at the start of the Ethernet header.
+*
+* Parameters:
+*  const cy_wcm_mac_t peer_mac: MAC address of the peer
+*  uint32_t *pattern_id: ID assigned to the pattern (may be NULL)
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the pattern was programmed
+*
+*******************************************************************************/
+cy_rslt_t wowl_pattern_add_peer(const cy_wcm_mac_t peer_mac, uint32_t *pattern_id)
+{
+    uint8_t pattern[WOWL_MAC_LEN * 2U];
+
+    memcpy(pattern, device_mac, WOWL_MAC_LEN);
+    memcpy(&pattern[WOWL_MAC_LEN], peer_mac, WOWL_MAC_LEN);
+
+    return wowl_pattern_add(0U, pattern, NULL, sizeof(pattern), pattern_id);
+}
+
+/*******************************************************************************
+* Function Name: wowl_pattern_add_template
+********************************************************************************
+* Summary:
+*  Adds a pattern described by a hexadecimal template, for example
+*  "{mac}xxxxxxxxxxxx0800". Two hex digits give one byte that must match,
+*  "xx" gives one byte that is ignored, and "{mac}" expands to the device MAC
+*  address. An optional "0x" prefix and ':', '-' or ' ' separators are ignored.
+*
+* Parameters:
+*  uint32_t offset: Offset of the pattern from the start of the frame
+*  const char *hex_template: Pattern template
+*  uint32_t *pattern_id: ID assigned to the pattern (may be NULL)
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the pattern was programmed
+*
+*******************************************************************************/
+cy_rslt_t wowl_pattern_add_template(uint32_t offset, const char *hex_template,
+                                    uint32_t *pattern_id)
+{
+    uint8_t pattern[WOWL_MAX_PATTERN_LEN];
+    uint8_t mask[WOWL_MAX_PATTERN_LEN];
+    uint32_t len = 0U;
+    const char *cursor = hex_template;
+    int high;
+    int low;
+
+    if ((0 == strncmp(cursor, "0x", 2)) || (0 == strncmp(cursor, "0X", 2)))
+    {
+        cursor += 2;
+    }
+
+    while ('\0' != *cursor)
+    {
+        if ((':' == *cursor) || ('-' == *cursor) || (' ' == *cursor))
+        {
+            cursor++;
+            continue;
+        }
+
+        if (0 == strncmp(cursor, WOWL_TEMPLATE_DEVICE_MAC, sizeof(WOWL_TEMPLATE_DEVICE_MAC) - 1U))
+        {
+            if ((len + WOWL_MAC_LEN) > WOWL_MAX_PATTERN_LEN)
+            {
+                return WOWL_PATTERN_RSLT_BAD_TEMPLATE;
+            }
+            memcpy(&pattern[len], device_mac, WOWL_MAC_LEN);
+            memset(&mask[len], WOWL_BYTE_MATCH, WOWL_MAC_LEN);
+            len += WOWL_MAC_LEN;
+            cursor += sizeof(WOWL_TEMPLATE_DEVICE_MAC) - 1U;
+            continue;
+        }
+
+        if (len >= WOWL_MAX_PATTERN_LEN)
+        {
+            return WOWL_PATTERN_RSLT_BAD_TEMPLATE;
+        }
+
+        if (0 == strncmp(cursor, WOWL_TEMPLATE_WILDCARD, sizeof(WOWL_TEMPLATE_WILDCARD) - 1U))
+        {
+            pattern[len] = 0U;
+            mask[len] = WOWL_BYTE_ANY;
+        }
+        else
+        {
+            high = hex_value(cursor[0]);
+            low = hex_value(cursor[1]);
+            if ((high < 0) || (low < 0))
+            {
+                printf("Invalid WOWL template near '%s'\n", cursor);
+                return WOWL_PATTERN_RSLT_BAD_TEMPLATE;
+            }
+            pattern[len] = (uint8_t)((high << 4) | low);
+            mask[len] = WOWL_BYTE_MATCH;
+        }
+        len++;
+        cursor += 2;
+    }
+
+    return wowl_pattern_add(offset, pattern, mask, len, pattern_id);
+}
+
+/*******************************************************************************
+* Function Name: wowl_pattern_clear
+********************************************************************************
+* Summary:
+*  Deletes the patterns this module added from the firmware. Patterns
+*  configured through LPA are not touched.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS on success
+*
+*******************************************************************************/
+cy_rslt_t wowl_pattern_clear(void)
+{
+    cy_rslt_t result;
+
+    while (0U != pattern_count)
+    {
+        result = send_pattern_command(WOWL_PATTERN_CMD_DELETE, &pattern_copies[pattern_count - 1U]);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            printf("Failed to delete WOWL pattern! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+            return result;
+        }
+        pattern_count--;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wowl_pattern_remove
+********************************************************************************
+* Summary:
+*  Deletes one pattern this module added from the firmware, for a pattern that
+*  is rebuilt when what it matches changes.
+*
+* Parameters:
+*  uint32_t pattern_id: ID returned when the pattern was added
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS if the pattern was deleted, or
+*  WOWL_PATTERN_RSLT_INVALID if no such pattern was added
+*
+*******************************************************************************/
+cy_rslt_t wowl_pattern_remove(uint32_t pattern_id)
+{
+    cy_rslt_t result;
+
+    for (uint32_t index = 0U; index < pattern_count; index++)
+    {
+        if (pattern_copies[index].id != pattern_id)
+        {
+            continue;
+        }
+
+        result = send_pattern_command(WOWL_PATTERN_CMD_DELETE, &pattern_copies[index]);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            printf("Failed to delete WOWL pattern! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+            return result;
+        }
+
+        pattern_count--;
+        memmove(&pattern_copies[index], &pattern_copies[index + 1U],
+                (pattern_count - index) * sizeof(pattern_copies[0]));
+
+        return CY_RSLT_SUCCESS;
+    }
+
+    return WOWL_PATTERN_RSLT_INVALID;
+}
+
+#if (WAKE_DISPATCH)
+/*******************************************************************************
+* Function Name: wowl_pattern_match
+********************************************************************************
+* Summary:
+*  Finds the programmed pattern that a received frame matches, the way the
+*  firmware does when it decides to wake the host.
+*
+* Parameters:
+*  const uint8_t *frame: Frame, starting at the Ethernet header
+*  uint32_t length: Length of the frame
+*  uint32_t *pattern_id: ID of the first pattern matched
+*
+* Return:
+*  bool: true if a pattern matches
+*
+*******************************************************************************/
+bool wowl_pattern_match(const uint8_t *frame, uint32_t length, uint32_t *pattern_id)
+{
+    for (uint32_t index = 0U; index < pattern_count; index++)
+    {
+        const wowl_pattern_copy_t *copy = &pattern_copies[index];
+        bool match = ((copy->offset + copy->len) <= length);
+
+        for (uint32_t i = 0U; match && (i < copy->len); i++)
+        {
+            if ((0U != (copy->mask[i / WOWL_BITS_PER_MASK_BYTE] & (1U << (i % WOWL_BITS_PER_MASK_BYTE)))) &&
+                (frame[copy->offset + i] != copy->pattern[i]))
+            {
+                match = false;
+            }
+        }
+
+        if (match)
+        {
+            *pattern_id = copy->id;
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif /* WAKE_DISPATCH */
+
+/*******************************************************************************
+* Function Name: wowl_pattern_activate
+********************************************************************************
+* Summary:
+*  Called by the network task before the network stack is suspended. Adds
+*  wake on network pattern to the wake events already enabled and activates
+*  WOWL, so that while the host sleeps only frames matching a pattern wake it.
+*  Does nothing when no pattern is programmed.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS on success
+*
+*******************************************************************************/
+cy_rslt_t wowl_pattern_activate(void)
+{
+    cy_rslt_t result;
+    whd_interface_t whd_ifp;
+    uint32_t wake_caps = 0U;
+
+    if ((0U == pattern_count) || wowl_active)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    result = get_whd_interface(&whd_ifp);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_wifi_get_iovar_value(whd_ifp, WOWL_IOVAR, &wake_caps);
+    }
+
+    if ((CY_RSLT_SUCCESS == result) && (0U == (wake_caps & WOWL_CAP_NET_PATTERN)))
+    {
+        result = whd_wifi_set_iovar_value(whd_ifp, WOWL_IOVAR, wake_caps | WOWL_CAP_NET_PATTERN);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_wifi_set_iovar_value(whd_ifp, WOWL_ACTIVATE_IOVAR, WOWL_ACTIVATE);
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("WOWL activation failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        return result;
+    }
+
+    wowl_active = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wowl_pattern_deactivate
+********************************************************************************
+* Summary:
+*  Called by the network task after the network stack resumed. Deactivates
+*  WOWL so that the firmware passes all traffic to the host again.
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS on success
+*
+*******************************************************************************/
+cy_rslt_t wowl_pattern_deactivate(void)
+{
+    cy_rslt_t result;
+    whd_interface_t whd_ifp;
+
+    if (!wowl_active)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    result = get_whd_interface(&whd_ifp);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = whd_wifi_set_iovar_value(whd_ifp, WOWL_ACTIVATE_IOVAR, WOWL_DEACTIVATE);
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("WOWL deactivation failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        return result;
+    }
+
+    wowl_active = false;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
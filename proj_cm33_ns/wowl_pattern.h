@@ -0,0 +1,95 @@
+/*******************************************************************************
+* File Name:   wowl_pattern.h
+*
+* Description: This file contains declarations of functions that build Wake on
+* Wireless LAN (WOWL) patterns from the device MAC address at runtime and
+* program them into the WLAN firmware.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef WOWL_PATTERN_H_
+#define WOWL_PATTERN_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "app_result.h"
+#include "cy_wcm.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set this macro to '1' to build the WOWL patterns at runtime from the device
+ * MAC address instead of entering them in the Device Configurator.
+ */
+#ifndef WOWL_RUNTIME_PATTERNS
+#define WOWL_RUNTIME_PATTERNS                    (0U)
+#endif
+
+/* MAC address of the peer whose unicast frames wake the host. */
+#define WOWL_PEER_MAC                            { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 }
+
+#define WOWL_MAX_PATTERNS                        (8U)
+#define WOWL_MAX_PATTERN_LEN                     (128U)
+
+/* Placeholder and wildcard tokens accepted by wowl_pattern_add_template(). */
+#define WOWL_TEMPLATE_DEVICE_MAC                 "{mac}"
+#define WOWL_TEMPLATE_WILDCARD                   "xx"
+
+/* Results returned by this module. */
+#define WOWL_PATTERN_RSLT_INVALID                APP_RSLT_ERROR(APP_RSLT_GROUP_WOWL_PATTERN, 1U)
+#define WOWL_PATTERN_RSLT_BAD_TEMPLATE           APP_RSLT_ERROR(APP_RSLT_GROUP_WOWL_PATTERN, 2U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t wowl_pattern_init(void);
+cy_rslt_t wowl_pattern_add(uint32_t offset, const uint8_t *pattern,
+                           const uint8_t *mask, uint32_t pattern_len,
+                           uint32_t *pattern_id);
+cy_rslt_t wowl_pattern_add_peer(const cy_wcm_mac_t peer_mac, uint32_t *pattern_id);
+cy_rslt_t wowl_pattern_add_template(uint32_t offset, const char *hex_template,
+                                    uint32_t *pattern_id);
+cy_rslt_t wowl_pattern_remove(uint32_t pattern_id);
+cy_rslt_t wowl_pattern_clear(void);
+cy_rslt_t wowl_pattern_activate(void);
+cy_rslt_t wowl_pattern_deactivate(void);
+bool wowl_pattern_match(const uint8_t *frame, uint32_t length, uint32_t *pattern_id);
+
+#endif /* WOWL_PATTERN_H_ */
+
+/* [] END OF FILE */
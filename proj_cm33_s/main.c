@@ -45,11 +45,47 @@
 
 #include "cy_pdl.h"
 #include "cybsp.h"
+#include <string.h>
+
+/* Boot-phase record shared with the non-secure and CM55 projects. */
+#include "boot_profile_shared.h"
 
 /*****************************************************************************
 * Macros
 ******************************************************************************/
 #define CM33_NS_APP_BOOT_ADDR      (CYMEM_CM33_0_m33_nvm_START + CYBSP_MCUBOOT_HEADER_SIZE) 
+
+/*****************************************************************************
+* Global Variables
+******************************************************************************/
+#if (BOOT_PROFILE)
+/* Secure boot markers read by the CM33 non-secure core for the boot report,
+ * in the dedicated boot profile region.
+ */
+static volatile boot_profile_secure_record_t * const secure_record = &BOOT_PROFILE_SHARED->secure;
+
+/*****************************************************************************
+* Function Name: boot_profile_mark
+******************************************************************************
+* Records the end of a secure boot phase in the shared boot record. Times are
+* counted by the DWT cycle counter from the start of main(), which the
+* non-secure project keeps reading.
+*****************************************************************************/
+static void boot_profile_mark(const char *name)
+{
+    uint32_t index = secure_record->count;
+
+    if (index < BOOT_PROFILE_SECURE_MAX_MARKS)
+    {
+        strncpy((char *)secure_record->marks[index].name, name, BOOT_PROFILE_NAME_LEN - 1U);
+        secure_record->marks[index].name[BOOT_PROFILE_NAME_LEN - 1U] = '\0';
+        secure_record->marks[index].cycles = DWT->CYCCNT;
+        secure_record->marks[index].clock_hz = SystemCoreClock;
+        secure_record->count = index + 1U;
+        secure_record->magic = BOOT_PROFILE_SECURE_MAGIC;
+    }
+}
+#endif
 /*****************************************************************************
 * Function Name: main
 ******************************************************************************
@@ -69,6 +105,17 @@ int main(void)
     cy_cmse_funcptr NonSecure_ResetHandler;
     cy_rslt_t result;
 
+#if (BOOT_PROFILE)
+    /* Start the boot time line at zero. The region is not initialized at
+     * reset, so the record is cleared first.
+     */
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    secure_record->magic = 0U;
+    secure_record->count = 0U;
+#endif
+
     /* Set up internal routing, pins, and clock-to-peripheral connections */
     result = cybsp_init();
 
@@ -85,6 +132,10 @@ int main(void)
 
     }
 
+#if (BOOT_PROFILE)
+    boot_profile_mark("Secure cybsp_init");
+#endif
+
     /* Enable global interrupts */
     __enable_irq();
 
@@ -93,6 +144,10 @@ int main(void)
     
     NonSecure_ResetHandler = (cy_cmse_funcptr)(*((uint32_t*)(CM33_NS_APP_BOOT_ADDR + 4)));
 
+#if (BOOT_PROFILE)
+    boot_profile_mark("Secure hand-off");
+#endif
+
     /* Start non-secure application */
     NonSecure_ResetHandler();
 
@@ -44,6 +44,13 @@
 #include "task.h"
 #include "cyabs_rtos.h"
 #include "cyabs_rtos_impl.h"
+#include <string.h>
+
+/* Boot-phase record shared with the CM33 non-secure project. */
+#include "boot_profile_shared.h"
+
+/* Energy accounting record shared with the CM33 non-secure project. */
+#include "energy_stats_shared.h"
 
 /*******************************************************************************
 * Macros
@@ -52,6 +59,15 @@
 #define TASK_STACK_SIZE          (configMINIMAL_STACK_SIZE * 4U)
 #define TASK_PRIORITY            (configMAX_PRIORITIES - 1U)
 
+/* Build with STATIC_ALLOCATION_PROFILE=1 to create the task from statically
+ * placed memory. The memory is grouped in one input section so that it shows
+ * up as a single block in the map file.
+ */
+#ifndef STATIC_ALLOCATION_PROFILE
+#define STATIC_ALLOCATION_PROFILE (0U)
+#endif
+#define STATIC_RTOS_SECTION      CY_SECTION(".bss.static_rtos")
+
 /* Enabling or disabling a MCWDT requires a wait time of upto 2 CLK_LF cycles  
  * to come into effect. This wait time value will depend on the actual CLK_LF  
  * frequency set by the BSP.
@@ -72,9 +88,215 @@ static mtb_hal_lptimer_t lptimer_obj;
 /* RTC HAL object */
 static mtb_hal_rtc_t rtc_obj;
 
+#if (BOOT_PROFILE)
+/* Boot markers read by the CM33 non-secure core for the boot report, in the
+ * dedicated boot profile region.
+ */
+static volatile boot_profile_cm55_record_t * const cm55_record = &BOOT_PROFILE_SHARED->cm55;
+#endif
+
+#if (ENERGY_STATS)
+/* Residency read by the CM33 non-secure core for the energy report. It must
+ * be the only object in the .cy_sharedmem section of both images.
+ */
+CY_SECTION_SHAREDMEM static volatile energy_stats_cm55_record_t energy_record;
+
+/* Low-power residency, in LPTimer ticks. */
+typedef struct
+{
+    uint64_t entered_ticks;
+    uint64_t total_ticks;
+} energy_residency_t;
+
+static uint32_t energy_last_count;
+static uint64_t energy_ticks = 0U;
+static energy_residency_t sleep_residency;
+static energy_residency_t deepsleep_residency;
+static uint32_t energy_wakeups = 0U;
+
+static cy_en_syspm_status_t energy_stats_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode);
+
+static cy_stc_syspm_callback_params_t energy_sleep_params =
+{
+    .base    = NULL,
+    .context = &sleep_residency
+};
+
+static cy_stc_syspm_callback_params_t energy_deepsleep_params =
+{
+    .base    = NULL,
+    .context = &deepsleep_residency
+};
+
+/* Both run last before and first after the transition. */
+static cy_stc_syspm_callback_t energy_sleep_callback =
+{
+    .callback       = energy_stats_callback,
+    .type           = CY_SYSPM_SLEEP,
+    .skipMode       = 0U,
+    .callbackParams = &energy_sleep_params,
+    .prevItm        = NULL,
+    .nextItm        = NULL,
+    .order          = 255U
+};
+
+static cy_stc_syspm_callback_t energy_deepsleep_callback =
+{
+    .callback       = energy_stats_callback,
+    .type           = CY_SYSPM_DEEPSLEEP,
+    .skipMode       = 0U,
+    .callbackParams = &energy_deepsleep_params,
+    .prevItm        = NULL,
+    .nextItm        = NULL,
+    .order          = 255U
+};
+#endif
+
+#if (STATIC_ALLOCATION_PROFILE)
+/* Stack and control block of the CM55 task. */
+STATIC_RTOS_SECTION static StackType_t cm55_task_stack[TASK_STACK_SIZE];
+STATIC_RTOS_SECTION static StaticTask_t cm55_task_tcb;
+
+/* Memory of the idle and timer service tasks. */
+STATIC_RTOS_SECTION static StaticTask_t idle_task_tcb;
+STATIC_RTOS_SECTION static StackType_t idle_task_stack[configMINIMAL_STACK_SIZE];
+STATIC_RTOS_SECTION static StaticTask_t timer_task_tcb;
+STATIC_RTOS_SECTION static StackType_t timer_task_stack[configTIMER_TASK_STACK_DEPTH];
+#endif
+
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
+#if (BOOT_PROFILE)
+/*******************************************************************************
+* Function Name: boot_profile_mark
+********************************************************************************
+* Summary:
+* Records the end of a CM55 boot phase in the shared boot record. Times are
+* counted by the DWT cycle counter from the start of main().
+*
+* Parameters:
+*  const char *name: Name of the phase that ends now
+*
+*******************************************************************************/
+static void boot_profile_mark(const char *name)
+{
+    uint32_t index = cm55_record->count;
+
+    if (index < BOOT_PROFILE_CM55_MAX_MARKS)
+    {
+        strncpy((char *)cm55_record->marks[index].name, name, BOOT_PROFILE_NAME_LEN - 1U);
+        cm55_record->marks[index].name[BOOT_PROFILE_NAME_LEN - 1U] = '\0';
+        cm55_record->marks[index].cycles = DWT->CYCCNT;
+        cm55_record->marks[index].clock_hz = SystemCoreClock;
+        cm55_record->count = index + 1U;
+        cm55_record->magic = BOOT_PROFILE_CM55_MAGIC;
+
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+        /* Make the record visible to the CM33 core. */
+        SCB_CleanDCache_by_Addr((void *)cm55_record, sizeof(*cm55_record));
+#endif
+    }
+}
+#endif
+
+#if (ENERGY_STATS)
+/*******************************************************************************
+* Function Name: energy_stats_publish
+********************************************************************************
+* Summary:
+* Brings the shared energy record up to date. seq is odd while the record is
+* being written so that the CM33 reader can detect a torn copy.
+*
+*******************************************************************************/
+static void energy_stats_publish(void)
+{
+    uint32_t count = mtb_hal_lptimer_read(&lptimer_obj);
+
+    energy_ticks += (uint32_t)(count - energy_last_count);
+    energy_last_count = count;
+
+    energy_record.seq++;
+    __DMB();
+    energy_record.elapsed_ticks = energy_ticks;
+    energy_record.sleep_ticks = sleep_residency.total_ticks;
+    energy_record.deepsleep_ticks = deepsleep_residency.total_ticks;
+    energy_record.wakeups = energy_wakeups;
+    __DMB();
+    energy_record.seq++;
+
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    /* Make the record visible to the CM33 core. */
+    SCB_CleanDCache_by_Addr((void *)&energy_record, sizeof(energy_record));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: energy_stats_callback
+********************************************************************************
+* Summary:
+* SysPm callback for both Sleep and Deep Sleep. Publishes the record on the
+* way in and adds the time spent in the mode on the way out.
+*
+* Parameters:
+*  cy_stc_syspm_callback_params_t *callback_params: context is the residency
+*  cy_en_syspm_callback_mode_t mode: Callback mode
+*
+* Return:
+*  cy_en_syspm_status_t: Always CY_SYSPM_SUCCESS
+*
+*******************************************************************************/
+static cy_en_syspm_status_t energy_stats_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode)
+{
+    energy_residency_t *residency = (energy_residency_t *)callback_params->context;
+
+    if (CY_SYSPM_BEFORE_TRANSITION == mode)
+    {
+        energy_stats_publish();
+        residency->entered_ticks = energy_ticks;
+    }
+    else if (CY_SYSPM_AFTER_TRANSITION == mode)
+    {
+        energy_stats_publish();
+        residency->total_ticks += energy_ticks - residency->entered_ticks;
+        energy_wakeups++;
+        energy_stats_publish();
+    }
+    else
+    {
+        /* Nothing to do for the readiness check and its rollback. */
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: energy_stats_start
+********************************************************************************
+* Summary:
+* Clears the shared energy record and registers the residency callbacks.
+* Call after the LPTimer is set up.
+*
+*******************************************************************************/
+static void energy_stats_start(void)
+{
+    energy_last_count = mtb_hal_lptimer_read(&lptimer_obj);
+    energy_record.seq = 0U;
+    energy_record.magic = ENERGY_STATS_CM55_MAGIC;
+    energy_stats_publish();
+
+    if (!Cy_SysPm_RegisterCallback(&energy_sleep_callback) ||
+        !Cy_SysPm_RegisterCallback(&energy_deepsleep_callback))
+    {
+        handle_app_error();
+    }
+}
+#endif
+
 /*******************************************************************************
 * Function Name: cm55_task
 ********************************************************************************
@@ -92,6 +314,10 @@ static mtb_hal_rtc_t rtc_obj;
  static void cm55_task(void * arg)
  {
      CY_UNUSED_PARAMETER(arg);
+
+#if (BOOT_PROFILE)
+     boot_profile_mark("Scheduler start");
+#endif
  
      for (;;)
      {
@@ -100,6 +326,41 @@ static mtb_hal_rtc_t rtc_obj;
      }
  }
  
+#if (STATIC_ALLOCATION_PROFILE)
+/*******************************************************************************
+* Function Name: vApplicationGetIdleTaskMemory
+********************************************************************************
+* Summary:
+* Provides the statically placed memory of the idle task. This overrides the
+* weak default of the RTOS abstraction library.
+*
+*******************************************************************************/
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+                                   StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    *ppxIdleTaskTCBBuffer = &idle_task_tcb;
+    *ppxIdleTaskStackBuffer = idle_task_stack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+/*******************************************************************************
+* Function Name: vApplicationGetTimerTaskMemory
+********************************************************************************
+* Summary:
+* Provides the statically placed memory of the timer service task.
+*
+*******************************************************************************/
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+                                    StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+    *ppxTimerTaskTCBBuffer = &timer_task_tcb;
+    *ppxTimerTaskStackBuffer = timer_task_stack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+
 /*******************************************************************************
 * Function Name: handle_app_error
 ********************************************************************************
@@ -255,6 +516,13 @@ int main(void)
 {
     cy_rslt_t result;
 
+#if (BOOT_PROFILE)
+    /* Start the CM55 boot time line at zero. */
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
     /* Initialize the device and board peripherals */
     result = cybsp_init();
 
@@ -263,20 +531,40 @@ int main(void)
     {
         handle_app_error();
     }
+#if (BOOT_PROFILE)
+    boot_profile_mark("cybsp_init");
+#endif
 
     /* Setup CLIB support library. */
     setup_clib_support();
+#if (BOOT_PROFILE)
+    boot_profile_mark("setup_clib_support");
+#endif
 
     /* Setup the LPTimer instance for CM55*/
     setup_tickless_idle_timer();
+#if (BOOT_PROFILE)
+    boot_profile_mark("setup_tickless_idle_timer");
+#endif
+
+#if (ENERGY_STATS)
+    /* Account the CM55 residency for the CM33 energy report. */
+    energy_stats_start();
+#endif
 
     /* Enable global interrupts */
     __enable_irq();
 
     /* Create the FreeRTOS Task */
+#if (STATIC_ALLOCATION_PROFILE)
+    result = (NULL != xTaskCreateStatic(cm55_task, TASK_NAME,
+                        TASK_STACK_SIZE, NULL, TASK_PRIORITY,
+                        cm55_task_stack, &cm55_task_tcb)) ? pdPASS : pdFAIL;
+#else
     result = xTaskCreate(cm55_task, TASK_NAME,
                         TASK_STACK_SIZE, NULL,
                         TASK_PRIORITY, NULL);
+#endif
 
     if( pdPASS == result )
     {
@@ -0,0 +1,132 @@
+/*******************************************************************************
+* File Name:   boot_profile_shared.h
+*
+* Description: This file contains the layout of the boot-phase records that
+* the CM33 secure and CM55 cores fill in shared memory and the CM33
+* non-secure core reads for the boot report.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BOOT_PROFILE_SHARED_H_
+#define BOOT_PROFILE_SHARED_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Build with BOOT_PROFILE=1 to record boot-phase timestamps on all cores. */
+#ifndef BOOT_PROFILE
+#define BOOT_PROFILE                             (0U)
+#endif
+
+#define BOOT_PROFILE_SECURE_MAGIC                (0xB0073333UL)
+#define BOOT_PROFILE_SECURE_MAX_MARKS            (4U)
+#define BOOT_PROFILE_CM55_MAGIC                  (0xB0075555UL)
+#define BOOT_PROFILE_CM55_MAX_MARKS              (8U)
+#define BOOT_PROFILE_NAME_LEN                    (24U)
+
+/* The records live at the start of the "m33_m55_boot_profile" memory region,
+ * so they have the same address in all three images whatever else the
+ * images place in shared memory. Add a 1 KB SRAM region of that name for
+ * CM33_0 and CM55_0 in the Device Configurator memory configuration; each
+ * core gets the address from its own generated symbols.
+ */
+#if (BOOT_PROFILE)
+#if defined(CORE_NAME_CM55_0)
+#if !defined(CYMEM_CM55_0_m33_m55_boot_profile_START)
+#error "BOOT_PROFILE needs the m33_m55_boot_profile region in the Device Configurator memory configuration"
+#endif
+#define BOOT_PROFILE_SHARED_ADDR                 (CYMEM_CM55_0_m33_m55_boot_profile_START)
+#else
+#if !defined(CYMEM_CM33_0_m33_m55_boot_profile_START)
+#error "BOOT_PROFILE needs the m33_m55_boot_profile region in the Device Configurator memory configuration"
+#endif
+#define BOOT_PROFILE_SHARED_ADDR                 (CYMEM_CM33_0_m33_m55_boot_profile_START)
+#endif
+
+#define BOOT_PROFILE_SHARED                      ((volatile boot_profile_shared_t *)BOOT_PROFILE_SHARED_ADDR)
+#endif /* BOOT_PROFILE */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* One marker. The cycle count is taken from the DWT cycle counter of the
+ * core, which is started at its first main(); the clock is the core clock
+ * at the time of the marker.
+ */
+typedef struct
+{
+    char name[BOOT_PROFILE_NAME_LEN];
+    uint32_t cycles;
+    uint32_t clock_hz;
+} boot_profile_shared_mark_t;
+
+/* Markers of the CM33 secure project, filled in before it starts the
+ * non-secure image. The CM33 cycle counter runs on into the non-secure
+ * project.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t count;
+    boot_profile_shared_mark_t marks[BOOT_PROFILE_SECURE_MAX_MARKS];
+} boot_profile_secure_record_t;
+
+/* Markers of the CM55 project. The CM33 non-secure core clears them before
+ * it enables the CM55 core.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t count;
+    boot_profile_shared_mark_t marks[BOOT_PROFILE_CM55_MAX_MARKS];
+} boot_profile_cm55_record_t;
+
+/* Layout of the m33_m55_boot_profile region. */
+typedef struct
+{
+    boot_profile_secure_record_t secure;
+    boot_profile_cm55_record_t cm55;
+} boot_profile_shared_t;
+
+#endif /* BOOT_PROFILE_SHARED_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* File Name:   energy_stats_shared.h
+*
+* Description: This file contains the energy accounting record that the CM55
+* core keeps in shared memory for the CM33 non-secure energy report.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ENERGY_STATS_SHARED_H_
+#define ENERGY_STATS_SHARED_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Build with ENERGY_STATS=1 to account the power-state residency of all cores
+ * and the network traffic for the energy model (energy_model.py).
+ */
+#ifndef ENERGY_STATS
+#define ENERGY_STATS                             (0U)
+#endif
+
+#define ENERGY_STATS_CM55_MAGIC                  (0xE5E55555UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* CM55 residency, placed in the .cy_sharedmem section of both non-secure
+ * images. Times are counted by the CM55 LPTimer, which runs from the same
+ * low-frequency clock as the CM33 LPTimer, and are brought up to date each
+ * time the CM55 wakes. The CM55 increments seq before and after each update,
+ * so the CM33 reader retries while seq is odd or changes under it.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t seq;
+    uint64_t elapsed_ticks;
+    uint64_t sleep_ticks;
+    uint64_t deepsleep_ticks;
+    uint32_t wakeups;
+} energy_stats_cm55_record_t;
+
+#endif /* ENERGY_STATS_SHARED_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,401 @@
+#******************************************************************************
+# File Name:   stack_usage.py
+#
+# Description: Host-side worst-case stack analysis for the task stacks of
+# proj_cm33_ns and proj_cm55. Reads the call graph and per-function stack
+# usage that GCC writes with STACK_USAGE=1 (.ci files), follows the calls
+# from each task entry point listed in configs/stack_usage.json, and reports
+# the deepest call chain. Stack high-water marks from TASK_STATS reports in a
+# terminal log, or given on the command line, are combined with it to
+# recommend a stack size for each task.
+#
+# Usage:
+#   python stack_usage.py proj_cm33_ns/build/APP_KIT_PSE84_EVAL_EPC2/Debug
+#   python stack_usage.py <build dirs> --log terminal.log
+#   python stack_usage.py <build dirs> --free "CM55 Task=1320" --json stacks.json
+#
+# Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+#******************************************************************************
+
+#!/usr/bin/python
+
+import argparse
+import json
+import os
+import re
+import sys
+
+REPO_ROOT = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_CONFIG = os.path.join(REPO_ROOT, "configs", "stack_usage.json")
+INDIRECT_CALL = "__indirect_call"
+WORD_BYTES = 4
+STACK_ALIGN = 8
+
+NODE = re.compile(r'^node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE = re.compile(r'^edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+STACK_LABEL = re.compile(r"\\n(\d+) bytes \(([a-z,]+)\)")
+DEFINE = re.compile(r"^\s*#\s*define\s+(\w+)\s+([^/]+?)\s*(/[/*].*)?$")
+IDENTIFIER = re.compile(r"\b[A-Za-z_]\w*\b")
+INTEGER_SUFFIX = re.compile(r"\b(\d+)[uUlL]+\b")
+# One task line of the TASK_STATS report (task_stats.c).
+TASK_STATS_LINE = re.compile(r"^(.+?)\s+\d+\.\d%\s+\d+\.\d%\s+(\d+)\s*$")
+
+
+class Function(object):
+    def __init__(self, title):
+        self.title = title
+        self.stack = None           # Bytes of its own frame, None if unknown
+        self.dynamic = False
+        self.calls = []
+
+
+def load_call_graph(build_dirs):
+    """Merges the .ci files found under the build directories."""
+    functions = {}
+    files = 0
+    for build_dir in build_dirs:
+        for root, _, names in os.walk(build_dir):
+            for name in names:
+                if not name.endswith(".ci"):
+                    continue
+                files += 1
+                with open(os.path.join(root, name), errors="replace") as ci_file:
+                    for line in ci_file:
+                        match = NODE.match(line)
+                        if match:
+                            function = functions.setdefault(match.group(1),
+                                                            Function(match.group(1)))
+                            stack = STACK_LABEL.search(match.group(2))
+                            if stack:
+                                # Defined here; a duplicate keeps the larger frame.
+                                size = int(stack.group(1))
+                                function.stack = max(size, function.stack or 0)
+                                function.dynamic = (function.dynamic or
+                                                    stack.group(2).startswith("dynamic") and
+                                                    "bounded" not in stack.group(2))
+                            continue
+                        match = EDGE.match(line)
+                        if match:
+                            functions.setdefault(match.group(1), Function(match.group(1)))
+                            functions[match.group(1)].calls.append(match.group(2))
+    return functions, files
+
+
+def find_function(functions, name):
+    """Finds a function by name; static functions are titled 'file.c:name'."""
+    if name in functions and functions[name].stack is not None:
+        return functions[name]
+    for title, function in sorted(functions.items()):
+        if title.endswith(":" + name) and function.stack is not None:
+            return function
+    return None
+
+
+class Analysis(object):
+    """Worst-case depth of the calls from one task entry point."""
+
+    def __init__(self, functions, indirect_targets, unknown_bytes):
+        self.functions = functions
+        self.unknown_bytes = unknown_bytes
+        self.indirect = [f for f in (find_function(functions, name)
+                                     for name in indirect_targets) if f is not None]
+        self.missing_targets = [name for name in indirect_targets
+                                if find_function(functions, name) is None]
+        self.memo = {}
+        self.unknown = set()
+        self.recursion = set()
+        self.dynamic = set()
+        self.indirect_sites = 0
+
+    def depth(self, title, active=()):
+        """Returns (bytes, chain) of the deepest path starting at title."""
+        if title in self.memo:
+            return self.memo[title]
+
+        function = self.functions.get(title)
+        if function is None or function.stack is None:
+            self.unknown.add(title)
+            return self.unknown_bytes, [title + " (no stack data)"]
+
+        if function.dynamic:
+            self.dynamic.add(title)
+        active = active + (title,)
+        deepest, chain = 0, []
+        for callee in function.calls:
+            if callee == INDIRECT_CALL:
+                self.indirect_sites += 1
+                size, path = self.unknown_bytes, ["(indirect call)"]
+                for target in self.indirect:
+                    if target.title in active:
+                        self.recursion.add(target.title)
+                        continue
+                    target_size, target_path = self.depth(target.title, active)
+                    if target_size > size:
+                        size, path = target_size, ["(indirect) " + target_path[0]] + target_path[1:]
+            elif callee in active:
+                # Counted once; the real depth depends on the recursion depth.
+                self.recursion.add(callee)
+                continue
+            else:
+                size, path = self.depth(callee, active)
+            if size > deepest:
+                deepest, chain = size, path
+
+        result = (function.stack + deepest, ["%s (%d)" % (title, function.stack)] + chain)
+        self.memo[title] = result
+        return result
+
+
+def project_defines(project):
+    """Object-like macros of the sources at the top level of a project, each
+    with every value it is defined to."""
+    defines = {}
+    directory = os.path.join(REPO_ROOT, project)
+    for name in sorted(os.listdir(directory)):
+        if not name.endswith((".c", ".h")):
+            continue
+        with open(os.path.join(directory, name), errors="replace") as source_file:
+            for line in source_file:
+                match = DEFINE.match(line)
+                if match:
+                    defines.setdefault(match.group(1), set()).add(match.group(2))
+    return defines
+
+
+def evaluate_macro(name, defines, depth=0):
+    """Value of a macro that expands to integer arithmetic, or None when it is
+    not defined, is defined differently under different build options, or
+    is not arithmetic."""
+    values = defines.get(name)
+    if not values or len(values) > 1 or depth > 16:
+        return None
+    expression = INTEGER_SUFFIX.sub(r"\1", next(iter(values)))
+    for identifier in set(IDENTIFIER.findall(expression)):
+        value = evaluate_macro(identifier, defines, depth + 1)
+        if value is None:
+            return None
+        expression = re.sub(r"\b%s\b" % identifier, str(value), expression)
+    if not re.match(r"^[\d\s()+\-*/]+$", expression):
+        return None
+    return int(eval(expression.replace("/", "//")))
+
+
+def source_words(task, defines):
+    """Stack size in words that the stack-macro of a task gives in the tree."""
+    return evaluate_macro(task["stack-macro"].split()[0], defines)
+
+
+def runtime_free_bytes(log_paths, free_options):
+    """Smallest free stack per task name seen in the TASK_STATS reports, and
+    values given as 'name=bytes'."""
+    free = {}
+    for path in log_paths:
+        in_report = False
+        with open(path, errors="replace") as log_file:
+            for line in log_file:
+                if line.startswith("Task ") and "Stack free" in line:
+                    in_report = True
+                    continue
+                if not in_report:
+                    continue
+                match = TASK_STATS_LINE.match(line.rstrip())
+                if not match:
+                    in_report = False
+                    continue
+                name, value = match.group(1).strip(), int(match.group(2))
+                # TASK_STATS runs on the CM33 only.
+                name = "proj_cm33_ns:" + name
+                free[name] = min(value, free.get(name, value))
+    for option in free_options:
+        name, _, value = option.rpartition("=")
+        if not name:
+            print("ERROR: --free takes 'task name=bytes', not '%s'" % option)
+            sys.exit(1)
+        free[name] = min(int(value), free.get(name, int(value)))
+    return free
+
+
+def round_up(value, step):
+    return (value + step - 1) // step * step
+
+
+def analyse_task(task, functions, config, free, defines, shared_names):
+    # The tree is authoritative; configured-words is used when the macro
+    # cannot be evaluated here.
+    words = source_words(task, defines)
+    configured = (task["configured-words"] if words is None else words) * WORD_BYTES
+    analysis = Analysis(functions, task.get("indirect-targets", []),
+                        config["unknown-function-bytes"])
+
+    static_bytes, chain = 0, []
+    for entry in task["entries"]:
+        function = find_function(functions, entry)
+        if function is None:
+            continue
+        size, path = analysis.depth(function.title)
+        if size > static_bytes:
+            static_bytes, chain = size, path
+
+    if not chain:
+        return None
+
+    # An interrupt stacks the extended (FPU) frame on the task stack.
+    static_bytes += config["exception-frame-bytes"]
+    # Tasks such as IDLE run on both cores; plain names are taken for the
+    # task of that name only where it is unique.
+    key = "%s:%s" % (task["project"], task["name"])
+    if key not in free and task["name"] not in shared_names:
+        key = task["name"]
+    runtime_bytes = configured - free[key] if key in free else None
+    need = max(static_bytes, runtime_bytes or 0)
+    recommended = round_up(need * (100 + config["margin-percent"]) // 100, STACK_ALIGN)
+
+    return {
+        "project": task["project"],
+        "task": task["name"],
+        "stack-macro": task["stack-macro"],
+        "configured_bytes": configured,
+        "configured_from_source": words is not None,
+        "listed_words": task["configured-words"],
+        "static_bytes": static_bytes,
+        "runtime_bytes": runtime_bytes,
+        "recommended_bytes": recommended,
+        "recommended_words": recommended // WORD_BYTES,
+        "saving_bytes": configured - recommended,
+        "complete": not (analysis.unknown or analysis.recursion or analysis.dynamic),
+        "deepest_chain": chain,
+        "unknown_functions": sorted(analysis.unknown),
+        "recursion": sorted(analysis.recursion),
+        "dynamic": sorted(analysis.dynamic),
+        "indirect_calls": analysis.indirect_sites,
+        "missing_indirect_targets": analysis.missing_targets,
+    }
+
+
+def print_result(result):
+    print("%s: %s" % (result["project"], result["task"]))
+    print("  Configured       : %6d bytes (%s)" % (result["configured_bytes"],
+                                                  result["stack-macro"]))
+    if not result["configured_from_source"]:
+        print("  Note: macro not evaluated; using configured-words %d from the configuration"
+              % result["listed_words"])
+    elif result["listed_words"] * WORD_BYTES != result["configured_bytes"]:
+        print("  Note: configured-words %d is out of date; the macro gives %d words"
+              % (result["listed_words"], result["configured_bytes"] // WORD_BYTES))
+    print("  Static worst case: %6d bytes%s" % (result["static_bytes"],
+          "" if result["complete"] else " (lower bound, see below)"))
+    if result["runtime_bytes"] is None:
+        print("  Runtime peak     :    n/a (no high-water mark given)")
+    else:
+        print("  Runtime peak     : %6d bytes" % result["runtime_bytes"])
+    print("  Recommended      : %6d bytes = %d words (%+d bytes)"
+          % (result["recommended_bytes"], result["recommended_words"],
+             -result["saving_bytes"]))
+    print("  Deepest chain:")
+    for step in result["deepest_chain"]:
+        print("    %s" % step)
+    if result["indirect_calls"]:
+        print("  Indirect calls   : %d, charged the deepest listed target"
+              % result["indirect_calls"])
+    for name in result["missing_indirect_targets"]:
+        print("  Note: indirect target %s not found in the call graph" % name)
+    for label, key in (("no stack data", "unknown_functions"), ("recursion", "recursion"),
+                       ("unbounded dynamic stack", "dynamic")):
+        if result[key]:
+            print("  Note: %s: %s" % (label, ", ".join(result[key][:8]) +
+                                      (", ..." if len(result[key]) > 8 else "")))
+    print("")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Worst-case task stack depth from GCC call graph and stack usage data")
+    parser.add_argument("build_dirs", nargs="+", help="Build output directories "
+                        "of projects built with STACK_USAGE=1; each task is looked "
+                        "up in the directories whose path names its project")
+    parser.add_argument("--config", default=DEFAULT_CONFIG,
+                        help="JSON task list (default: %(default)s)")
+    parser.add_argument("--log", action="append", default=[],
+                        help="Terminal log with TASK_STATS reports")
+    parser.add_argument("--free", action="append", default=[],
+                        help="Smallest free stack of a task as 'task name=bytes', for "
+                        "example read with the RTOS-aware debugger; prefix the project "
+                        "as in 'proj_cm55:IDLE=200' for a task name used on both cores")
+    parser.add_argument("--json", help="Write the results to this JSON file")
+    args = parser.parse_args()
+
+    with open(args.config) as config_file:
+        config = json.load(config_file)
+
+    free = runtime_free_bytes(args.log, args.free)
+    graphs = {}
+    defines = {}
+    names = [task["name"] for task in config["tasks"]]
+    shared_names = set(name for name in names if names.count(name) > 1)
+    results = []
+    for task in config["tasks"]:
+        # Each project is its own image; static functions of the same name
+        # in different projects must not be mixed up.
+        project = task["project"]
+        if project not in graphs:
+            dirs = [d for d in args.build_dirs
+                    if project in re.split(r"[/\\]", os.path.abspath(d))]
+            graphs[project] = load_call_graph(dirs)
+            defines[project] = project_defines(project)
+        functions, files = graphs[project]
+        if not files:
+            print("%s: %s: no .ci files for %s; build with 'make build STACK_USAGE=1'\n"
+                  % (project, task["name"], project))
+            continue
+
+        result = analyse_task(task, functions, config, free, defines[project], shared_names)
+        if result is None:
+            print("%s: %s: entry %s not in the call graph; skipped\n"
+                  % (task["project"], task["name"], " or ".join(task["entries"])))
+            continue
+        print_result(result)
+        results.append(result)
+
+    if results:
+        print("Stack bytes that can be given back: %d"
+              % sum(max(result["saving_bytes"], 0) for result in results))
+
+    if args.json:
+        with open(args.json, "w") as output_file:
+            json.dump(results, output_file, indent=4)
+        print("Generated %s" % args.json)
+
+
+if __name__ == "__main__":
+    main()
+
+# [] END OF FILE